@@ -0,0 +1,84 @@
+#pragma once
+
+// Shared helpers for the host benchmark and simulation suites. Each suite is
+// a function selected by name on the command line (see bench_main.cpp).
+
+#include <Arduino.h>
+
+#include <algorithm>
+#include <cstdint>
+#include <vector>
+
+#include "host_runtime.h"
+
+namespace bench {
+
+struct Stats {
+    uint32_t iterations = 0;
+    double mean_ns = 0.0;
+    uint64_t p50_ns = 0;
+    uint64_t p99_ns = 0;
+    uint64_t max_ns = 0;
+};
+
+Stats summarize(std::vector<uint64_t>& samples_ns);
+void print_header(const char* suite);
+void print_stats(const char* name, const Stats& stats);
+
+// Times each call to fn individually with Serial muted, after a short warm-up.
+template <typename Fn>
+Stats measure(uint32_t iterations, Fn&& fn) {
+    host::serial_set_enabled(false);
+    for (uint32_t i = 0; i < std::min<uint32_t>(iterations / 10 + 1, 100); ++i) {
+        fn();
+    }
+    std::vector<uint64_t> samples;
+    samples.reserve(iterations);
+    for (uint32_t i = 0; i < iterations; ++i) {
+        const uint64_t start = host::real_now_ns();
+        fn();
+        samples.push_back(host::real_now_ns() - start);
+    }
+    host::serial_set_enabled(true);
+    return summarize(samples);
+}
+
+// operator new calls made by the process so far (bench_main.cpp replaces
+// the global allocator to count them).
+uint64_t allocation_count();
+
+// Heap allocations per call of fn, averaged over iterations.
+template <typename Fn>
+double allocations_per_call(uint32_t iterations, Fn&& fn) {
+    fn();
+    const uint64_t before = allocation_count();
+    for (uint32_t i = 0; i < iterations; ++i) {
+        fn();
+    }
+    return static_cast<double>(allocation_count() - before) / iterations;
+}
+
+// Prints a failed expectation and returns false so suites can exit non-zero.
+bool check(bool condition, const char* what);
+
+int run_services(int argc, char** argv);
+int run_inflate(int argc, char** argv);
+int run_scheduler_sim(int argc, char** argv);
+int run_event_loop_sim(int argc, char** argv);
+int run_http_queue_sim(int argc, char** argv);
+int run_conditional_get_sim(int argc, char** argv);
+int run_sync_sim(int argc, char** argv);
+int run_portal_sim(int argc, char** argv);
+int run_fleet_sim(int argc, char** argv);
+int run_outbox_sim(int argc, char** argv);
+int run_activity_sim(int argc, char** argv);
+int run_net_phases_sim(int argc, char** argv);
+int run_nonce_bench(int argc, char** argv);
+int run_base64_bench(int argc, char** argv);
+int run_qr_encoder_bench(int argc, char** argv);
+
+// The mbedtls + String::replace base64url encoder the firmware used before
+// its fixed-buffer codec, kept as the baseline (bench_base64.cpp).
+String legacy_base64url_encode(const uint8_t* data, size_t length);
+
+} // namespace bench
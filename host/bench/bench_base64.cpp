@@ -0,0 +1,183 @@
+#include <mbedtls/base64.h>
+
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <string>
+#include <vector>
+
+#include "bench.h"
+#include "src/services/service_auth.h"
+
+namespace bench {
+
+String legacy_base64url_encode(const uint8_t* data, size_t length) {
+    size_t output_length = 0;
+    std::vector<uint8_t> output(((length + 2) / 3) * 4 + 1);
+    if (mbedtls_base64_encode(output.data(), output.size(), &output_length, data, length) != 0) {
+        return "";
+    }
+    String encoded(reinterpret_cast<char*>(output.data()), output_length);
+    encoded.replace("+", "-");
+    encoded.replace("/", "_");
+    encoded.replace("=", "");
+    return encoded;
+}
+
+namespace {
+
+struct Vector {
+    const char* bytes;
+    const char* text;
+};
+
+// RFC 4648 section 10, in the URL alphabet and without padding.
+constexpr Vector kRfcVectors[] = {
+    {"", ""},
+    {"f", "Zg"},
+    {"fo", "Zm8"},
+    {"foo", "Zm9v"},
+    {"foob", "Zm9vYg"},
+    {"fooba", "Zm9vYmE"},
+    {"foobar", "Zm9vYmFy"},
+};
+
+// The mbedtls decoder on the way back: URL alphabet to standard, padding
+// put back, a vector per call.
+int legacy_base64url_decode(const String& text, std::vector<uint8_t>& out) {
+    String standard = text;
+    standard.replace("-", "+");
+    standard.replace("_", "/");
+    while (standard.length() % 4 != 0) {
+        standard += "=";
+    }
+    out.assign(standard.length() / 4 * 3, 0);
+    size_t output_length = 0;
+    if (mbedtls_base64_decode(out.data(), out.size(), &output_length,
+            reinterpret_cast<const uint8_t*>(standard.c_str()), standard.length()) != 0) {
+        return -1;
+    }
+    out.resize(output_length);
+    return static_cast<int>(output_length);
+}
+
+bool encodes_to(const uint8_t* data, size_t length, const char* expected) {
+    char out[64];
+    const size_t written = ptc::service_auth_base64url_encode(data, length, out, sizeof(out));
+    return written == strlen(expected) && strcmp(out, expected) == 0;
+}
+
+bool decodes_to(const char* text, const uint8_t* expected, size_t expected_length) {
+    uint8_t out[64];
+    const int written = ptc::service_auth_base64url_decode(text, strlen(text), out, sizeof(out));
+    return written == static_cast<int>(expected_length) && memcmp(out, expected, expected_length) == 0;
+}
+
+bool rejects(const char* text) {
+    uint8_t out[64];
+    return ptc::service_auth_base64url_decode(text, strlen(text), out, sizeof(out)) == -1;
+}
+
+// Every length up to 300 against the mbedtls path, and back again.
+bool round_trips() {
+    uint8_t data[300];
+    char text[ptc::service_auth_base64url_length(sizeof(data)) + 1];
+    uint8_t back[sizeof(data)];
+    srand(4648);
+    for (size_t length = 0; length <= sizeof(data); ++length) {
+        for (size_t i = 0; i < length; ++i) {
+            data[i] = static_cast<uint8_t>(rand());
+        }
+        const size_t written = ptc::service_auth_base64url_encode(data, length, text, sizeof(text));
+        if (written != ptc::service_auth_base64url_length(length) || legacy_base64url_encode(data, length) != text ||
+            ptc::service_auth_base64url_decode(text, written, back, length) != static_cast<int>(length) ||
+            memcmp(back, data, length) != 0) {
+            printf("round trip differs at %u bytes\n", static_cast<unsigned>(length));
+            return false;
+        }
+    }
+    return true;
+}
+
+void print_case(const char* name, size_t length, uint32_t iterations, const std::vector<uint8_t>& data) {
+    char label[40];
+    char text[ptc::service_auth_base64url_length(256) + 1];
+    snprintf(label, sizeof(label), "legacy encode, %u B", static_cast<unsigned>(length));
+    print_stats(label, measure(iterations, [&] {
+        legacy_base64url_encode(data.data(), length);
+    }));
+    snprintf(label, sizeof(label), "encode, %u B (%s)", static_cast<unsigned>(length), name);
+    print_stats(label, measure(iterations, [&] {
+        ptc::service_auth_base64url_encode(data.data(), length, text, sizeof(text));
+    }));
+
+    ptc::service_auth_base64url_encode(data.data(), length, text, sizeof(text));
+    const String encoded(text);
+    std::vector<uint8_t> legacy_out;
+    uint8_t out[256];
+    snprintf(label, sizeof(label), "legacy decode, %u B", static_cast<unsigned>(length));
+    print_stats(label, measure(iterations, [&] {
+        legacy_base64url_decode(encoded, legacy_out);
+    }));
+    snprintf(label, sizeof(label), "decode, %u B", static_cast<unsigned>(length));
+    print_stats(label, measure(iterations, [&] {
+        ptc::service_auth_base64url_decode(text, encoded.length(), out, sizeof(out));
+    }));
+}
+
+} // namespace
+
+int run_base64_bench(int argc, char** argv) {
+    const uint32_t iterations = argc > 1 ? static_cast<uint32_t>(strtoul(argv[1], nullptr, 10)) : 20000;
+    bool ok = true;
+
+    bool rfc_ok = true;
+    for (const Vector& vector : kRfcVectors) {
+        const auto* bytes = reinterpret_cast<const uint8_t*>(vector.bytes);
+        rfc_ok &= encodes_to(bytes, strlen(vector.bytes), vector.text) &&
+            decodes_to(vector.text, bytes, strlen(vector.bytes));
+    }
+    ok &= check(rfc_ok, "RFC 4648 test vectors encode and decode");
+    const uint8_t url_bytes[] = {0xfb, 0xff, 0xbf};
+    ok &= check(encodes_to(url_bytes, 2, "-_8") && encodes_to(url_bytes, 3, "-_-_") &&
+            decodes_to("-_-_", url_bytes, 3),
+        "62 and 63 are '-' and '_'");
+    ok &= check(decodes_to("Zm9vYg==", reinterpret_cast<const uint8_t*>("foob"), 4) &&
+            decodes_to("Zm9vYmE=", reinterpret_cast<const uint8_t*>("fooba"), 5),
+        "padded input decodes");
+    ok &= check(rejects("Zm9v+A") && rejects("Zm/v") && rejects("Zm9 ") && rejects("Z") && rejects("Zm9vY") &&
+            rejects("Zh") && rejects("Zm9") && rejects("Zm9v===="),
+        "bad characters, lengths and trailing bits are rejected");
+
+    char small[5];
+    uint8_t small_out[2];
+    ok &= check(ptc::service_auth_base64url_encode(url_bytes, 3, small, 4) == 0 &&
+            ptc::service_auth_base64url_encode(url_bytes, 3, small, sizeof(small)) == 4 &&
+            ptc::service_auth_base64url_decode("Zm9v", 4, small_out, sizeof(small_out)) == -1,
+        "buffers one short are refused");
+    ok &= check(round_trips(), "0..300 random bytes match mbedtls and decode back");
+
+    std::vector<uint8_t> data(256);
+    for (size_t i = 0; i < data.size(); ++i) {
+        data[i] = static_cast<uint8_t>(i * 37 + 11);
+    }
+    char text[ptc::service_auth_base64url_length(256) + 1];
+    uint8_t out[256];
+    const double legacy_allocations = allocations_per_call(1000, [&] {
+        legacy_base64url_encode(data.data(), 32);
+    });
+    const double allocations = allocations_per_call(1000, [&] {
+        ptc::service_auth_base64url_encode(data.data(), 32, text, sizeof(text));
+        ptc::service_auth_base64url_decode(text, ptc::kSignatureLength, out, sizeof(out));
+    });
+    ok &= check(allocations == 0.0, "encode and decode take no heap");
+
+    print_header("base64");
+    print_case("nonce", 12, iterations, data);
+    print_case("HMAC digest", 32, iterations, data);
+    print_case("QR JSON", 200, iterations, data);
+    printf("allocations/call (32 B): legacy encode %.1f -> encode+decode %.1f\n", legacy_allocations, allocations);
+    return ok ? 0 : 1;
+}
+
+} // namespace bench
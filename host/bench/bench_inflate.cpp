@@ -0,0 +1,184 @@
+#include <ArduinoJson.h>
+#include <WiFiClient.h>
+
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <string>
+
+#include "bench.h"
+#include "inflate_fixtures.h"
+#include "src/services/service_http_stream.h"
+
+namespace bench {
+
+namespace {
+
+// Airtime the compression saves on a weak link, 1 Mbit/s = 125 bytes/ms.
+constexpr double kWeakLinkBytesPerMs = 125.0;
+
+uint32_t crc32(const std::string& data) {
+    uint32_t crc = 0xFFFFFFFF;
+    for (unsigned char c : data) {
+        crc ^= c;
+        for (uint8_t bit = 0; bit < 8; ++bit) {
+            crc = (crc >> 1) ^ (0xEDB88320U & (0U - (crc & 1U)));
+        }
+    }
+    return ~crc;
+}
+
+std::string inflate_all(ptc::InflateStream& stream) {
+    std::string out;
+    for (int c = stream.read(); c >= 0; c = stream.read()) {
+        out += static_cast<char>(c);
+    }
+    return out;
+}
+
+struct Decoded {
+    std::string data;
+    bool finished = false;
+    bool failed = false;
+};
+
+Decoded decode(const InflateFixture& fixture, size_t window_bytes, const uint8_t* data = nullptr, size_t size = 0) {
+    ptc::MemoryStream source(reinterpret_cast<const char*>(data ? data : fixture.data), data ? size : fixture.size);
+    ptc::InflateStream stream(source, fixture.encoding, window_bytes);
+    Decoded decoded;
+    decoded.data = inflate_all(stream);
+    decoded.finished = stream.finished();
+    decoded.failed = stream.failed();
+    return decoded;
+}
+
+const InflateFixture& fixture(const char* name) {
+    for (const InflateFixture& candidate : kInflateFixtures) {
+        if (strcmp(candidate.name, name) == 0) {
+            return candidate;
+        }
+    }
+    abort();
+}
+
+std::string chunked(const uint8_t* data, size_t size, size_t chunk_bytes) {
+    std::string framed;
+    for (size_t offset = 0; offset < size; offset += chunk_bytes) {
+        const size_t length = std::min(chunk_bytes, size - offset);
+        char line[16];
+        snprintf(line, sizeof(line), "%zx\r\n", length);
+        framed += line;
+        framed.append(reinterpret_cast<const char*>(data + offset), length);
+        framed += "\r\n";
+    }
+    return framed + "0\r\n\r\n";
+}
+
+bool check_fixtures() {
+    bool ok = true;
+    for (const InflateFixture& item : kInflateFixtures) {
+        const Decoded decoded = decode(item, ptc::kInflateMaxWindowBytes);
+        const bool matches = decoded.finished && decoded.data.size() == item.plain_size &&
+            crc32(decoded.data) == item.plain_crc;
+        char what[96];
+        snprintf(what, sizeof(what), "%s inflates to the recorded JSON", item.name);
+        ok &= check(matches, what);
+        if (item.window_bytes < ptc::kInflateMaxWindowBytes) {
+            const Decoded bounded = decode(item, item.window_bytes);
+            snprintf(what, sizeof(what), "%s inflates in a %u B window", item.name,
+                static_cast<unsigned>(item.window_bytes));
+            ok &= check(bounded.finished && crc32(bounded.data) == item.plain_crc, what);
+        }
+    }
+
+    // A 32 KB-window stream refuses a smaller window instead of corrupting
+    // the output: zlib at the header, gzip at the first far back reference.
+    ok &= check(decode(fixture("activity_deflate"), 512).failed, "zlib window larger than the buffer is refused");
+    ok &= check(decode(fixture("release_gzip"), 512).failed, "gzip back reference past the window fails");
+
+    const InflateFixture& notices = fixture("notices_gzip");
+    std::string corrupt(reinterpret_cast<const char*>(notices.data), notices.size);
+    corrupt[notices.size / 2] ^= 0x20;
+    const Decoded damaged = decode(notices, ptc::kInflateMaxWindowBytes,
+        reinterpret_cast<const uint8_t*>(corrupt.data()), corrupt.size());
+    ok &= check(!damaged.finished, "corrupt gzip body is not accepted");
+    const InflateFixture& activity = fixture("activity_deflate");
+    ok &= check(decode(activity, ptc::kInflateMaxWindowBytes, activity.data, activity.size / 2).failed,
+        "truncated deflate body fails");
+
+    // As service_http reads notices: chunked transfer, then inflate, then
+    // the array walked element by element.
+    WiFiClient client;
+    client.host_receive(chunked(notices.data, notices.size, 100), true);
+    ptc::HttpBodyStream body(client, -1, true, 1000);
+    uint16_t elements = 0;
+    bool trailer_ok = false;
+    {
+        ptc::InflateStream inflated(body, notices.encoding);
+        StaticJsonDocument<64> filter;
+        filter["id"] = true;
+        DynamicJsonDocument item(4096);
+        ptc::JsonArrayReader reader(inflated);
+        while (reader.next(item, filter) == ptc::JsonArrayStep::kElement) {
+            elements++;
+        }
+        trailer_ok = inflated.read_to_end();
+    }
+    ok &= check(elements == notices.elements && trailer_ok && body.drain() && body.finished(),
+        "chunked gzip notices parse element by element");
+
+    // As service_ota reads the release: filtered straight off the stream.
+    const InflateFixture& release_fixture = fixture("release_gzip");
+    ptc::MemoryStream release_source(reinterpret_cast<const char*>(release_fixture.data), release_fixture.size);
+    ptc::InflateStream release_stream(release_source, release_fixture.encoding);
+    StaticJsonDocument<256> filter;
+    filter["tag_name"] = true;
+    filter["assets"][0]["name"] = true;
+    DynamicJsonDocument release(2048);
+    const bool parsed = deserializeJson(release, release_stream, DeserializationOption::Filter(filter)) ==
+        DeserializationError::Ok;
+    ok &= check(parsed && String(release["tag_name"] | "") == "v1.4.0" &&
+            String(release["assets"][0]["name"] | "") == "firmware.bin",
+        "gzip release JSON parses through the filter");
+    ok &= check(release_stream.read_to_end(), "release gzip trailer is read after the parser stops");
+
+    // The JSON parses before the trailer is reached, so a bad CRC only shows
+    // once the rest is read.
+    std::string bad_crc(reinterpret_cast<const char*>(release_fixture.data), release_fixture.size);
+    bad_crc[bad_crc.size() - 8] ^= 0x01;
+    ptc::MemoryStream bad_source(bad_crc.data(), bad_crc.size());
+    ptc::InflateStream bad_stream(bad_source, release_fixture.encoding);
+    const bool bad_parsed = deserializeJson(release, bad_stream, DeserializationOption::Filter(filter)) ==
+        DeserializationError::Ok;
+    ok &= check(bad_parsed && !bad_stream.read_to_end(), "gzip body with a bad CRC parses but fails read_to_end");
+    return ok;
+}
+
+} // namespace
+
+int run_inflate(int argc, char** argv) {
+    const uint32_t iterations = argc > 1 ? static_cast<uint32_t>(strtoul(argv[1], nullptr, 10)) : 300;
+    bool ok = check_fixtures();
+
+    printf("\n== inflate (recorded portal/GitHub bodies; decode time vs bytes saved) ==\n");
+    printf("%-22s %8s %8s %6s %10s %8s %14s\n",
+        "body", "json_b", "wire_b", "saved", "mean_us", "MB/s", "air_saved_ms");
+    for (const InflateFixture& item : kInflateFixtures) {
+        const Stats stats = measure(iterations, [&]() {
+            decode(item, ptc::kInflateMaxWindowBytes);
+        });
+        const double saved = item.plain_size > item.size ? item.plain_size - item.size : 0.0;
+        printf("%-22s %8u %8u %5.0f%% %10.1f %8.1f %14.1f\n",
+            item.name,
+            static_cast<unsigned>(item.plain_size),
+            static_cast<unsigned>(item.size),
+            100.0 * (1.0 - static_cast<double>(item.size) / item.plain_size),
+            stats.mean_ns / 1000.0,
+            item.plain_size / (stats.mean_ns / 1000.0),
+            saved / kWeakLinkBytesPerMs);
+    }
+    fflush(stdout);
+    return ok ? 0 : 1;
+}
+
+} // namespace bench
@@ -0,0 +1,157 @@
+#include <atomic>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <new>
+
+#include "bench.h"
+
+namespace {
+
+std::atomic<uint64_t> g_allocations{0};
+
+void* counted_alloc(size_t size) {
+    g_allocations.fetch_add(1, std::memory_order_relaxed);
+    return malloc(size ? size : 1);
+}
+
+} // namespace
+
+// Every operator new in the process is counted, so suites can report heap
+// allocations per call next to time per call.
+void* operator new(size_t size) {
+    void* pointer = counted_alloc(size);
+    if (!pointer) {
+        throw std::bad_alloc();
+    }
+    return pointer;
+}
+void* operator new[](size_t size) {
+    return operator new(size);
+}
+void* operator new(size_t size, const std::nothrow_t&) noexcept {
+    return counted_alloc(size);
+}
+void* operator new[](size_t size, const std::nothrow_t&) noexcept {
+    return counted_alloc(size);
+}
+void operator delete(void* pointer) noexcept {
+    free(pointer);
+}
+void operator delete[](void* pointer) noexcept {
+    free(pointer);
+}
+void operator delete(void* pointer, size_t) noexcept {
+    free(pointer);
+}
+void operator delete[](void* pointer, size_t) noexcept {
+    free(pointer);
+}
+
+namespace bench {
+
+uint64_t allocation_count() {
+    return g_allocations.load(std::memory_order_relaxed);
+}
+
+namespace {
+
+struct Suite {
+    const char* name;
+    int (*run)(int argc, char** argv);
+    const char* description;
+};
+
+constexpr Suite kSuites[] = {
+    {"services", run_services, "auth signature, QR payload, notices/activity JSON, activity file"},
+    {"inflate", run_inflate, "gzip/deflate decode of recorded bodies: correctness, MB/s vs bytes saved"},
+    {"scheduler", run_scheduler_sim, "legacy tick chain vs deadline scheduler: wakeups/s and jitter"},
+    {"event_loop", run_event_loop_sim, "polling loop vs notification-driven loop: wakeups and event latency"},
+    {"http_queue", run_http_queue_sim, "single-slot HTTP worker vs priority queue: manual-code latency"},
+    {"conditional_get", run_conditional_get_sim, "ETag/If-None-Match polling vs full refetch: bytes, 304s, SD/NVS writes"},
+    {"sync", run_sync_sim, "separate config/heartbeat/activity/notices requests vs one batched sync"},
+    {"portal", run_portal_sim, "mock PT Portal over TCP: HMAC checks, request rate, backoff, recovery ('serve [port]' to run it)"},
+    {"fleet", run_fleet_sim, "many devices vs a mock portal outage: global doubling vs jittered endpoint breakers"},
+    {"outbox", run_outbox_sim, "offline outbox: records kept across Wi-Fi loss and reboot, batched drain, dedupe"},
+    {"activity", run_activity_sim, "10k-event activity backlog: since= poll vs chained cursor pages, resumed mid-page"},
+    {"net_phases", run_net_phases_sim, "per-request DNS/connect/ttfb/body timing: slow resolver vs handshake vs portal"},
+    {"nonce", run_nonce_bench, "nonce entropy ring + fixed-buffer base64url vs per-call vector and String"},
+    {"base64", run_base64_bench, "table-driven base64url into caller buffers vs mbedtls + String::replace"},
+    {"qr_encoder", run_qr_encoder_bench, "QR encoder for versions 5-10 vs qrcode_initText: same modules, encode time"},
+};
+
+void print_usage(const char* program) {
+    printf("usage: %s <suite> [args]\n\nsuites:\n", program);
+    for (const Suite& suite : kSuites) {
+        printf("  %-16s %s\n", suite.name, suite.description);
+    }
+    printf("  %-16s run every suite with default arguments\n", "all");
+}
+
+} // namespace
+
+Stats summarize(std::vector<uint64_t>& samples_ns) {
+    Stats stats;
+    stats.iterations = static_cast<uint32_t>(samples_ns.size());
+    if (samples_ns.empty()) {
+        return stats;
+    }
+    std::sort(samples_ns.begin(), samples_ns.end());
+    double total = 0.0;
+    for (const uint64_t sample : samples_ns) {
+        total += static_cast<double>(sample);
+    }
+    stats.mean_ns = total / static_cast<double>(samples_ns.size());
+    stats.p50_ns = samples_ns[samples_ns.size() / 2];
+    stats.p99_ns = samples_ns[std::min(samples_ns.size() - 1, samples_ns.size() * 99 / 100)];
+    stats.max_ns = samples_ns.back();
+    return stats;
+}
+
+void print_header(const char* suite) {
+    printf("\n== %s ==\n", suite);
+    printf("%-32s %8s %11s %11s %11s %11s\n", "case", "iters", "mean_us", "p50_us", "p99_us", "max_us");
+}
+
+void print_stats(const char* name, const Stats& stats) {
+    printf("%-32s %8u %11.2f %11.2f %11.2f %11.2f\n",
+        name,
+        static_cast<unsigned>(stats.iterations),
+        stats.mean_ns / 1000.0,
+        static_cast<double>(stats.p50_ns) / 1000.0,
+        static_cast<double>(stats.p99_ns) / 1000.0,
+        static_cast<double>(stats.max_ns) / 1000.0);
+    fflush(stdout);
+}
+
+bool check(bool condition, const char* what) {
+    if (!condition) {
+        printf("CHECK FAILED: %s\n", what);
+        fflush(stdout);
+    }
+    return condition;
+}
+
+} // namespace bench
+
+int main(int argc, char** argv) {
+    if (argc < 2) {
+        bench::print_usage(argv[0]);
+        return 2;
+    }
+    if (strcmp(argv[1], "all") == 0) {
+        int failures = 0;
+        for (const auto& suite : bench::kSuites) {
+            char* suite_argv[] = {const_cast<char*>(suite.name), nullptr};
+            failures += suite.run(1, suite_argv) != 0 ? 1 : 0;
+        }
+        return failures == 0 ? 0 : 1;
+    }
+    for (const auto& suite : bench::kSuites) {
+        if (strcmp(argv[1], suite.name) == 0) {
+            return suite.run(argc - 1, argv + 1);
+        }
+    }
+    bench::print_usage(argv[0]);
+    return 2;
+}
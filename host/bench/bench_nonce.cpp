@@ -0,0 +1,169 @@
+#include <esp_system.h>
+
+#include <atomic>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <set>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "bench.h"
+#include "src/services/service_auth.h"
+#include "src/services/service_auth_entropy.h"
+
+namespace bench {
+
+namespace {
+
+constexpr uint32_t kThreadTakes = 20000;
+constexpr char kBase64UrlAlphabet[] = "ABCDEFGHIJKLMNOPQRSTUVWXYZabcdefghijklmnopqrstuvwxyz0123456789-_";
+
+// The nonce as it was made before the entropy ring: a vector per call, an
+// RNG read, and base64 turned into base64url through String::replace.
+String legacy_nonce(size_t byte_count) {
+    std::vector<uint8_t> bytes(byte_count);
+    esp_fill_random(bytes.data(), bytes.size());
+    return legacy_base64url_encode(bytes.data(), bytes.size());
+}
+
+bool is_base64url(const char* text, size_t length) {
+    return strlen(text) == length && strspn(text, kBase64UrlAlphabet) == length;
+}
+
+void drain_ring() {
+    uint8_t bytes[ptc::kEntropySlotBytes];
+    while (ptc::service_auth_entropy_level() > 0) {
+        ptc::service_auth_entropy_take(bytes, sizeof(bytes));
+    }
+}
+
+// Times each format on its own with the ring topped up between batches, so
+// the refill stays out of the samples.
+Stats measure_pooled(uint32_t iterations, char* out, size_t out_size) {
+    host::serial_set_enabled(false);
+    std::vector<uint64_t> samples;
+    samples.reserve(iterations);
+    while (samples.size() < iterations) {
+        ptc::service_auth_entropy_refill();
+        for (uint8_t i = 0; i < ptc::kEntropySlots && samples.size() < iterations; ++i) {
+            const uint64_t start = host::real_now_ns();
+            ptc::service_auth_format_nonce(out, out_size);
+            samples.push_back(host::real_now_ns() - start);
+        }
+    }
+    host::serial_set_enabled(true);
+    return summarize(samples);
+}
+
+// One producer topping the ring up while two takers drain it; every nonce
+// must come out once.
+bool run_contention(uint32_t& out_taken, uint32_t& out_fallbacks) {
+    drain_ring();
+    ptc::EntropyStats before;
+    ptc::service_auth_entropy_stats(before);
+    std::atomic<bool> done{false};
+    std::thread producer([&] {
+        while (!done.load()) {
+            ptc::service_auth_entropy_refill();
+        }
+    });
+    std::vector<std::string> nonces[2];
+    std::vector<std::thread> takers;
+    for (auto& out : nonces) {
+        takers.emplace_back([&out] {
+            out.reserve(kThreadTakes);
+            char nonce[ptc::kNonceLength + 1];
+            for (uint32_t i = 0; i < kThreadTakes; ++i) {
+                ptc::service_auth_format_nonce(nonce, sizeof(nonce));
+                out.push_back(nonce);
+            }
+        });
+    }
+    for (std::thread& taker : takers) {
+        taker.join();
+    }
+    done = true;
+    producer.join();
+
+    ptc::EntropyStats after;
+    ptc::service_auth_entropy_stats(after);
+    out_taken = after.taken - before.taken;
+    out_fallbacks = after.fallbacks - before.fallbacks;
+    std::set<std::string> unique;
+    for (const auto& out : nonces) {
+        unique.insert(out.begin(), out.end());
+    }
+    return unique.size() == kThreadTakes * 2 && out_taken + out_fallbacks == kThreadTakes * 2;
+}
+
+} // namespace
+
+int run_nonce_bench(int argc, char** argv) {
+    const uint32_t iterations = argc > 1 ? static_cast<uint32_t>(strtoul(argv[1], nullptr, 10)) : 20000;
+    bool ok = true;
+    char nonce[ptc::kNonceLength + 1];
+    char qr_nonce[17];
+
+    drain_ring();
+    ok &= check(ptc::service_auth_format_nonce(nonce, sizeof(nonce)) == ptc::kNonceLength &&
+            is_base64url(nonce, ptc::kNonceLength),
+        "16-byte nonce is 22 base64url chars");
+    ok &= check(ptc::service_auth_format_nonce(qr_nonce, sizeof(qr_nonce), 12) == 16 && is_base64url(qr_nonce, 16),
+        "12-byte QR nonce is 16 base64url chars");
+    ok &= check(ptc::service_auth_entropy_refill() == ptc::kEntropySlots &&
+            ptc::service_auth_entropy_refill() == 0 && ptc::service_auth_entropy_level() == ptc::kEntropySlots,
+        "refill fills every slot once");
+    ok &= check(ptc::service_auth_format_nonce(nonce, ptc::kNonceLength) == 0 &&
+            ptc::service_auth_format_nonce(nonce, sizeof(nonce), ptc::kEntropySlotBytes + 1) == 0 &&
+            ptc::service_auth_entropy_level() == ptc::kEntropySlots,
+        "a nonce that does not fit is refused without taking a slot");
+    ptc::EntropyStats before;
+    ptc::service_auth_entropy_stats(before);
+    ptc::service_auth_format_nonce(nonce, sizeof(nonce));
+    ptc::EntropyStats after;
+    ptc::service_auth_entropy_stats(after);
+    ok &= check(after.taken == before.taken + 1 && after.fallbacks == before.fallbacks &&
+            after.level == ptc::kEntropySlots - 1,
+        "a nonce takes one slot from the ring");
+    drain_ring();
+    ptc::service_auth_entropy_stats(before);
+    ok &= check(ptc::service_auth_format_nonce(nonce, sizeof(nonce)) == ptc::kNonceLength &&
+            is_base64url(nonce, ptc::kNonceLength),
+        "an empty ring still yields a nonce");
+    ptc::service_auth_entropy_stats(after);
+    ok &= check(after.fallbacks == before.fallbacks + 1, "an empty ring falls back to the RNG");
+
+    const double legacy_allocations = allocations_per_call(1000, [] {
+        legacy_nonce(16);
+    });
+    const double pooled_allocations = allocations_per_call(ptc::kEntropySlots - 1, [&] {
+        ptc::service_auth_format_nonce(nonce, sizeof(nonce));
+    });
+    ok &= check(pooled_allocations == 0.0, "nonce formatting takes no heap");
+
+    uint32_t taken = 0;
+    uint32_t fallbacks = 0;
+    ok &= check(run_contention(taken, fallbacks), "one producer, two takers: every nonce taken once");
+
+    print_header("nonce");
+    print_stats("legacy String nonce", measure(iterations, [] {
+        legacy_nonce(16);
+    }));
+    print_stats("ring + fixed buffer", measure_pooled(iterations, nonce, sizeof(nonce)));
+    drain_ring();
+    print_stats("empty ring (RNG fallback)", measure(iterations, [&] {
+        ptc::service_auth_format_nonce(nonce, sizeof(nonce));
+    }));
+    print_stats("refill, per slot", measure(iterations / ptc::kEntropySlots + 1, [] {
+        drain_ring();
+        ptc::service_auth_entropy_refill(1);
+    }));
+    printf("allocations/call: legacy %.1f -> ring %.1f\n", legacy_allocations, pooled_allocations);
+    printf("contention: %u nonces, %u from the ring, %u from the RNG\n", static_cast<unsigned>(kThreadTakes * 2),
+        static_cast<unsigned>(taken), static_cast<unsigned>(fallbacks));
+    return ok ? 0 : 1;
+}
+
+} // namespace bench
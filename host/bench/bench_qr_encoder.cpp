@@ -0,0 +1,204 @@
+#include <qrcode.h>
+
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <string>
+#include <vector>
+
+#include "bench.h"
+#include "src/services/service_qr.h"
+#include "src/services/service_qr_encoder.h"
+
+namespace bench {
+
+namespace {
+
+constexpr char kUrlAlphabet[] = "ABCDEFGHIJKLMNOPQRSTUVWXYZabcdefghijklmnopqrstuvwxyz0123456789-_";
+// Payloads per version for the comparison against the library.
+constexpr int kPayloadsPerVersion = 200;
+
+// "ptc1:" and base64url up to length, like service_qr_build_payload.
+std::string random_payload(size_t length) {
+    std::string payload = "ptc1:";
+    while (payload.size() < length) {
+        payload += kUrlAlphabet[rand() % 64];
+    }
+    return payload;
+}
+
+size_t version_capacity(size_t i) {
+    return ptc::kQrCapacities[i].byte_capacity;
+}
+
+size_t previous_capacity(size_t i) {
+    return i == 0 ? 5 : ptc::kQrCapacities[i - 1].byte_capacity;
+}
+
+int8_t library_encode(const std::string& payload, uint8_t version, std::vector<uint8_t>& modules) {
+    QRCode qrcode;
+    modules.assign(qrcode_getBufferSize(version), 0);
+    if (qrcode_initText(&qrcode, modules.data(), version, ECC_LOW, payload.c_str()) != 0) {
+        return -1;
+    }
+    return static_cast<int8_t>(qrcode.mask);
+}
+
+int8_t encode(const std::string& payload, uint8_t version, int8_t mask, std::vector<uint8_t>& modules) {
+    modules.assign(ptc::service_qr_encoder_buffer_size(version), 0xA5);
+    return ptc::service_qr_encoder_encode(reinterpret_cast<const uint8_t*>(payload.data()), payload.size(), version,
+        mask, modules.data());
+}
+
+// Auto mask matches qrcode_initText module for module at every version, from
+// the shortest payload that selects it up to its capacity. Each payload is
+// also encoded with the library's mask forced, which has to match as well;
+// masks_seen collects the masks that were covered that way.
+bool matches_library(uint32_t& compared, uint8_t& masks_seen) {
+    std::vector<uint8_t> expected;
+    std::vector<uint8_t> actual;
+    srand(18004);
+    for (size_t i = 0; i < sizeof(ptc::kQrCapacities) / sizeof(ptc::kQrCapacities[0]); ++i) {
+        const uint8_t version = ptc::kQrCapacities[i].version;
+        for (int n = 0; n < kPayloadsPerVersion; ++n) {
+            const size_t span = version_capacity(i) - previous_capacity(i);
+            const size_t length = n == 0 ? version_capacity(i) : previous_capacity(i) + 1 + rand() % span;
+            const std::string payload = random_payload(length);
+            const int8_t library_mask = library_encode(payload, version, expected);
+            if (library_mask < 0 || encode(payload, version, ptc::kQrMaskAuto, actual) != library_mask ||
+                actual != expected) {
+                printf("version %u, %u bytes: auto mask differs from qrcode_initText\n", version,
+                    static_cast<unsigned>(length));
+                return false;
+            }
+            if (encode(payload, version, library_mask, actual) != library_mask || actual != expected) {
+                printf("version %u, %u bytes: mask %d differs from qrcode_initText\n", version,
+                    static_cast<unsigned>(length), library_mask);
+                return false;
+            }
+            masks_seen |= static_cast<uint8_t>(1 << library_mask);
+            compared++;
+        }
+    }
+    return true;
+}
+
+bool mask_bit(int mask, int x, int y) {
+    switch (mask) {
+        case 0: return (x + y) % 2 == 0;
+        case 1: return y % 2 == 0;
+        case 2: return x % 3 == 0;
+        case 3: return (x + y) % 3 == 0;
+        case 4: return (x / 3 + y / 2) % 2 == 0;
+        case 5: return x * y % 2 + x * y % 3 == 0;
+        case 6: return (x * y % 2 + x * y % 3) % 2 == 0;
+        default: return ((x + y) % 2 + x * y % 3) % 2 == 0;
+    }
+}
+
+bool in_format(int size, int x, int y) {
+    return (y == 8 && (x <= 8 || x >= size - 8)) || (x == 8 && (y <= 8 || y >= size - 8));
+}
+
+// Outside the format bits, a code with mask m may only differ from the same
+// code with mask 0 where exactly one of the two masks flips a module.
+bool masks_differ_only_by_mask(uint8_t version, const std::string& payload) {
+    std::vector<uint8_t> reference;
+    std::vector<uint8_t> masked;
+    if (encode(payload, version, 0, reference) != 0) {
+        return false;
+    }
+    const int size = ptc::service_qr_encoder_size(version);
+    for (int8_t mask = 1; mask < 8; ++mask) {
+        if (encode(payload, version, mask, masked) != mask) {
+            return false;
+        }
+        uint32_t differing = 0;
+        for (int y = 0; y < size; ++y) {
+            for (int x = 0; x < size; ++x) {
+                const uint32_t offset = static_cast<uint32_t>(y) * size + x;
+                const bool a = (reference[offset >> 3] >> (7 - (offset & 7))) & 1;
+                const bool b = (masked[offset >> 3] >> (7 - (offset & 7))) & 1;
+                if (a != b && !in_format(size, x, y)) {
+                    if (mask_bit(0, x, y) == mask_bit(mask, x, y)) {
+                        return false;
+                    }
+                    differing++;
+                }
+            }
+        }
+        if (differing == 0) {
+            return false;
+        }
+    }
+    return true;
+}
+
+bool rejects_bad_input() {
+    std::vector<uint8_t> modules(ptc::service_qr_encoder_buffer_size(40));
+    const std::string payload = random_payload(ptc::kQrCapacities[0].byte_capacity + 1);
+    const auto* data = reinterpret_cast<const uint8_t*>(payload.data());
+    return ptc::service_qr_encoder_encode(data, payload.size(), 5, ptc::kQrMaskAuto, modules.data()) == -1 &&
+        ptc::service_qr_encoder_encode(data, 10, 4, ptc::kQrMaskAuto, modules.data()) == -1 &&
+        ptc::service_qr_encoder_encode(data, 10, 11, ptc::kQrMaskAuto, modules.data()) == -1 &&
+        ptc::service_qr_encoder_encode(data, 10, 5, 8, modules.data()) == -1 &&
+        ptc::service_qr_encoder_encode(data, payload.size() - 1, 5, ptc::kQrMaskAuto, modules.data()) >= 0;
+}
+
+void print_case(size_t i, uint32_t iterations) {
+    const uint8_t version = ptc::kQrCapacities[i].version;
+    srand(version);
+    const std::string payload = random_payload(version_capacity(i));
+    std::vector<uint8_t> modules(ptc::service_qr_encoder_buffer_size(version));
+    const auto* data = reinterpret_cast<const uint8_t*>(payload.data());
+    char label[48];
+    snprintf(label, sizeof(label), "qrcode_initText, v%u %u B", version, static_cast<unsigned>(payload.size()));
+    print_stats(label, measure(iterations, [&] {
+        QRCode qrcode;
+        qrcode_initText(&qrcode, modules.data(), version, ECC_LOW, payload.c_str());
+    }));
+    snprintf(label, sizeof(label), "encoder auto mask, v%u", version);
+    print_stats(label, measure(iterations, [&] {
+        ptc::service_qr_encoder_encode(data, payload.size(), version, ptc::kQrMaskAuto, modules.data());
+    }));
+    snprintf(label, sizeof(label), "encoder mask 0, v%u", version);
+    print_stats(label, measure(iterations, [&] {
+        ptc::service_qr_encoder_encode(data, payload.size(), version, 0, modules.data());
+    }));
+}
+
+} // namespace
+
+int run_qr_encoder_bench(int argc, char** argv) {
+    const uint32_t iterations = argc > 1 ? static_cast<uint32_t>(strtoul(argv[1], nullptr, 10)) : 300;
+    bool ok = true;
+
+    uint32_t compared = 0;
+    uint8_t masks_seen = 0;
+    ok &= check(matches_library(compared, masks_seen), "auto and forced masks match qrcode_initText module for module");
+    ok &= check(masks_seen == 0xFF, "the library picked each of the eight masks at least once");
+    bool masks_ok = true;
+    for (const ptc::QrCapacity& capacity : ptc::kQrCapacities) {
+        masks_ok &= masks_differ_only_by_mask(capacity.version, random_payload(capacity.byte_capacity));
+    }
+    ok &= check(masks_ok, "fixed masks change only masked modules and format bits");
+    ok &= check(rejects_bad_input(), "versions outside kQrCapacities, bad masks and oversize data are refused");
+
+    std::vector<uint8_t> modules(ptc::service_qr_encoder_buffer_size(10));
+    const std::string payload = random_payload(ptc::kQrCapacities[5].byte_capacity);
+    const double allocations = allocations_per_call(100, [&] {
+        ptc::service_qr_encoder_encode(reinterpret_cast<const uint8_t*>(payload.data()), payload.size(), 10,
+            ptc::kQrMaskAuto, modules.data());
+    });
+    ok &= check(allocations == 0.0, "encoder takes no heap");
+
+    print_header("qr_encoder");
+    printf("%u payloads compared against qrcode_initText, masks seen 0x%02X\n", static_cast<unsigned>(compared),
+        masks_seen);
+    for (size_t i = 0; i < sizeof(ptc::kQrCapacities) / sizeof(ptc::kQrCapacities[0]); ++i) {
+        print_case(i, iterations);
+    }
+    return ok ? 0 : 1;
+}
+
+} // namespace bench
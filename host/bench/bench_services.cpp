@@ -0,0 +1,275 @@
+#include <cstdio>
+#include <cstdlib>
+#include <vector>
+
+#include <WiFiClient.h>
+
+#include "bench.h"
+#include "src/services/service_auth.h"
+#include "src/services/service_http.h"
+#include "src/services/service_http_stream.h"
+#include "src/services/service_log.h"
+#include "src/services/service_qr.h"
+#include "src/services/service_storage.h"
+
+namespace bench {
+
+namespace {
+
+constexpr const char* kDeviceId = "ESP32S3-A1B2C3D4E5F6";
+constexpr const char* kDeviceSecret =
+    "9f3c1a7e5b2d4c6f8a0e1b3d5f7a9c2e4b6d8f0a1c3e5a7b9d2f4a6c8e0b1d3f";
+constexpr uint32_t kTimestamp = 1767225600;
+constexpr uint16_t kActivityFileLines = 1000;
+
+String heartbeat_body() {
+    return String("{\"device_id\":\"") + kDeviceId +
+        "\",\"firmware_version\":\"" + ptc::kFirmwareVersion +
+        "\",\"ip\":\"192.168.1.42\",\"wifi_rssi\":-61,\"free_heap\":183204,\"uptime_sec\":86400}";
+}
+
+String notices_json(uint16_t count) {
+    String json = "[";
+    for (uint16_t i = 0; i < count; ++i) {
+        if (i > 0) {
+            json += ",";
+        }
+        json += String("{\"id\":\"notice-") + i +
+            "\",\"title\":\"Shift handover briefing " + i +
+            "\",\"body\":\"Please review the updated rota before clocking in. Breaks are staggered "
+            "across the team and the kitchen closes at 21:30 on weekdays.\""
+            ",\"image_url\":\"\",\"hyperlink_url\":\"https://portal.example.com/notices/" + i +
+            "\",\"display_seconds\":8,\"sort_order\":" + i +
+            ",\"created_at\":\"2026-01-01T08:00:00Z\",\"updated_at\":\"2026-01-02T09:30:00Z\"}";
+    }
+    json += "]";
+    return json;
+}
+
+String activity_json(uint16_t count) {
+    String json = "[";
+    for (uint16_t i = 0; i < count; ++i) {
+        if (i > 0) {
+            json += ",";
+        }
+        json += String("{\"id\":\"evt-") + (100000 + i) +
+            "\",\"user_name\":\"Employee " + (i % 12) +
+            "\",\"action\":\"" + (i % 2 == 0 ? "clock_in" : "clock_out") +
+            "\",\"occurred_at\":\"2026-01-01T" + (i / 4 < 10 ? "0" : "") + (i / 4) + ":" +
+            ((i % 4) * 15 < 10 ? "0" : "") + ((i % 4) * 15) + ":00Z\"}";
+    }
+    json += "]";
+    return json;
+}
+
+// One event a minute from 2026-01-01, so any count gets distinct ids and
+// valid timestamps.
+String long_activity_json(uint16_t count) {
+    String json = "[";
+    for (uint16_t i = 0; i < count; ++i) {
+        const uint16_t day = 1 + i / 1440;
+        const uint16_t hour = (i / 60) % 24;
+        const uint16_t minute = i % 60;
+        char occurred_at[24];
+        snprintf(occurred_at, sizeof(occurred_at), "2026-01-%02uT%02u:%02u:00Z", day, hour, minute);
+        json += String(i > 0 ? ",\n" : "") + "{\"id\":\"bulk-" + i +
+            "\",\"employee_name\":\"Employee " + (i % 12) +
+            "\",\"punch_type\":\"" + (i % 2 == 0 ? "in" : "out") +
+            "\",\"occurred_at\":\"" + occurred_at + "\",\"site\":{\"id\":4,\"name\":\"Depot\"}}";
+    }
+    json += "]";
+    return json;
+}
+
+// Reads a body through HttpBodyStream and returns it, leaving anything past
+// the body on the client.
+String read_body(WiFiClient& client, int content_length, bool chunked, bool& out_finished) {
+    ptc::HttpBodyStream body(client, content_length, chunked, 100);
+    String text;
+    int c = 0;
+    while ((c = body.read()) >= 0) {
+        text += static_cast<char>(c);
+    }
+    out_finished = body.finished();
+    return text;
+}
+
+} // namespace
+
+int run_services(int argc, char** argv) {
+    const uint32_t iterations = argc > 1 ? static_cast<uint32_t>(strtoul(argv[1], nullptr, 10)) : 2000;
+    bool ok = true;
+
+    host::sd_set_root("/tmp/ptc-host-sd-bench");
+    host::sd_wipe();
+    ptc::service_storage_init();
+    ptc::service_log_init();
+
+    ptc::DeviceConfig config;
+    config.device_id = kDeviceId;
+    config.device_secret = kDeviceSecret;
+
+    print_header("services");
+
+    const String body = heartbeat_body();
+    const String timestamp = String(kTimestamp);
+    char nonce_text[ptc::kNonceLength + 1];
+    ptc::service_auth_format_nonce(nonce_text, sizeof(nonce_text));
+    const String nonce = nonce_text;
+    ok &= check(ptc::service_auth_request_signature(
+                    "POST", "/api/timeclock/devices/heartbeat", timestamp, nonce, body, kDeviceSecret)
+                    .length() == 43,
+        "request signature is 43 base64url chars");
+    print_stats("auth_request_signature", measure(iterations, [&] {
+        ptc::service_auth_request_signature(
+            "POST", "/api/timeclock/devices/heartbeat", timestamp, nonce, body, kDeviceSecret);
+    }));
+
+    // The cached signer must match the one-shot path for every key length,
+    // including keys longer than the SHA-256 block and a change of key.
+    ptc::HmacSigner signer;
+    const String heartbeat_path = "/api/timeclock/devices/heartbeat";
+    char signature[ptc::kSignatureLength + 1];
+    bool signer_matches = true;
+    for (const String& secret : {String(kDeviceSecret), String("k"), String(String(kDeviceSecret) + kDeviceSecret),
+             String(kDeviceSecret)}) {
+        signer.set_key(secret);
+        signer_matches &= signer.sign_request("POST", "/api/timeclock/devices/heartbeat", timestamp.c_str(),
+                              nonce.c_str(), body, signature, sizeof(signature)) &&
+            ptc::service_auth_request_signature(
+                "POST", "/api/timeclock/devices/heartbeat", timestamp, nonce, body, secret) == signature;
+    }
+    ok &= check(signer_matches, "cached signer matches service_auth_request_signature");
+    ok &= check(!signer.sign_request("GET", "/", "1", "n", "", signature, ptc::kSignatureLength),
+        "signer refuses a short output buffer");
+    print_stats("signer_sign_request (cached key)", measure(iterations, [&] {
+        signer.set_key(config.device_secret);
+        signer.sign_request("POST", heartbeat_path, timestamp.c_str(), nonce.c_str(), body,
+            signature, sizeof(signature));
+    }));
+    const String qr_material = String(kDeviceId) + "." + kTimestamp + "." + nonce;
+    print_stats("auth_hmac_sha256_base64url (QR)", measure(iterations, [&] {
+        ptc::service_auth_hmac_sha256_base64url(kDeviceSecret, qr_material);
+    }));
+    print_stats("signer QR material (cached key)", measure(iterations, [&] {
+        signer.set_key(config.device_secret);
+        signer.begin();
+        signer.update(qr_material);
+        signer.finish(signature, sizeof(signature));
+    }));
+    printf("allocations/call: request signature %.1f -> %.1f, QR signature %.1f -> %.1f\n",
+        allocations_per_call(iterations, [&] {
+            ptc::service_auth_request_signature(
+                "POST", "/api/timeclock/devices/heartbeat", timestamp, nonce, body, kDeviceSecret);
+        }),
+        allocations_per_call(iterations, [&] {
+            signer.set_key(config.device_secret);
+            signer.sign_request("POST", heartbeat_path, timestamp.c_str(), nonce.c_str(),
+                body, signature, sizeof(signature));
+        }),
+        allocations_per_call(iterations, [&] {
+            ptc::service_auth_hmac_sha256_base64url(kDeviceSecret, qr_material);
+        }),
+        allocations_per_call(iterations, [&] {
+            signer.set_key(config.device_secret);
+            signer.begin();
+            signer.update(qr_material);
+            signer.finish(signature, sizeof(signature));
+        }));
+
+    ok &= check(ptc::service_qr_build_payload(config, kTimestamp).startsWith("ptc1:"),
+        "QR payload has ptc1: prefix");
+    print_stats("qr_build_payload", measure(iterations, [&] {
+        ptc::service_qr_build_payload(config, kTimestamp);
+    }));
+    const String qr_payload = ptc::service_qr_build_payload(config, kTimestamp);
+    ptc::QrFrame frame;
+    ok &= check(ptc::service_qr_encode(qr_payload, frame) &&
+            frame.version == ptc::service_qr_select_version(qr_payload.length()) &&
+            frame.size == frame.version * 4 + 17,
+        "QR payload encodes");
+    print_stats("qr_encode", measure(iterations / 10 + 1, [&] {
+        ptc::service_qr_encode(qr_payload, frame);
+    }));
+
+    // The next payload is encoded ahead of the rotation and takes over the
+    // moment it is due, without waiting for a tick.
+    host::clock_use_virtual(true, 1000);
+    ptc::AppState qr_state;
+    qr_state.time_sync_ok = true;
+    config.qr_interval_sec = 30;
+    ptc::service_qr_tick(config, qr_state);
+    const uint32_t first_sequence = ptc::service_qr_frame_sequence();
+    host::clock_advance_ms(30000 - ptc::kQrPrepareAheadMs - 1);
+    ptc::service_qr_tick(config, qr_state);
+    const bool early = ptc::service_qr_next_sequence() == 0;
+    host::clock_advance_ms(1);
+    ptc::service_qr_tick(config, qr_state);
+    ptc::QrFrame next;
+    ok &= check(early && ptc::service_qr_next_frame(next) && next.sequence != first_sequence &&
+            next.shown_at_ms == 31000 && next.version != 0,
+        "next QR frame prepared ahead of the rotation");
+    host::clock_advance_ms(ptc::kQrPrepareAheadMs - 1);
+    const bool held = ptc::service_qr_frame_sequence() == first_sequence;
+    host::clock_advance_ms(1);
+    ok &= check(held && ptc::service_qr_frame_sequence() == next.sequence &&
+            ptc::service_qr_payload() == next.payload && ptc::service_qr_seconds_remaining() == 30,
+        "next QR frame shown exactly when due");
+    host::clock_use_virtual(false);
+
+    const String notices = notices_json(8);
+    ok &= check(ptc::service_http_load_notices_json(notices, false), "notices JSON parses");
+    ok &= check(ptc::service_http_notice_count() == 8, "8 notices loaded");
+    print_stats("load_notices_json (8)", measure(iterations, [&] {
+        ptc::service_http_load_notices_json(notices, false);
+    }));
+
+    // Steady state: the portal keeps returning events the device already
+    // holds, so most items end in the duplicate check rather than an append.
+    const String activity = activity_json(40);
+    ok &= check(ptc::service_http_load_activity_json(activity) == 40, "40 activity items accepted");
+    print_stats("load_activity_json (40)", measure(iterations, [&] {
+        ptc::service_http_load_activity_json(activity);
+    }));
+
+    // Arrays far longer than the notice cache or the old whole-body document
+    // are parsed one element at a time.
+    ok &= check(ptc::service_http_load_notices_json(notices_json(500), false) &&
+            ptc::service_http_notice_count() == 16,
+        "500 notices stream through, 16 kept");
+    ok &= check(ptc::service_http_load_activity_json(long_activity_json(2000)) == 2000,
+        "2000 activity items accepted");
+    ok &= check(ptc::service_http_load_activity_json("[]") == 0, "empty activity array accepted");
+    ok &= check(!ptc::service_http_load_notices_json("{\"error\":\"unavailable\"}", false),
+        "non-array notices body rejected");
+
+    WiFiClient client;
+    bool finished = false;
+    client.host_receive("4\r\nWiki\r\n5;name=value\r\npedia\r\nE\r\n in\r\n\r\nchunks.\r\n0\r\nX-Trailer: 1\r\n\r\nNEXT", true);
+    ok &= check(read_body(client, -1, true, finished) == "Wikipedia in\r\n\r\nchunks." && finished &&
+            client.readString() == "NEXT",
+        "chunked body decoded up to the last chunk");
+    client.host_receive("[1,2]HTTP/1.1 200 OK", true);
+    ok &= check(read_body(client, 5, false, finished) == "[1,2]" && finished &&
+            client.available() == 15,
+        "body stops at Content-Length");
+    client.host_receive("3\r\nabc\r\n", true);
+    read_body(client, -1, true, finished);
+    ok &= check(!finished, "truncated chunked body reported");
+
+    for (uint16_t i = 0; i < kActivityFileLines; ++i) {
+        ptc::service_storage_append_activity(
+            String("file-") + i, kTimestamp + i * 60U, String("Employee ") + (i % 12),
+            i % 2 == 0 ? "clocked in" : "clocked out");
+    }
+    std::vector<ptc::StoredActivity> entries;
+    ok &= check(ptc::service_storage_load_recent_activity(entries, 30) && entries.size() == 30,
+        "30 recent activity entries loaded from SD");
+    print_stats("load_recent_activity (30/1000)", measure(iterations / 20 + 1, [&] {
+        ptc::service_storage_load_recent_activity(entries, 30);
+    }));
+
+    return ok ? 0 : 1;
+}
+
+} // namespace bench
@@ -0,0 +1,617 @@
+#pragma once
+
+// Portal and GitHub response bodies recorded compressed (Python zlib/gzip,
+// levels 0-9, 32 KB and 512 B windows), with the size and CRC-32 of the
+// decoded JSON. Used by the inflate suite.
+
+#include <cstddef>
+#include <cstdint>
+
+#include "src/services/service_http_inflate.h"
+
+namespace bench {
+
+constexpr uint8_t kNoticesGzip[] = {
+    0x1f, 0x8b, 0x08, 0x00, 0x00, 0xf2, 0xa3, 0x69, 0x00, 0xff, 0xed, 0x98, 0x4d, 0x8b, 0xdb, 0x30,
+    0x10, 0x40, 0xff, 0x8a, 0xf0, 0x29, 0x85, 0x38, 0x91, 0xfc, 0x6d, 0xf7, 0xd6, 0x43, 0xe9, 0x71,
+    0x29, 0xe9, 0xa5, 0xa5, 0x04, 0x59, 0x96, 0x6d, 0x11, 0xdb, 0x32, 0x92, 0xb2, 0x8b, 0x29, 0xfd,
+    0xef, 0x55, 0xb2, 0x4b, 0xc9, 0x2e, 0x48, 0x2b, 0x36, 0x3e, 0x38, 0x10, 0x93, 0x53, 0x3c, 0x12,
+    0xe3, 0x79, 0x0f, 0xa1, 0x99, 0x5f, 0x7f, 0x3c, 0x56, 0x79, 0x85, 0x97, 0x56, 0x88, 0x40, 0xfd,
+    0xf8, 0x41, 0x1d, 0x96, 0x7e, 0x44, 0x52, 0xea, 0xe7, 0x38, 0x46, 0x3e, 0xbc, 0x78, 0xbc, 0xb5,
+    0xa7, 0x98, 0xea, 0xa8, 0x0e, 0xff, 0xce, 0x15, 0x06, 0xc7, 0xb1, 0xc2, 0x8a, 0x82, 0x15, 0xfa,
+    0xa4, 0xdf, 0x94, 0xbc, 0x9a, 0xf4, 0x8b, 0x87, 0x8e, 0x62, 0x49, 0x81, 0xa0, 0x8f, 0x8c, 0x3e,
+    0x01, 0xd5, 0xd2, 0x97, 0xa8, 0x0a, 0x88, 0xd3, 0x12, 0x3e, 0x9c, 0xff, 0x93, 0x0a, 0xd7, 0x35,
+    0x28, 0x39, 0x16, 0x15, 0x28, 0x69, 0xcd, 0x05, 0x05, 0xa4, 0xe3, 0xe4, 0xc0, 0x86, 0x06, 0xb0,
+    0x61, 0x03, 0xbe, 0x08, 0x8a, 0x0f, 0x12, 0x60, 0x71, 0x0e, 0x6d, 0x1a, 0x2a, 0xf4, 0x06, 0x98,
+    0x08, 0x2e, 0xe5, 0x79, 0xbd, 0xa2, 0xb8, 0xff, 0x0c, 0x48, 0x4b, 0xc9, 0x01, 0x4c, 0xfc, 0x28,
+    0x80, 0xec, 0xb8, 0x02, 0x4f, 0x4c, 0xb5, 0xcf, 0xdb, 0xb7, 0xac, 0x56, 0x40, 0x67, 0x52, 0x6d,
+    0x80, 0x4e, 0x8d, 0xf5, 0xb8, 0xa1, 0xfb, 0xa3, 0xe8, 0x74, 0x7e, 0xad, 0x52, 0xa3, 0x2c, 0xb6,
+    0x5b, 0xd6, 0xcb, 0xcd, 0xc8, 0x26, 0xdc, 0x2b, 0x81, 0x1f, 0x69, 0xb7, 0x21, 0xbc, 0xdf, 0x4a,
+    0xc5, 0x85, 0x8e, 0xdc, 0x0e, 0x5c, 0x31, 0x42, 0xe5, 0x16, 0x6e, 0xc6, 0xa1, 0xd1, 0xeb, 0xdb,
+    0x69, 0xa4, 0xa2, 0x63, 0xc3, 0xc1, 0x61, 0x8f, 0xff, 0x6b, 0xf5, 0xba, 0x8a, 0xc9, 0xb1, 0xc3,
+    0xd3, 0x5e, 0x52, 0xc2, 0x87, 0x4a, 0x7a, 0x45, 0xb6, 0xf6, 0x24, 0x17, 0x6a, 0xcf, 0x45, 0x45,
+    0x85, 0x57, 0xc0, 0xb5, 0x47, 0xf4, 0x87, 0xea, 0xe2, 0xec, 0xb1, 0xd2, 0xfb, 0x06, 0x30, 0x48,
+    0x7c, 0x18, 0xfa, 0x10, 0xed, 0x60, 0x56, 0x40, 0xa8, 0x7f, 0x3f, 0xf5, 0x36, 0x2f, 0x05, 0x7c,
+    0x13, 0x13, 0xec, 0x60, 0x5e, 0x84, 0xcf, 0x31, 0x7f, 0xd7, 0xaf, 0x29, 0x22, 0x0b, 0x45, 0x74,
+    0x41, 0xf1, 0x2b, 0xd3, 0x05, 0xae, 0x04, 0xeb, 0x3a, 0xb0, 0x0a, 0x96, 0x0c, 0x71, 0x71, 0x09,
+    0xbd, 0xb1, 0xea, 0x83, 0x92, 0x20, 0x07, 0x49, 0x90, 0x49, 0x92, 0xc0, 0x41, 0x92, 0xd0, 0x22,
+    0x49, 0x60, 0x91, 0x24, 0xb8, 0x90, 0xe4, 0x1b, 0xef, 0x58, 0x85, 0x27, 0xd0, 0xea, 0x8a, 0x48,
+    0xb0, 0x0a, 0xef, 0x9e, 0xdc, 0x72, 0x42, 0xf3, 0x88, 0x1b, 0x38, 0x88, 0x1b, 0x98, 0xc4, 0x0d,
+    0x1d, 0xc4, 0x8d, 0x2c, 0xe2, 0x86, 0x16, 0x71, 0xc3, 0x0b, 0x71, 0x7f, 0x0c, 0x4c, 0x97, 0xb2,
+    0xd7, 0xc5, 0xef, 0xd9, 0xa0, 0x53, 0x02, 0xab, 0x68, 0xc9, 0xee, 0xce, 0x43, 0x26, 0x74, 0x20,
+    0x13, 0x9a, 0xc8, 0x44, 0x0e, 0x64, 0x62, 0x0b, 0x99, 0xc8, 0x42, 0x26, 0xba, 0x20, 0xf3, 0x80,
+    0xc5, 0xb9, 0x82, 0xa4, 0xc5, 0x43, 0x43, 0xf5, 0xa1, 0x12, 0x2f, 0x19, 0xcc, 0xe2, 0x12, 0xba,
+    0xe2, 0x4a, 0x13, 0x5d, 0x71, 0xa5, 0x89, 0x1c, 0xd4, 0x8a, 0x4c, 0x6a, 0xc5, 0x0e, 0x6a, 0x25,
+    0x16, 0xb5, 0x62, 0x8b, 0x5a, 0xf1, 0x85, 0x5a, 0x3b, 0x5d, 0x46, 0x50, 0x0a, 0x46, 0xeb, 0x53,
+    0xe1, 0x57, 0xc9, 0x5d, 0xac, 0x5b, 0x4e, 0x68, 0x9e, 0x33, 0x31, 0x76, 0x10, 0x37, 0x36, 0x89,
+    0x9b, 0x38, 0x88, 0x9b, 0x5a, 0xc4, 0x4d, 0x2c, 0xe2, 0x26, 0xa6, 0x8e, 0x2a, 0x5d, 0xb2, 0xb6,
+    0xf3, 0x40, 0x49, 0x1c, 0xa0, 0x24, 0x26, 0x28, 0xa9, 0x03, 0x94, 0xcc, 0x02, 0x25, 0xb5, 0x40,
+    0x49, 0x0d, 0x0d, 0x52, 0xb6, 0x64, 0x26, 0x8b, 0x4b, 0x68, 0x1e, 0x49, 0x52, 0x07, 0x49, 0x52,
+    0x93, 0x24, 0x99, 0x83, 0x24, 0xb9, 0x45, 0x92, 0xcc, 0x22, 0x49, 0x66, 0x6e, 0x90, 0xf2, 0xbb,
+    0x27, 0xb7, 0x9c, 0xd0, 0x15, 0x97, 0xab, 0xec, 0x8a, 0xcb, 0x55, 0xe6, 0x60, 0x7a, 0x66, 0x32,
+    0x3d, 0x7f, 0xdf, 0x74, 0x04, 0x2d, 0xa6, 0xe7, 0x16, 0xd3, 0x73, 0x6b, 0x47, 0x85, 0xe0, 0x92,
+    0x6d, 0x9f, 0xe7, 0x10, 0xca, 0x1d, 0xd0, 0xe4, 0x06, 0x34, 0xa7, 0xb2, 0xbf, 0x8b, 0x06, 0x59,
+    0xd0, 0x60, 0x0b, 0x1a, 0x6c, 0x6b, 0xa9, 0xd0, 0xa2, 0xa7, 0xb2, 0x8b, 0x4b, 0x68, 0xa6, 0x81,
+    0x9e, 0xcb, 0xd8, 0x17, 0x99, 0xe6, 0xbe, 0xc8, 0x61, 0xee, 0x8b, 0x6c, 0x73, 0xdf, 0xd2, 0x22,
+    0x4b, 0x69, 0x6e, 0x92, 0xd0, 0x7d, 0xf6, 0x7b, 0xd3, 0x09, 0xcd, 0xe4, 0xae, 0xd3, 0x34, 0xda,
+    0x34, 0x8e, 0x46, 0x0e, 0xe3, 0x68, 0xf4, 0x6a, 0x1c, 0xfd, 0xfb, 0x1f, 0xf5, 0xb2, 0x9c, 0x42,
+    0x7b, 0x1a, 0x00, 0x00,
+};
+
+constexpr uint8_t kActivityDeflate[] = {
+    0x78, 0x9c, 0xb5, 0x9c, 0x4f, 0x8f, 0xdb, 0x36, 0x10, 0xc5, 0xbf, 0x8a, 0xe1, 0x73, 0x0c, 0x70,
+    0xf8, 0x47, 0x14, 0x79, 0xdb, 0x24, 0x9b, 0x14, 0x28, 0x9a, 0x14, 0xd8, 0x9e, 0x5a, 0x14, 0x86,
+    0x60, 0xab, 0xb1, 0xb0, 0x5e, 0x3b, 0x75, 0xec, 0x05, 0x92, 0xa2, 0xdf, 0xbd, 0x43, 0xe7, 0x36,
+    0x42, 0xc3, 0x95, 0xe6, 0x39, 0xc8, 0x25, 0xab, 0x05, 0xf2, 0x30, 0x14, 0xf9, 0x7b, 0x33, 0x1c,
+    0xcd, 0x1f, 0xff, 0x2c, 0x87, 0xed, 0x32, 0x2f, 0xfb, 0xe7, 0xf3, 0x8a, 0x4c, 0xf9, 0xb3, 0x7c,
+    0xb5, 0xbc, 0x7c, 0xe9, 0x4f, 0xeb, 0x43, 0xf7, 0xd4, 0xf3, 0x83, 0x37, 0xbb, 0xfd, 0xb1, 0x5f,
+    0xfc, 0xd2, 0x9d, 0xce, 0xc3, 0x81, 0x1f, 0x7d, 0xbe, 0x1c, 0x36, 0xbb, 0xf5, 0xf9, 0xeb, 0xe7,
+    0xf2, 0x6c, 0xb3, 0x3f, 0x6e, 0x1e, 0xd7, 0xc7, 0xcb, 0x99, 0x1f, 0x1c, 0x37, 0x9b, 0xcb, 0xe9,
+    0xd4, 0x6f, 0xd7, 0xdd, 0x99, 0x9f, 0x58, 0x63, 0x9b, 0x95, 0x71, 0x2b, 0x43, 0xbf, 0x99, 0x36,
+    0x1b, 0x97, 0x4d, 0xf8, 0x9d, 0x7f, 0x89, 0x7f, 0xbf, 0x3b, 0x0f, 0xc7, 0xc3, 0xfa, 0xfa, 0x7f,
+    0xf2, 0xbf, 0x56, 0x91, 0x7f, 0xba, 0xed, 0x9f, 0x87, 0x4d, 0xff, 0xfd, 0x67, 0xf7, 0x0f, 0xbf,
+    0x3a, 0xfb, 0xe0, 0x56, 0x77, 0xf4, 0xda, 0xbe, 0x71, 0x6f, 0xfd, 0x7d, 0x78, 0xd7, 0x2c, 0xff,
+    0x7d, 0x25, 0x55, 0x92, 0x50, 0x79, 0xf7, 0x34, 0x1c, 0xba, 0xc5, 0xcf, 0xbb, 0xee, 0x7f, 0x34,
+    0x5e, 0xb5, 0xff, 0x50, 0x62, 0x9b, 0x43, 0x0b, 0x95, 0x68, 0x85, 0xc4, 0xd7, 0xc3, 0xbe, 0xdb,
+    0x2f, 0xee, 0x76, 0x4f, 0xfd, 0x76, 0x6e, 0x1c, 0xc9, 0xe5, 0x60, 0xa1, 0x22, 0x1d, 0x3a, 0x8e,
+    0x94, 0x32, 0x19, 0xa8, 0x44, 0x7f, 0x83, 0x38, 0xa6, 0xec, 0x13, 0x54, 0x64, 0x98, 0x2a, 0xb2,
+    0x1a, 0x48, 0xeb, 0xb2, 0x77, 0x50, 0x8d, 0x8d, 0xd0, 0xf8, 0xbe, 0x3f, 0x9e, 0x3e, 0xf5, 0x8b,
+    0xfb, 0xe7, 0xee, 0xf0, 0x65, 0xae, 0x48, 0x8f, 0x0e, 0x64, 0xc4, 0x07, 0x32, 0xa1, 0x77, 0x76,
+    0x3b, 0x71, 0xd3, 0xd4, 0x5f, 0x48, 0x17, 0xb2, 0xc7, 0xee, 0x9a, 0x24, 0x34, 0xbe, 0xed, 0x0e,
+    0x43, 0xbf, 0x5f, 0x7c, 0x7c, 0xec, 0xfe, 0x3a, 0x9e, 0x66, 0x46, 0xd2, 0x35, 0xd9, 0x42, 0x8f,
+    0x71, 0xba, 0x05, 0x6c, 0x3c, 0x65, 0x07, 0x8d, 0x25, 0x49, 0xd8, 0xd4, 0x55, 0x56, 0x43, 0xe9,
+    0x03, 0xef, 0x1d, 0xa8, 0x48, 0x89, 0x1b, 0xde, 0xd6, 0x8b, 0x0f, 0xc7, 0xe7, 0xee, 0x71, 0xa6,
+    0xc2, 0x60, 0x78, 0xbd, 0xa1, 0x0a, 0x25, 0x6b, 0x5e, 0xf0, 0x4a, 0xd6, 0x57, 0x3b, 0x50, 0xf6,
+    0xd0, 0xdd, 0x4d, 0x93, 0x79, 0x53, 0x0f, 0xa5, 0xcd, 0x21, 0x42, 0x35, 0x4a, 0xdc, 0x60, 0x42,
+    0xc9, 0x3b, 0x1c, 0x4a, 0x1c, 0x9a, 0x4e, 0x9c, 0x9a, 0xca, 0x94, 0x0d, 0x23, 0x87, 0xa0, 0x2a,
+    0x25, 0x72, 0x7e, 0xea, 0xf8, 0x34, 0x7f, 0xb8, 0x7c, 0xbb, 0x3c, 0x0e, 0xb3, 0x45, 0x72, 0x34,
+    0xa1, 0x5c, 0x24, 0xc9, 0x1c, 0xfd, 0x79, 0xce, 0x46, 0x8d, 0xc0, 0x76, 0x92, 0xf0, 0xd4, 0x61,
+    0x95, 0x6c, 0xce, 0xa1, 0xb1, 0xb4, 0x92, 0x3a, 0x95, 0xa3, 0xb2, 0xbe, 0xdc, 0xec, 0xd5, 0x2c,
+    0x74, 0xe7, 0x58, 0x89, 0x1c, 0xc0, 0x3b, 0x69, 0x9b, 0xec, 0xa0, 0x27, 0xa5, 0x9d, 0x9c, 0xe1,
+    0x54, 0xd7, 0xda, 0x59, 0xf4, 0x5a, 0x4b, 0xe8, 0xa8, 0x4d, 0x6f, 0x2a, 0x36, 0x28, 0x40, 0x4f,
+    0x20, 0x2b, 0x91, 0xa3, 0xb7, 0x41, 0x9c, 0xe0, 0x98, 0x6c, 0xa0, 0xfc, 0xb6, 0x12, 0x3a, 0xca,
+    0x5c, 0x91, 0x25, 0xfa, 0x6c, 0xb0, 0x81, 0x94, 0xc0, 0x79, 0xd7, 0x9d, 0xba, 0xdd, 0xe2, 0x61,
+    0xd8, 0x6e, 0x87, 0xbf, 0x2f, 0xb3, 0x77, 0x8e, 0x4f, 0xe8, 0x50, 0x4a, 0xe4, 0x60, 0x74, 0x06,
+    0x36, 0x95, 0xd8, 0x78, 0x4a, 0xea, 0x54, 0x8f, 0xa1, 0x1f, 0xaf, 0x39, 0xf1, 0x3b, 0xc9, 0xb6,
+    0x12, 0xea, 0x85, 0xac, 0x64, 0x8e, 0xee, 0x34, 0x2f, 0x12, 0xd9, 0x52, 0x42, 0xbd, 0xb9, 0x93,
+    0xc0, 0x51, 0x1e, 0x94, 0x45, 0x23, 0x43, 0x11, 0x9a, 0xe4, 0x38, 0x49, 0x1c, 0x75, 0x18, 0xc9,
+    0x67, 0x87, 0x0d, 0xa3, 0xe4, 0x8d, 0xda, 0x4e, 0x16, 0x95, 0x31, 0x13, 0x94, 0x38, 0x4e, 0x12,
+    0x47, 0x8b, 0xee, 0xef, 0x22, 0x03, 0x76, 0xb5, 0xd1, 0x45, 0xb5, 0x22, 0x32, 0x81, 0x13, 0x46,
+    0x87, 0xcf, 0x72, 0x58, 0xa6, 0xe5, 0xbf, 0x58, 0x99, 0x12, 0x3a, 0x18, 0x99, 0x68, 0x6f, 0xee,
+    0x26, 0xa7, 0x39, 0xd5, 0x43, 0xc8, 0x06, 0x36, 0x6c, 0x50, 0x8d, 0x93, 0x79, 0xf3, 0x82, 0x40,
+    0xf2, 0x06, 0x87, 0x02, 0xc7, 0x4d, 0x04, 0x4e, 0x35, 0x8c, 0x6c, 0x7a, 0x09, 0x6a, 0xcc, 0x3d,
+    0x36, 0xc1, 0x29, 0x12, 0x1b, 0xb4, 0x44, 0x89, 0x1b, 0xad, 0x2f, 0x2f, 0x22, 0x13, 0xb8, 0x32,
+    0xe0, 0xc1, 0x09, 0x0e, 0x6b, 0xf4, 0x84, 0x0e, 0xe4, 0x8c, 0xaa, 0x5a, 0x5d, 0xa5, 0x65, 0x2f,
+    0x09, 0x55, 0x29, 0x79, 0xa3, 0x3f, 0x7c, 0xbc, 0x03, 0x9b, 0x5d, 0x2f, 0x71, 0xa3, 0xdd, 0xd7,
+    0x3e, 0xa0, 0xa3, 0x08, 0xaf, 0xa7, 0x15, 0x95, 0x31, 0x5b, 0xa8, 0x01, 0xf2, 0x73, 0x92, 0x9b,
+    0x6a, 0x30, 0x83, 0x03, 0xe7, 0x8a, 0x1e, 0x7c, 0x8b, 0x53, 0x34, 0x26, 0x36, 0xbd, 0x50, 0x8d,
+    0x12, 0x35, 0xfa, 0x05, 0xa7, 0x6c, 0x38, 0x4b, 0x84, 0x52, 0x3b, 0x48, 0xdc, 0xa8, 0xcf, 0x72,
+    0x16, 0x89, 0x4e, 0xb9, 0x03, 0x1c, 0x38, 0x54, 0xae, 0xe3, 0xb1, 0xfe, 0x27, 0xa0, 0x81, 0xc3,
+    0x1a, 0x03, 0x78, 0x7b, 0x07, 0x09, 0x1c, 0xed, 0x6d, 0x58, 0x11, 0x99, 0xc0, 0xa9, 0x62, 0x90,
+    0xbc, 0xd1, 0xd5, 0xaa, 0x58, 0xa2, 0xb5, 0xe0, 0x7b, 0xa6, 0x20, 0x71, 0x03, 0x88, 0xa3, 0xe5,
+    0x43, 0x12, 0x2b, 0x52, 0x12, 0x47, 0x1f, 0xc7, 0x06, 0xbd, 0xd4, 0x12, 0x37, 0x80, 0x8d, 0x6d,
+    0x5b, 0xf0, 0x75, 0x7c, 0x90, 0xb0, 0x51, 0x3a, 0x72, 0xe2, 0x20, 0x82, 0x2f, 0x90, 0x83, 0x64,
+    0x0d, 0xa0, 0x26, 0x59, 0x74, 0x26, 0x70, 0x1e, 0xdb, 0x4c, 0x2e, 0xa6, 0xd5, 0x45, 0x16, 0x57,
+    0x0e, 0x0d, 0x66, 0x83, 0xbe, 0xbf, 0x29, 0x22, 0xd1, 0xd9, 0x76, 0x83, 0xa7, 0x8d, 0x6f, 0xb3,
+    0x83, 0xba, 0xb4, 0x46, 0xd2, 0x06, 0xf3, 0x56, 0xfa, 0x04, 0x6e, 0xae, 0x6a, 0xa6, 0x5f, 0xe1,
+    0x54, 0x83, 0x19, 0x3c, 0xf8, 0x34, 0x6f, 0x24, 0x72, 0x00, 0xce, 0x9c, 0x65, 0x36, 0x6c, 0x84,
+    0xa0, 0x32, 0xa7, 0x42, 0xa7, 0xb6, 0xde, 0x36, 0x1b, 0x0b, 0x2e, 0xfa, 0x35, 0x93, 0xfb, 0xd4,
+    0x5e, 0x20, 0xb2, 0x65, 0xb7, 0x06, 0x15, 0x29, 0xa9, 0x03, 0x58, 0x6f, 0x5b, 0x5c, 0x2f, 0xf6,
+    0xea, 0xa1, 0x99, 0xd1, 0x35, 0x50, 0x8f, 0x26, 0x35, 0xe0, 0x34, 0x27, 0x4a, 0xf0, 0xe8, 0x2b,
+    0x2d, 0xb6, 0xd8, 0x4a, 0x03, 0xad, 0x4e, 0x46, 0x78, 0x9e, 0x63, 0x4b, 0x97, 0x27, 0x36, 0x87,
+    0x88, 0x92, 0x3c, 0x6a, 0x3c, 0xda, 0xab, 0xb1, 0x84, 0xa2, 0x27, 0x62, 0x7b, 0xa3, 0x59, 0xa2,
+    0x43, 0xb7, 0xc1, 0xc7, 0xc9, 0x65, 0xb5, 0x7a, 0x1c, 0x4b, 0x2b, 0x2a, 0x94, 0x3a, 0x71, 0x0e,
+    0x75, 0x5e, 0xa0, 0x33, 0x66, 0x8f, 0xdd, 0x39, 0x37, 0x68, 0x1e, 0x60, 0x9d, 0xde, 0x83, 0xef,
+    0x1f, 0xa2, 0x44, 0x0f, 0xe2, 0x1c, 0x62, 0x73, 0x89, 0xad, 0x4b, 0x47, 0x74, 0xeb, 0x80, 0x2d,
+    0x95, 0x4a, 0x6c, 0xea, 0x18, 0x6f, 0x02, 0x9e, 0x60, 0xb2, 0x87, 0x7a, 0x8d, 0x56, 0x82, 0x47,
+    0xef, 0x87, 0x02, 0xba, 0x93, 0xbb, 0x95, 0xd8, 0x01, 0x58, 0x0d, 0x57, 0x6c, 0x1b, 0xf6, 0x72,
+    0xbe, 0x45, 0x7f, 0x94, 0x53, 0x44, 0xb6, 0xe0, 0x0d, 0xde, 0xe2, 0x1b, 0xa5, 0x59, 0x26, 0xa1,
+    0xfb, 0x66, 0x5b, 0x09, 0x1f, 0x7d, 0x71, 0xda, 0x15, 0xd7, 0x86, 0x4d, 0x72, 0x5b, 0x49, 0x1f,
+    0x88, 0xca, 0x08, 0x6e, 0x75, 0x68, 0x25, 0x7b, 0xb4, 0xa9, 0x78, 0xb9, 0x1c, 0x03, 0xdf, 0x8f,
+    0xb5, 0x92, 0x3b, 0xea, 0x14, 0xd7, 0xe1, 0x0b, 0x96, 0x2d, 0x1a, 0x3b, 0xee, 0xfa, 0x8d, 0x13,
+    0xf6, 0xac, 0x94, 0xd8, 0x51, 0xbb, 0x36, 0x97, 0x9d, 0x01, 0xf3, 0x3b, 0x4d, 0xff, 0x34, 0xa7,
+    0x1a, 0x49, 0x47, 0xe0, 0xef, 0x20, 0x92, 0xa4, 0x8e, 0x7e, 0xdb, 0x38, 0x0b, 0xae, 0xab, 0x26,
+    0x89, 0x1c, 0xbd, 0x5d, 0x73, 0xd7, 0x2f, 0xb1, 0xa0, 0x07, 0x50, 0x92, 0xcc, 0xd1, 0x5d, 0x7e,
+    0xbb, 0x62, 0xcf, 0xb1, 0x55, 0x82, 0x24, 0x71, 0x03, 0xa1, 0xa2, 0x43, 0x7f, 0x09, 0x9a, 0xa6,
+    0xf3, 0xa6, 0x1a, 0x4b, 0x6f, 0xc1, 0x47, 0x79, 0xba, 0x45, 0xaa, 0x53, 0xbe, 0x57, 0xcd, 0x04,
+    0x85, 0x77, 0x82, 0xdf, 0xed, 0xb8, 0x52, 0xfa, 0x25, 0x6c, 0x30, 0x25, 0x72, 0x00, 0x27, 0x65,
+    0x29, 0xfd, 0x42, 0x6b, 0xaa, 0x49, 0x32, 0x07, 0x21, 0xb2, 0xc5, 0xc2, 0x9b, 0x66, 0xcc, 0x1e,
+    0xa8, 0x8b, 0x4c, 0xd8, 0x66, 0x6e, 0x1a, 0x8d, 0x1e, 0xd0, 0x32, 0xc7, 0x97, 0x4f, 0xda, 0xa0,
+    0xcd, 0x0e, 0x34, 0x9a, 0x3d, 0xa0, 0x75, 0x41, 0x2c, 0x30, 0x62, 0xf7, 0x36, 0x81, 0x47, 0x0f,
+    0xb0, 0x44, 0x02, 0xf7, 0x51, 0xd2, 0x68, 0xf4, 0x80, 0x0e, 0x8a, 0xbe, 0xe4, 0x60, 0xd0, 0x0a,
+    0x3f, 0x8d, 0xe6, 0x0e, 0xe8, 0x17, 0xba, 0x34, 0x8c, 0x60, 0x35, 0x4a, 0xd8, 0xa8, 0xed, 0xae,
+    0x2f, 0x69, 0x22, 0x34, 0xe7, 0xa6, 0xd1, 0xdc, 0x01, 0x80, 0xbb, 0xf0, 0xd7, 0x26, 0x6e, 0xa4,
+    0x09, 0xa2, 0xd1, 0xe8, 0x01, 0xfd, 0x7a, 0xdb, 0x06, 0xdb, 0x58, 0x47, 0xa3, 0xd1, 0x03, 0xda,
+    0x5d, 0x83, 0xee, 0x8f, 0x26, 0xfc, 0xd8, 0x81, 0xa2, 0x92, 0x2d, 0x39, 0xf4, 0x95, 0x1c, 0x8d,
+    0x1d, 0xd0, 0x57, 0x2e, 0xfc, 0xb5, 0x6a, 0x8e, 0xf4, 0xbb, 0x34, 0x9a, 0x3b, 0xa0, 0xc7, 0xa1,
+    0x37, 0xe0, 0x5d, 0x33, 0x9a, 0x3c, 0x00, 0xd0, 0x08, 0x1e, 0x7c, 0x42, 0xa3, 0xb1, 0x03, 0xda,
+    0x5d, 0x13, 0x0c, 0xf6, 0x2b, 0x55, 0x1a, 0x0d, 0x1d, 0x00, 0x94, 0x78, 0x7d, 0x99, 0x8d, 0x00,
+    0x9d, 0xd6, 0x41, 0xa3, 0xa1, 0x03, 0x88, 0xcd, 0xcd, 0x7e, 0x1c, 0xfa, 0x3d, 0x3f, 0x8d, 0x86,
+    0x0e, 0xa8, 0x0b, 0xd1, 0xac, 0x30, 0x62, 0x33, 0x1b, 0x1a, 0x0d, 0x1d, 0x50, 0xfb, 0xf1, 0x70,
+    0xfd, 0xb8, 0x12, 0xbb, 0xde, 0xf8, 0x1e, 0xe9, 0x50, 0x06, 0x96, 0xe9, 0x9a, 0x07, 0xfe, 0xfc,
+    0x0f, 0x18, 0xc0, 0xfe, 0x33,
+};
+
+constexpr uint8_t kReleaseGzip[] = {
+    0x1f, 0x8b, 0x08, 0x00, 0x00, 0x00, 0x00, 0x00, 0x02, 0x03, 0xd5, 0x96, 0xdb, 0x6e, 0xe2, 0x30,
+    0x10, 0x86, 0xef, 0xf7, 0x29, 0x2c, 0x7a, 0xb1, 0x07, 0x15, 0x12, 0x4f, 0x12, 0x28, 0x5c, 0xee,
+    0x45, 0xef, 0x77, 0xb5, 0x52, 0xa5, 0x3d, 0x08, 0x39, 0x89, 0x21, 0x56, 0x93, 0x38, 0x8a, 0x27,
+    0x4b, 0xbb, 0x15, 0xef, 0xbe, 0xce, 0x01, 0x42, 0x4c, 0x4b, 0xa5, 0xca, 0xa8, 0x02, 0x21, 0xc0,
+    0xe3, 0xc9, 0x6f, 0x7b, 0xe6, 0xff, 0x48, 0x9e, 0x3e, 0x10, 0x32, 0xaa, 0xca, 0x74, 0xb4, 0x20,
+    0xa3, 0x04, 0xb1, 0x50, 0x0b, 0xc7, 0x61, 0x85, 0x98, 0xac, 0x05, 0x26, 0x55, 0x38, 0x89, 0x64,
+    0xe6, 0x94, 0xbc, 0x90, 0xca, 0xe1, 0x0f, 0x2c, 0x2b, 0x52, 0xee, 0x14, 0x38, 0x46, 0x91, 0xf1,
+    0x28, 0x95, 0xd1, 0xbd, 0x9e, 0x4a, 0x39, 0x53, 0x5c, 0x39, 0x74, 0x74, 0x5d, 0x0b, 0x25, 0x98,
+    0xa5, 0x4b, 0x43, 0xed, 0x40, 0xe9, 0xb4, 0x06, 0xb2, 0xb5, 0xf3, 0x97, 0x4e, 0xfc, 0x89, 0xdb,
+    0x8a, 0x89, 0x58, 0xcb, 0xd0, 0xe6, 0xa7, 0x9e, 0x5a, 0xe6, 0x2c, 0xe3, 0xb5, 0xee, 0x61, 0x0a,
+    0xb2, 0x72, 0xcd, 0x71, 0xa9, 0xb5, 0x33, 0x81, 0x42, 0x25, 0xf5, 0x7c, 0xc6, 0x44, 0xde, 0xce,
+    0x3e, 0x77, 0x45, 0x5c, 0xb2, 0x15, 0xea, 0xe0, 0x8a, 0xa5, 0x8a, 0x37, 0x91, 0xa2, 0xe4, 0xdd,
+    0x16, 0x06, 0x61, 0x56, 0x61, 0x22, 0x4b, 0x1d, 0x7a, 0xd2, 0x23, 0x3d, 0x4e, 0xe5, 0x5a, 0xeb,
+    0x6a, 0xb5, 0x2e, 0x79, 0x1c, 0x4a, 0x6c, 0x24, 0x77, 0x3b, 0xf5, 0xa1, 0x1b, 0xe1, 0x63, 0xd1,
+    0x2c, 0xfb, 0xb5, 0x4f, 0x50, 0x02, 0xf9, 0x92, 0xc5, 0x59, 0xa3, 0xb0, 0x5f, 0xe3, 0xd5, 0xca,
+    0x57, 0x8a, 0x97, 0xca, 0x39, 0x5c, 0x50, 0x5f, 0xb5, 0x6d, 0xb6, 0x17, 0x95, 0x9c, 0x21, 0x8f,
+    0x97, 0xac, 0x3e, 0xcc, 0x08, 0x5c, 0x98, 0x8e, 0x5d, 0x6f, 0x0c, 0xee, 0x0f, 0xea, 0x2e, 0xdc,
+    0xfa, 0xfd, 0xb3, 0x3d, 0x6f, 0x51, 0x85, 0xa9, 0x2e, 0xcc, 0x4b, 0x99, 0x41, 0x9f, 0xc9, 0x94,
+    0xe2, 0xa8, 0x74, 0xce, 0xaf, 0x66, 0x6b, 0xed, 0xb1, 0xad, 0x98, 0xa3, 0x55, 0x76, 0x28, 0xed,
+    0xca, 0xb1, 0xef, 0x2d, 0xdd, 0x8f, 0x77, 0xad, 0x5a, 0x89, 0x32, 0xdb, 0xb0, 0x92, 0x4f, 0xc2,
+    0xae, 0x89, 0x6d, 0xed, 0x59, 0xc8, 0x9b, 0x4d, 0xf4, 0xa1, 0x48, 0xe6, 0xc8, 0x73, 0x5c, 0xee,
+    0x8a, 0xcd, 0x8a, 0x22, 0x15, 0x11, 0x43, 0x21, 0x73, 0x47, 0x46, 0xc8, 0x71, 0xac, 0x50, 0x97,
+    0x28, 0xeb, 0xaf, 0x50, 0xa8, 0x0b, 0x56, 0xa7, 0x56, 0x45, 0x2a, 0x59, 0xcc, 0xe3, 0x83, 0x29,
+    0xf1, 0xaf, 0x9e, 0xa1, 0xfe, 0xd4, 0x83, 0xf9, 0x74, 0x1f, 0x8e, 0xc5, 0x9a, 0xab, 0xa6, 0x6a,
+    0x2a, 0x61, 0x10, 0x4c, 0x75, 0xad, 0xde, 0xfc, 0xa2, 0x81, 0xef, 0x07, 0xfd, 0x8a, 0xb1, 0xdc,
+    0xe4, 0xf5, 0x2e, 0xb4, 0x75, 0xab, 0xbc, 0x5e, 0xc2, 0xf3, 0xfa, 0xa3, 0x9d, 0x6a, 0xad, 0xbf,
+    0x6f, 0x58, 0xdb, 0x9c, 0x22, 0x3e, 0x95, 0xeb, 0x1d, 0xe6, 0x86, 0xa5, 0xdc, 0x68, 0x43, 0x2d,
+    0xf7, 0x6b, 0xbf, 0x15, 0xd4, 0x9d, 0x40, 0x47, 0xab, 0xf3, 0x7c, 0xd3, 0xba, 0x32, 0xf7, 0x08,
+    0xbd, 0x86, 0xd1, 0x31, 0x4a, 0x47, 0x38, 0x75, 0xd1, 0x6d, 0xf3, 0xbd, 0xbd, 0x3e, 0x97, 0x51,
+    0xc1, 0x34, 0x2a, 0x1c, 0x19, 0x35, 0x94, 0x12, 0xdb, 0xf3, 0xbd, 0x8f, 0x55, 0x03, 0xea, 0xfa,
+    0xe7, 0x31, 0xea, 0xcc, 0xf3, 0xfc, 0x53, 0x46, 0x9d, 0x5e, 0xae, 0x51, 0x5f, 0x6a, 0xda, 0x05,
+    0x5b, 0xd5, 0x33, 0xad, 0xea, 0x1d, 0x59, 0xb5, 0x60, 0x25, 0x8a, 0xda, 0x6d, 0xea, 0x5d, 0xac,
+    0xea, 0xb9, 0x33, 0x38, 0x8f, 0x53, 0xe7, 0x00, 0xde, 0x29, 0xa7, 0xce, 0x2f, 0xd7, 0xa9, 0x2f,
+    0xf5, 0xec, 0x82, 0x9d, 0xea, 0x9b, 0x4e, 0xf5, 0x8f, 0x9c, 0x9a, 0x0a, 0xc4, 0x94, 0xaf, 0xde,
+    0xc7, 0xa7, 0xfa, 0x0f, 0xf5, 0x26, 0x98, 0x9d, 0xe9, 0xee, 0x1f, 0xd2, 0xc3, 0x9b, 0xca, 0x91,
+    0x55, 0xfb, 0xde, 0x5c, 0x9e, 0x55, 0x9f, 0x6f, 0xda, 0xf9, 0x8d, 0xaa, 0x3f, 0xff, 0x34, 0x0f,
+    0xae, 0xa1, 0x8c, 0x1f, 0xeb, 0x94, 0xab, 0x2b, 0x72, 0x97, 0x30, 0xfc, 0xa8, 0x48, 0x94, 0xb0,
+    0x7c, 0xcd, 0xe3, 0xdf, 0xf9, 0x17, 0x72, 0x2b, 0x1e, 0x88, 0x7e, 0xf8, 0xce, 0x88, 0xbb, 0x20,
+    0x28, 0xd6, 0x89, 0xb6, 0x0d, 0xf9, 0xf6, 0x9d, 0x94, 0x12, 0x1b, 0xb7, 0xe8, 0x98, 0x7e, 0x28,
+    0x5f, 0x13, 0x96, 0xc7, 0xa4, 0x90, 0x25, 0xb2, 0x94, 0x94, 0x1c, 0xcb, 0x47, 0x12, 0xb2, 0xe8,
+    0x5e, 0xae, 0x56, 0xa4, 0xca, 0xf5, 0x21, 0xc8, 0x86, 0xb3, 0x7b, 0x72, 0x27, 0xc6, 0xb7, 0x82,
+    0x7c, 0xba, 0x02, 0xd7, 0xfd, 0x3c, 0x90, 0xa6, 0x16, 0xa5, 0xe9, 0x50, 0x1a, 0x2c, 0x4a, 0xc3,
+    0x50, 0xda, 0xb3, 0x28, 0xed, 0x0d, 0xa5, 0x7d, 0x8b, 0xd2, 0xfe, 0x50, 0x3a, 0xb0, 0x28, 0x1d,
+    0x0c, 0xa5, 0xa7, 0x16, 0xa5, 0xa7, 0x43, 0xe9, 0x99, 0x45, 0xe9, 0xd9, 0x50, 0xfa, 0xc6, 0xa2,
+    0xf4, 0xcd, 0x50, 0x7a, 0x6e, 0x51, 0x7a, 0x6e, 0x20, 0x63, 0x11, 0x47, 0x6a, 0xe2, 0x68, 0x91,
+    0x47, 0x6a, 0xf0, 0x48, 0x2d, 0x02, 0x49, 0x0d, 0x20, 0xa9, 0x45, 0x22, 0xa9, 0x41, 0x24, 0xb5,
+    0x88, 0x24, 0x35, 0x90, 0xa4, 0x16, 0x99, 0xa4, 0x06, 0x93, 0xd4, 0x22, 0x94, 0xd4, 0x80, 0x92,
+    0x5a, 0xa4, 0x92, 0x1a, 0x54, 0x52, 0x8b, 0x58, 0x52, 0x03, 0x4b, 0x6a, 0x91, 0x4b, 0x6a, 0x70,
+    0x09, 0x16, 0xb9, 0x04, 0x83, 0x4b, 0xb0, 0xc8, 0x25, 0x98, 0xf7, 0x49, 0x8b, 0x5c, 0x82, 0xc1,
+    0x25, 0x58, 0xe4, 0x12, 0x0c, 0x2e, 0xc1, 0x22, 0x97, 0x60, 0x70, 0x09, 0x16, 0xb9, 0x04, 0x83,
+    0x4b, 0xb0, 0xc8, 0x25, 0x18, 0x5c, 0x82, 0x45, 0x2e, 0xc1, 0xe0, 0x12, 0x2c, 0x72, 0x09, 0x06,
+    0x97, 0x60, 0x91, 0x4b, 0xa8, 0xb9, 0x1c, 0x7d, 0xd8, 0xfe, 0x07, 0xbf, 0x63, 0xe7, 0x4c, 0x9f,
+    0x17, 0x00, 0x00,
+};
+
+constexpr uint8_t kActivityRawDeflate[] = {
+    0xb5, 0x9c, 0x4b, 0x6f, 0x1b, 0x47, 0x10, 0x84, 0xff, 0x0a, 0xc1, 0xb3, 0x05, 0xcc, 0x73, 0x1f,
+    0x73, 0x93, 0x6d, 0x39, 0x01, 0x82, 0x3c, 0x00, 0xe5, 0x14, 0x23, 0x10, 0x16, 0x24, 0x13, 0x11,
+    0x92, 0x48, 0x87, 0x26, 0x05, 0x24, 0x41, 0xfe, 0x7b, 0x6a, 0x95, 0x8b, 0x51, 0x72, 0xdc, 0x43,
+    0x4d, 0xd9, 0xf0, 0xc5, 0x5a, 0x1b, 0x2e, 0x74, 0x4f, 0xf7, 0x57, 0xd3, 0x33, 0xbb, 0xef, 0xff,
+    0x5e, 0x6e, 0xd7, 0xcb, 0xb2, 0xdc, 0x3c, 0x1e, 0x2f, 0xbc, 0x9b, 0x7f, 0x2d, 0x5f, 0x2d, 0x4f,
+    0x1f, 0x37, 0x87, 0x9b, 0xdd, 0xf4, 0xb0, 0xc1, 0x83, 0x37, 0xb7, 0xf7, 0xfb, 0xcd, 0xe2, 0xfb,
+    0xe9, 0x70, 0xdc, 0xee, 0xf0, 0xe8, 0xc3, 0x69, 0xb7, 0xba, 0xbd, 0x39, 0xfe, 0xf9, 0x61, 0x7e,
+    0xb6, 0xba, 0xdf, 0xaf, 0xee, 0x6e, 0xf6, 0xa7, 0x23, 0x1e, 0xec, 0x57, 0xab, 0xd3, 0xe1, 0xb0,
+    0x59, 0xdf, 0x4c, 0x47, 0x3c, 0x09, 0x2e, 0x74, 0x17, 0x2e, 0x5e, 0x38, 0xff, 0xb3, 0x1b, 0x8a,
+    0x8b, 0xc5, 0xe5, 0x5f, 0xf0, 0x97, 0xf0, 0xf7, 0xa7, 0xe3, 0x76, 0xbf, 0xbb, 0x79, 0xfa, 0x3f,
+    0xf1, 0xa7, 0x8b, 0x1e, 0x3f, 0x5d, 0x6f, 0x1e, 0xb7, 0xab, 0xcd, 0x7f, 0x3f, 0xbb, 0xba, 0xfe,
+    0x29, 0x86, 0xeb, 0x78, 0x71, 0xe9, 0x5f, 0x87, 0x37, 0xf1, 0x6d, 0xba, 0xca, 0xef, 0xba, 0xe5,
+    0x3f, 0xaf, 0x58, 0xa5, 0xc7, 0x3f, 0xfb, 0x54, 0xe5, 0xe5, 0xc3, 0x76, 0x37, 0x2d, 0xbe, 0xbb,
+    0x9d, 0xfe, 0x47, 0xe3, 0x93, 0xf6, 0x2f, 0x4a, 0x1c, 0x4a, 0x1e, 0xa4, 0x12, 0x03, 0x49, 0x7c,
+    0xbd, 0xbd, 0x9f, 0xee, 0x17, 0x97, 0xb7, 0x0f, 0x9b, 0x35, 0x9e, 0xbc, 0x28, 0x8e, 0x3e, 0x96,
+    0x1c, 0xa4, 0x22, 0x23, 0x89, 0x6c, 0x8e, 0xa3, 0x1f, 0x8b, 0x77, 0x52, 0x89, 0x89, 0x24, 0x2a,
+    0xe2, 0x38, 0x96, 0x34, 0x4a, 0x45, 0xe6, 0x73, 0x45, 0x9a, 0x0b, 0x32, 0xc4, 0x92, 0xa2, 0x54,
+    0x63, 0x47, 0x1a, 0xbf, 0xd9, 0xec, 0x0f, 0xbf, 0x6f, 0x16, 0x57, 0x8f, 0xd3, 0xee, 0x23, 0x1e,
+    0x7d, 0x66, 0x45, 0xda, 0x22, 0x93, 0x3a, 0x90, 0x73, 0x3f, 0xf8, 0xb4, 0xb0, 0xcd, 0x6c, 0xdb,
+    0x1a, 0x47, 0x75, 0x65, 0x0f, 0xa4, 0xd1, 0x2a, 0x1a, 0xbb, 0x41, 0xc6, 0x5c, 0x92, 0xb6, 0x6a,
+    0x46, 0xd2, 0xf8, 0x76, 0xda, 0x6d, 0x37, 0xf7, 0x8b, 0x1f, 0xef, 0xa6, 0xdf, 0xf6, 0x87, 0x17,
+    0x66, 0x3b, 0x76, 0x25, 0x48, 0xdb, 0xb8, 0xff, 0x1a, 0xb0, 0x49, 0xbe, 0x44, 0x69, 0x2c, 0x3d,
+    0xc3, 0xc6, 0x46, 0xa2, 0xb9, 0x28, 0x53, 0x2e, 0x21, 0x29, 0xab, 0xdb, 0x33, 0x6e, 0x50, 0xd6,
+    0x8b, 0x1f, 0xf6, 0x8f, 0xd3, 0xdd, 0x0b, 0x93, 0x9d, 0x5d, 0x89, 0x9d, 0x54, 0x21, 0xb3, 0xa6,
+    0x62, 0x49, 0xda, 0x95, 0x93, 0x7d, 0x49, 0x52, 0x6e, 0xfb, 0xb3, 0x79, 0x63, 0x26, 0x3b, 0x87,
+    0x92, 0x7b, 0x69, 0x28, 0x19, 0x37, 0x9a, 0x50, 0x0e, 0x25, 0x4a, 0x89, 0xe3, 0xcf, 0x27, 0x8e,
+    0x95, 0xf0, 0xb1, 0x38, 0x20, 0xc7, 0x4b, 0x83, 0xc9, 0xc8, 0xf9, 0x76, 0x82, 0x95, 0xbc, 0x3e,
+    0xfd, 0x75, 0xba, 0xdb, 0x7e, 0xbe, 0x76, 0x2a, 0x44, 0xc2, 0x4d, 0x4a, 0x0d, 0x86, 0x67, 0xe6,
+    0x54, 0x64, 0xdc, 0x58, 0x97, 0x30, 0x6a, 0x5e, 0x6c, 0x27, 0xbd, 0x9e, 0x3a, 0x50, 0x89, 0xfd,
+    0x83, 0x34, 0x96, 0x81, 0xa9, 0x63, 0xb4, 0x4a, 0x3b, 0xdd, 0xf0, 0x6a, 0x41, 0x5a, 0x39, 0x81,
+    0x91, 0x23, 0x58, 0x93, 0xa1, 0x2b, 0x51, 0xda, 0x29, 0x03, 0x23, 0xa7, 0xd5, 0xab, 0x8d, 0x25,
+    0x06, 0x75, 0xae, 0x19, 0x3a, 0xcd, 0xa6, 0x17, 0x22, 0xbb, 0x92, 0xa5, 0x1d, 0x28, 0x30, 0x72,
+    0x6c, 0x83, 0x61, 0xaf, 0xc9, 0xe4, 0x8a, 0x93, 0xf2, 0x3b, 0x30, 0x74, 0x2c, 0xdb, 0x6b, 0xf6,
+    0x9f, 0x94, 0x8a, 0xd3, 0x06, 0x92, 0x81, 0xf3, 0x6e, 0x3a, 0x4c, 0xb7, 0x8b, 0xeb, 0xed, 0x7a,
+    0xbd, 0xfd, 0xe3, 0xf4, 0xe2, 0x6e, 0x9e, 0x40, 0x1d, 0x6d, 0x28, 0x19, 0x39, 0x1a, 0x9d, 0x19,
+    0xa6, 0x52, 0x1b, 0x4f, 0xa6, 0x8e, 0xd9, 0x86, 0xbe, 0x9c, 0x73, 0x8f, 0x35, 0x09, 0x5b, 0x29,
+    0xf5, 0x42, 0x81, 0x99, 0xd3, 0xd6, 0xcd, 0x67, 0x89, 0xb0, 0x94, 0x52, 0x6f, 0x1e, 0x19, 0x38,
+    0x8d, 0x8d, 0x72, 0xd6, 0x08, 0x28, 0x4a, 0x37, 0x39, 0x91, 0x89, 0xd3, 0x1c, 0x46, 0x9f, 0x4a,
+    0xd4, 0x86, 0x91, 0x79, 0x63, 0xf7, 0x72, 0xa3, 0x4d, 0x22, 0x90, 0xbe, 0x2f, 0x5e, 0xea, 0x2e,
+    0x22, 0x13, 0xc7, 0xac, 0x99, 0x2a, 0x91, 0x59, 0x9b, 0x6d, 0x26, 0x8e, 0xb9, 0x22, 0x2b, 0x44,
+    0xce, 0x64, 0x54, 0x1a, 0xf3, 0xc8, 0xc0, 0xa9, 0xf0, 0xbc, 0xb6, 0xcc, 0xe0, 0x4a, 0xd0, 0xca,
+    0x64, 0xe8, 0x68, 0x64, 0xaa, 0xbd, 0x79, 0x64, 0xe6, 0x98, 0xeb, 0xd2, 0xec, 0xe5, 0x21, 0xc3,
+    0xb0, 0x49, 0x33, 0x7e, 0x36, 0x6f, 0x2a, 0xf2, 0x8d, 0x02, 0x97, 0x02, 0x27, 0x9e, 0x09, 0x1c,
+    0x33, 0x8c, 0x30, 0xbd, 0x5e, 0x6a, 0xcc, 0x13, 0xf3, 0xa6, 0xb9, 0x97, 0xc3, 0xf2, 0x8a, 0x25,
+    0x32, 0x6e, 0xec, 0x5e, 0x6e, 0xc7, 0x11, 0x53, 0x7d, 0xa9, 0xfd, 0x49, 0x0c, 0x1c, 0xb3, 0x4b,
+    0x9a, 0x1a, 0x31, 0x9c, 0x14, 0x07, 0x92, 0x71, 0x53, 0xd1, 0x7d, 0x6c, 0x95, 0x18, 0x58, 0x49,
+    0x07, 0xbd, 0x89, 0x79, 0xd3, 0xde, 0x7c, 0x12, 0xf6, 0xdc, 0xda, 0x6c, 0x33, 0x6e, 0x8c, 0xaa,
+    0xb1, 0xa3, 0x98, 0xd5, 0x51, 0x64, 0xd2, 0xd8, 0x45, 0x63, 0xf7, 0xc7, 0xd4, 0x97, 0x20, 0x35,
+    0x40, 0x89, 0x41, 0x53, 0xb3, 0xb9, 0x31, 0x83, 0x99, 0x71, 0x84, 0xac, 0x4d, 0x37, 0xb3, 0xc6,
+    0xda, 0xce, 0xda, 0xa1, 0xcc, 0x18, 0x56, 0x49, 0x1d, 0x6f, 0x62, 0xd4, 0xb4, 0x27, 0xdc, 0xe3,
+    0x24, 0xbe, 0x04, 0x29, 0xb5, 0x33, 0xe3, 0xc6, 0x56, 0x69, 0xa4, 0x1b, 0x22, 0xd5, 0x5b, 0xee,
+    0x2c, 0x07, 0x0e, 0x3a, 0x79, 0x14, 0xfb, 0x9f, 0xac, 0x06, 0x0e, 0x34, 0x22, 0xdb, 0xd2, 0xf2,
+    0xce, 0x0c, 0x1c, 0x7b, 0x58, 0x65, 0x66, 0x1b, 0x97, 0x06, 0xb4, 0x5b, 0xc5, 0xcc, 0xbc, 0xb1,
+    0x8a, 0xdb, 0x94, 0x18, 0x82, 0xf8, 0x9c, 0x29, 0x33, 0x6e, 0x04, 0x71, 0xc4, 0x1c, 0xda, 0x49,
+    0x9d, 0x64, 0x66, 0xe2, 0xb4, 0xc7, 0x11, 0x53, 0x68, 0x69, 0x8f, 0xcc, 0x8c, 0x1b, 0x41, 0xf7,
+    0x09, 0x83, 0xf8, 0x38, 0x3e, 0x33, 0x6c, 0x0c, 0x6f, 0x61, 0xb1, 0x06, 0x47, 0xdc, 0x49, 0x7c,
+    0x80, 0x9c, 0x99, 0x35, 0x35, 0xd8, 0xae, 0xd0, 0x89, 0xdb, 0x17, 0x52, 0xda, 0x74, 0x4c, 0x1b,
+    0xd3, 0x94, 0xdb, 0x22, 0x67, 0x57, 0x2e, 0x5d, 0x94, 0x1d, 0xd3, 0xc6, 0xf4, 0xbb, 0x15, 0x22,
+    0xd5, 0xbb, 0xed, 0x4e, 0x4f, 0x9b, 0x84, 0x23, 0x64, 0xa9, 0x4b, 0xeb, 0x98, 0x36, 0x9a, 0x55,
+    0x89, 0x89, 0xbe, 0xf6, 0x72, 0x55, 0xc7, 0xc0, 0x11, 0x74, 0xf3, 0x8c, 0xe3, 0x11, 0x69, 0x37,
+    0xef, 0x18, 0x39, 0x35, 0xc1, 0x34, 0xc9, 0x98, 0x31, 0x1b, 0x90, 0x1e, 0x7e, 0x76, 0xe7, 0x42,
+    0xc7, 0xaa, 0x1d, 0x1c, 0x2a, 0x06, 0xf1, 0xd0, 0xaf, 0x63, 0xea, 0x34, 0x77, 0x21, 0x88, 0x1c,
+    0xe0, 0xd6, 0x94, 0xe3, 0xb4, 0x8e, 0xa9, 0x23, 0xc8, 0x37, 0x66, 0x55, 0x30, 0x19, 0xd2, 0x61,
+    0x74, 0xc7, 0xe4, 0xa9, 0x18, 0x61, 0xd8, 0x29, 0xf7, 0xb8, 0xac, 0x26, 0x05, 0x4f, 0xcf, 0xe0,
+    0xa9, 0x90, 0x69, 0x14, 0x0f, 0x56, 0x25, 0xd2, 0x2e, 0x9d, 0x4e, 0xf6, 0x4c, 0x9e, 0x66, 0x3b,
+    0x04, 0x91, 0xf0, 0x1a, 0xd2, 0x3d, 0x44, 0xcf, 0xe4, 0x69, 0xc6, 0xe3, 0x5c, 0xdf, 0x62, 0xf4,
+    0xf4, 0x8c, 0x9e, 0x46, 0xef, 0x1b, 0x70, 0xbb, 0x4a, 0x7c, 0x0d, 0xbe, 0x67, 0xea, 0x08, 0xe2,
+    0x38, 0x5f, 0x45, 0x95, 0x52, 0xa7, 0x7f, 0x09, 0x75, 0xec, 0xfa, 0x8e, 0x7d, 0x49, 0xda, 0xca,
+    0x61, 0xec, 0xd4, 0x74, 0x4b, 0x5b, 0x27, 0x2e, 0x39, 0x68, 0xcf, 0x1f, 0x7a, 0x46, 0x8f, 0xa2,
+    0x0f, 0xe1, 0x3e, 0xaa, 0x76, 0x2e, 0xdd, 0x33, 0x7b, 0xcc, 0xa5, 0x69, 0xf6, 0x4a, 0x4c, 0x2a,
+    0xb5, 0x5b, 0xc7, 0xfe, 0xab, 0x80, 0x07, 0x17, 0x67, 0x93, 0xf4, 0x80, 0x71, 0x60, 0xf0, 0x58,
+    0x8d, 0xc8, 0x5e, 0x94, 0xf0, 0x6c, 0xda, 0x9b, 0xdc, 0x03, 0x63, 0xa7, 0xa6, 0x78, 0x8c, 0x8c,
+    0xa3, 0x5b, 0xc2, 0x6d, 0x48, 0xc1, 0x33, 0x30, 0x78, 0x9a, 0x6d, 0xdb, 0x3c, 0x71, 0x11, 0x17,
+    0xf8, 0xc0, 0xe0, 0xa9, 0x28, 0x70, 0x2b, 0xe5, 0x11, 0x1b, 0x5c, 0xf1, 0xe9, 0xd8, 0xc0, 0xf0,
+    0xb1, 0x9d, 0x46, 0x85, 0x4a, 0x50, 0x5c, 0xea, 0xda, 0x06, 0xa6, 0x8f, 0x44, 0x25, 0x3a, 0x91,
+    0xb6, 0xc4, 0x99, 0x3d, 0xe6, 0xba, 0x34, 0x6b, 0x27, 0x78, 0xf1, 0xf9, 0xd8, 0xc0, 0xdc, 0x69,
+    0xde, 0xe2, 0xce, 0xb7, 0x66, 0xc5, 0x5b, 0xdc, 0x41, 0x8d, 0x1d, 0x68, 0x44, 0xe1, 0x48, 0xb7,
+    0x65, 0x03, 0x63, 0xc7, 0x44, 0xa3, 0x5d, 0x37, 0x11, 0x37, 0x99, 0xa4, 0xae, 0x6d, 0x64, 0xe8,
+    0x08, 0xb2, 0x1d, 0x71, 0xa7, 0x45, 0x6a, 0xd9, 0x46, 0xa6, 0x4e, 0x7b, 0xd9, 0xe0, 0x32, 0x86,
+    0xf6, 0xc5, 0x9c, 0x91, 0x91, 0x53, 0xd1, 0xcd, 0xcd, 0xe2, 0x9e, 0xdf, 0xc4, 0x92, 0x36, 0xa0,
+    0x91, 0x99, 0x63, 0x0c, 0xa8, 0x6d, 0x85, 0xbd, 0x78, 0x4a, 0x30, 0x32, 0x6e, 0x2a, 0xe2, 0x58,
+    0x51, 0x37, 0xea, 0x37, 0x41, 0xc7, 0xf3, 0x79, 0x63, 0xc6, 0x32, 0x61, 0x4d, 0x4a, 0xa7, 0xaa,
+    0x23, 0xe3, 0xa6, 0xc6, 0xad, 0xd9, 0xc1, 0xc4, 0x95, 0x0c, 0x2f, 0x85, 0xf7, 0xc8, 0xc8, 0xb1,
+    0xe1, 0x6d, 0x07, 0x73, 0x7e, 0xef, 0x45, 0x39, 0x65, 0x1b, 0x19, 0x39, 0x82, 0x4e, 0x39, 0x8f,
+    0x7e, 0xa5, 0x33, 0xd5, 0x91, 0x99, 0xa3, 0x10, 0x89, 0x3b, 0xc8, 0x4a, 0xe6, 0xe0, 0xf3, 0x03,
+    0xf4, 0xd2, 0xaa, 0x42, 0x24, 0x0a, 0x5c, 0x79, 0xb4, 0xe3, 0x9d, 0x9a, 0x39, 0x48, 0x35, 0x7e,
+    0x2b, 0xbb, 0xb9, 0x77, 0xcc, 0x1c, 0xd3, 0x61, 0x18, 0x65, 0x03, 0x81, 0xb8, 0x46, 0xa9, 0xac,
+    0x6d, 0xef, 0x98, 0x38, 0xd6, 0xae, 0xd6, 0x94, 0xe8, 0xc5, 0xf7, 0x28, 0xbd, 0x63, 0xe4, 0xb4,
+    0x41, 0x11, 0x83, 0x20, 0xfc, 0x56, 0x5a, 0x49, 0xef, 0x98, 0x36, 0xed, 0x89, 0x9e, 0x2f, 0x8c,
+    0x68, 0x35, 0x32, 0x6c, 0x4c, 0x8d, 0x16, 0x69, 0x10, 0x45, 0x9c, 0x39, 0x29, 0x9d, 0xa4, 0x77,
+    0x4c, 0x1a, 0x81, 0xbb, 0xc0, 0xd4, 0x1c, 0x86, 0x57, 0x79, 0x54, 0xe2, 0x1d, 0xb3, 0xc6, 0x8c,
+    0xa5, 0x59, 0x35, 0x98, 0x9b, 0x4b, 0x2f, 0xd6, 0x79, 0xc7, 0xa8, 0x69, 0xad, 0x1a, 0xf5, 0xfd,
+    0x68, 0xaf, 0xff, 0xec, 0x00, 0x0a, 0x7b, 0xb6, 0xe4, 0xd2, 0x25, 0xf9, 0xec, 0xb3, 0x03, 0xb6,
+    0xf9, 0xb1, 0x0b, 0x67, 0x9e, 0x9a, 0x2b, 0x27, 0x6a, 0xfe, 0xd9, 0x77, 0x07, 0x5a, 0xb7, 0x60,
+    0xd8, 0x6d, 0x3b, 0x71, 0xd5, 0x78, 0x46, 0x8d, 0x40, 0x23, 0x64, 0x6a, 0xe3, 0xa8, 0x66, 0x0d,
+    0xc6, 0xd0, 0xd2, 0xb7, 0x54, 0xbd, 0x67, 0xd6, 0xd4, 0x6c, 0x1a, 0xcc, 0xf6, 0x83, 0x6f, 0x23,
+    0x48, 0xbf, 0xd6, 0xe1, 0x9f, 0x7d, 0x74, 0xc0, 0x36, 0x91, 0x76, 0xd9, 0xc0, 0x8f, 0x4b, 0xdf,
+    0xe7, 0xf7, 0x9e, 0x79, 0x63, 0x2e, 0xc9, 0x0a, 0x91, 0xb0, 0x68, 0xca, 0x9d, 0x8d, 0x7f, 0xf6,
+    0xd1, 0x01, 0x3b, 0x94, 0x46, 0xbe, 0xf3, 0xd3, 0xcb, 0x95, 0x52, 0x24, 0x3e, 0xfb, 0xe6, 0x40,
+    0x7b, 0x9b, 0x84, 0x4a, 0x8c, 0xfd, 0x9a, 0xdc, 0xee, 0xaf, 0xff, 0x02,
+};
+
+constexpr uint8_t kNoticesGzipStored[] = {
+    0x1f, 0x8b, 0x08, 0x00, 0x00, 0x00, 0x00, 0x00, 0x04, 0x03, 0x01, 0xdc, 0x05, 0x23, 0xfa, 0x5b,
+    0x7b, 0x22, 0x69, 0x64, 0x22, 0x3a, 0x22, 0x37, 0x64, 0x31, 0x63, 0x30, 0x30, 0x30, 0x30, 0x2d,
+    0x32, 0x66, 0x33, 0x62, 0x2d, 0x34, 0x63, 0x37, 0x65, 0x2d, 0x39, 0x61, 0x35, 0x31, 0x2d, 0x30,
+    0x30, 0x30, 0x30, 0x30, 0x30, 0x30, 0x30, 0x30, 0x30, 0x30, 0x30, 0x22, 0x2c, 0x22, 0x74, 0x69,
+    0x74, 0x6c, 0x65, 0x22, 0x3a, 0x22, 0x52, 0x6f, 0x74, 0x61, 0x20, 0x75, 0x70, 0x64, 0x61, 0x74,
+    0x65, 0x20, 0x28, 0x31, 0x29, 0x22, 0x2c, 0x22, 0x62, 0x6f, 0x64, 0x79, 0x22, 0x3a, 0x22, 0x50,
+    0x6c, 0x65, 0x61, 0x73, 0x65, 0x20, 0x72, 0x65, 0x76, 0x69, 0x65, 0x77, 0x20, 0x74, 0x68, 0x65,
+    0x20, 0x75, 0x70, 0x64, 0x61, 0x74, 0x65, 0x64, 0x20, 0x72, 0x6f, 0x74, 0x61, 0x20, 0x6f, 0x6e,
+    0x20, 0x74, 0x68, 0x65, 0x20, 0x73, 0x74, 0x61, 0x66, 0x66, 0x20, 0x62, 0x6f, 0x61, 0x72, 0x64,
+    0x20, 0x62, 0x65, 0x66, 0x6f, 0x72, 0x65, 0x20, 0x63, 0x6c, 0x6f, 0x63, 0x6b, 0x69, 0x6e, 0x67,
+    0x20, 0x69, 0x6e, 0x2e, 0x20, 0x42, 0x72, 0x65, 0x61, 0x6b, 0x73, 0x20, 0x61, 0x72, 0x65, 0x20,
+    0x73, 0x74, 0x61, 0x67, 0x67, 0x65, 0x72, 0x65, 0x64, 0x20, 0x61, 0x63, 0x72, 0x6f, 0x73, 0x73,
+    0x20, 0x74, 0x68, 0x65, 0x20, 0x74, 0x65, 0x61, 0x6d, 0x3b, 0x20, 0x63, 0x68, 0x65, 0x63, 0x6b,
+    0x20, 0x79, 0x6f, 0x75, 0x72, 0x20, 0x73, 0x6c, 0x6f, 0x74, 0x20, 0x77, 0x69, 0x74, 0x68, 0x20,
+    0x74, 0x68, 0x65, 0x20, 0x73, 0x68, 0x69, 0x66, 0x74, 0x20, 0x6c, 0x65, 0x61, 0x64, 0x2e, 0x20,
+    0x22, 0x2c, 0x22, 0x69, 0x6d, 0x61, 0x67, 0x65, 0x5f, 0x75, 0x72, 0x6c, 0x22, 0x3a, 0x22, 0x68,
+    0x74, 0x74, 0x70, 0x73, 0x3a, 0x2f, 0x2f, 0x69, 0x6d, 0x73, 0x2e, 0x70, 0x69, 0x79, 0x61, 0x6d,
+    0x74, 0x72, 0x61, 0x76, 0x65, 0x6c, 0x2e, 0x63, 0x6f, 0x6d, 0x2f, 0x73, 0x74, 0x6f, 0x72, 0x61,
+    0x67, 0x65, 0x2f, 0x6e, 0x6f, 0x74, 0x69, 0x63, 0x65, 0x73, 0x2f, 0x30, 0x2e, 0x70, 0x6e, 0x67,
+    0x22, 0x2c, 0x22, 0x68, 0x79, 0x70, 0x65, 0x72, 0x6c, 0x69, 0x6e, 0x6b, 0x5f, 0x75, 0x72, 0x6c,
+    0x22, 0x3a, 0x22, 0x68, 0x74, 0x74, 0x70, 0x73, 0x3a, 0x2f, 0x2f, 0x69, 0x6d, 0x73, 0x2e, 0x70,
+    0x69, 0x79, 0x61, 0x6d, 0x74, 0x72, 0x61, 0x76, 0x65, 0x6c, 0x2e, 0x63, 0x6f, 0x6d, 0x2f, 0x6e,
+    0x6f, 0x74, 0x69, 0x63, 0x65, 0x73, 0x2f, 0x30, 0x22, 0x2c, 0x22, 0x64, 0x69, 0x73, 0x70, 0x6c,
+    0x61, 0x79, 0x5f, 0x73, 0x65, 0x63, 0x6f, 0x6e, 0x64, 0x73, 0x22, 0x3a, 0x38, 0x2c, 0x22, 0x73,
+    0x6f, 0x72, 0x74, 0x5f, 0x6f, 0x72, 0x64, 0x65, 0x72, 0x22, 0x3a, 0x30, 0x2c, 0x22, 0x63, 0x72,
+    0x65, 0x61, 0x74, 0x65, 0x64, 0x5f, 0x61, 0x74, 0x22, 0x3a, 0x22, 0x32, 0x30, 0x32, 0x36, 0x2d,
+    0x30, 0x33, 0x2d, 0x30, 0x31, 0x54, 0x30, 0x38, 0x3a, 0x30, 0x30, 0x3a, 0x30, 0x30, 0x5a, 0x22,
+    0x2c, 0x22, 0x75, 0x70, 0x64, 0x61, 0x74, 0x65, 0x64, 0x5f, 0x61, 0x74, 0x22, 0x3a, 0x22, 0x32,
+    0x30, 0x32, 0x36, 0x2d, 0x30, 0x33, 0x2d, 0x30, 0x32, 0x54, 0x30, 0x39, 0x3a, 0x33, 0x30, 0x3a,
+    0x30, 0x30, 0x5a, 0x22, 0x7d, 0x2c, 0x7b, 0x22, 0x69, 0x64, 0x22, 0x3a, 0x22, 0x37, 0x64, 0x31,
+    0x63, 0x30, 0x30, 0x30, 0x31, 0x2d, 0x32, 0x66, 0x33, 0x62, 0x2d, 0x34, 0x63, 0x37, 0x65, 0x2d,
+    0x39, 0x61, 0x35, 0x31, 0x2d, 0x30, 0x30, 0x30, 0x30, 0x30, 0x30, 0x30, 0x30, 0x30, 0x30, 0x30,
+    0x31, 0x22, 0x2c, 0x22, 0x74, 0x69, 0x74, 0x6c, 0x65, 0x22, 0x3a, 0x22, 0x46, 0x69, 0x72, 0x65,
+    0x20, 0x64, 0x72, 0x69, 0x6c, 0x6c, 0x20, 0x28, 0x32, 0x29, 0x22, 0x2c, 0x22, 0x62, 0x6f, 0x64,
+    0x79, 0x22, 0x3a, 0x22, 0x50, 0x6c, 0x65, 0x61, 0x73, 0x65, 0x20, 0x72, 0x65, 0x76, 0x69, 0x65,
+    0x77, 0x20, 0x74, 0x68, 0x65, 0x20, 0x75, 0x70, 0x64, 0x61, 0x74, 0x65, 0x64, 0x20, 0x72, 0x6f,
+    0x74, 0x61, 0x20, 0x6f, 0x6e, 0x20, 0x74, 0x68, 0x65, 0x20, 0x73, 0x74, 0x61, 0x66, 0x66, 0x20,
+    0x62, 0x6f, 0x61, 0x72, 0x64, 0x20, 0x62, 0x65, 0x66, 0x6f, 0x72, 0x65, 0x20, 0x63, 0x6c, 0x6f,
+    0x63, 0x6b, 0x69, 0x6e, 0x67, 0x20, 0x69, 0x6e, 0x2e, 0x20, 0x42, 0x72, 0x65, 0x61, 0x6b, 0x73,
+    0x20, 0x61, 0x72, 0x65, 0x20, 0x73, 0x74, 0x61, 0x67, 0x67, 0x65, 0x72, 0x65, 0x64, 0x20, 0x61,
+    0x63, 0x72, 0x6f, 0x73, 0x73, 0x20, 0x74, 0x68, 0x65, 0x20, 0x74, 0x65, 0x61, 0x6d, 0x3b, 0x20,
+    0x63, 0x68, 0x65, 0x63, 0x6b, 0x20, 0x79, 0x6f, 0x75, 0x72, 0x20, 0x73, 0x6c, 0x6f, 0x74, 0x20,
+    0x77, 0x69, 0x74, 0x68, 0x20, 0x74, 0x68, 0x65, 0x20, 0x73, 0x68, 0x69, 0x66, 0x74, 0x20, 0x6c,
+    0x65, 0x61, 0x64, 0x2e, 0x20, 0x50, 0x6c, 0x65, 0x61, 0x73, 0x65, 0x20, 0x72, 0x65, 0x76, 0x69,
+    0x65, 0x77, 0x20, 0x74, 0x68, 0x65, 0x20, 0x75, 0x70, 0x64, 0x61, 0x74, 0x65, 0x64, 0x20, 0x72,
+    0x6f, 0x74, 0x61, 0x20, 0x6f, 0x6e, 0x20, 0x74, 0x68, 0x65, 0x20, 0x73, 0x74, 0x61, 0x66, 0x66,
+    0x20, 0x62, 0x6f, 0x61, 0x72, 0x64, 0x20, 0x62, 0x65, 0x66, 0x6f, 0x72, 0x65, 0x20, 0x63, 0x6c,
+    0x6f, 0x63, 0x6b, 0x69, 0x6e, 0x67, 0x20, 0x69, 0x6e, 0x2e, 0x20, 0x42, 0x72, 0x65, 0x61, 0x6b,
+    0x73, 0x20, 0x61, 0x72, 0x65, 0x20, 0x73, 0x74, 0x61, 0x67, 0x67, 0x65, 0x72, 0x65, 0x64, 0x20,
+    0x61, 0x63, 0x72, 0x6f, 0x73, 0x73, 0x20, 0x74, 0x68, 0x65, 0x20, 0x74, 0x65, 0x61, 0x6d, 0x3b,
+    0x20, 0x63, 0x68, 0x65, 0x63, 0x6b, 0x20, 0x79, 0x6f, 0x75, 0x72, 0x20, 0x73, 0x6c, 0x6f, 0x74,
+    0x20, 0x77, 0x69, 0x74, 0x68, 0x20, 0x74, 0x68, 0x65, 0x20, 0x73, 0x68, 0x69, 0x66, 0x74, 0x20,
+    0x6c, 0x65, 0x61, 0x64, 0x2e, 0x20, 0x22, 0x2c, 0x22, 0x69, 0x6d, 0x61, 0x67, 0x65, 0x5f, 0x75,
+    0x72, 0x6c, 0x22, 0x3a, 0x22, 0x22, 0x2c, 0x22, 0x68, 0x79, 0x70, 0x65, 0x72, 0x6c, 0x69, 0x6e,
+    0x6b, 0x5f, 0x75, 0x72, 0x6c, 0x22, 0x3a, 0x22, 0x68, 0x74, 0x74, 0x70, 0x73, 0x3a, 0x2f, 0x2f,
+    0x69, 0x6d, 0x73, 0x2e, 0x70, 0x69, 0x79, 0x61, 0x6d, 0x74, 0x72, 0x61, 0x76, 0x65, 0x6c, 0x2e,
+    0x63, 0x6f, 0x6d, 0x2f, 0x6e, 0x6f, 0x74, 0x69, 0x63, 0x65, 0x73, 0x2f, 0x31, 0x22, 0x2c, 0x22,
+    0x64, 0x69, 0x73, 0x70, 0x6c, 0x61, 0x79, 0x5f, 0x73, 0x65, 0x63, 0x6f, 0x6e, 0x64, 0x73, 0x22,
+    0x3a, 0x38, 0x2c, 0x22, 0x73, 0x6f, 0x72, 0x74, 0x5f, 0x6f, 0x72, 0x64, 0x65, 0x72, 0x22, 0x3a,
+    0x31, 0x2c, 0x22, 0x63, 0x72, 0x65, 0x61, 0x74, 0x65, 0x64, 0x5f, 0x61, 0x74, 0x22, 0x3a, 0x22,
+    0x32, 0x30, 0x32, 0x36, 0x2d, 0x30, 0x33, 0x2d, 0x30, 0x32, 0x54, 0x30, 0x38, 0x3a, 0x30, 0x30,
+    0x3a, 0x30, 0x30, 0x5a, 0x22, 0x2c, 0x22, 0x75, 0x70, 0x64, 0x61, 0x74, 0x65, 0x64, 0x5f, 0x61,
+    0x74, 0x22, 0x3a, 0x22, 0x32, 0x30, 0x32, 0x36, 0x2d, 0x30, 0x33, 0x2d, 0x30, 0x33, 0x54, 0x30,
+    0x39, 0x3a, 0x33, 0x30, 0x3a, 0x30, 0x30, 0x5a, 0x22, 0x7d, 0x2c, 0x7b, 0x22, 0x69, 0x64, 0x22,
+    0x3a, 0x22, 0x37, 0x64, 0x31, 0x63, 0x30, 0x30, 0x30, 0x32, 0x2d, 0x32, 0x66, 0x33, 0x62, 0x2d,
+    0x34, 0x63, 0x37, 0x65, 0x2d, 0x39, 0x61, 0x35, 0x31, 0x2d, 0x30, 0x30, 0x30, 0x30, 0x30, 0x30,
+    0x30, 0x30, 0x30, 0x30, 0x30, 0x32, 0x22, 0x2c, 0x22, 0x74, 0x69, 0x74, 0x6c, 0x65, 0x22, 0x3a,
+    0x22, 0x48, 0x6f, 0x6c, 0x69, 0x64, 0x61, 0x79, 0x20, 0x68, 0x6f, 0x75, 0x72, 0x73, 0x20, 0x28,
+    0x33, 0x29, 0x22, 0x2c, 0x22, 0x62, 0x6f, 0x64, 0x79, 0x22, 0x3a, 0x22, 0x50, 0x6c, 0x65, 0x61,
+    0x73, 0x65, 0x20, 0x72, 0x65, 0x76, 0x69, 0x65, 0x77, 0x20, 0x74, 0x68, 0x65, 0x20, 0x75, 0x70,
+    0x64, 0x61, 0x74, 0x65, 0x64, 0x20, 0x72, 0x6f, 0x74, 0x61, 0x20, 0x6f, 0x6e, 0x20, 0x74, 0x68,
+    0x65, 0x20, 0x73, 0x74, 0x61, 0x66, 0x66, 0x20, 0x62, 0x6f, 0x61, 0x72, 0x64, 0x20, 0x62, 0x65,
+    0x66, 0x6f, 0x72, 0x65, 0x20, 0x63, 0x6c, 0x6f, 0x63, 0x6b, 0x69, 0x6e, 0x67, 0x20, 0x69, 0x6e,
+    0x2e, 0x20, 0x42, 0x72, 0x65, 0x61, 0x6b, 0x73, 0x20, 0x61, 0x72, 0x65, 0x20, 0x73, 0x74, 0x61,
+    0x67, 0x67, 0x65, 0x72, 0x65, 0x64, 0x20, 0x61, 0x63, 0x72, 0x6f, 0x73, 0x73, 0x20, 0x74, 0x68,
+    0x65, 0x20, 0x74, 0x65, 0x61, 0x6d, 0x3b, 0x20, 0x63, 0x68, 0x65, 0x63, 0x6b, 0x20, 0x79, 0x6f,
+    0x75, 0x72, 0x20, 0x73, 0x6c, 0x6f, 0x74, 0x20, 0x77, 0x69, 0x74, 0x68, 0x20, 0x74, 0x68, 0x65,
+    0x20, 0x73, 0x68, 0x69, 0x66, 0x74, 0x20, 0x6c, 0x65, 0x61, 0x64, 0x2e, 0x20, 0x50, 0x6c, 0x65,
+    0x61, 0x73, 0x65, 0x20, 0x72, 0x65, 0x76, 0x69, 0x65, 0x77, 0x20, 0x74, 0x68, 0x65, 0x20, 0x75,
+    0x70, 0x64, 0x61, 0x74, 0x65, 0x64, 0x20, 0x72, 0x6f, 0x74, 0x61, 0x20, 0x6f, 0x6e, 0x20, 0x74,
+    0x68, 0x65, 0x20, 0x73, 0x74, 0x61, 0x66, 0x66, 0x20, 0x62, 0x6f, 0x61, 0x72, 0x64, 0x20, 0x62,
+    0x65, 0x66, 0x6f, 0x72, 0x65, 0x20, 0x63, 0x6c, 0x6f, 0x63, 0x6b, 0x69, 0x6e, 0x67, 0x20, 0x69,
+    0x6e, 0x2e, 0x20, 0x42, 0x72, 0x65, 0x61, 0x6b, 0x73, 0x20, 0x61, 0x72, 0x65, 0x20, 0x73, 0x74,
+    0x61, 0x67, 0x67, 0x65, 0x72, 0x65, 0x64, 0x20, 0x61, 0x63, 0x72, 0x6f, 0x73, 0x73, 0x20, 0x74,
+    0x68, 0x65, 0x20, 0x74, 0x65, 0x61, 0x6d, 0x3b, 0x20, 0x63, 0x68, 0x65, 0x63, 0x6b, 0x20, 0x79,
+    0x6f, 0x75, 0x72, 0x20, 0x73, 0x6c, 0x6f, 0x74, 0x20, 0x77, 0x69, 0x74, 0x68, 0x20, 0x74, 0x68,
+    0x65, 0x20, 0x73, 0x68, 0x69, 0x66, 0x74, 0x20, 0x6c, 0x65, 0x61, 0x64, 0x2e, 0x20, 0x50, 0x6c,
+    0x65, 0x61, 0x73, 0x65, 0x20, 0x72, 0x65, 0x76, 0x69, 0x65, 0x77, 0x20, 0x74, 0x68, 0x65, 0x20,
+    0x75, 0x70, 0x64, 0x61, 0x74, 0x65, 0x64, 0x20, 0x72, 0x6f, 0x74, 0x61, 0x20, 0x6f, 0x6e, 0x20,
+    0x74, 0x68, 0x65, 0x20, 0x73, 0x74, 0x61, 0x66, 0x66, 0x20, 0x62, 0x6f, 0x61, 0x72, 0x64, 0x20,
+    0x62, 0x65, 0x66, 0x6f, 0x72, 0x65, 0x20, 0x63, 0x6c, 0x6f, 0x63, 0x6b, 0x69, 0x6e, 0x67, 0x20,
+    0x69, 0x6e, 0x2e, 0x20, 0x42, 0x72, 0x65, 0x61, 0x6b, 0x73, 0x20, 0x61, 0x72, 0x65, 0x20, 0x73,
+    0x74, 0x61, 0x67, 0x67, 0x65, 0x72, 0x65, 0x64, 0x20, 0x61, 0x63, 0x72, 0x6f, 0x73, 0x73, 0x20,
+    0x74, 0x68, 0x65, 0x20, 0x74, 0x65, 0x61, 0x6d, 0x3b, 0x20, 0x63, 0x68, 0x65, 0x63, 0x6b, 0x20,
+    0x79, 0x6f, 0x75, 0x72, 0x20, 0x73, 0x6c, 0x6f, 0x74, 0x20, 0x77, 0x99, 0x18, 0xf0, 0xc4, 0xdc,
+    0x05, 0x00, 0x00,
+};
+
+constexpr uint8_t kNoticesGzipW512[] = {
+    0x1f, 0x8b, 0x08, 0x00, 0x00, 0x00, 0x00, 0x00, 0x02, 0x03, 0xed, 0x8f, 0x41, 0x6f, 0xeb, 0xba,
+    0x11, 0x85, 0xff, 0xca, 0x80, 0xab, 0x04, 0xb0, 0x24, 0x5a, 0xb2, 0x63, 0x5b, 0xd9, 0x65, 0x51,
+    0x74, 0x19, 0x14, 0xee, 0x26, 0x5d, 0x08, 0x14, 0x39, 0x92, 0x08, 0x51, 0xa2, 0x30, 0x1c, 0xdb,
+    0x10, 0x82, 0xfc, 0xf7, 0xce, 0xb5, 0x83, 0x77, 0xbb, 0x08, 0xd0, 0x07, 0x74, 0xf3, 0x16, 0x1d,
+    0x70, 0xc3, 0x39, 0xe7, 0x7c, 0x38, 0xf3, 0xaf, 0x4f, 0xe5, 0x9d, 0xaa, 0xd5, 0xc1, 0x6d, 0xad,
+    0x96, 0xc9, 0xca, 0xae, 0x6a, 0xb3, 0x9d, 0x3d, 0x60, 0x76, 0x32, 0xfb, 0x6d, 0xa6, 0xff, 0x63,
+    0xd4, 0x46, 0xb1, 0xe7, 0x80, 0x62, 0xff, 0x47, 0x64, 0x03, 0x97, 0xc5, 0x19, 0x46, 0x78, 0xda,
+    0x3e, 0x8b, 0xd2, 0x46, 0xb7, 0x8a, 0xf0, 0x1e, 0xd0, 0x24, 0x04, 0xc2, 0xab, 0xc7, 0x1b, 0xf0,
+    0x80, 0xdf, 0x2e, 0x07, 0xf4, 0x2b, 0x12, 0xe7, 0xfb, 0x2e, 0xb1, 0xe9, 0x3a, 0x68, 0xa3, 0x21,
+    0x07, 0x2d, 0x76, 0x91, 0x10, 0x6c, 0x88, 0x76, 0xf4, 0x73, 0x0f, 0x7e, 0xce, 0xe1, 0x8d, 0xd0,
+    0x8c, 0x09, 0x0c, 0xdd, 0xad, 0x7d, 0x8f, 0x24, 0x00, 0x63, 0x29, 0xa6, 0x74, 0xcf, 0x33, 0x9a,
+    0xe9, 0x15, 0xec, 0x80, 0x76, 0x84, 0x35, 0x5e, 0x08, 0x52, 0x88, 0x0c, 0x37, 0xcf, 0xc3, 0x03,
+    0x3f, 0xf8, 0x8e, 0x41, 0x9a, 0xb8, 0x1c, 0xa4, 0x9a, 0x9f, 0x4c, 0x8f, 0xcd, 0x85, 0x82, 0xf4,
+    0x1b, 0x98, 0x97, 0x54, 0x17, 0x85, 0x9f, 0x52, 0xbe, 0xf8, 0xd5, 0x4c, 0x4c, 0xe6, 0x8a, 0x21,
+    0xb7, 0x71, 0x2a, 0x12, 0x47, 0x12, 0x67, 0x31, 0x47, 0xf6, 0x16, 0x53, 0xa1, 0xf3, 0x65, 0xee,
+    0x25, 0x3f, 0xac, 0x0b, 0x52, 0xf0, 0xf3, 0xf8, 0x27, 0x18, 0x7f, 0x64, 0x25, 0xe7, 0x7c, 0x5a,
+    0x82, 0x59, 0x9b, 0x84, 0x36, 0xce, 0x2e, 0xa9, 0xfa, 0xb8, 0x51, 0x29, 0x12, 0x37, 0x91, 0x1c,
+    0x92, 0xaa, 0xf5, 0x46, 0x59, 0x39, 0x94, 0xd1, 0x35, 0x86, 0x85, 0x5b, 0xea, 0xf2, 0x25, 0xd3,
+    0x55, 0xa6, 0xb7, 0x67, 0x7d, 0xac, 0xb5, 0x96, 0xf7, 0x21, 0x98, 0xcb, 0xe2, 0x7e, 0xf0, 0x94,
+    0x67, 0x7d, 0xaa, 0xab, 0x87, 0xe7, 0x6b, 0xf3, 0xa9, 0xbc, 0x13, 0xf5, 0xe0, 0xb6, 0x56, 0x6b,
+    0xbd, 0xcd, 0xca, 0xae, 0x6a, 0xb3, 0x9d, 0x3d, 0x60, 0x76, 0x32, 0xfb, 0x6d, 0xa6, 0x7f, 0xcf,
+    0x56, 0x88, 0xec, 0x39, 0xa0, 0xd8, 0xff, 0xe6, 0x09, 0xc1, 0x91, 0x0f, 0x01, 0x9e, 0xca, 0x67,
+    0x11, 0xda, 0xe8, 0x56, 0xd9, 0xbf, 0x07, 0x34, 0x09, 0x81, 0xf0, 0xea, 0xf1, 0x06, 0x3c, 0x20,
+    0x7c, 0x77, 0x00, 0x8a, 0x6c, 0x20, 0xce, 0xf7, 0x5d, 0x62, 0xd3, 0x75, 0xd0, 0x46, 0x43, 0x0e,
+    0x5a, 0xec, 0xa2, 0xb0, 0x6c, 0x88, 0x76, 0xf4, 0x73, 0x0f, 0x7e, 0xce, 0xe1, 0x4d, 0x6e, 0x1b,
+    0x13, 0x18, 0xba, 0x5b, 0xfb, 0x1e, 0x49, 0x00, 0xc6, 0x52, 0x4c, 0xe9, 0x9e, 0x67, 0x34, 0xd3,
+    0x2b, 0xd8, 0x01, 0xed, 0x08, 0x6b, 0xbc, 0x10, 0xa4, 0x10, 0x19, 0x6e, 0x9e, 0x87, 0x07, 0x7e,
+    0xf0, 0x1d, 0x83, 0x34, 0x71, 0x39, 0xfc, 0xe5, 0x0a, 0xa9, 0x8d, 0xf2, 0x93, 0xe9, 0xb1, 0xb9,
+    0x50, 0x50, 0xb5, 0x92, 0xef, 0xb0, 0x2e, 0x48, 0xc1, 0xcf, 0xe3, 0xf7, 0x6a, 0x60, 0x5e, 0x52,
+    0x5d, 0x14, 0x7e, 0x4a, 0xf9, 0xe2, 0x57, 0x33, 0x31, 0x99, 0x2b, 0x86, 0xdc, 0xc6, 0xa9, 0x98,
+    0x23, 0x7b, 0x8b, 0xa9, 0xd8, 0x4a, 0xce, 0xf9, 0xb4, 0x04, 0xb3, 0x36, 0x09, 0x6d, 0x9c, 0x5d,
+    0x52, 0xf5, 0x71, 0xa3, 0x52, 0x24, 0x6e, 0x22, 0x39, 0x24, 0x55, 0x6f, 0x37, 0xca, 0x4a, 0x6f,
+    0xb9, 0xb5, 0x31, 0x2c, 0xdc, 0x52, 0x97, 0x2f, 0x99, 0xae, 0x32, 0x5d, 0x9e, 0xf5, 0xb1, 0xd6,
+    0x5a, 0xde, 0x87, 0x60, 0x2e, 0x8b, 0xfb, 0xc1, 0x53, 0x9d, 0xf5, 0xa9, 0xae, 0x1e, 0x9e, 0xaf,
+    0xcd, 0xa7, 0xf2, 0x4e, 0xd4, 0x83, 0xdb, 0x5a, 0xad, 0x75, 0x99, 0x95, 0x5d, 0xd5, 0x66, 0x3b,
+    0x7b, 0xc0, 0xec, 0x64, 0xf6, 0xdb, 0x4c, 0xff, 0x9e, 0x52, 0x88, 0xec, 0x39, 0xa0, 0xd8, 0xff,
+    0x1e, 0x83, 0x77, 0x66, 0x85, 0x21, 0x5e, 0x28, 0xc1, 0x53, 0xf5, 0x2c, 0x5a, 0x1b, 0xdd, 0x2a,
+    0xd2, 0x7b, 0x40, 0x93, 0x10, 0x08, 0xaf, 0x1e, 0x6f, 0xc0, 0x03, 0xc2, 0x77, 0x0d, 0xa0, 0xc8,
+    0x06, 0xe2, 0x7c, 0xdf, 0x25, 0x36, 0x5d, 0x07, 0x6d, 0x34, 0xe4, 0xa0, 0xc5, 0x2e, 0x12, 0x82,
+    0x0d, 0xd1, 0x8e, 0x7e, 0xee, 0xc1, 0xcf, 0x39, 0xbc, 0xc9, 0x79, 0x63, 0x02, 0x43, 0x77, 0x6b,
+    0xdf, 0x23, 0x09, 0xc0, 0x58, 0x8a, 0x29, 0xdd, 0xf3, 0x8c, 0x66, 0x7a, 0x05, 0x3b, 0xa0, 0x1d,
+    0x61, 0x95, 0x12, 0x90, 0x42, 0x64, 0xb8, 0x79, 0x1e, 0x1e, 0xf8, 0xc1, 0x77, 0x0c, 0xd2, 0xc4,
+    0xe5, 0xf0, 0xff, 0x42, 0xff, 0xad, 0x90, 0xda, 0x28, 0x3f, 0x99, 0x1e, 0x9b, 0x0b, 0x05, 0x55,
+    0x2b, 0xf9, 0x0e, 0xeb, 0x82, 0x14, 0xfc, 0x3c, 0x7e, 0xaf, 0x06, 0xe6, 0x25, 0xd5, 0x45, 0xe1,
+    0xa7, 0x94, 0x2f, 0x7e, 0x35, 0x13, 0x93, 0xb9, 0x62, 0xc8, 0x6d, 0x9c, 0x8a, 0x39, 0xb2, 0xb7,
+    0x98, 0x8a, 0x52, 0x72, 0xce, 0xa7, 0x25, 0x98, 0xb5, 0x49, 0x68, 0xe3, 0xec, 0x92, 0xaa, 0x8f,
+    0x1b, 0x95, 0x22, 0x71, 0x13, 0xc9, 0x21, 0xa9, 0xba, 0xdc, 0x28, 0x2b, 0xbd, 0xe5, 0xd6, 0xc6,
+    0xb0, 0x70, 0x4b, 0x5d, 0xbe, 0x64, 0xba, 0x92, 0x77, 0xd6, 0xc7, 0x5a, 0x6b, 0x79, 0x1f, 0x82,
+    0xb9, 0x2c, 0xee, 0x07, 0xcf, 0xee, 0xac, 0x4f, 0x75, 0xf5, 0xf0, 0x7c, 0x6d, 0x3e, 0x95, 0x77,
+    0xa2, 0x1e, 0xdc, 0xd6, 0x6a, 0x2d, 0x72, 0xd9, 0x55, 0x6d, 0xb6, 0xb3, 0x07, 0xcc, 0x4e, 0x66,
+    0xbf, 0xcd, 0xf4, 0xef, 0xa9, 0x84, 0xc8, 0x9e, 0x03, 0x8a, 0xfd, 0x9f, 0xb3, 0xef, 0x22, 0x4d,
+    0x40, 0x38, 0xf9, 0x59, 0x2a, 0xc1, 0xd3, 0xee, 0x59, 0xe4, 0x36, 0xba, 0x55, 0xd4, 0xf7, 0x80,
+    0x26, 0xa1, 0x88, 0x57, 0x8f, 0x37, 0xe0, 0x01, 0xe1, 0xbb, 0x09, 0x50, 0x64, 0x03, 0x71, 0xbe,
+    0xef, 0x12, 0x9b, 0xae, 0x83, 0x36, 0x1a, 0x72, 0xd0, 0xa2, 0xe0, 0x10, 0x6c, 0x88, 0x76, 0xf4,
+    0x73, 0x0f, 0x7e, 0xce, 0xe1, 0x4d, 0x2e, 0x1c, 0x13, 0x18, 0xba, 0x5b, 0xfb, 0x1e, 0x49, 0x00,
+    0xc6, 0x52, 0x4c, 0xe9, 0x9e, 0x67, 0x34, 0xd3, 0x2b, 0xd8, 0x01, 0xed, 0x08, 0x6b, 0xbc, 0x10,
+    0xa4, 0x10, 0x19, 0x6e, 0x9e, 0x87, 0x07, 0x7e, 0xf0, 0x1d, 0x83, 0x34, 0x71, 0x39, 0x48, 0x35,
+    0x3f, 0x99, 0x1e, 0x9b, 0x0b, 0x05, 0xe9, 0x27, 0xdf, 0x61, 0x5d, 0x90, 0x82, 0x9f, 0xc7, 0xef,
+    0xd5, 0xc0, 0xbc, 0xa4, 0xba, 0x28, 0xfc, 0x94, 0xf2, 0xc5, 0xaf, 0x66, 0x62, 0x32, 0x57, 0x0c,
+    0xb9, 0x8d, 0x53, 0x31, 0x47, 0xf6, 0x16, 0x53, 0x51, 0x49, 0xce, 0xf9, 0xb4, 0x04, 0xb3, 0x36,
+    0x09, 0x6d, 0x9c, 0x5d, 0x52, 0xf5, 0x71, 0xa3, 0x52, 0x24, 0x6e, 0x22, 0x39, 0x24, 0x55, 0x57,
+    0x1b, 0x65, 0xa5, 0xb7, 0xdc, 0xda, 0x18, 0x16, 0x6e, 0xa9, 0xcb, 0x97, 0x4c, 0x57, 0x99, 0xde,
+    0x9d, 0xf5, 0xb1, 0xd6, 0x5a, 0xde, 0x87, 0x60, 0x2e, 0x8b, 0xfb, 0xc1, 0xb3, 0x3f, 0xeb, 0x53,
+    0x5d, 0x3d, 0x3c, 0x5f, 0x9b, 0x4f, 0xe5, 0x9d, 0xa8, 0x07, 0xb7, 0xb5, 0x5a, 0xeb, 0x5d, 0x56,
+    0x76, 0x55, 0x9b, 0xed, 0xec, 0x01, 0xb3, 0x93, 0xd9, 0x6f, 0x33, 0xfd, 0x7b, 0x76, 0x42, 0x64,
+    0xcf, 0x01, 0xc5, 0xfe, 0x6e, 0x68, 0xf4, 0x73, 0x0f, 0x76, 0x30, 0x73, 0x8f, 0x09, 0x9e, 0xf6,
+    0xcf, 0xa2, 0xb6, 0xd1, 0xad, 0xbf, 0xc4, 0x80, 0x26, 0x21, 0x10, 0x5e, 0x3d, 0xde, 0x80, 0x07,
+    0x84, 0xef, 0x22, 0x40, 0x91, 0x0d, 0xc4, 0xf9, 0xbe, 0x4b, 0x6c, 0xba, 0x0e, 0xda, 0x68, 0xc8,
+    0x41, 0x8b, 0x5d, 0x24, 0x04, 0x1b, 0xa2, 0xbd, 0x63, 0xfd, 0x9c, 0xc3, 0x9b, 0x1c, 0x38, 0x26,
+    0x30, 0x74, 0xb7, 0xf6, 0x3d, 0x92, 0x00, 0x8c, 0xa5, 0x98, 0xd2, 0x3d, 0xcf, 0x68, 0xa6, 0x57,
+    0x29, 0x80, 0x76, 0x84, 0x35, 0x5e, 0x08, 0x52, 0x88, 0x0c, 0x37, 0xcf, 0xc3, 0x03, 0x3f, 0xf8,
+    0x8e, 0x41, 0x9a, 0xb8, 0x1c, 0xfe, 0x72, 0x85, 0xd4, 0x46, 0xf9, 0xc9, 0xf4, 0xd8, 0x5c, 0x28,
+    0xa8, 0x5a, 0x0d, 0xcc, 0x4b, 0xaa, 0x8b, 0xc2, 0x4f, 0x29, 0x5f, 0xfc, 0x6a, 0x26, 0x26, 0x73,
+    0xc5, 0x90, 0xdb, 0x38, 0x15, 0x89, 0x23, 0x89, 0xb3, 0x98, 0x23, 0x7b, 0x8b, 0xa9, 0xd8, 0xe5,
+    0xcb, 0xdc, 0x4b, 0x7e, 0x58, 0x17, 0xa4, 0xe0, 0xe7, 0xf1, 0x4f, 0x30, 0xfe, 0xc8, 0x4a, 0xce,
+    0xf9, 0xb4, 0x04, 0xb3, 0x36, 0x09, 0x6d, 0x9c, 0x5d, 0x52, 0xf5, 0x71, 0xa3, 0x52, 0x24, 0x6e,
+    0x22, 0x39, 0x24, 0x55, 0xef, 0x36, 0xca, 0xca, 0xa1, 0x8c, 0xae, 0x31, 0x2c, 0xdc, 0x52, 0x97,
+    0x2f, 0x99, 0xae, 0x32, 0xbd, 0x3f, 0xeb, 0x63, 0xad, 0xb5, 0xbc, 0x0f, 0xc1, 0x5c, 0x16, 0xf7,
+    0x83, 0xe7, 0xe5, 0xac, 0x4f, 0x75, 0xf5, 0xf0, 0x7c, 0x6d, 0x3e, 0x95, 0x77, 0xa2, 0x1e, 0xdc,
+    0xd6, 0x6a, 0xad, 0xf7, 0x59, 0xd9, 0x55, 0x6d, 0xb6, 0xb3, 0x07, 0xcc, 0x4e, 0x66, 0xbf, 0xcd,
+    0xf4, 0xef, 0xd9, 0x0b, 0x91, 0x3d, 0x07, 0x14, 0xfb, 0x19, 0xcd, 0x04, 0x2d, 0x79, 0xec, 0xfc,
+    0xdc, 0xc3, 0xd3, 0xcb, 0xb3, 0x68, 0x6d, 0x74, 0xab, 0x48, 0xef, 0x01, 0x4d, 0x42, 0x20, 0xbc,
+    0x7a, 0xbc, 0x01, 0x0f, 0x08, 0xdf, 0x35, 0x80, 0x22, 0x1b, 0x88, 0xf3, 0x7d, 0x97, 0xd8, 0x74,
+    0x1d, 0xb4, 0xd1, 0x90, 0x83, 0x16, 0xbb, 0x48, 0x08, 0x36, 0x44, 0x3b, 0xfe, 0xc2, 0xf9, 0x39,
+    0x87, 0x37, 0x39, 0x6f, 0x4c, 0x60, 0xe8, 0x6e, 0xed, 0x7b, 0x24, 0x01, 0x18, 0x4b, 0x31, 0xa5,
+    0x7b, 0x9e, 0xa5, 0xc0, 0x2b, 0xd8, 0x01, 0xed, 0x08, 0x6b, 0xbc, 0x10, 0xa4, 0x10, 0x19, 0x6e,
+    0x9e, 0x87, 0x07, 0x7e, 0xf0, 0x1d, 0x83, 0x34, 0x71, 0x39, 0xfc, 0x2f, 0x85, 0xfe, 0x0d, 0xe7,
+    0xb8, 0xd6, 0x2b, 0xb8, 0x0b, 0x00, 0x00,
+};
+
+constexpr uint8_t kNoticesZlibW512[] = {
+    0x18, 0xd3, 0xed, 0x8f, 0x41, 0x6f, 0xeb, 0xba, 0x11, 0x85, 0xff, 0xca, 0x80, 0xab, 0x04, 0xb0,
+    0x24, 0x5a, 0xb2, 0x63, 0x5b, 0xd9, 0x65, 0x51, 0x74, 0x19, 0x14, 0xee, 0x26, 0x5d, 0x08, 0x14,
+    0x39, 0x92, 0x08, 0x51, 0xa2, 0x30, 0x1c, 0xdb, 0x10, 0x82, 0xfc, 0xf7, 0xce, 0xb5, 0x83, 0x77,
+    0xbb, 0x08, 0xd0, 0x07, 0x74, 0xf3, 0x16, 0x1d, 0x70, 0xc3, 0x39, 0xe7, 0x7c, 0x38, 0xf3, 0xaf,
+    0x4f, 0xe5, 0x9d, 0xaa, 0xd5, 0xc1, 0x6d, 0xad, 0x96, 0xc9, 0xca, 0xae, 0x6a, 0xb3, 0x9d, 0x3d,
+    0x60, 0x76, 0x32, 0xfb, 0x6d, 0xa6, 0xff, 0x63, 0xd4, 0x46, 0xb1, 0xe7, 0x80, 0x62, 0xff, 0x47,
+    0x64, 0x03, 0x97, 0xc5, 0x19, 0x46, 0x78, 0xda, 0x3e, 0x8b, 0xd2, 0x46, 0xb7, 0x8a, 0xf0, 0x1e,
+    0xd0, 0x24, 0x04, 0xc2, 0xab, 0xc7, 0x1b, 0xf0, 0x80, 0xdf, 0x2e, 0x07, 0xf4, 0x2b, 0x12, 0xe7,
+    0xfb, 0x2e, 0xb1, 0xe9, 0x3a, 0x68, 0xa3, 0x21, 0x07, 0x2d, 0x76, 0x91, 0x10, 0x6c, 0x88, 0x76,
+    0xf4, 0x73, 0x0f, 0x7e, 0xce, 0xe1, 0x8d, 0xd0, 0x8c, 0x09, 0x0c, 0xdd, 0xad, 0x7d, 0x8f, 0x24,
+    0x00, 0x63, 0x29, 0xa6, 0x74, 0xcf, 0x33, 0x9a, 0xe9, 0x15, 0xec, 0x80, 0x76, 0x84, 0x35, 0x5e,
+    0x08, 0x52, 0x88, 0x0c, 0x37, 0xcf, 0xc3, 0x03, 0x3f, 0xf8, 0x8e, 0x41, 0x9a, 0xb8, 0x1c, 0xa4,
+    0x9a, 0x9f, 0x4c, 0x8f, 0xcd, 0x85, 0x82, 0xf4, 0x1b, 0x98, 0x97, 0x54, 0x17, 0x85, 0x9f, 0x52,
+    0xbe, 0xf8, 0xd5, 0x4c, 0x4c, 0xe6, 0x8a, 0x21, 0xb7, 0x71, 0x2a, 0x12, 0x47, 0x12, 0x67, 0x31,
+    0x47, 0xf6, 0x16, 0x53, 0xa1, 0xf3, 0x65, 0xee, 0x25, 0x3f, 0xac, 0x0b, 0x52, 0xf0, 0xf3, 0xf8,
+    0x27, 0x18, 0x7f, 0x64, 0x25, 0xe7, 0x7c, 0x5a, 0x82, 0x59, 0x9b, 0x84, 0x36, 0xce, 0x2e, 0xa9,
+    0xfa, 0xb8, 0x51, 0x29, 0x12, 0x37, 0x91, 0x1c, 0x92, 0xaa, 0xf5, 0x46, 0x59, 0x39, 0x94, 0xd1,
+    0x35, 0x86, 0x85, 0x5b, 0xea, 0xf2, 0x25, 0xd3, 0x55, 0xa6, 0xb7, 0x67, 0x7d, 0xac, 0xb5, 0x96,
+    0xf7, 0x21, 0x98, 0xcb, 0xe2, 0x7e, 0xf0, 0x94, 0x67, 0x7d, 0xaa, 0xab, 0x87, 0xe7, 0x6b, 0xf3,
+    0xa9, 0xbc, 0x13, 0xf5, 0xe0, 0xb6, 0x56, 0x6b, 0xbd, 0xcd, 0xca, 0xae, 0x6a, 0xb3, 0x9d, 0x3d,
+    0x60, 0x76, 0x32, 0xfb, 0x6d, 0xa6, 0x7f, 0xcf, 0x56, 0x88, 0xec, 0x39, 0xa0, 0xd8, 0xff, 0xe6,
+    0x09, 0xc1, 0x91, 0x0f, 0x01, 0x9e, 0xca, 0x67, 0x11, 0xda, 0xe8, 0x56, 0xd9, 0xbf, 0x07, 0x34,
+    0x09, 0x81, 0xf0, 0xea, 0xf1, 0x06, 0x3c, 0x20, 0x7c, 0x77, 0x00, 0x8a, 0x6c, 0x20, 0xce, 0xf7,
+    0x5d, 0x62, 0xd3, 0x75, 0xd0, 0x46, 0x43, 0x0e, 0x5a, 0xec, 0xa2, 0xb0, 0x6c, 0x88, 0x76, 0xf4,
+    0x73, 0x0f, 0x7e, 0xce, 0xe1, 0x4d, 0x6e, 0x1b, 0x13, 0x18, 0xba, 0x5b, 0xfb, 0x1e, 0x49, 0x00,
+    0xc6, 0x52, 0x4c, 0xe9, 0x9e, 0x67, 0x34, 0xd3, 0x2b, 0xd8, 0x01, 0xed, 0x08, 0x6b, 0xbc, 0x10,
+    0xa4, 0x10, 0x19, 0x6e, 0x9e, 0x87, 0x07, 0x7e, 0xf0, 0x1d, 0x83, 0x34, 0x71, 0x39, 0xfc, 0xe5,
+    0x0a, 0xa9, 0x8d, 0xf2, 0x93, 0xe9, 0xb1, 0xb9, 0x50, 0x50, 0xb5, 0x92, 0xef, 0xb0, 0x2e, 0x48,
+    0xc1, 0xcf, 0xe3, 0xf7, 0x6a, 0x60, 0x5e, 0x52, 0x5d, 0x14, 0x7e, 0x4a, 0xf9, 0xe2, 0x57, 0x33,
+    0x31, 0x99, 0x2b, 0x86, 0xdc, 0xc6, 0xa9, 0x98, 0x23, 0x7b, 0x8b, 0xa9, 0xd8, 0x4a, 0xce, 0xf9,
+    0xb4, 0x04, 0xb3, 0x36, 0x09, 0x6d, 0x9c, 0x5d, 0x52, 0xf5, 0x71, 0xa3, 0x52, 0x24, 0x6e, 0x22,
+    0x39, 0x24, 0x55, 0x6f, 0x37, 0xca, 0x4a, 0x6f, 0xb9, 0xb5, 0x31, 0x2c, 0xdc, 0x52, 0x97, 0x2f,
+    0x99, 0xae, 0x32, 0x5d, 0x9e, 0xf5, 0xb1, 0xd6, 0x5a, 0xde, 0x87, 0x60, 0x2e, 0x8b, 0xfb, 0xc1,
+    0x53, 0x9d, 0xf5, 0xa9, 0xae, 0x1e, 0x9e, 0xaf, 0xcd, 0xa7, 0xf2, 0x4e, 0xd4, 0x83, 0xdb, 0x5a,
+    0xad, 0x75, 0x99, 0x95, 0x5d, 0xd5, 0x66, 0x3b, 0x7b, 0xc0, 0xec, 0x64, 0xf6, 0xdb, 0x4c, 0xff,
+    0x9e, 0x52, 0x88, 0xec, 0x39, 0xa0, 0xd8, 0xff, 0x1e, 0x83, 0x77, 0x66, 0x85, 0x21, 0x5e, 0x28,
+    0xc1, 0x53, 0xf5, 0x2c, 0x5a, 0x1b, 0xdd, 0x2a, 0xd2, 0x7b, 0x40, 0x93, 0x10, 0x08, 0xaf, 0x1e,
+    0x6f, 0xc0, 0x03, 0xc2, 0x77, 0x0d, 0xa0, 0xc8, 0x06, 0xe2, 0x7c, 0xdf, 0x25, 0x36, 0x5d, 0x07,
+    0x6d, 0x34, 0xe4, 0xa0, 0xc5, 0x2e, 0x12, 0x82, 0x0d, 0xd1, 0x8e, 0x7e, 0xee, 0xc1, 0xcf, 0x39,
+    0xbc, 0xc9, 0x79, 0x63, 0x02, 0x43, 0x77, 0x6b, 0xdf, 0x23, 0x09, 0xc0, 0x58, 0x8a, 0x29, 0xdd,
+    0xf3, 0x8c, 0x66, 0x7a, 0x05, 0x3b, 0xa0, 0x1d, 0x61, 0x95, 0x12, 0x90, 0x42, 0x64, 0xb8, 0x79,
+    0x1e, 0x1e, 0xf8, 0xc1, 0x77, 0x0c, 0xd2, 0xc4, 0xe5, 0xf0, 0xff, 0x42, 0xff, 0xad, 0x90, 0xda,
+    0x28, 0x3f, 0x99, 0x1e, 0x9b, 0x0b, 0x05, 0x55, 0x2b, 0xf9, 0x0e, 0xeb, 0x82, 0x14, 0xfc, 0x3c,
+    0x7e, 0xaf, 0x06, 0xe6, 0x25, 0xd5, 0x45, 0xe1, 0xa7, 0x94, 0x2f, 0x7e, 0x35, 0x13, 0x93, 0xb9,
+    0x62, 0xc8, 0x6d, 0x9c, 0x8a, 0x39, 0xb2, 0xb7, 0x98, 0x8a, 0x52, 0x72, 0xce, 0xa7, 0x25, 0x98,
+    0xb5, 0x49, 0x68, 0xe3, 0xec, 0x92, 0xaa, 0x8f, 0x1b, 0x95, 0x22, 0x71, 0x13, 0xc9, 0x21, 0xa9,
+    0xba, 0xdc, 0x28, 0x2b, 0xbd, 0xe5, 0xd6, 0xc6, 0xb0, 0x70, 0x4b, 0x5d, 0xbe, 0x64, 0xba, 0x92,
+    0x77, 0xd6, 0xc7, 0x5a, 0x6b, 0x79, 0x1f, 0x82, 0xb9, 0x2c, 0xee, 0x07, 0xcf, 0xee, 0xac, 0x4f,
+    0x75, 0xf5, 0xf0, 0x7c, 0x6d, 0x3e, 0x95, 0x77, 0xa2, 0x1e, 0xdc, 0xd6, 0x6a, 0x2d, 0x72, 0xd9,
+    0x55, 0x6d, 0xb6, 0xb3, 0x07, 0xcc, 0x4e, 0x66, 0xbf, 0xcd, 0xf4, 0xef, 0xa9, 0x84, 0xc8, 0x9e,
+    0x03, 0x8a, 0xfd, 0x9f, 0xb3, 0xef, 0x22, 0x4d, 0x40, 0x38, 0xf9, 0x59, 0x2a, 0xc1, 0xd3, 0xee,
+    0x59, 0xe4, 0x36, 0xba, 0x55, 0xd4, 0xf7, 0x80, 0x26, 0xa1, 0x88, 0x57, 0x8f, 0x37, 0xe0, 0x01,
+    0xe1, 0xbb, 0x09, 0x50, 0x64, 0x03, 0x71, 0xbe, 0xef, 0x12, 0x9b, 0xae, 0x83, 0x36, 0x1a, 0x72,
+    0xd0, 0xa2, 0xe0, 0x10, 0x6c, 0x88, 0x76, 0xf4, 0x73, 0x0f, 0x7e, 0xce, 0xe1, 0x4d, 0x2e, 0x1c,
+    0x13, 0x18, 0xba, 0x5b, 0xfb, 0x1e, 0x49, 0x00, 0xc6, 0x52, 0x4c, 0xe9, 0x9e, 0x67, 0x34, 0xd3,
+    0x2b, 0xd8, 0x01, 0xed, 0x08, 0x6b, 0xbc, 0x10, 0xa4, 0x10, 0x19, 0x6e, 0x9e, 0x87, 0x07, 0x7e,
+    0xf0, 0x1d, 0x83, 0x34, 0x71, 0x39, 0x48, 0x35, 0x3f, 0x99, 0x1e, 0x9b, 0x0b, 0x05, 0xe9, 0x27,
+    0xdf, 0x61, 0x5d, 0x90, 0x82, 0x9f, 0xc7, 0xef, 0xd5, 0xc0, 0xbc, 0xa4, 0xba, 0x28, 0xfc, 0x94,
+    0xf2, 0xc5, 0xaf, 0x66, 0x62, 0x32, 0x57, 0x0c, 0xb9, 0x8d, 0x53, 0x31, 0x47, 0xf6, 0x16, 0x53,
+    0x51, 0x49, 0xce, 0xf9, 0xb4, 0x04, 0xb3, 0x36, 0x09, 0x6d, 0x9c, 0x5d, 0x52, 0xf5, 0x71, 0xa3,
+    0x52, 0x24, 0x6e, 0x22, 0x39, 0x24, 0x55, 0x57, 0x1b, 0x65, 0xa5, 0xb7, 0xdc, 0xda, 0x18, 0x16,
+    0x6e, 0xa9, 0xcb, 0x97, 0x4c, 0x57, 0x99, 0xde, 0x9d, 0xf5, 0xb1, 0xd6, 0x5a, 0xde, 0x87, 0x60,
+    0x2e, 0x8b, 0xfb, 0xc1, 0xb3, 0x3f, 0xeb, 0x53, 0x5d, 0x3d, 0x3c, 0x5f, 0x9b, 0x4f, 0xe5, 0x9d,
+    0xa8, 0x07, 0xb7, 0xb5, 0x5a, 0xeb, 0x5d, 0x56, 0x76, 0x55, 0x9b, 0xed, 0xec, 0x01, 0xb3, 0x93,
+    0xd9, 0x6f, 0x33, 0xfd, 0x7b, 0x76, 0x42, 0x64, 0xcf, 0x01, 0xc5, 0xfe, 0x6e, 0x68, 0xf4, 0x73,
+    0x0f, 0x76, 0x30, 0x73, 0x8f, 0x09, 0x9e, 0xf6, 0xcf, 0xa2, 0xb6, 0xd1, 0xad, 0xbf, 0xc4, 0x80,
+    0x26, 0x21, 0x10, 0x5e, 0x3d, 0xde, 0x80, 0x07, 0x84, 0xef, 0x22, 0x40, 0x91, 0x0d, 0xc4, 0xf9,
+    0xbe, 0x4b, 0x6c, 0xba, 0x0e, 0xda, 0x68, 0xc8, 0x41, 0x8b, 0x5d, 0x24, 0x04, 0x1b, 0xa2, 0xbd,
+    0x63, 0xfd, 0x9c, 0xc3, 0x9b, 0x1c, 0x38, 0x26, 0x30, 0x74, 0xb7, 0xf6, 0x3d, 0x92, 0x00, 0x8c,
+    0xa5, 0x98, 0xd2, 0x3d, 0xcf, 0x68, 0xa6, 0x57, 0x29, 0x80, 0x76, 0x84, 0x35, 0x5e, 0x08, 0x52,
+    0x88, 0x0c, 0x37, 0xcf, 0xc3, 0x03, 0x3f, 0xf8, 0x8e, 0x41, 0x9a, 0xb8, 0x1c, 0xfe, 0x72, 0x85,
+    0xd4, 0x46, 0xf9, 0xc9, 0xf4, 0xd8, 0x5c, 0x28, 0xa8, 0x5a, 0x0d, 0xcc, 0x4b, 0xaa, 0x8b, 0xc2,
+    0x4f, 0x29, 0x5f, 0xfc, 0x6a, 0x26, 0x26, 0x73, 0xc5, 0x90, 0xdb, 0x38, 0x15, 0x89, 0x23, 0x89,
+    0xb3, 0x98, 0x23, 0x7b, 0x8b, 0xa9, 0xd8, 0xe5, 0xcb, 0xdc, 0x4b, 0x7e, 0x58, 0x17, 0xa4, 0xe0,
+    0xe7, 0xf1, 0x4f, 0x30, 0xfe, 0xc8, 0x4a, 0xce, 0xf9, 0xb4, 0x04, 0xb3, 0x36, 0x09, 0x6d, 0x9c,
+    0x5d, 0x52, 0xf5, 0x71, 0xa3, 0x52, 0x24, 0x6e, 0x22, 0x39, 0x24, 0x55, 0xef, 0x36, 0xca, 0xca,
+    0xa1, 0x8c, 0xae, 0x31, 0x2c, 0xdc, 0x52, 0x97, 0x2f, 0x99, 0xae, 0x32, 0xbd, 0x3f, 0xeb, 0x63,
+    0xad, 0xb5, 0xbc, 0x0f, 0xc1, 0x5c, 0x16, 0xf7, 0x83, 0xe7, 0xe5, 0xac, 0x4f, 0x75, 0xf5, 0xf0,
+    0x7c, 0x6d, 0x3e, 0x95, 0x77, 0xa2, 0x1e, 0xdc, 0xd6, 0x6a, 0xad, 0xf7, 0x59, 0xd9, 0x55, 0x6d,
+    0xb6, 0xb3, 0x07, 0xcc, 0x4e, 0x66, 0xbf, 0xcd, 0xf4, 0xef, 0xd9, 0x0b, 0x91, 0x3d, 0x07, 0x14,
+    0xfb, 0x19, 0xcd, 0x04, 0x2d, 0x79, 0xec, 0xfc, 0xdc, 0xc3, 0xd3, 0xcb, 0xb3, 0x68, 0x6d, 0x74,
+    0xab, 0x48, 0xef, 0x01, 0x4d, 0x42, 0x20, 0xbc, 0x7a, 0xbc, 0x01, 0x0f, 0x08, 0xdf, 0x35, 0x80,
+    0x22, 0x1b, 0x88, 0xf3, 0x7d, 0x97, 0xd8, 0x74, 0x1d, 0xb4, 0xd1, 0x90, 0x83, 0x16, 0xbb, 0x48,
+    0x08, 0x36, 0x44, 0x3b, 0xfe, 0xc2, 0xf9, 0x39, 0x87, 0x37, 0x39, 0x6f, 0x4c, 0x60, 0xe8, 0x6e,
+    0xed, 0x7b, 0x24, 0x01, 0x18, 0x4b, 0x31, 0xa5, 0x7b, 0x9e, 0xa5, 0xc0, 0x2b, 0xd8, 0x01, 0xed,
+    0x08, 0x6b, 0xbc, 0x10, 0xa4, 0x10, 0x19, 0x6e, 0x9e, 0x87, 0x07, 0x7e, 0xf0, 0x1d, 0x83, 0x34,
+    0x71, 0x39, 0xfc, 0x2f, 0x85, 0xfe, 0x0d, 0xc7, 0xa9, 0xe1, 0xc3,
+};
+
+struct InflateFixture {
+    const char* name;
+    ptc::ContentEncoding encoding;
+    const uint8_t* data;
+    size_t size;
+    uint32_t plain_size;
+    uint32_t plain_crc;
+    // Window the stream was compressed with.
+    uint32_t window_bytes;
+    // JSON array elements, or 0 for an object.
+    uint16_t elements;
+};
+
+constexpr InflateFixture kInflateFixtures[] = {
+    {"notices_gzip", ptc::ContentEncoding::kGzip, kNoticesGzip, sizeof(kNoticesGzip), 6779, 0x429cb2f5, 32768, 12},
+    {"activity_deflate", ptc::ContentEncoding::kDeflate, kActivityDeflate, sizeof(kActivityDeflate), 19800, 0x597f7f5f, 32768, 120},
+    {"release_gzip", ptc::ContentEncoding::kGzip, kReleaseGzip, sizeof(kReleaseGzip), 6047, 0x4ce763bf, 32768, 0},
+    {"activity_raw_deflate", ptc::ContentEncoding::kDeflate, kActivityRawDeflate, sizeof(kActivityRawDeflate), 19800, 0x597f7f5f, 32768, 120},
+    {"notices_gzip_stored", ptc::ContentEncoding::kGzip, kNoticesGzipStored, sizeof(kNoticesGzipStored), 1500, 0xc4f01899, 32768, 0},
+    {"notices_gzip_w512", ptc::ContentEncoding::kGzip, kNoticesGzipW512, sizeof(kNoticesGzipW512), 3000, 0x2bd6b8e7, 512, 0},
+    {"notices_zlib_w512", ptc::ContentEncoding::kDeflate, kNoticesZlibW512, sizeof(kNoticesZlibW512), 3000, 0x2bd6b8e7, 512, 0},
+};
+
+} // namespace bench
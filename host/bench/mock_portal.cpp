@@ -0,0 +1,690 @@
+#include "mock_portal.h"
+
+#include <Arduino.h>
+#include <ArduinoJson.h>
+#include <arpa/inet.h>
+#include <esp_system.h>
+#include <mbedtls/sha256.h>
+#include <netinet/in.h>
+#include <poll.h>
+#include <strings.h>
+#include <sys/socket.h>
+#include <unistd.h>
+
+#include <algorithm>
+#include <cstdio>
+#include <cstring>
+#include <ctime>
+
+namespace bench {
+
+namespace {
+
+constexpr uint32_t kTimestampWindowSec = 120;
+constexpr uint32_t kManualCodeTtlSec = 30;
+constexpr size_t kActivityLimit = 50;
+// Idle keep-alive connections are closed after this much real time.
+constexpr int kIdleCloseMs = 15000;
+constexpr size_t kMaxRequestBytes = 64 * 1024;
+
+const char* reason_phrase(int status) {
+    switch (status) {
+        case 200:
+            return "OK";
+        case 400:
+            return "Bad Request";
+        case 401:
+            return "Unauthorized";
+        case 403:
+            return "Forbidden";
+        case 404:
+            return "Not Found";
+        case 405:
+            return "Method Not Allowed";
+        case 429:
+            return "Too Many Requests";
+        case 500:
+            return "Internal Server Error";
+        case 502:
+            return "Bad Gateway";
+        case 503:
+            return "Service Unavailable";
+        default:
+            return "Status";
+    }
+}
+
+std::string lower(std::string value) {
+    std::transform(value.begin(), value.end(), value.begin(), [](unsigned char c) {
+        return static_cast<char>(tolower(c));
+    });
+    return value;
+}
+
+std::string header(const std::map<std::string, std::string>& headers, const char* name) {
+    const auto found = headers.find(lower(name));
+    return found == headers.end() ? std::string() : found->second;
+}
+
+bool has_query_param(const std::string& query, const char* name) {
+    const std::string key = std::string(name) + "=";
+    return query.compare(0, key.size(), key) == 0 || query.find("&" + key) != std::string::npos;
+}
+
+std::string url_decode(const std::string& value) {
+    std::string decoded;
+    for (size_t i = 0; i < value.size(); ++i) {
+        if (value[i] == '%' && i + 2 < value.size()) {
+            decoded += static_cast<char>(strtoul(value.substr(i + 1, 2).c_str(), nullptr, 16));
+            i += 2;
+        } else {
+            decoded += value[i];
+        }
+    }
+    return decoded;
+}
+
+std::string query_param(const std::string& query, const char* name) {
+    const std::string key = std::string(name) + "=";
+    size_t at = 0;
+    while (at < query.size()) {
+        const size_t end = std::min(query.find('&', at), query.size());
+        if (query.compare(at, key.size(), key) == 0) {
+            return query.substr(at + key.size(), end - at - key.size());
+        }
+        at = end + 1;
+    }
+    return std::string();
+}
+
+std::string hex(const uint8_t* data, size_t length) {
+    static const char kDigits[] = "0123456789abcdef";
+    std::string out;
+    for (size_t i = 0; i < length; ++i) {
+        out += kDigits[data[i] >> 4];
+        out += kDigits[data[i] & 0x0F];
+    }
+    return out;
+}
+
+void sha256(const std::string& data, uint8_t out[32]) {
+    mbedtls_sha256_ret(reinterpret_cast<const unsigned char*>(data.data()), data.size(), out, 0);
+}
+
+// RFC 2104 over the raw digest, deliberately not through the md wrapper the
+// firmware signs with.
+void hmac_sha256(const std::string& key, const std::string& message, uint8_t out[32]) {
+    uint8_t block[64] = {};
+    if (key.size() > sizeof(block)) {
+        sha256(key, block);
+    } else {
+        memcpy(block, key.data(), key.size());
+    }
+    std::string inner(64, '\0');
+    std::string outer(64, '\0');
+    for (size_t i = 0; i < 64; ++i) {
+        inner[i] = static_cast<char>(block[i] ^ 0x36);
+        outer[i] = static_cast<char>(block[i] ^ 0x5C);
+    }
+    uint8_t inner_digest[32];
+    sha256(inner + message, inner_digest);
+    sha256(outer + std::string(reinterpret_cast<const char*>(inner_digest), 32), out);
+}
+
+bool base64url_decode(const std::string& text, std::string& out) {
+    out.clear();
+    uint32_t buffer = 0;
+    int bits = 0;
+    for (char c : text) {
+        int value = -1;
+        if (c >= 'A' && c <= 'Z') value = c - 'A';
+        else if (c >= 'a' && c <= 'z') value = c - 'a' + 26;
+        else if (c >= '0' && c <= '9') value = c - '0' + 52;
+        else if (c == '-') value = 62;
+        else if (c == '_') value = 63;
+        else if (c == '=') break;
+        if (value < 0) {
+            return false;
+        }
+        buffer = (buffer << 6) | static_cast<uint32_t>(value);
+        bits += 6;
+        if (bits >= 8) {
+            bits -= 8;
+            out += static_cast<char>((buffer >> bits) & 0xFF);
+        }
+    }
+    return true;
+}
+
+bool constant_time_equal(const std::string& a, const uint8_t* b, size_t length) {
+    uint8_t difference = a.size() == length ? 0 : 1;
+    for (size_t i = 0; i < length; ++i) {
+        difference |= static_cast<uint8_t>(a.size() == length ? a[i] : 0) ^ b[i];
+    }
+    return difference == 0;
+}
+
+std::string iso8601(uint32_t epoch) {
+    const time_t value = epoch;
+    struct tm utc;
+    gmtime_r(&value, &utc);
+    char text[24];
+    strftime(text, sizeof(text), "%Y-%m-%dT%H:%M:%SZ", &utc);
+    return text;
+}
+
+std::string activity_json(const PortalActivity& event) {
+    return "{\"id\":\"" + event.id + "\",\"user_name\":\"" + event.user_name + "\",\"action\":\"" +
+        event.action + "\",\"occurred_at\":\"" + iso8601(event.timestamp) + "\"}";
+}
+
+std::string json_error(const char* message) {
+    return std::string("{\"error\":\"") + message + "\"}";
+}
+
+} // namespace
+
+const char* portal_auth_name(PortalAuth auth) {
+    switch (auth) {
+        case PortalAuth::kUnsigned:
+            return "unsigned";
+        case PortalAuth::kOk:
+            return "ok";
+        case PortalAuth::kMissingHeaders:
+            return "missing headers";
+        case PortalAuth::kUnknownDevice:
+            return "unknown device";
+        case PortalAuth::kExpired:
+            return "expired timestamp";
+        case PortalAuth::kBadSignature:
+            return "bad signature";
+        case PortalAuth::kReplayedNonce:
+            return "replayed nonce";
+        default:
+            return "?";
+    }
+}
+
+MockPortal::~MockPortal() {
+    stop();
+}
+
+bool MockPortal::start(uint16_t port) {
+    if (running_) {
+        return true;
+    }
+    listen_fd_ = socket(AF_INET, SOCK_STREAM, 0);
+    if (listen_fd_ < 0) {
+        return false;
+    }
+    const int reuse = 1;
+    setsockopt(listen_fd_, SOL_SOCKET, SO_REUSEADDR, &reuse, sizeof(reuse));
+    sockaddr_in address = {};
+    address.sin_family = AF_INET;
+    address.sin_port = htons(port);
+    address.sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+    socklen_t length = sizeof(address);
+    if (bind(listen_fd_, reinterpret_cast<sockaddr*>(&address), sizeof(address)) != 0 ||
+        listen(listen_fd_, 8) != 0 ||
+        getsockname(listen_fd_, reinterpret_cast<sockaddr*>(&address), &length) != 0) {
+        close(listen_fd_);
+        listen_fd_ = -1;
+        return false;
+    }
+    port_ = ntohs(address.sin_port);
+    running_ = true;
+    acceptor_ = std::thread(&MockPortal::accept_loop, this);
+    return true;
+}
+
+void MockPortal::stop() {
+    if (!running_.exchange(false)) {
+        return;
+    }
+    acceptor_.join();
+    close(listen_fd_);
+    listen_fd_ = -1;
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        for (int fd : connection_fds_) {
+            shutdown(fd, SHUT_RDWR);
+        }
+    }
+    for (std::thread& connection : connections_) {
+        connection.join();
+    }
+    connections_.clear();
+    connection_fds_.clear();
+}
+
+void MockPortal::add_device(const std::string& device_id, const std::string& secret, bool active) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    Device& device = devices_[device_id];
+    device.secret = secret;
+    device.active = active;
+}
+
+void MockPortal::set_device_active(const std::string& device_id, bool active) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    devices_[device_id].active = active;
+}
+
+void MockPortal::set_enrollment_code(const std::string& code, const std::string& device_id) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    enrollment_code_ = code;
+    enrollment_device_ = device_id;
+}
+
+void MockPortal::set_qr_interval(uint32_t seconds) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    qr_interval_sec_ = seconds;
+}
+
+void MockPortal::set_notices(const std::string& json_array) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    notices_ = json_array;
+}
+
+void MockPortal::add_activity(const PortalActivity& event) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    activity_.push_back(event);
+}
+
+void MockPortal::set_activity_page_size(size_t events) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    activity_page_size_ = events;
+}
+
+void MockPortal::set_activity_null_last_cursor(bool null_cursor) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    activity_null_last_cursor_ = null_cursor;
+}
+
+void MockPortal::set_clock_skew(int32_t seconds) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    clock_skew_ = seconds;
+}
+
+void MockPortal::set_latency(uint32_t latency_ms) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    latency_ms_ = latency_ms;
+}
+
+void MockPortal::set_keep_alive(bool keep_alive) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    keep_alive_ = keep_alive;
+}
+
+void MockPortal::set_faults(const std::vector<PortalFault>& faults) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    faults_ = faults;
+    fault_hits_.assign(faults.size(), 0);
+}
+
+std::vector<PortalRecord> MockPortal::records() {
+    std::lock_guard<std::mutex> lock(mutex_);
+    return records_;
+}
+
+void MockPortal::clear_records() {
+    std::lock_guard<std::mutex> lock(mutex_);
+    records_.clear();
+}
+
+std::vector<PortalEvent> MockPortal::events() {
+    std::lock_guard<std::mutex> lock(mutex_);
+    return events_;
+}
+
+uint32_t MockPortal::duplicate_events() {
+    std::lock_guard<std::mutex> lock(mutex_);
+    return duplicate_events_;
+}
+
+std::string MockPortal::last_heartbeat() {
+    std::lock_guard<std::mutex> lock(mutex_);
+    return last_heartbeat_;
+}
+
+uint32_t MockPortal::now() const {
+    return static_cast<uint32_t>(time(nullptr) + clock_skew_);
+}
+
+void MockPortal::accept_loop() {
+    while (running_) {
+        pollfd waiting = {listen_fd_, POLLIN, 0};
+        if (poll(&waiting, 1, 50) <= 0) {
+            continue;
+        }
+        const int fd = accept(listen_fd_, nullptr, nullptr);
+        if (fd < 0) {
+            continue;
+        }
+        std::lock_guard<std::mutex> lock(mutex_);
+        connection_fds_.push_back(fd);
+        connections_.emplace_back(&MockPortal::serve, this, fd);
+    }
+}
+
+// One thread per connection, HTTP/1.1 keep-alive, no pipelining.
+void MockPortal::serve(int fd) {
+    serve_requests(fd);
+    std::lock_guard<std::mutex> lock(mutex_);
+    connection_fds_.erase(std::find(connection_fds_.begin(), connection_fds_.end(), fd));
+    close(fd);
+}
+
+void MockPortal::serve_requests(int fd) {
+    std::string buffer;
+    while (running_) {
+        size_t header_end = buffer.find("\r\n\r\n");
+        while (header_end == std::string::npos) {
+            pollfd waiting = {fd, POLLIN, 0};
+            char chunk[2048];
+            const ssize_t count = poll(&waiting, 1, kIdleCloseMs) == 1 ? recv(fd, chunk, sizeof(chunk), 0) : -1;
+            if (count <= 0 || buffer.size() > kMaxRequestBytes) {
+                return;
+            }
+            buffer.append(chunk, static_cast<size_t>(count));
+            header_end = buffer.find("\r\n\r\n");
+        }
+
+        std::map<std::string, std::string> headers;
+        const size_t line_end = buffer.find("\r\n");
+        const std::string request_line = buffer.substr(0, line_end);
+        for (size_t at = line_end + 2; at < header_end;) {
+            const size_t end = buffer.find("\r\n", at);
+            const size_t colon = buffer.find(':', at);
+            if (colon != std::string::npos && colon < end) {
+                const size_t value_at = buffer.find_first_not_of(' ', colon + 1);
+                headers[lower(buffer.substr(at, colon - at))] =
+                    value_at < end ? buffer.substr(value_at, end - value_at) : std::string();
+            }
+            at = end + 2;
+        }
+        const size_t length = strtoul(header(headers, "Content-Length").c_str(), nullptr, 10);
+        while (buffer.size() < header_end + 4 + length) {
+            char chunk[2048];
+            const ssize_t count = recv(fd, chunk, sizeof(chunk), 0);
+            if (count <= 0) {
+                return;
+            }
+            buffer.append(chunk, static_cast<size_t>(count));
+        }
+        const std::string body = buffer.substr(header_end + 4, length);
+        buffer.erase(0, header_end + 4 + length);
+
+        const size_t method_end = request_line.find(' ');
+        const size_t target_end = request_line.find(' ', method_end + 1);
+        const Response response = handle(request_line.substr(0, method_end),
+            request_line.substr(method_end + 1, target_end - method_end - 1), headers, body);
+        if (response.drop) {
+            return;
+        }
+        bool keep_alive = strcasecmp(header(headers, "Connection").c_str(), "close") != 0;
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            keep_alive = keep_alive && keep_alive_;
+        }
+        char retry_after[32] = "";
+        if (response.retry_after_sec > 0) {
+            snprintf(retry_after, sizeof(retry_after), "Retry-After: %u\r\n",
+                static_cast<unsigned>(response.retry_after_sec));
+        }
+        char head[192];
+        snprintf(head, sizeof(head),
+            "HTTP/1.1 %d %s\r\nContent-Type: application/json\r\nContent-Length: %zu\r\n%sConnection: %s\r\n\r\n",
+            response.status, reason_phrase(response.status), response.body.size(), retry_after,
+            keep_alive ? "keep-alive" : "close");
+        const std::string out = head +
+            (response.truncate_at > 0 ? response.body.substr(0, response.truncate_at) : response.body);
+        if (send(fd, out.data(), out.size(), MSG_NOSIGNAL) != static_cast<ssize_t>(out.size()) || !keep_alive ||
+            response.truncate_at > 0) {
+            return;
+        }
+    }
+}
+
+MockPortal::Response MockPortal::handle(const std::string& method, const std::string& target,
+    const std::map<std::string, std::string>& headers, const std::string& body) {
+    const uint32_t at_ms = millis();
+    const size_t query_at = target.find('?');
+    const std::string path = target.substr(0, query_at);
+    const std::string query = query_at == std::string::npos ? "" : target.substr(query_at + 1);
+
+    PortalFault fault;
+    bool faulted = false;
+    uint32_t latency_ms = 0;
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        latency_ms = latency_ms_;
+        for (size_t i = 0; i < faults_.size(); ++i) {
+            const PortalFault& candidate = faults_[i];
+            if (at_ms >= candidate.start_ms && at_ms < candidate.end_ms &&
+                (!candidate.route || path.find(candidate.route) != std::string::npos) &&
+                (candidate.max_hits == 0 || fault_hits_[i] < candidate.max_hits)) {
+                fault_hits_[i]++;
+                fault = candidate;
+                faulted = true;
+                latency_ms += candidate.latency_ms;
+                break;
+            }
+        }
+    }
+    if (latency_ms > 0) {
+        std::this_thread::sleep_for(std::chrono::milliseconds(latency_ms));
+    }
+
+    Response response;
+    PortalRecord record;
+    record.at_ms = at_ms;
+    record.method = method;
+    record.route = path.substr(path.rfind('/') + 1);
+    std::lock_guard<std::mutex> lock(mutex_);
+    std::string device_id;
+    const bool signed_route = path != "/api/timeclock/devices/register";
+    record.auth = signed_route ? authenticate(method, target, headers, body, device_id) : PortalAuth::kUnsigned;
+    record.faulted = faulted;
+
+    if (faulted && fault.status != 0 && fault.status != 200) {
+        // An injected answer, before the request reaches the route.
+        response.status = fault.status;
+        response.body = fault.status == 429
+            ? "{\"error\":\"rate limited\",\"retry_after\":" + std::to_string(fault.retry_after_sec) + "}"
+            : json_error(reason_phrase(fault.status));
+        response.retry_after_sec = fault.retry_after_sec;
+    } else if (faulted && fault.status == 0) {
+        response.drop = true;
+    } else if (signed_route && record.auth != PortalAuth::kOk) {
+        response.status = 401;
+        response.body = json_error("unauthorized");
+    } else if (signed_route && !devices_[device_id].active) {
+        response.status = 403;
+        response.body = json_error("device inactive");
+    } else {
+        response = route(method, path, query, device_id, body);
+        if (faulted && fault.truncate_bytes > 0) {
+            response.truncate_at = std::min<size_t>(fault.truncate_bytes, response.body.size());
+        }
+    }
+    record.status = response.drop ? 0 : response.status;
+    records_.push_back(record);
+    return response;
+}
+
+// Checks happen in the order the portal spec lists them; a nonce is only
+// remembered once the signature is valid, so forged requests cannot fill
+// the cache or burn a genuine nonce.
+PortalAuth MockPortal::authenticate(const std::string& method, const std::string& target,
+    const std::map<std::string, std::string>& headers, const std::string& body, std::string& device_id) {
+    device_id = header(headers, "X-PTC-Device-Id");
+    const std::string timestamp = header(headers, "X-PTC-Timestamp");
+    const std::string nonce = header(headers, "X-PTC-Nonce");
+    const std::string signature = header(headers, "X-PTC-Signature");
+    if (device_id.empty() || timestamp.empty() || nonce.empty() || signature.empty()) {
+        return PortalAuth::kMissingHeaders;
+    }
+    const auto device = devices_.find(device_id);
+    if (device == devices_.end()) {
+        return PortalAuth::kUnknownDevice;
+    }
+    const uint32_t server_now = now();
+    const uint32_t sent = static_cast<uint32_t>(strtoul(timestamp.c_str(), nullptr, 10));
+    if ((sent > server_now ? sent - server_now : server_now - sent) > kTimestampWindowSec) {
+        return PortalAuth::kExpired;
+    }
+
+    uint8_t body_hash[32];
+    sha256(body, body_hash);
+    const std::string material = method + "\n" + target + "\n" + timestamp + "\n" + nonce + "\n" +
+        hex(body_hash, sizeof(body_hash));
+    uint8_t expected[32];
+    hmac_sha256(device->second.secret, material, expected);
+    std::string received;
+    if (!base64url_decode(signature, received) || !constant_time_equal(received, expected, sizeof(expected))) {
+        return PortalAuth::kBadSignature;
+    }
+
+    for (auto it = nonces_.begin(); it != nonces_.end();) {
+        it = server_now - it->second > 2 * kTimestampWindowSec ? nonces_.erase(it) : std::next(it);
+    }
+    if (!nonces_.emplace(device_id + ":" + nonce, server_now).second) {
+        return PortalAuth::kReplayedNonce;
+    }
+    return PortalAuth::kOk;
+}
+
+MockPortal::Response MockPortal::route(const std::string& method, const std::string& path,
+    const std::string& query, const std::string& device_id, const std::string& body) {
+    Response response;
+    const std::string devices = "/api/timeclock/devices/";
+    const std::string name = path.compare(0, devices.size(), devices) == 0 ? path.substr(devices.size()) : "";
+    const bool get = method == "GET";
+    const bool post = method == "POST";
+    if (!query_param(query, "device_id").empty() && query_param(query, "device_id") != device_id) {
+        response.status = 403;
+        response.body = json_error("device mismatch");
+    } else if (name == "config" && get) {
+        response.body = "{\"device_id\":\"" + device_id +
+            "\",\"location_id\":\"loc-7\",\"location_name\":\"North depot\",\"qr_interval_sec\":" +
+            std::to_string(qr_interval_sec_) + ",\"is_active\":true}";
+    } else if (name == "heartbeat" && post) {
+        last_heartbeat_ = body;
+        response.body = "{\"ok\":true,\"server_time\":\"" + iso8601(now()) + "\"}";
+    } else if (path == "/api/timeclock/notices" && get) {
+        response.body = notices_;
+    } else if (name == "activity" && get && activity_page_size_ > 0 && has_query_param(query, "cursor")) {
+        // The cursor is an index into the portal's event order, so the same
+        // cursor always starts with the same events.
+        const std::string cursor = url_decode(query_param(query, "cursor"));
+        size_t first = 0;
+        if (cursor.empty()) {
+            const uint32_t since = static_cast<uint32_t>(strtoul(query_param(query, "since").c_str(), nullptr, 10));
+            while (first < activity_.size() && activity_[first].timestamp <= since) {
+                first++;
+            }
+        } else if (cursor.compare(0, 3, "v1:") == 0) {
+            first = std::min<size_t>(strtoul(cursor.c_str() + 3, nullptr, 10), activity_.size());
+        } else {
+            response.status = 400;
+            response.body = json_error("invalid cursor");
+            return response;
+        }
+        const size_t last = std::min(first + activity_page_size_, activity_.size());
+        response.body = "{\"events\":[";
+        for (size_t i = first; i < last; ++i) {
+            response.body += (i > first ? "," : "") + activity_json(activity_[i]);
+        }
+        const bool null_cursor = activity_null_last_cursor_ && last == activity_.size();
+        const std::string next = null_cursor ? "null" : "\"v1:" + std::to_string(last) + "\"";
+        response.body += "],\"next_cursor\":" + next + ",\"has_more\":" + (last < activity_.size() ? "true" : "false") +
+            "}";
+    } else if (name == "activity" && get) {
+        // The latest 50 newer than since, oldest first.
+        const uint32_t since = static_cast<uint32_t>(strtoul(query_param(query, "since").c_str(), nullptr, 10));
+        std::vector<const PortalActivity*> newer;
+        for (const PortalActivity& event : activity_) {
+            if (event.timestamp > since) {
+                newer.push_back(&event);
+            }
+        }
+        const size_t first = newer.size() > kActivityLimit ? newer.size() - kActivityLimit : 0;
+        response.body = "[";
+        for (size_t i = first; i < newer.size(); ++i) {
+            response.body += (i > first ? "," : "") + activity_json(*newer[i]);
+        }
+        response.body += "]";
+    } else if (name == "manual-code" && post) {
+        StaticJsonDocument<512> request;
+        Device& device = devices_[device_id];
+        const uint32_t server_now = now();
+        if (deserializeJson(request, body) != DeserializationError::Ok ||
+            std::string(request["device_id"] | "") != device_id ||
+            !String(request["qr_payload"] | "").startsWith("ptc1:")) {
+            response.status = 400;
+            response.body = json_error("invalid request");
+        } else if (device.last_manual_code != 0 && server_now - device.last_manual_code < qr_interval_sec_) {
+            // One code per QR rotation.
+            response.status = 429;
+            response.body = "{\"error\":\"rate limited\",\"retry_after\":" +
+                std::to_string(qr_interval_sec_ - (server_now - device.last_manual_code)) + "}";
+        } else {
+            device.last_manual_code = server_now;
+            char code[9];
+            snprintf(code, sizeof(code), "%08u", static_cast<unsigned>(esp_random() % 100000000U));
+            response.body = std::string("{\"code\":\"") + code + "\",\"code_display\":\"" +
+                std::string(code, 4) + "-" + std::string(code + 4, 4) + "\",\"expires_at\":\"" +
+                iso8601(server_now + kManualCodeTtlSec) + "\"}";
+        }
+    } else if (name == "events" && post) {
+        DynamicJsonDocument request(body.size() * 2 + 1024);
+        if (deserializeJson(request, body) != DeserializationError::Ok ||
+            std::string(request["device_id"] | "") != device_id || !request["events"].is<JsonArray>()) {
+            response.status = 400;
+            response.body = json_error("invalid request");
+            return response;
+        }
+        Device& device = devices_[device_id];
+        uint32_t accepted = 0;
+        uint32_t duplicates = 0;
+        for (JsonObject item : request["events"].as<JsonArray>()) {
+            const std::string key = item["key"] | "";
+            if (key.empty() || !device.event_keys.insert(key).second) {
+                duplicates++;
+                continue;
+            }
+            PortalEvent event;
+            event.device_id = device_id;
+            event.key = key;
+            event.type = item["type"] | "";
+            event.timestamp = item["ts"] | 0;
+            events_.push_back(event);
+            accepted++;
+        }
+        duplicate_events_ += duplicates;
+        response.body = "{\"accepted\":" + std::to_string(accepted) + ",\"duplicates\":" +
+            std::to_string(duplicates) + "}";
+    } else if (name == "register" && post) {
+        // No open enrollment: only an administrator's one-time code is
+        // exchanged, once, for the secret.
+        StaticJsonDocument<512> request;
+        deserializeJson(request, body);
+        const std::string code = request["enrollment_code"] | "";
+        if (enrollment_code_.empty() || code != enrollment_code_) {
+            response.status = 403;
+            response.body = json_error("enrollment required");
+        } else {
+            const Device& device = devices_[enrollment_device_];
+            response.body = "{\"device_id\":\"" + enrollment_device_ + "\",\"secret\":\"" + device.secret +
+                "\",\"location_id\":\"loc-7\",\"location_name\":\"North depot\",\"qr_interval_sec\":" +
+                std::to_string(qr_interval_sec_) + ",\"is_active\":true}";
+            enrollment_code_.clear();
+        }
+    } else {
+        response.status = 404;
+        response.body = json_error("not found");
+    }
+    return response;
+}
+
+} // namespace bench
@@ -0,0 +1,176 @@
+#pragma once
+
+// Local stand-in for the PT Portal device routes, served over real TCP on
+// 127.0.0.1 so the host build of service_http talks to it through
+// host::http_use_socket(). Signed requests are verified as
+// PT-PORTAL-INTEGRATION-REQUIREMENTS.md describes: HMAC-SHA256 over
+// METHOD, path and query, timestamp, nonce and body hash, a 120 s timestamp
+// window, constant-time comparison and a nonce replay cache.
+//
+// Routes: devices/register (enrollment code exchange only), devices/config,
+// devices/heartbeat, devices/activity, devices/manual-code, devices/events
+// (outbox batches, deduplicated by key per device) and notices.
+// Faults scripted against millis() replace the answer of matching requests.
+
+#include <atomic>
+#include <cstdint>
+#include <map>
+#include <mutex>
+#include <set>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace bench {
+
+enum class PortalAuth : uint8_t {
+    kUnsigned,
+    kOk,
+    kMissingHeaders,
+    kUnknownDevice,
+    kExpired,
+    kBadSignature,
+    kReplayedNonce,
+};
+
+const char* portal_auth_name(PortalAuth auth);
+
+// A fault applies to requests received while start_ms <= millis() < end_ms,
+// on every route or only on paths containing route. status 0 closes the
+// connection without an answer. retry_after_sec, when set, goes out as a
+// Retry-After header; a 429 also carries it in the body.
+// latency_ms (real time) is added before answering, fault or not. With
+// truncate_bytes set the route answers as usual but the connection closes
+// after that many body bytes. A fault with max_hits set stops applying after
+// that many requests.
+struct PortalFault {
+    uint32_t start_ms = 0;
+    uint32_t end_ms = 0;
+    int status = 0;
+    uint32_t retry_after_sec = 0;
+    uint32_t latency_ms = 0;
+    const char* route = nullptr;
+    uint16_t max_hits = 0;
+    uint32_t truncate_bytes = 0;
+};
+
+struct PortalRecord {
+    uint32_t at_ms = 0;
+    std::string method;
+    std::string route;
+    int status = 0;
+    PortalAuth auth = PortalAuth::kUnsigned;
+    bool faulted = false;
+};
+
+struct PortalActivity {
+    std::string id;
+    std::string user_name;
+    std::string action;
+    uint32_t timestamp = 0;
+};
+
+// An outbox record the events route stored; redeliveries are not repeated.
+struct PortalEvent {
+    std::string device_id;
+    std::string key;
+    std::string type;
+    uint32_t timestamp = 0;
+};
+
+class MockPortal {
+public:
+    MockPortal() = default;
+    ~MockPortal();
+    MockPortal(const MockPortal&) = delete;
+    MockPortal& operator=(const MockPortal&) = delete;
+
+    // Listens on 127.0.0.1:port; 0 picks a free port.
+    bool start(uint16_t port = 0);
+    void stop();
+    uint16_t port() const { return port_; }
+
+    void add_device(const std::string& device_id, const std::string& secret, bool active = true);
+    void set_device_active(const std::string& device_id, bool active);
+    // One-time code that devices/register exchanges for the device secret.
+    void set_enrollment_code(const std::string& code, const std::string& device_id);
+    void set_qr_interval(uint32_t seconds);
+    void set_notices(const std::string& json_array);
+    void add_activity(const PortalActivity& event);
+    // Requests carrying cursor= get pages of up to this many events as
+    // {"events","next_cursor","has_more"}; 0 answers every request with the
+    // bare array of the latest 50 newer than since=.
+    void set_activity_page_size(size_t events);
+    // true answers the last page with "next_cursor":null instead of a cursor.
+    void set_activity_null_last_cursor(bool null_cursor);
+    // Seconds added to the portal's clock when checking timestamps.
+    void set_clock_skew(int32_t seconds);
+    void set_latency(uint32_t latency_ms);
+    // false answers every request with "Connection: close", so each one
+    // opens a new connection.
+    void set_keep_alive(bool keep_alive);
+    void set_faults(const std::vector<PortalFault>& faults);
+
+    std::vector<PortalRecord> records();
+    void clear_records();
+    std::vector<PortalEvent> events();
+    // Records posted again with a key the portal already stored.
+    uint32_t duplicate_events();
+    // Body of the latest heartbeat posted, empty before the first.
+    std::string last_heartbeat();
+
+private:
+    struct Device {
+        std::string secret;
+        bool active = true;
+        uint32_t last_manual_code = 0;
+        std::set<std::string> event_keys;
+    };
+    struct Response {
+        int status = 200;
+        std::string body;
+        uint32_t retry_after_sec = 0;
+        bool drop = false;
+        size_t truncate_at = 0;
+    };
+
+    void accept_loop();
+    void serve(int fd);
+    void serve_requests(int fd);
+    Response handle(const std::string& method, const std::string& target,
+        const std::map<std::string, std::string>& headers, const std::string& body);
+    PortalAuth authenticate(const std::string& method, const std::string& target,
+        const std::map<std::string, std::string>& headers, const std::string& body, std::string& device_id);
+    Response route(const std::string& method, const std::string& path, const std::string& query,
+        const std::string& device_id, const std::string& body);
+    uint32_t now() const;
+
+    std::mutex mutex_;
+    std::atomic<bool> running_{false};
+    int listen_fd_ = -1;
+    uint16_t port_ = 0;
+    std::thread acceptor_;
+    std::vector<std::thread> connections_;
+    std::vector<int> connection_fds_;
+
+    std::map<std::string, Device> devices_;
+    std::map<std::string, uint32_t> nonces_;
+    std::string enrollment_code_;
+    std::string enrollment_device_;
+    uint32_t qr_interval_sec_ = 20;
+    std::string notices_ = "[]";
+    std::vector<PortalActivity> activity_;
+    size_t activity_page_size_ = 0;
+    bool activity_null_last_cursor_ = false;
+    int32_t clock_skew_ = 0;
+    uint32_t latency_ms_ = 0;
+    bool keep_alive_ = true;
+    std::vector<PortalFault> faults_;
+    std::vector<uint16_t> fault_hits_;
+    std::vector<PortalRecord> records_;
+    std::vector<PortalEvent> events_;
+    uint32_t duplicate_events_ = 0;
+    std::string last_heartbeat_;
+};
+
+} // namespace bench
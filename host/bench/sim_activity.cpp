@@ -0,0 +1,212 @@
+#include <SD.h>
+
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <set>
+#include <string>
+#include <vector>
+
+#include "bench.h"
+#include "mock_portal.h"
+#include "src/services/service_http.h"
+#include "src/services/service_log.h"
+#include "src/services/service_storage.h"
+#include "src/services/service_time.h"
+
+namespace bench {
+
+namespace {
+
+constexpr uint32_t kTickMs = 1000;
+constexpr const char* kDeviceId = "cb9008f8-0098-4b46-b77b-b82029aff3f2";
+constexpr const char* kDeviceSecret = "9f3c1a7e5b2d4c6f8a0e1b3d5f7a9c2e4b6d8f0a1c3e5a7b9d2f4a6c8e0b1d3f";
+constexpr const char* kActivityFiles[] = {"/ptc/activity.jsonl.1", "/ptc/activity.jsonl"};
+constexpr uint32_t kEventsPerSecond = 10;
+constexpr size_t kPageSize = 250;
+// Bodies cut off part way through a page, one every kTruncateEverySec, so
+// pages are resumed mid-way.
+constexpr uint16_t kTruncatedPages = 3;
+constexpr uint32_t kTruncateBytes[kTruncatedPages] = {12000, 5000, 19000};
+constexpr uint32_t kTruncateEverySec = 10;
+
+// Scripted timeline, seconds from the start of the run: the device is in
+// step with the portal, drops off Wi-Fi while the backlog builds up, then
+// reconnects and catches up.
+constexpr uint32_t kWarmEvents = 10;
+constexpr uint32_t kOfflineSec = 60;
+constexpr uint32_t kOnlineSec = 120;
+constexpr uint32_t kEndSec = 900;
+
+struct ReplayReport {
+    const char* name = "";
+    uint32_t backlog = 0;
+    uint32_t applied = 0;
+    uint32_t unique = 0;
+    uint32_t duplicates = 0;
+    uint32_t requests = 0;
+    uint32_t truncated = 0;
+    // Seconds from reconnecting until the last backlog event was applied.
+    uint32_t catch_up_sec = 0;
+    uint64_t replay_real_ms = 0;
+    uint32_t auth_failures = 0;
+    String cursor;
+    String last_error;
+};
+
+// Every backlog event id in the device's activity log, in order written.
+std::vector<std::string> logged_backlog_ids() {
+    std::vector<std::string> ids;
+    for (const char* path : kActivityFiles) {
+        File file = SD.open(path, FILE_READ);
+        if (!file) {
+            continue;
+        }
+        const String text = file.readString();
+        file.close();
+        const std::string lines = text.c_str();
+        for (size_t at = lines.find("\"id\":\"bk-"); at != std::string::npos; at = lines.find("\"id\":\"bk-", at + 1)) {
+            const size_t start = at + 6;
+            ids.push_back(lines.substr(start, lines.find('"', start) - start));
+        }
+    }
+    return ids;
+}
+
+// null_last_cursor answers the last page with "next_cursor":null and leaves
+// out the truncated pages, so any invalid body is down to the cursor.
+ReplayReport run_replay(bool paged, uint32_t backlog, bool null_last_cursor = false) {
+    ReplayReport report;
+    report.name = null_last_cursor ? "null cursor" : paged ? "cursor pages" : "since= poll";
+    report.backlog = backlog;
+    MockPortal portal;
+    portal.add_device(kDeviceId, kDeviceSecret);
+    portal.set_activity_page_size(paged ? kPageSize : 0);
+    portal.set_activity_null_last_cursor(null_last_cursor);
+    const uint32_t base_ts = static_cast<uint32_t>(time(nullptr)) - 86400;
+    for (uint32_t i = 0; i < kWarmEvents; ++i) {
+        portal.add_activity({"warm-" + std::to_string(i), "Employee " + std::to_string(i),
+            i % 2 ? "clock_out" : "clock_in", base_ts + i});
+    }
+    if (!portal.start()) {
+        return report;
+    }
+    host::http_use_socket("127.0.0.1", portal.port());
+    host::sd_wipe();
+    ptc::service_storage_init();
+    ptc::service_log_init();
+    ptc::DeviceConfig config;
+    config.device_id = kDeviceId;
+    config.device_secret = kDeviceSecret;
+    ptc::AppState state;
+    state.time_sync_ok = true;
+    state.provisioning_complete = true;
+    ptc::service_http_init();
+
+    const uint32_t base_ms = millis();
+    uint32_t revision_at_online = 0;
+    uint64_t online_real_ns = 0;
+    for (uint32_t second = 0; second < kEndSec; ++second) {
+        if (second == kOfflineSec) {
+            host::wifi_set_connected(false);
+            // Ten clock events a second, so most share their second with
+            // others, and all of them land while the device is away.
+            for (uint32_t i = 0; i < backlog; ++i) {
+                portal.add_activity({"bk-" + std::to_string(i), "Employee " + std::to_string(i % 400),
+                    i % 2 ? "clock_out" : "clock_in", base_ts + kWarmEvents + i / kEventsPerSecond});
+            }
+        }
+        if (second == kOnlineSec) {
+            std::vector<PortalFault> faults;
+            for (uint16_t i = 0; i < (null_last_cursor ? 0 : kTruncatedPages); ++i) {
+                PortalFault truncate;
+                truncate.start_ms = base_ms + (kOnlineSec + i * kTruncateEverySec) * 1000;
+                truncate.end_ms = base_ms + kEndSec * 1000;
+                truncate.status = 200;
+                truncate.route = "activity";
+                truncate.truncate_bytes = kTruncateBytes[i];
+                truncate.max_hits = 1;
+                faults.push_back(truncate);
+            }
+            portal.set_faults(faults);
+            portal.clear_records();
+            host::wifi_set_connected(true);
+            revision_at_online = ptc::service_log_revision();
+            online_real_ns = host::real_now_ns();
+        }
+        ptc::service_time_tick(config, state);
+        ptc::service_http_tick(config, state);
+        host::task_wait_idle("portal_http", 10000);
+        if (second >= kOnlineSec && report.catch_up_sec == 0 &&
+            ptc::service_log_revision() - revision_at_online >= backlog) {
+            report.catch_up_sec = second - kOnlineSec + 1;
+            report.replay_real_ms = (host::real_now_ns() - online_real_ns) / 1000000ULL;
+        }
+        host::clock_advance_ms(kTickMs);
+    }
+    report.last_error = ptc::service_http_last_error();
+    portal.stop();
+    host::http_use_socket("", 0);
+
+    const std::vector<std::string> ids = logged_backlog_ids();
+    const std::set<std::string> unique(ids.begin(), ids.end());
+    report.applied = static_cast<uint32_t>(ids.size());
+    report.unique = static_cast<uint32_t>(unique.size());
+    report.duplicates = report.applied - report.unique;
+    for (const PortalRecord& record : portal.records()) {
+        if (record.route == "activity") {
+            report.requests++;
+            report.truncated += record.faulted ? 1 : 0;
+        }
+        report.auth_failures += record.auth != PortalAuth::kOk ? 1 : 0;
+    }
+    ptc::service_storage_load_activity_cursor(report.cursor);
+    return report;
+}
+
+void print_report(const ReplayReport& report) {
+    printf("%-14s %7lu %7lu %6lu %8lu %9lu %9lu %9llu\n", report.name,
+        static_cast<unsigned long>(report.unique), static_cast<unsigned long>(report.backlog - report.unique),
+        static_cast<unsigned long>(report.duplicates), static_cast<unsigned long>(report.requests),
+        static_cast<unsigned long>(report.truncated), static_cast<unsigned long>(report.catch_up_sec),
+        static_cast<unsigned long long>(report.replay_real_ms));
+}
+
+} // namespace
+
+int run_activity_sim(int argc, char** argv) {
+    const uint32_t backlog = argc > 1 ? static_cast<uint32_t>(strtoul(argv[1], nullptr, 10)) : 10000;
+    host::clock_use_virtual(true, 1000);
+    host::sd_set_root("/tmp/ptc-host-sd-activity");
+    host::serial_set_enabled(false);
+    const ReplayReport legacy = run_replay(false, backlog);
+    const ReplayReport paged = run_replay(true, backlog);
+    const ReplayReport null_cursor = run_replay(true, backlog, true);
+    host::serial_set_enabled(true);
+
+    printf("\n== activity (%lu clock events, %lu a second, while Wi-Fi is down; %lu per page, %u pages cut short) ==\n",
+        static_cast<unsigned long>(backlog), static_cast<unsigned long>(kEventsPerSecond),
+        static_cast<unsigned long>(kPageSize), static_cast<unsigned>(kTruncatedPages));
+    printf("%-14s %7s %7s %6s %8s %9s %9s %9s\n", "mode", "applied", "lost", "dupes", "requests", "truncated",
+        "catchup_s", "real_ms");
+    print_report(legacy);
+    print_report(paged);
+    print_report(null_cursor);
+    printf("cursor after replay: %s\n", paged.cursor.c_str());
+    fflush(stdout);
+
+    const uint32_t pages = (backlog + kPageSize - 1) / kPageSize;
+    bool ok = true;
+    ok &= check(legacy.auth_failures == 0 && paged.auth_failures == 0, "every activity request verifies");
+    ok &= check(legacy.unique < backlog, "since= polling loses most of a backlog");
+    ok &= check(paged.unique == backlog && paged.duplicates == 0, "cursor pages apply every event exactly once");
+    ok &= check(paged.truncated == kTruncatedPages, "pages cut short were resumed");
+    ok &= check(paged.catch_up_sec > 0 && paged.catch_up_sec <= pages + kTruncatedPages,
+        "pages chained without waiting for the poll interval");
+    ok &= check(paged.cursor == String("v1:") + String(kWarmEvents + backlog), "cursor saved at the end of the backlog");
+    ok &= check(null_cursor.unique == backlog && null_cursor.duplicates == 0 && null_cursor.last_error.isEmpty(),
+        "a null next_cursor is read as none and the repeated last page adds no duplicates");
+    return ok ? 0 : 1;
+}
+
+} // namespace bench
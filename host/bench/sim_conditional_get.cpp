@@ -0,0 +1,243 @@
+#include <cstdio>
+#include <cstdlib>
+#include <mutex>
+#include <string>
+
+#include "bench.h"
+#include "src/services/service_http.h"
+#include "src/services/service_log.h"
+#include "src/services/service_storage.h"
+
+namespace bench {
+
+namespace {
+
+constexpr uint32_t kTickMs = 1000;
+// Notices change every 2 h and the config once, 5 h into each phase.
+constexpr uint32_t kNoticeRevisionMs = 2 * 3600 * 1000;
+constexpr uint32_t kConfigChangeMs = 5 * 3600 * 1000;
+constexpr uint16_t kNoticeCount = 8;
+
+struct PortalCounters {
+    uint32_t requests = 0;
+    uint32_t conditional = 0;
+    uint32_t full = 0;
+    uint32_t not_modified = 0;
+    uint64_t body_bytes = 0;
+};
+
+// Portal stand-in for the config and notices endpoints. With validators on it
+// tags every response with an ETag derived from the content revision and
+// answers a matching If-None-Match with 304 and no body.
+struct Portal {
+    std::mutex mutex;
+    bool validators = false;
+    uint32_t notice_revision = 0;
+    uint32_t qr_interval_sec = 20;
+    PortalCounters config;
+    PortalCounters notices;
+    uint32_t other_requests = 0;
+};
+
+Portal g_portal;
+
+std::string config_body(uint32_t qr_interval_sec) {
+    return std::string("{\"location_id\":\"loc-7\",\"location_name\":\"North depot\",\"qr_interval_sec\":") +
+        std::to_string(qr_interval_sec) + ",\"is_active\":true}";
+}
+
+std::string notice_title(uint32_t revision, uint16_t index) {
+    return "Rota r" + std::to_string(revision) + " #" + std::to_string(index);
+}
+
+std::string notices_body(uint32_t revision) {
+    std::string json = "[";
+    for (uint16_t i = 0; i < kNoticeCount; ++i) {
+        if (i > 0) {
+            json += ",";
+        }
+        json += "{\"id\":\"notice-" + std::to_string(i) + "\",\"title\":\"" + notice_title(revision, i) +
+            "\",\"body\":\"Please review the updated rota before clocking in. Breaks are staggered "
+            "across the team and the kitchen closes at 21:30 on weekdays.\",\"image_url\":\"\","
+            "\"hyperlink_url\":\"https://portal.example.com/notices/" + std::to_string(i) +
+            "\",\"display_seconds\":8,\"sort_order\":" + std::to_string(i) +
+            ",\"created_at\":\"2026-01-01T08:00:00Z\",\"updated_at\":\"2026-01-02T09:30:00Z\"}";
+    }
+    return json + "]";
+}
+
+host::HttpResponse respond(PortalCounters& counters, const host::HttpRequest& request,
+    const std::string& etag, const std::string& body) {
+    host::HttpResponse response;
+    counters.requests++;
+    const auto validator = request.headers.find("If-None-Match");
+    const bool conditional = validator != request.headers.end();
+    if (conditional) {
+        counters.conditional++;
+    }
+    if (g_portal.validators) {
+        response.headers["ETag"] = etag;
+        if (conditional && validator->second == etag) {
+            response.status_code = 304;
+            counters.not_modified++;
+            return response;
+        }
+    }
+    response.body = body;
+    counters.full++;
+    counters.body_bytes += body.size();
+    return response;
+}
+
+host::HttpResponse handle(const host::HttpRequest& request) {
+    std::lock_guard<std::mutex> lock(g_portal.mutex);
+    if (request.path_and_query.find("/devices/config") != std::string::npos) {
+        return respond(g_portal.config, request,
+            "\"cfg-" + std::to_string(g_portal.qr_interval_sec) + "\"",
+            config_body(g_portal.qr_interval_sec));
+    }
+    if (request.path_and_query.find("/notices") != std::string::npos) {
+        host::HttpResponse response = respond(g_portal.notices, request,
+            "\"ntc-" + std::to_string(g_portal.notice_revision) + "\"",
+            notices_body(g_portal.notice_revision));
+        if (response.status_code == 200) {
+            response.headers["Transfer-Encoding"] = "chunked";
+        }
+        return response;
+    }
+    g_portal.other_requests++;
+    host::HttpResponse response;
+    response.body = request.path_and_query.find("/activity") != std::string::npos ? "[]" : "{}";
+    return response;
+}
+
+struct PhaseReport {
+    PortalCounters config;
+    PortalCounters notices;
+    uint32_t notice_changes = 0;
+    uint32_t config_changes = 0;
+    host::StorageWriteStats storage;
+    bool in_sync = true;
+};
+
+PhaseReport run_phase(bool validators, uint32_t seconds, ptc::DeviceConfig& config, ptc::AppState& state) {
+    {
+        std::lock_guard<std::mutex> lock(g_portal.mutex);
+        g_portal.validators = validators;
+        g_portal.config = PortalCounters();
+        g_portal.notices = PortalCounters();
+    }
+    PhaseReport report;
+    const host::StorageWriteStats before = host::storage_write_stats();
+    const uint32_t start_ms = millis();
+    uint32_t last_revision_ms = start_ms;
+    bool config_changed = false;
+
+    for (uint32_t elapsed_ms = 0; elapsed_ms < seconds * 1000U; elapsed_ms += kTickMs) {
+        const uint32_t now_ms = millis();
+        {
+            std::lock_guard<std::mutex> lock(g_portal.mutex);
+            if (now_ms - last_revision_ms >= kNoticeRevisionMs) {
+                g_portal.notice_revision++;
+                last_revision_ms = now_ms;
+                report.notice_changes++;
+            }
+            if (!config_changed && now_ms - start_ms >= kConfigChangeMs) {
+                g_portal.qr_interval_sec = g_portal.qr_interval_sec == 20 ? 30 : 20;
+                config_changed = true;
+                report.config_changes++;
+            }
+        }
+        ptc::service_http_tick(config, state);
+        // Let the worker answer everything the tick queued before time moves.
+        host::task_wait_idle("portal_http");
+        host::clock_advance_ms(kTickMs);
+    }
+    ptc::service_http_tick(config, state);
+
+    const host::StorageWriteStats after = host::storage_write_stats();
+    report.storage.sd_rewrites = after.sd_rewrites - before.sd_rewrites;
+    report.storage.sd_appends = after.sd_appends - before.sd_appends;
+    report.storage.sd_bytes_written = after.sd_bytes_written - before.sd_bytes_written;
+    report.storage.nvs_writes = after.nvs_writes - before.nvs_writes;
+
+    std::lock_guard<std::mutex> lock(g_portal.mutex);
+    report.config = g_portal.config;
+    report.notices = g_portal.notices;
+    ptc::Notice first;
+    report.in_sync = config.qr_interval_sec == g_portal.qr_interval_sec &&
+        ptc::service_http_notice_count() == kNoticeCount &&
+        ptc::service_http_get_notice(0, first) &&
+        first.title == notice_title(g_portal.notice_revision, 0).c_str();
+    return report;
+}
+
+void print_report(const char* model, const PhaseReport& report) {
+    printf("%-14s %6u %6u %6u %9.1f %6u %6u %6u %9.1f %8u %7u %5u\n",
+        model,
+        static_cast<unsigned>(report.config.requests),
+        static_cast<unsigned>(report.config.not_modified),
+        static_cast<unsigned>(report.config.conditional),
+        report.config.body_bytes / 1024.0,
+        static_cast<unsigned>(report.notices.requests),
+        static_cast<unsigned>(report.notices.not_modified),
+        static_cast<unsigned>(report.notices.conditional),
+        report.notices.body_bytes / 1024.0,
+        static_cast<unsigned>(report.storage.sd_rewrites),
+        static_cast<unsigned>(report.storage.sd_appends),
+        static_cast<unsigned>(report.storage.nvs_writes));
+    fflush(stdout);
+}
+
+} // namespace
+
+int run_conditional_get_sim(int argc, char** argv) {
+    const uint32_t seconds = argc > 1 ? static_cast<uint32_t>(strtoul(argv[1], nullptr, 10)) : 6 * 3600;
+    bool ok = true;
+
+    host::clock_use_virtual(true, 1000);
+    host::sd_set_root("/tmp/ptc-host-sd-conditional");
+    host::sd_wipe();
+    host::http_set_handler(handle);
+    host::serial_set_enabled(false);
+    ptc::service_storage_init();
+    ptc::service_log_init();
+
+    ptc::DeviceConfig config;
+    config.device_id = "ESP32S3-A1B2C3D4E5F6";
+    config.device_secret = "9f3c1a7e5b2d4c6f8a0e1b3d5f7a9c2e4b6d8f0a1c3e5a7b9d2f4a6c8e0b1d3f";
+    ptc::AppState state;
+    state.time_sync_ok = true;
+    state.provisioning_complete = true;
+    ptc::service_http_init();
+
+    const PhaseReport plain = run_phase(false, seconds, config, state);
+    const PhaseReport conditional = run_phase(true, seconds, config, state);
+    host::serial_set_enabled(true);
+    host::http_set_handler(nullptr);
+
+    printf("\n== conditional GET (virtual clock, %u s per phase; config/notices polls, SD and NVS writes) ==\n",
+        static_cast<unsigned>(seconds));
+    printf("%-14s %6s %6s %6s %9s %6s %6s %6s %9s %8s %7s %5s\n",
+        "portal", "cfg", "304", "cond", "cfg_kb", "ntc", "304", "cond", "ntc_kb", "rewrites", "appends", "nvs");
+    print_report("no validators", plain);
+    print_report("etag", conditional);
+
+    ok &= check(plain.in_sync && conditional.in_sync, "device config and notices follow the portal");
+    ok &= check(plain.config.conditional == 0 && plain.notices.conditional == 0,
+        "no If-None-Match without an ETag");
+    ok &= check(conditional.config.not_modified > 0 && conditional.notices.not_modified > 0,
+        "unchanged polls answered with 304");
+    // Every poll after the first ETag is conditional; only content changes
+    // (and the first response carrying a validator) come back in full.
+    ok &= check(conditional.config.full == conditional.config_changes + 1 &&
+            conditional.notices.full == conditional.notice_changes + 1,
+        "only changed content is downloaded");
+    ok &= check(conditional.notices.body_bytes * 4 < plain.notices.body_bytes,
+        "notice download volume drops");
+    ok &= check(conditional.storage.sd_rewrites <= plain.storage.sd_rewrites,
+        "no more SD rewrites than content changes");
+    return ok ? 0 : 1;
+}
+
+} // namespace bench
@@ -0,0 +1,260 @@
+#include <cstdio>
+#include <cstdlib>
+#include <deque>
+#include <vector>
+
+#include <freertos/FreeRTOS.h>
+#include <freertos/task.h>
+
+#include "bench.h"
+#include "src/services/service_scheduler.h"
+
+namespace bench {
+
+namespace {
+
+// Event sources that end the loop's sleep, with the rate at which they fire.
+enum EventKind : uint8_t {
+    kTouchIrq,
+    kHttpResult,
+    kOtaResult,
+    kEventKindCount,
+};
+
+struct EventSource {
+    const char* name;
+    uint32_t bits;
+    uint32_t per_minute;
+};
+
+// On the device touch IRQs notify the render task; here every source wakes
+// the one simulated loop.
+constexpr uint32_t kTouchEventBit = 1UL << 31;
+
+constexpr EventSource kSources[kEventKindCount] = {
+    {"touch", kTouchEventBit, 120},
+    {"http", ptc::kSchedulerEventHttpResult, 30},
+    {"ota", ptc::kSchedulerEventOtaResult, 6},
+};
+
+// Periods mirror main.cpp before and after the event-driven loop.
+struct SimService {
+    const char* name;
+    uint32_t legacy_period_ms;
+    uint32_t period_ms;
+    uint32_t cost_us;
+    int8_t consumes;
+};
+
+constexpr SimService kServices[] = {
+    {"wifi", 25, 25, 40, -1},
+    {"ota", 60, 60, 20, kOtaResult},
+    {"time", 200, 200, 30, -1},
+    {"http", 40, 100, 250, kHttpResult},
+    {"qr", 80, 80, 60, -1},
+    {"log", 120, 120, 5, -1},
+    {"screen_idle", 250, 1000, 5, -1},
+};
+constexpr size_t kServiceCount = sizeof(kServices) / sizeof(kServices[0]);
+constexpr uint32_t kLegacySleepMs = 5;
+constexpr uint32_t kLoopPassCostUs = 30;
+constexpr uint32_t kTouchReadCostUs = 120;
+constexpr uint32_t kLvglTimerPeriodMs = 1000;
+
+std::deque<uint64_t> g_pending[kEventKindCount];
+std::vector<uint64_t> g_latency_us[kEventKindCount];
+uint64_t g_busy_us = 0;
+
+void spend_us(uint32_t us) {
+    host::clock_advance_us(us);
+    g_busy_us += us;
+}
+
+// Handles every event of this kind that has happened by now.
+void consume(uint8_t kind) {
+    const uint64_t now_us = host::clock_now_us();
+    std::deque<uint64_t>& pending = g_pending[kind];
+    while (!pending.empty() && pending.front() <= now_us) {
+        g_latency_us[kind].push_back(now_us - pending.front());
+        pending.pop_front();
+    }
+}
+
+void run_service(size_t index) {
+    if (kServices[index].consumes >= 0) {
+        consume(static_cast<uint8_t>(kServices[index].consumes));
+    }
+    spend_us(kServices[index].cost_us);
+}
+
+template <size_t Index>
+void sim_tick(uint32_t now_ms) {
+    (void)now_ms;
+    run_service(Index);
+}
+
+constexpr ptc::SchedulerTickFn kTicks[kServiceCount] = {
+    sim_tick<0>, sim_tick<1>, sim_tick<2>, sim_tick<3>, sim_tick<4>, sim_tick<5>, sim_tick<6>,
+};
+
+// The touch driver only reads the panel when its IRQ flag is set.
+void poll_touch() {
+    const uint64_t now_us = host::clock_now_us();
+    if (!g_pending[kTouchIrq].empty() && g_pending[kTouchIrq].front() <= now_us) {
+        consume(kTouchIrq);
+        spend_us(kTouchReadCostUs);
+    }
+}
+
+// Queues the same pseudo-random event times for every model; when
+// loop_task is set they are also delivered as task notifications.
+uint32_t schedule_events(uint32_t start_ms, uint32_t seconds, HostTask* loop_task) {
+    srand(11);
+    std::vector<uint64_t> times[kEventKindCount];
+    uint32_t total = 0;
+    for (uint8_t kind = 0; kind < kEventKindCount; ++kind) {
+        g_pending[kind].clear();
+        g_latency_us[kind].clear();
+        const uint32_t count = kSources[kind].per_minute * seconds / 60U;
+        for (uint32_t i = 0; i < count; ++i) {
+            const uint64_t at_us = start_ms * 1000ULL + static_cast<uint64_t>(rand()) % (seconds * 1000000ULL);
+            times[kind].push_back(at_us);
+            if (loop_task) {
+                host::task_notify_at_us(loop_task, at_us, kSources[kind].bits);
+            }
+        }
+        std::sort(times[kind].begin(), times[kind].end());
+        g_pending[kind].assign(times[kind].begin(), times[kind].end());
+        total += count;
+    }
+    return total;
+}
+
+struct LoopReport {
+    double wakeups_per_sec = 0.0;
+    double event_wakeups_per_sec = 0.0;
+    double busy_percent = 0.0;
+    Stats latency[kEventKindCount];
+    uint32_t unhandled = 0;
+};
+
+LoopReport collect(uint64_t wakeups, uint64_t event_wakeups, uint32_t seconds) {
+    LoopReport report;
+    report.wakeups_per_sec = static_cast<double>(wakeups) / seconds;
+    report.event_wakeups_per_sec = static_cast<double>(event_wakeups) / seconds;
+    report.busy_percent = 100.0 * static_cast<double>(g_busy_us) / (seconds * 1000000.0);
+    for (uint8_t kind = 0; kind < kEventKindCount; ++kind) {
+        report.latency[kind] = summarize(g_latency_us[kind]);
+        report.unhandled += static_cast<uint32_t>(g_pending[kind].size());
+    }
+    return report;
+}
+
+// loop() before the change: touch polled and every service tick checked on
+// each pass, then a fixed sleep; worker results wait for the next tick.
+LoopReport run_polling(uint32_t seconds) {
+    host::clock_use_virtual(true, 1000);
+    host::task_clear_pending_notifications();
+    g_busy_us = 0;
+    const uint32_t start_ms = millis();
+    schedule_events(start_ms, seconds, nullptr);
+    uint32_t last_tick_ms[kServiceCount] = {};
+    const uint32_t end_ms = start_ms + seconds * 1000U;
+    uint64_t wakeups = 0;
+    while (static_cast<int32_t>(millis() - end_ms) < 0) {
+        spend_us(kLoopPassCostUs);
+        poll_touch();
+        const uint32_t now_ms = millis();
+        for (size_t i = 0; i < kServiceCount; ++i) {
+            if (now_ms - last_tick_ms[i] >= kServices[i].legacy_period_ms) {
+                last_tick_ms[i] = now_ms;
+                run_service(i);
+            }
+        }
+        delay(kLegacySleepMs);
+        wakeups++;
+    }
+    // Results still queued at the end were never going to be late by more
+    // than a tick; drain them so the counts compare like for like.
+    for (size_t i = 0; i < kServiceCount; ++i) {
+        run_service(i);
+    }
+    poll_touch();
+    return collect(wakeups, 0, seconds);
+}
+
+// loop() after the change: sleep until the next scheduler, LVGL or touch
+// deadline, or until an IRQ or worker result signals the loop task.
+LoopReport run_event_driven(uint32_t seconds, uint32_t& scheduled_events) {
+    host::clock_use_virtual(true, 1000);
+    host::task_clear_pending_notifications();
+    ptc::service_scheduler_reset();
+    g_busy_us = 0;
+    for (size_t i = 0; i < kServiceCount; ++i) {
+        const int8_t consumes = kServices[i].consumes;
+        ptc::service_scheduler_add(kServices[i].name,
+            kServices[i].period_ms,
+            kTicks[i],
+            false,
+            consumes >= 0 ? kSources[consumes].bits : 0);
+    }
+    const uint32_t start_ms = millis();
+    scheduled_events = schedule_events(start_ms, seconds, xTaskGetCurrentTaskHandle());
+    uint32_t last_lvgl_ms = start_ms;
+    const uint32_t end_ms = start_ms + seconds * 1000U;
+    while (static_cast<int32_t>(millis() - end_ms) < 0) {
+        spend_us(kLoopPassCostUs);
+        poll_touch();
+        uint32_t sleep_ms = ptc::service_scheduler_run_due();
+        const uint32_t now_ms = millis();
+        if (now_ms - last_lvgl_ms >= kLvglTimerPeriodMs) {
+            last_lvgl_ms = now_ms;
+        }
+        sleep_ms = min(sleep_ms, kLvglTimerPeriodMs - (now_ms - last_lvgl_ms));
+        ptc::service_scheduler_sleep(min(sleep_ms, end_ms - millis()));
+    }
+    host::task_clear_pending_notifications();
+    return collect(ptc::service_scheduler_wakeups(), ptc::service_scheduler_event_wakeups(), seconds);
+}
+
+void print_report(const char* model, const LoopReport& report) {
+    printf("%-22s %9.1f %9.1f %7.2f", model, report.wakeups_per_sec, report.event_wakeups_per_sec, report.busy_percent);
+    for (const Stats& latency : report.latency) {
+        printf(" %9.3f %9.3f", latency.mean_ns / 1000.0, static_cast<double>(latency.max_ns) / 1000.0);
+    }
+    printf("\n");
+    fflush(stdout);
+}
+
+} // namespace
+
+int run_event_loop_sim(int argc, char** argv) {
+    const uint32_t seconds = argc > 1 ? static_cast<uint32_t>(strtoul(argv[1], nullptr, 10)) : 60;
+    bool ok = true;
+
+    printf("\n== event loop (virtual clock, %u s; latency in ms) ==\n", static_cast<unsigned>(seconds));
+    printf("%-22s %9s %9s %7s", "model", "wakeups/s", "events/s", "busy%");
+    for (const EventSource& source : kSources) {
+        printf(" %9s %9s", source.name, "max");
+    }
+    printf("\n");
+
+    const LoopReport polling = run_polling(seconds);
+    print_report("polling loop (5 ms)", polling);
+    uint32_t scheduled_events = 0;
+    const LoopReport event_driven = run_event_driven(seconds, scheduled_events);
+    print_report("event-driven loop", event_driven);
+
+    ok &= check(scheduled_events > 0 && event_driven.unhandled == 0, "every signalled event is handled");
+    ok &= check(polling.unhandled == 0, "the polling loop handles every event");
+    for (uint8_t kind = 0; kind < kEventKindCount; ++kind) {
+        ok &= check(event_driven.latency[kind].max_ns < 1000000, "event-to-handling latency stays under 1 ms");
+        ok &= check(event_driven.latency[kind].mean_ns < polling.latency[kind].mean_ns,
+            "signalled events are handled sooner than polled ones");
+    }
+    ok &= check(event_driven.wakeups_per_sec * 2 < polling.wakeups_per_sec, "wakeups drop well below polling");
+    ok &= check(event_driven.event_wakeups_per_sec > 0, "event wakeups are counted");
+    return ok ? 0 : 1;
+}
+
+} // namespace bench
@@ -0,0 +1,263 @@
+#include <HTTPClient.h>
+#include <WiFiClient.h>
+
+#include <algorithm>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <string>
+#include <vector>
+
+#include "bench.h"
+#include "mock_portal.h"
+#include "src/services/service_auth.h"
+#include "src/services/service_http_breaker.h"
+
+namespace bench {
+
+namespace {
+
+// A site's devices booted together after a power cut, so their polls line
+// up to the second; then the portal answers 503 on every route for 15 min.
+constexpr uint32_t kTickMs = 1000;
+constexpr uint32_t kOutageSec = 600;
+constexpr uint32_t kOutageEndSec = 1500;
+constexpr uint32_t kEndSec = 2400;
+constexpr uint32_t kAfterOutageSec = 300;
+constexpr uint32_t kHistogramBucketSec = 60;
+constexpr uint32_t kHeartbeatIntervalMs = 60000;
+constexpr uint32_t kActivityIntervalMs = 30000;
+constexpr uint32_t kLockstepBackoffStartMs = 5000;
+constexpr const char* kBaseUrl = "https://portal.local";
+
+enum class Policy : uint8_t {
+    // service_http before per-endpoint breakers: one gate per device, 5 s
+    // doubling to 300 s, set once per tick whichever request failed.
+    kLockstep,
+    kBreakers,
+};
+
+struct Endpoint {
+    const char* method;
+    const char* path;
+    uint32_t interval_ms;
+    uint32_t last_ms = 0;
+    ptc::HttpBreaker breaker;
+};
+
+struct Device {
+    std::string id;
+    std::string secret;
+    std::string heartbeat_body;
+    std::string activity_path;
+    Endpoint endpoints[2] = {
+        {"POST", "/api/timeclock/devices/heartbeat", kHeartbeatIntervalMs},
+        {"GET", nullptr, kActivityIntervalMs},
+    };
+    uint32_t retry_started_ms = 0;
+    uint32_t retry_delay_ms = 0;
+    uint32_t backoff_ms = kLockstepBackoffStartMs;
+    uint32_t recovered_ms = 0;
+};
+
+struct FleetReport {
+    const char* name = "";
+    uint32_t outage_requests = 0;
+    // Requests in the busiest second once the first failed poll is over.
+    uint32_t peak_per_sec = 0;
+    // Seconds of the outage in which at least one retry arrived.
+    uint32_t busy_sec = 0;
+    uint32_t recover_p50_sec = 0;
+    uint32_t recover_max_sec = 0;
+    uint32_t recovered = 0;
+    uint32_t auth_failures = 0;
+    std::vector<uint32_t> histogram;
+};
+
+int send(ptc::HmacSigner& signer, const Device& device, const Endpoint& endpoint) {
+    const std::string path = endpoint.path ? endpoint.path : device.activity_path;
+    const bool post = strcmp(endpoint.method, "POST") == 0;
+    const String body = post ? String(device.heartbeat_body.c_str()) : String();
+    char timestamp[12];
+    snprintf(timestamp, sizeof(timestamp), "%lu", static_cast<unsigned long>(time(nullptr)));
+    char nonce[ptc::kNonceLength + 1];
+    ptc::service_auth_format_nonce(nonce, sizeof(nonce));
+    char signature[ptc::kSignatureLength + 1];
+    signer.set_key(String(device.secret.c_str()));
+    if (!signer.sign_request(endpoint.method, String(path.c_str()), timestamp, nonce, body,
+            signature, sizeof(signature))) {
+        return 0;
+    }
+    WiFiClient client;
+    HTTPClient http;
+    http.begin(client, String(kBaseUrl) + path.c_str());
+    http.addHeader("X-PTC-Device-Id", device.id.c_str());
+    http.addHeader("X-PTC-Timestamp", timestamp);
+    http.addHeader("X-PTC-Nonce", nonce);
+    http.addHeader("X-PTC-Signature", signature);
+    const int status = post ? http.POST(body) : http.GET();
+    http.getString();
+    http.end();
+    return status;
+}
+
+void tick_device(Policy policy, ptc::HmacSigner& signer, Device& device, uint32_t outage_end_ms) {
+    const uint32_t now = millis();
+    if (policy == Policy::kLockstep && device.retry_delay_ms != 0) {
+        if (now - device.retry_started_ms < device.retry_delay_ms) {
+            return;
+        }
+        device.retry_delay_ms = 0;
+    }
+    bool failed = false;
+    for (Endpoint& endpoint : device.endpoints) {
+        if (endpoint.last_ms != 0 && now - endpoint.last_ms < endpoint.interval_ms) {
+            continue;
+        }
+        if (policy == Policy::kBreakers && !ptc::service_http_breaker_allow(endpoint.breaker)) {
+            continue;
+        }
+        const int status = send(signer, device, endpoint);
+        if (status >= 200 && status < 300) {
+            endpoint.last_ms = now;
+            ptc::service_http_breaker_success(endpoint.breaker);
+            device.backoff_ms = kLockstepBackoffStartMs;
+            if (now >= outage_end_ms && device.recovered_ms == 0) {
+                device.recovered_ms = now;
+            }
+        } else if (policy == Policy::kBreakers) {
+            ptc::service_http_breaker_failure(endpoint.breaker, status);
+        } else {
+            failed = true;
+        }
+    }
+    if (failed) {
+        device.retry_started_ms = now;
+        device.retry_delay_ms = device.backoff_ms;
+        device.backoff_ms = std::min<uint32_t>(device.backoff_ms * 2, ptc::kHttpBreakerMaxMs);
+    }
+}
+
+FleetReport run_fleet(Policy policy, uint16_t device_count) {
+    MockPortal portal;
+    std::vector<Device> devices(device_count);
+    for (uint16_t i = 0; i < device_count; ++i) {
+        char id[32];
+        snprintf(id, sizeof(id), "fleet-%04u", static_cast<unsigned>(i));
+        Device& device = devices[i];
+        device.id = id;
+        device.secret = std::string(ptc::service_auth_sha256_hex(String(id)).c_str());
+        device.heartbeat_body = "{\"device_id\":\"" + device.id + "\"}";
+        device.activity_path = "/api/timeclock/devices/activity?device_id=" + device.id;
+        portal.add_device(device.id, device.secret);
+    }
+    FleetReport report;
+    report.name = policy == Policy::kLockstep ? "global doubling" : "endpoint breakers";
+    if (!portal.start()) {
+        return report;
+    }
+    host::http_use_socket("127.0.0.1", portal.port());
+
+    const uint32_t base_ms = millis();
+    auto at = [base_ms](uint32_t seconds) { return base_ms + seconds * 1000; };
+    PortalFault outage;
+    outage.start_ms = at(kOutageSec);
+    outage.end_ms = at(kOutageEndSec);
+    outage.status = 503;
+    portal.set_faults({outage});
+
+    ptc::HmacSigner signer;
+    for (uint32_t second = 0; second < kEndSec; ++second) {
+        for (Device& device : devices) {
+            tick_device(policy, signer, device, at(kOutageEndSec));
+        }
+        host::clock_advance_ms(kTickMs);
+    }
+    portal.stop();
+    host::http_use_socket("", 0);
+
+    const std::vector<PortalRecord> records = portal.records();
+    std::vector<uint32_t> per_sec(kOutageEndSec + kAfterOutageSec - kOutageSec, 0);
+    report.histogram.assign((kOutageEndSec - kOutageSec) / kHistogramBucketSec, 0);
+    for (const PortalRecord& record : records) {
+        report.auth_failures += record.auth != PortalAuth::kOk ? 1 : 0;
+        if (record.at_ms < at(kOutageSec)) {
+            continue;
+        }
+        const uint32_t second = (record.at_ms - at(kOutageSec)) / 1000;
+        if (second < per_sec.size()) {
+            per_sec[second]++;
+        }
+        if (record.at_ms < at(kOutageEndSec)) {
+            report.outage_requests++;
+            report.histogram[second / kHistogramBucketSec]++;
+        }
+    }
+    // Second 0 is the poll that found the portal down, the same for both.
+    for (uint32_t second = 1; second < per_sec.size(); ++second) {
+        report.peak_per_sec = std::max(report.peak_per_sec, per_sec[second]);
+        report.busy_sec += second < kOutageEndSec - kOutageSec && per_sec[second] > 0 ? 1 : 0;
+    }
+    std::vector<uint32_t> recover_sec;
+    for (const Device& device : devices) {
+        if (device.recovered_ms != 0) {
+            recover_sec.push_back((device.recovered_ms - at(kOutageEndSec)) / 1000);
+        }
+    }
+    std::sort(recover_sec.begin(), recover_sec.end());
+    report.recovered = static_cast<uint32_t>(recover_sec.size());
+    if (!recover_sec.empty()) {
+        report.recover_p50_sec = recover_sec[recover_sec.size() / 2];
+        report.recover_max_sec = recover_sec.back();
+    }
+    return report;
+}
+
+void print_report(const FleetReport& report) {
+    printf("%-18s %8u %9u %8u %8u %8u\n", report.name, static_cast<unsigned>(report.outage_requests),
+        static_cast<unsigned>(report.peak_per_sec), static_cast<unsigned>(report.busy_sec),
+        static_cast<unsigned>(report.recover_p50_sec), static_cast<unsigned>(report.recover_max_sec));
+}
+
+void print_histogram(const FleetReport& report) {
+    std::string line;
+    for (const uint32_t count : report.histogram) {
+        char cell[8];
+        snprintf(cell, sizeof(cell), "%5u", static_cast<unsigned>(count));
+        line += cell;
+    }
+    printf("%-18s%s\n", report.name, line.c_str());
+}
+
+} // namespace
+
+int run_fleet_sim(int argc, char** argv) {
+    const uint16_t device_count = argc > 1 ? static_cast<uint16_t>(strtoul(argv[1], nullptr, 10)) : 48;
+    host::clock_use_virtual(true, 1000);
+    host::serial_set_enabled(false);
+    const FleetReport lockstep = run_fleet(Policy::kLockstep, device_count);
+    const FleetReport breakers = run_fleet(Policy::kBreakers, device_count);
+    host::serial_set_enabled(true);
+
+    printf("\n== fleet (%u devices booted together, mock portal 503 for %u s; retry spread) ==\n",
+        static_cast<unsigned>(device_count), static_cast<unsigned>(kOutageEndSec - kOutageSec));
+    printf("%-18s %8s %9s %8s %8s %8s\n", "policy", "outage", "peak_rps", "busy_s", "rec_p50", "rec_max");
+    print_report(lockstep);
+    print_report(breakers);
+    printf("requests per %u s during the outage:\n", static_cast<unsigned>(kHistogramBucketSec));
+    print_histogram(lockstep);
+    print_histogram(breakers);
+    fflush(stdout);
+
+    bool ok = true;
+    ok &= check(lockstep.auth_failures == 0 && breakers.auth_failures == 0, "every fleet request verifies");
+    ok &= check(lockstep.peak_per_sec >= device_count, "doubling backoff retries the whole fleet in the same second");
+    ok &= check(breakers.peak_per_sec * 3 <= lockstep.peak_per_sec, "jittered retries cut the peak by 3x or more");
+    ok &= check(breakers.busy_sec >= lockstep.busy_sec * 4, "jittered retries spread over the outage");
+    ok &= check(breakers.recovered == device_count &&
+            breakers.recover_max_sec <= ptc::kHttpBreakerMaxMs / 1000 + 1,
+        "every device recovers within one capped backoff");
+    return ok ? 0 : 1;
+}
+
+} // namespace bench
@@ -0,0 +1,278 @@
+#include <cstdio>
+#include <cstdlib>
+#include <vector>
+
+#include "bench.h"
+#include "src/services/service_http_queue.h"
+
+namespace bench {
+
+namespace {
+
+// Request kinds in the slot order service_http.cpp uses (registration, slot
+// 0, does not occur once provisioned, and sync replaces the polled kinds
+// only when the portal offers it).
+enum SimSlot : uint8_t {
+    kRegister,
+    kManualCode,
+    kConfig,
+    kHeartbeat,
+    kActivity,
+    kNotices,
+    kSlotCount,
+};
+
+struct SimKind {
+    const char* name;
+    uint32_t period_ms;
+    uint32_t body_bytes;
+    uint32_t server_ms;
+    bool preemptible;
+};
+
+// A busy site on a weak link: large notice and activity payloads refreshed
+// often (forced notice fetches, short activity interval) next to the
+// per-payload manual-code requests of a 20 s QR rotation.
+constexpr SimKind kKinds[kSlotCount] = {
+    {"register", 0, 0, 0, false},
+    {"manual-code", 0, 300, 250, false},
+    {"config", 300000, 2048, 120, false},
+    {"heartbeat", 60000, 200, 150, false},
+    {"activity", 30000, 24 * 1024, 300, true},
+    {"notices", 45000, 64 * 1024, 400, true},
+};
+constexpr uint32_t kQrRotationMs = 20000;
+constexpr uint32_t kTickMs = 100;
+constexpr uint32_t kRttMs = 120;
+constexpr uint32_t kLinkBytesPerMs = 16;
+constexpr uint32_t kChunkBytes = 1436;
+
+struct SimRequest {
+    uint8_t slot;
+    uint32_t payload;
+};
+
+struct InFlight {
+    SimRequest* request = nullptr;
+    uint8_t slot = 0;
+    uint32_t header_ms = 0;
+    uint32_t body_left = 0;
+    uint32_t since_chunk = 0;
+    uint32_t delivered = 0;
+};
+
+struct QueueReport {
+    Stats manual_latency;
+    uint32_t manual_served = 0;
+    uint32_t completed[kSlotCount] = {};
+    uint32_t preempted = 0;
+    uint32_t wasted_bytes = 0;
+    uint32_t coalesced = 0;
+    uint32_t refused = 0;
+    uint8_t max_depth = 0;
+    bool counts_balance = true;
+};
+
+// legacy: one request in flight or queued at a time, chosen by the loop
+// tick (the single-slot queues before this change). queue: every due kind
+// is queued at once and manual codes preempt notice/activity downloads.
+QueueReport run_model(bool prioritized, uint32_t seconds) {
+    host::clock_use_virtual(true, 1000);
+    srand(23);
+    ptc::HttpQueue queue;
+    ptc::service_http_queue_init(queue);
+
+    QueueReport report;
+    std::vector<uint64_t> manual_latency_ns;
+    uint32_t last_done_ms[kSlotCount] = {};
+    uint8_t outstanding[kSlotCount] = {};
+    const uint32_t start_ms = millis();
+    const uint32_t end_ms = start_ms + seconds * 1000U;
+    uint32_t payload = 0;
+    uint32_t payload_since_ms = start_ms;
+    uint32_t payload_done = UINT32_MAX;
+    uint32_t payload_queued = UINT32_MAX;
+    InFlight flight;
+
+    auto push = [&](uint8_t slot) {
+        auto* request = new SimRequest{slot, payload};
+        void* waiting = nullptr;
+        if (!ptc::service_http_queue_push(queue, slot, request, waiting)) {
+            delete request;
+            report.refused++;
+            return;
+        }
+        auto* replaced = static_cast<SimRequest*>(waiting);
+        if (replaced) {
+            delete replaced;
+        } else {
+            outstanding[slot]++;
+        }
+        if (slot == kManualCode) {
+            payload_queued = payload;
+        }
+        report.max_depth = std::max(report.max_depth, queue.depth);
+    };
+    auto due = [&](uint8_t slot, uint32_t now_ms) {
+        if (slot == kManualCode) {
+            return payload_done != payload;
+        }
+        return last_done_ms[slot] == 0 || now_ms - last_done_ms[slot] >= kKinds[slot].period_ms;
+    };
+    auto finish = [&](uint32_t now_ms) {
+        SimRequest* request = flight.request;
+        report.completed[request->slot]++;
+        if (outstanding[request->slot] == 0) {
+            report.counts_balance = false;
+        } else {
+            outstanding[request->slot]--;
+        }
+        if (request->slot == kManualCode) {
+            if (request->payload == payload) {
+                payload_done = payload;
+                report.manual_served++;
+                manual_latency_ns.push_back(static_cast<uint64_t>(now_ms - payload_since_ms) * 1000000ULL);
+            }
+        } else {
+            last_done_ms[request->slot] = now_ms;
+        }
+        delete request;
+        flight.request = nullptr;
+    };
+
+    while (static_cast<int32_t>(millis() - end_ms) < 0) {
+        const uint32_t now_ms = millis();
+        if (now_ms - payload_since_ms >= kQrRotationMs) {
+            payload++;
+            payload_since_ms = now_ms;
+        }
+
+        if ((now_ms - start_ms) % kTickMs == 0) {
+            if (prioritized) {
+                for (uint8_t slot = kManualCode; slot < kSlotCount; ++slot) {
+                    const bool newer_payload = slot == kManualCode && payload_queued != payload;
+                    if (due(slot, now_ms) && (outstanding[slot] == 0 || newer_payload)) {
+                        push(slot);
+                    }
+                }
+            } else if (!flight.request && queue.depth == 0) {
+                for (uint8_t slot = kManualCode; slot < kSlotCount; ++slot) {
+                    if (due(slot, now_ms)) {
+                        push(slot);
+                        break;
+                    }
+                }
+            }
+        }
+
+        if (!flight.request) {
+            uint8_t slot = 0;
+            uint32_t waited_ms = 0;
+            auto* request = static_cast<SimRequest*>(ptc::service_http_queue_pop(queue, slot, waited_ms));
+            if (request) {
+                flight = InFlight();
+                flight.request = request;
+                flight.slot = slot;
+                flight.header_ms = kRttMs + kKinds[slot].server_ms + static_cast<uint32_t>(rand() % 80);
+                flight.body_left = kKinds[slot].body_bytes;
+            }
+        }
+
+        if (flight.request) {
+            if (flight.header_ms > 0) {
+                flight.header_ms--;
+            } else {
+                const uint32_t bytes = std::min(kLinkBytesPerMs, flight.body_left);
+                flight.body_left -= bytes;
+                flight.since_chunk += bytes;
+                flight.delivered += bytes;
+                if (flight.body_left == 0) {
+                    finish(now_ms + 1);
+                } else if (flight.since_chunk >= kChunkBytes) {
+                    flight.since_chunk = 0;
+                    if (prioritized && kKinds[flight.slot].preemptible &&
+                        ptc::service_http_queue_urgent(queue, kManualCode)) {
+                        report.preempted++;
+                        report.wasted_bytes += flight.delivered;
+                        if (!ptc::service_http_queue_requeue(queue, flight.slot, flight.request)) {
+                            outstanding[flight.slot]--;
+                            delete flight.request;
+                        }
+                        flight.request = nullptr;
+                    }
+                }
+            }
+        }
+        host::clock_advance_ms(1);
+    }
+
+    delete flight.request;
+    uint8_t slot = 0;
+    uint32_t waited_ms = 0;
+    while (auto* request = static_cast<SimRequest*>(ptc::service_http_queue_pop(queue, slot, waited_ms))) {
+        delete request;
+    }
+    report.coalesced = queue.coalesced;
+    report.manual_latency = summarize(manual_latency_ns);
+    return report;
+}
+
+void print_report(const char* model, const QueueReport& report) {
+    printf("%-20s %7u %9.0f %9.0f %9.0f %8u %8u %8u %8u %9.1f %9u %6u\n",
+        model,
+        static_cast<unsigned>(report.manual_served),
+        static_cast<double>(report.manual_latency.p50_ns) / 1e6,
+        static_cast<double>(report.manual_latency.p99_ns) / 1e6,
+        static_cast<double>(report.manual_latency.max_ns) / 1e6,
+        static_cast<unsigned>(report.completed[kHeartbeat]),
+        static_cast<unsigned>(report.completed[kActivity]),
+        static_cast<unsigned>(report.completed[kNotices]),
+        static_cast<unsigned>(report.preempted),
+        report.wasted_bytes / 1024.0,
+        static_cast<unsigned>(report.coalesced),
+        static_cast<unsigned>(report.max_depth));
+    fflush(stdout);
+}
+
+} // namespace
+
+int run_http_queue_sim(int argc, char** argv) {
+    const uint32_t seconds = argc > 1 ? static_cast<uint32_t>(strtoul(argv[1], nullptr, 10)) : 3600;
+    bool ok = true;
+
+    printf("\n== http queue (virtual clock, %u s, %u B/ms link; manual-code latency in ms) ==\n",
+        static_cast<unsigned>(seconds),
+        static_cast<unsigned>(kLinkBytesPerMs));
+    printf("%-20s %7s %9s %9s %9s %8s %8s %8s %8s %9s %9s %6s\n",
+        "model", "codes", "p50", "p99", "max", "heartbt", "activity", "notices", "preempt", "waste_kb", "coalesced", "depth");
+
+    host::serial_set_enabled(false);
+    const QueueReport legacy = run_model(false, seconds);
+    const QueueReport prioritized = run_model(true, seconds);
+    host::serial_set_enabled(true);
+    print_report("single slot", legacy);
+    print_report("priority queue", prioritized);
+
+    ok &= check(legacy.counts_balance && prioritized.counts_balance, "every dequeued request completes once");
+    ok &= check(prioritized.max_depth <= kSlotCount, "queue depth stays bounded by the request kinds");
+    ok &= check(legacy.refused == 0 && prioritized.refused == 0, "every request kind has a queue slot");
+    ptc::HttpQueue bounds;
+    ptc::service_http_queue_init(bounds);
+    int item = 0;
+    void* waiting = &item;
+    ok &= check(!ptc::service_http_queue_push(bounds, ptc::kHttpQueueSlots, &item, waiting) && !waiting &&
+            bounds.depth == 0 && bounds.pushed == 0 && bounds.coalesced == 0,
+        "a slot past the end is refused, not counted as coalesced");
+    ok &= check(prioritized.manual_served >= legacy.manual_served, "no fewer manual codes are served");
+    ok &= check(prioritized.manual_latency.p99_ns < legacy.manual_latency.p99_ns,
+        "manual-code tail latency drops");
+    ok &= check(prioritized.manual_latency.max_ns < legacy.manual_latency.max_ns,
+        "manual-code worst case drops");
+    ok &= check(prioritized.completed[kNotices] * 10 >= legacy.completed[kNotices] * 8,
+        "preemption does not starve notice downloads");
+    ok &= check(prioritized.completed[kHeartbeat] >= legacy.completed[kHeartbeat] * 9 / 10,
+        "heartbeats keep their cadence");
+    return ok ? 0 : 1;
+}
+
+} // namespace bench
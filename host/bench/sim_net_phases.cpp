@@ -0,0 +1,181 @@
+#include <cstdio>
+#include <cstring>
+#include <string>
+
+#include "bench.h"
+#include "mock_portal.h"
+#include "src/services/service_http.h"
+#include "src/services/service_http_timing.h"
+#include "src/services/service_log.h"
+#include "src/services/service_storage.h"
+#include "src/services/service_time.h"
+
+namespace bench {
+
+namespace {
+
+constexpr const char* kDeviceId = "cb9008f8-0098-4b46-b77b-b82029aff3f2";
+constexpr const char* kDeviceSecret = "9f3c1a7e5b2d4c6f8a0e1b3d5f7a9c2e4b6d8f0a1c3e5a7b9d2f4a6c8e0b1d3f";
+constexpr uint32_t kWarmTicks = 4;
+// Notice fetches forced per scenario, one tick after another.
+constexpr uint32_t kFetches = 2;
+// What a phase has to stay under when nothing slows it down, and the delay
+// each scenario adds to one phase.
+constexpr uint32_t kQuietMs = 60;
+constexpr uint32_t kSlowMs = 250;
+
+struct Scenario {
+    const char* name;
+    uint32_t dns_ms;
+    uint32_t connect_ms;
+    uint32_t portal_ms;
+    bool dns_failing;
+    // false has the portal close after every answer, so each fetch opens.
+    bool keep_alive;
+};
+
+constexpr Scenario kScenarios[] = {
+    {"baseline", 0, 0, 0, false, true},
+    {"slow DNS", kSlowMs, 0, 0, false, false},
+    {"slow handshake", 0, kSlowMs, 0, false, false},
+    {"slow portal", 0, 0, kSlowMs, false, false},
+    {"DNS down", 0, 0, 0, true, false},
+};
+
+struct PhaseReport {
+    uint32_t requests = 0;
+    uint32_t opened = 0;
+    uint32_t failures = 0;
+    uint32_t dns_ms = 0;
+    uint32_t connect_ms = 0;
+    uint32_t ttfb_ms = 0;
+    uint32_t body_ms = 0;
+    String last_error;
+};
+
+void tick(ptc::DeviceConfig& config, ptc::AppState& state) {
+    ptc::service_time_tick(config, state);
+    ptc::service_http_tick(config, state);
+    host::task_wait_idle("portal_http", 10000);
+}
+
+PhaseReport run_scenario(MockPortal& portal, const Scenario& scenario, ptc::DeviceConfig& config,
+    ptc::AppState& state) {
+    portal.set_latency(scenario.portal_ms);
+    portal.set_keep_alive(scenario.keep_alive);
+    host::net_set_latency(scenario.dns_ms, scenario.connect_ms);
+    host::net_set_dns_failing(scenario.dns_failing);
+    // Starts the targets over, so the averages are this scenario's alone.
+    ptc::service_http_timing_init();
+    for (uint32_t fetch = 0; fetch < kFetches; ++fetch) {
+        ptc::service_http_force_notices_fetch();
+        tick(config, state);
+        tick(config, state);
+    }
+
+    PhaseReport report;
+    ptc::HttpTimingStats stats;
+    for (uint8_t i = 0; i < ptc::service_http_timing_count(); ++i) {
+        if (ptc::service_http_timing_stats(i, stats) && strcmp(stats.name, "notices") == 0) {
+            report.requests = stats.count;
+            report.opened = stats.opened;
+            report.failures = stats.failures;
+            report.dns_ms = stats.dns_ms;
+            report.connect_ms = stats.connect_ms;
+            report.ttfb_ms = stats.ttfb_ms;
+            report.body_ms = stats.body_ms;
+        }
+    }
+    report.last_error = ptc::service_http_last_error();
+    return report;
+}
+
+} // namespace
+
+int run_net_phases_sim(int argc, char** argv) {
+    (void)argc;
+    (void)argv;
+    MockPortal portal;
+    portal.add_device(kDeviceId, kDeviceSecret);
+    if (!check(portal.start(), "mock portal listening")) {
+        return 1;
+    }
+    host::http_use_socket("127.0.0.1", portal.port());
+    // Phases are timed with millis(), and the portal's latency is real time.
+    host::clock_use_virtual(false);
+    host::sd_set_root("/tmp/ptc-host-sd-net-phases");
+    host::serial_set_enabled(false);
+    host::sd_wipe();
+    ptc::service_storage_init();
+    ptc::service_log_init();
+    ptc::DeviceConfig config;
+    config.device_id = kDeviceId;
+    config.device_secret = kDeviceSecret;
+    ptc::AppState state;
+    state.time_sync_ok = true;
+    state.provisioning_complete = true;
+    ptc::service_http_init();
+    // Config, then the first heartbeat, which reports the config request;
+    // the baseline then starts on a closed connection.
+    portal.set_keep_alive(false);
+    for (uint32_t i = 0; i < kWarmTicks; ++i) {
+        tick(config, state);
+    }
+    const std::string heartbeat = portal.last_heartbeat();
+
+    PhaseReport reports[sizeof(kScenarios) / sizeof(kScenarios[0])];
+    for (size_t i = 0; i < sizeof(kScenarios) / sizeof(kScenarios[0]); ++i) {
+        reports[i] = run_scenario(portal, kScenarios[i], config, state);
+    }
+    host::net_set_latency(0, 0);
+    host::net_set_dns_failing(false);
+    portal.stop();
+    host::http_use_socket("", 0);
+    host::serial_set_enabled(true);
+
+    printf("\n== net_phases (%lu notice fetches per scenario, one phase slowed by %lu ms; averages in ms) ==\n",
+        static_cast<unsigned long>(kFetches), static_cast<unsigned long>(kSlowMs));
+    printf("%-15s %8s %6s %6s %5s %8s %5s %5s  %s\n", "scenario", "requests", "opened", "failed", "dns", "connect",
+        "ttfb", "body", "last error");
+    for (size_t i = 0; i < sizeof(kScenarios) / sizeof(kScenarios[0]); ++i) {
+        const PhaseReport& report = reports[i];
+        printf("%-15s %8lu %6lu %6lu %5lu %8lu %5lu %5lu  %s\n", kScenarios[i].name,
+            static_cast<unsigned long>(report.requests), static_cast<unsigned long>(report.opened),
+            static_cast<unsigned long>(report.failures), static_cast<unsigned long>(report.dns_ms),
+            static_cast<unsigned long>(report.connect_ms), static_cast<unsigned long>(report.ttfb_ms),
+            static_cast<unsigned long>(report.body_ms), report.last_error.c_str());
+    }
+    fflush(stdout);
+
+    const PhaseReport& baseline = reports[0];
+    const PhaseReport& slow_dns = reports[1];
+    const PhaseReport& slow_connect = reports[2];
+    const PhaseReport& slow_portal = reports[3];
+    const PhaseReport& dns_down = reports[4];
+    bool ok = true;
+    ok &= check(baseline.requests == kFetches && baseline.opened > 0 && baseline.failures == 0,
+        "baseline requests answered on an opened connection");
+    ok &= check(baseline.dns_ms < kQuietMs && baseline.connect_ms < kQuietMs && baseline.ttfb_ms < kQuietMs,
+        "baseline phases are quick");
+    ok &= check(baseline.opened < baseline.requests, "later requests reuse the connection");
+    // The slow DNS scenario's first fetch still goes out on the connection
+    // the baseline kept open.
+    ok &= check(slow_connect.opened == kFetches && slow_portal.opened == kFetches,
+        "a closed connection is opened again");
+    ok &= check(slow_dns.dns_ms >= kSlowMs && slow_dns.connect_ms < kQuietMs && slow_dns.ttfb_ms < kQuietMs,
+        "a slow resolver shows as dns");
+    ok &= check(slow_connect.connect_ms >= kSlowMs && slow_connect.dns_ms < kQuietMs &&
+            slow_connect.ttfb_ms < kQuietMs,
+        "a slow handshake shows as connect");
+    ok &= check(slow_portal.ttfb_ms >= kSlowMs && slow_portal.dns_ms < kQuietMs && slow_portal.connect_ms < kQuietMs,
+        "a slow portal shows as ttfb");
+    ok &= check(dns_down.requests > 0 && dns_down.failures == dns_down.requests &&
+            dns_down.last_error.indexOf("DNS lookup failed") >= 0,
+        "a failed lookup is reported as such");
+    ok &= check(heartbeat.find("\"net_ms\":{\"config\":{") != std::string::npos &&
+            heartbeat.find("\"ttfb\":") != std::string::npos,
+        "heartbeat carries the phase aggregates");
+    return ok ? 0 : 1;
+}
+
+} // namespace bench
@@ -0,0 +1,280 @@
+#include <SD.h>
+
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <set>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "bench.h"
+#include "mock_portal.h"
+#include "src/services/service_http.h"
+#include "src/services/service_log.h"
+#include "src/services/service_outbox.h"
+#include "src/services/service_storage.h"
+#include "src/services/service_time.h"
+
+namespace bench {
+
+namespace {
+
+constexpr uint32_t kTickMs = 1000;
+constexpr const char* kDeviceId = "cb9008f8-0098-4b46-b77b-b82029aff3f2";
+constexpr const char* kDeviceSecret = "9f3c1a7e5b2d4c6f8a0e1b3d5f7a9c2e4b6d8f0a1c3e5a7b9d2f4a6c8e0b1d3f";
+constexpr const char* kOutboxFile = "/ptc/outbox.jsonl";
+// The read timeout the device gives the portal, plus a little.
+constexpr uint32_t kStallMs = 8500;
+
+// Scripted timeline, seconds from the start of the run: Wi-Fi drops for two
+// hours, the device reboots half way through, and the first batch after
+// reconnecting stalls past the read timeout although the portal stored it.
+constexpr uint32_t kOfflineSec = 120;
+constexpr uint32_t kRebootSec = 3720;
+constexpr uint32_t kOnlineSec = 7320;
+constexpr uint32_t kEndSec = 7620;
+
+struct DrainReport {
+    uint32_t appended = 0;
+    uint32_t depth_offline = 0;
+    uint32_t depth_after_reboot = 0;
+    uint32_t heartbeats = 0;
+    uint32_t errors = 0;
+    uint32_t ota = 0;
+    uint32_t batches = 0;
+    uint32_t drain_ms = 0;
+    uint32_t drain_records = 0;
+    uint32_t per_min = 0;
+    uint32_t portal_events = 0;
+    uint32_t unique_keys = 0;
+    uint32_t portal_duplicates = 0;
+    uint32_t device_duplicates = 0;
+    uint32_t depth_end = 0;
+    uint32_t file_bytes_end = 0;
+    uint32_t auth_failures = 0;
+};
+
+void tick(ptc::DeviceConfig& config, ptc::AppState& state) {
+    ptc::service_time_tick(config, state);
+    ptc::service_log_tick(config, state);
+    ptc::service_http_tick(config, state);
+    const uint64_t started_ns = host::real_now_ns();
+    host::task_wait_idle("portal_http", kStallMs + 2000);
+    if (host::real_now_ns() - started_ns > (kStallMs - 1000) * 1000000ULL) {
+        // The device gave up on a stalled answer. Virtual seconds pass far
+        // faster than the portal's real-time stall, so let it finish storing
+        // the batch before the breaker's retry reaches it.
+        std::this_thread::sleep_for(std::chrono::milliseconds(1000));
+    }
+    host::clock_advance_ms(kTickMs);
+}
+
+DrainReport run_offline_drain(MockPortal& portal) {
+    DrainReport report;
+    ptc::DeviceConfig config;
+    config.device_id = kDeviceId;
+    config.device_secret = kDeviceSecret;
+    ptc::AppState state;
+    state.time_sync_ok = true;
+    state.provisioning_complete = true;
+    ptc::service_http_init();
+
+    const uint32_t base_ms = millis();
+    PortalFault stall;
+    stall.start_ms = base_ms + kOnlineSec * 1000;
+    stall.end_ms = base_ms + kEndSec * 1000;
+    stall.status = 200;
+    stall.latency_ms = kStallMs;
+    stall.route = "events";
+    stall.max_hits = 1;
+    portal.set_faults({stall});
+
+    ptc::OutboxStats stats;
+    for (uint32_t second = 0; second < kEndSec; ++second) {
+        if (second == kOfflineSec) {
+            host::wifi_set_connected(false);
+        }
+        if (second > kOfflineSec && second < kOnlineSec && second % 60 == 0) {
+            // One new fault a minute, and one that repeats every minute.
+            ptc::service_log_add_error("SD card read error at block " + String(second / 60));
+            ptc::service_log_add_error("Touch controller not responding");
+        }
+        if (second == kOfflineSec + 600) {
+            StaticJsonDocument<256> data;
+            data["stage"] = "download";
+            data["ok"] = false;
+            data["version"] = "9.9.9";
+            data["from"] = ptc::kFirmwareVersion;
+            data["error"] = "Download failed";
+            ptc::service_outbox_add(ptc::OutboxKind::kOta, data);
+        }
+        if (second == kRebootSec) {
+            ptc::service_outbox_stats(stats);
+            report.depth_offline = stats.depth;
+            report.appended = stats.appended;
+            // A reset loses everything in RAM; the outbox is read back from
+            // the card under a new boot id.
+            ptc::service_outbox_init();
+            ptc::service_outbox_stats(stats);
+            report.depth_after_reboot = stats.depth;
+        }
+        if (second == kOnlineSec) {
+            host::wifi_set_connected(true);
+        }
+        tick(config, state);
+    }
+    ptc::service_outbox_stats(stats);
+    report.appended += stats.appended;
+    report.batches = stats.batches;
+    report.drain_ms = stats.last_drain_ms;
+    report.drain_records = stats.last_drain_records;
+    report.per_min = ptc::service_outbox_drain_per_min();
+    report.device_duplicates = stats.duplicates;
+    report.depth_end = stats.depth;
+    report.file_bytes_end = ptc::service_storage_outbox_size();
+    portal.stop();
+
+    std::set<std::string> keys;
+    for (const PortalEvent& event : portal.events()) {
+        keys.insert(event.key);
+        report.portal_events++;
+        report.heartbeats += event.type == "heartbeat" ? 1 : 0;
+        report.errors += event.type == "error" ? 1 : 0;
+        report.ota += event.type == "ota" ? 1 : 0;
+    }
+    report.unique_keys = static_cast<uint32_t>(keys.size());
+    report.portal_duplicates = portal.duplicate_events();
+    for (const PortalRecord& record : portal.records()) {
+        report.auth_failures += record.auth != PortalAuth::kOk ? 1 : 0;
+    }
+    return report;
+}
+
+// Writes records with no portal in reach until the outbox has trimmed
+// itself several times over.
+bool check_size_bound() {
+    host::sd_wipe();
+    ptc::service_storage_init();
+    ptc::service_outbox_init();
+    const std::string padding(180, 'x');
+    uint32_t largest = 0;
+    for (uint32_t i = 0; i < 4000; ++i) {
+        StaticJsonDocument<384> data;
+        data["message"] = padding.c_str();
+        data["index"] = i;
+        ptc::service_outbox_add(ptc::OutboxKind::kError, data);
+        largest = std::max(largest, ptc::service_storage_outbox_size());
+    }
+    ptc::OutboxStats stats;
+    ptc::service_outbox_stats(stats);
+    ptc::OutboxBatch batch;
+    ptc::service_outbox_next_batch(batch);
+    printf("size bound: %lu records written, %lu kept, %lu dropped, largest file %lu B (limit %lu B)\n",
+        static_cast<unsigned long>(stats.appended), static_cast<unsigned long>(stats.depth),
+        static_cast<unsigned long>(stats.dropped), static_cast<unsigned long>(largest),
+        static_cast<unsigned long>(ptc::kOutboxMaxBytes));
+    bool ok = true;
+    ok &= check(largest <= ptc::kOutboxMaxBytes, "outbox file stays within its bound");
+    ok &= check(stats.dropped > 0 && stats.depth + stats.dropped == stats.appended,
+        "oldest records dropped, every record accounted for");
+    ok &= check(batch.count > 0 &&
+            batch.events.indexOf(String("\"index\":") + String(stats.dropped) + "}") > 0,
+        "the next batch starts at the oldest record kept");
+    return ok;
+}
+
+// A reset in the middle of an append leaves a line without its end; the
+// next boot terminates it and the reader steps over it.
+bool check_torn_record() {
+    host::sd_wipe();
+    ptc::service_storage_init();
+    ptc::service_outbox_init();
+    StaticJsonDocument<64> data;
+    data["message"] = "before";
+    ptc::service_outbox_add(ptc::OutboxKind::kError, data);
+    File file = SD.open(kOutboxFile, FILE_APPEND);
+    file.print("{\"key\":\"0000-9\",\"type\":\"err");
+    file.close();
+    ptc::service_outbox_init();
+    data["message"] = "after";
+    ptc::service_outbox_add(ptc::OutboxKind::kError, data);
+
+    ptc::OutboxBatch batch;
+    const bool read = ptc::service_outbox_next_batch(batch);
+    ptc::service_outbox_ack(batch, 0);
+    ptc::OutboxStats stats;
+    ptc::service_outbox_stats(stats);
+    bool ok = true;
+    ok &= check(read && batch.count == 2 && batch.lines == 3, "torn record skipped, whole records kept");
+    ok &= check(batch.events.indexOf("before") > 0 && batch.events.indexOf("after") > 0 &&
+            batch.events.indexOf("err\"") < 0,
+        "batch is the two whole records");
+    ok &= check(stats.depth == 0 && !ptc::service_outbox_pending(), "outbox empty after the ack");
+    return ok;
+}
+
+} // namespace
+
+int run_outbox_sim(int argc, char** argv) {
+    (void)argc;
+    (void)argv;
+    MockPortal portal;
+    portal.add_device(kDeviceId, kDeviceSecret);
+    if (!check(portal.start(), "mock portal listening")) {
+        return 1;
+    }
+    host::http_use_socket("127.0.0.1", portal.port());
+    host::clock_use_virtual(true, 1000);
+    host::sd_set_root("/tmp/ptc-host-sd-outbox");
+    host::sd_wipe();
+    host::serial_set_enabled(false);
+    ptc::service_storage_init();
+    ptc::service_log_init();
+    const DrainReport report = run_offline_drain(portal);
+    host::http_use_socket("", 0);
+    host::serial_set_enabled(true);
+
+    printf("\n== outbox (Wi-Fi down %u s with a reboot, then a batch stalled past the read timeout) ==\n",
+        static_cast<unsigned>(kOnlineSec - kOfflineSec));
+    printf("records queued   %5lu (heartbeat %lu, error %lu, ota %lu)\n",
+        static_cast<unsigned long>(report.appended), static_cast<unsigned long>(report.heartbeats),
+        static_cast<unsigned long>(report.errors), static_cast<unsigned long>(report.ota));
+    printf("depth at reboot  %5lu -> %lu after it\n", static_cast<unsigned long>(report.depth_offline),
+        static_cast<unsigned long>(report.depth_after_reboot));
+    printf("drain            %5lu records in %lu batches, %lu ms, %lu records/min\n",
+        static_cast<unsigned long>(report.drain_records), static_cast<unsigned long>(report.batches),
+        static_cast<unsigned long>(report.drain_ms), static_cast<unsigned long>(report.per_min));
+    printf("portal           %5lu stored, %lu unique keys, %lu redelivered (device saw %lu)\n",
+        static_cast<unsigned long>(report.portal_events), static_cast<unsigned long>(report.unique_keys),
+        static_cast<unsigned long>(report.portal_duplicates), static_cast<unsigned long>(report.device_duplicates));
+    printf("after            depth %lu, file %lu B\n", static_cast<unsigned long>(report.depth_end),
+        static_cast<unsigned long>(report.file_bytes_end));
+    fflush(stdout);
+
+    bool ok = true;
+    ok &= check(report.auth_failures == 0, "every outbox request verifies");
+    ok &= check(report.depth_after_reboot == report.depth_offline && report.depth_offline > 0,
+        "queued records survive a reboot");
+    ok &= check(report.heartbeats >= (kOnlineSec - kOfflineSec) / (ptc::kOutboxHeartbeatIntervalMs / 1000) - 2 &&
+            report.heartbeats <= (kOnlineSec - kOfflineSec) / (ptc::kOutboxHeartbeatIntervalMs / 1000) + 1,
+        "heartbeats downsampled while unreachable");
+    ok &= check(report.ota == 1, "OTA result delivered");
+    ok &= check(report.errors < (kOnlineSec - kOfflineSec) / 60 * 2, "repeated error queued once per window");
+    ok &= check(report.portal_events == report.appended && report.unique_keys == report.appended,
+        "every record delivered exactly once after dedupe");
+    ok &= check(report.portal_duplicates > 0 && report.portal_duplicates == report.device_duplicates,
+        "stalled batch redelivered and reported as duplicates");
+    ok &= check(report.depth_end == 0 && report.file_bytes_end == 0, "outbox drained and file removed");
+    ok &= check(report.drain_records > 0 && report.drain_ms < 60000, "backlog drains within a minute");
+
+    host::serial_set_enabled(false);
+    const bool bounded = check_size_bound();
+    const bool torn = check_torn_record();
+    host::serial_set_enabled(true);
+    ok &= bounded && torn;
+    return ok ? 0 : 1;
+}
+
+} // namespace bench
@@ -0,0 +1,488 @@
+#include <HTTPClient.h>
+#include <WiFiClient.h>
+
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "bench.h"
+#include "mock_portal.h"
+#include "src/services/service_auth.h"
+#include "src/services/service_http.h"
+#include "src/services/service_log.h"
+#include "src/services/service_storage.h"
+#include "src/services/service_time.h"
+
+namespace bench {
+
+namespace {
+
+constexpr uint32_t kTickMs = 1000;
+constexpr const char* kDeviceId = "cb9008f8-0098-4b46-b77b-b82029aff3f2";
+constexpr const char* kDeviceSecret = "9f3c1a7e5b2d4c6f8a0e1b3d5f7a9c2e4b6d8f0a1c3e5a7b9d2f4a6c8e0b1d3f";
+constexpr const char* kInactiveDeviceId = "5e1d7c0a-4b2f-4e8a-9d3c-6f0b1a2c3d4e";
+constexpr const char* kBaseUrl = "https://portal.local";
+// Endpoint breaker after 5xx or no answer (service_http_breaker.h).
+constexpr uint32_t kBackoffStartSec = 5;
+constexpr uint32_t kBackoffMaxSec = 300;
+constexpr uint32_t kRouteRetryAfterSec = 45;
+constexpr uint32_t kUnauthorizedDelaySec = 30;
+constexpr uint32_t kInactiveDelaySec = 300;
+constexpr uint32_t kRetryAfterSec = 90;
+constexpr uint32_t kClockSkewSec = 600;
+// The read timeout the device gives the portal, plus a little.
+constexpr uint32_t kStallMs = 8500;
+
+// Scripted timeline, seconds from the start of the run.
+constexpr uint32_t kRateFromSec = 300;
+constexpr uint32_t kOutageSec = 1500;
+constexpr uint32_t kOutageEndSec = 2400;
+constexpr uint32_t kDropSec = 3000;
+constexpr uint32_t kDropEndSec = 3300;
+constexpr uint32_t kRateLimitSec = 3900;
+constexpr uint32_t kUnauthorizedSec = 4500;
+constexpr uint32_t kInactiveSec = 5100;
+constexpr uint32_t kSkewSec = 5700;
+constexpr uint32_t kSkewEndSec = 5900;
+constexpr uint32_t kStallSec = 6300;
+constexpr uint32_t kRouteOutageSec = 6600;
+constexpr uint32_t kRouteOutageEndSec = 6900;
+constexpr uint32_t kEndSec = 7200;
+
+struct Probe {
+    const char* method;
+    std::string path;
+    std::string body;
+    const char* device_id;
+    int32_t timestamp_offset;
+    bool corrupt_signature;
+};
+
+struct ProbeHeaders {
+    std::string timestamp;
+    std::string nonce;
+    std::string signature;
+};
+
+// Sends one request straight through the host HTTPClient socket transport,
+// signed with the firmware's signer unless headers are given to replay.
+int send_probe(const Probe& probe, ProbeHeaders& headers, bool replay, std::string& response) {
+    WiFiClient client;
+    HTTPClient http;
+    http.begin(client, String(kBaseUrl) + probe.path.c_str());
+    if (probe.device_id) {
+        if (!replay) {
+            headers.timestamp = std::to_string(static_cast<int64_t>(time(nullptr)) + probe.timestamp_offset);
+            char nonce[ptc::kNonceLength + 1];
+            ptc::service_auth_format_nonce(nonce, sizeof(nonce));
+            headers.nonce = nonce;
+            headers.signature = ptc::service_auth_request_signature(probe.method, probe.path.c_str(),
+                headers.timestamp.c_str(), headers.nonce.c_str(), probe.body.c_str(), kDeviceSecret).c_str();
+            if (probe.corrupt_signature) {
+                headers.signature[0] = headers.signature[0] == 'A' ? 'B' : 'A';
+            }
+        }
+        http.addHeader("X-PTC-Device-Id", probe.device_id);
+        http.addHeader("X-PTC-Timestamp", headers.timestamp.c_str());
+        http.addHeader("X-PTC-Nonce", headers.nonce.c_str());
+        http.addHeader("X-PTC-Signature", headers.signature.c_str());
+    }
+    const int status = strcmp(probe.method, "POST") == 0 ? http.POST(probe.body.c_str()) : http.GET();
+    response = http.getString().c_str();
+    http.end();
+    return status;
+}
+
+bool check_contract(MockPortal& portal) {
+    bool ok = true;
+    const std::string config = std::string("/api/timeclock/devices/config?device_id=") + kDeviceId;
+    const std::string manual = "/api/timeclock/devices/manual-code";
+    const std::string manual_body = std::string("{\"device_id\":\"") + kDeviceId + "\",\"qr_payload\":\"ptc1:e30\"}";
+    ProbeHeaders headers;
+    std::string response;
+
+    ok &= check(send_probe({"GET", config, "", kDeviceId, 0, false}, headers, false, response) == 200,
+        "signed config request accepted");
+    ok &= check(send_probe({"GET", config, "", kDeviceId, 0, false}, headers, true, response) == 401,
+        "replayed nonce rejected");
+    ok &= check(send_probe({"GET", config, "", kDeviceId, 0, true}, headers, false, response) == 401,
+        "invalid signature rejected");
+    ok &= check(send_probe({"GET", config, "", kDeviceId, -121, false}, headers, false, response) == 401,
+        "timestamp outside 120 s rejected");
+    ok &= check(send_probe({"GET", config, "", kDeviceId, 115, false}, headers, false, response) == 200,
+        "timestamp inside 120 s accepted");
+    ok &= check(send_probe({"GET", config, "", nullptr, 0, false}, headers, false, response) == 401,
+        "unsigned config request rejected");
+    ok &= check(send_probe({"POST", "/api/timeclock/devices/heartbeat", "{\"device_id\":\"x\"}", kDeviceId, 0, false},
+                    headers, false, response) == 200 && response.find("server_time") != std::string::npos,
+        "heartbeat answers with server_time");
+
+    // Signed with another device's secret: authentication fails before the
+    // device's state is looked at.
+    const std::string inactive_config = std::string("/api/timeclock/devices/config?device_id=") + kInactiveDeviceId;
+    portal.add_device(kInactiveDeviceId, "0c2e4a6b8d1f3e5a7c9b0d2f4e6a8c1b", false);
+    ok &= check(send_probe({"GET", inactive_config, "", kInactiveDeviceId, 0, false}, headers, false, response) == 401,
+        "other device's secret rejected");
+    portal.add_device(kInactiveDeviceId, kDeviceSecret, false);
+    ok &= check(send_probe({"GET", inactive_config, "", kInactiveDeviceId, 0, false}, headers, false, response) == 403,
+        "inactive device answered 403");
+
+    ok &= check(send_probe({"POST", manual, manual_body, kDeviceId, 0, false}, headers, false, response) == 200 &&
+            response.find("\"code_display\":\"") != std::string::npos && response.size() > 60,
+        "manual code issued");
+    ok &= check(send_probe({"POST", manual, manual_body, kDeviceId, 0, false}, headers, false, response) == 429 &&
+            response.find("retry_after") != std::string::npos,
+        "second manual code within the QR interval rate limited");
+
+    const std::string register_path = "/api/timeclock/devices/register";
+    ok &= check(send_probe({"POST", register_path, "{\"device_id\":\"new\"}", nullptr, 0, false},
+                    headers, false, response) == 403,
+        "registration without an enrollment code refused");
+    portal.set_enrollment_code("ENR-4821", kInactiveDeviceId);
+    const std::string enroll = "{\"device_id\":\"new\",\"enrollment_code\":\"ENR-4821\"}";
+    ok &= check(send_probe({"POST", register_path, enroll, nullptr, 0, false}, headers, false, response) == 200 &&
+            response.find(kDeviceSecret) != std::string::npos,
+        "enrollment code exchanged for the secret");
+    ok &= check(send_probe({"POST", register_path, enroll, nullptr, 0, false}, headers, false, response) == 403,
+        "enrollment code single use");
+    return ok;
+}
+
+// Requests the device sent in the same virtual millisecond went out together
+// from one tick; backoff and rate limits act between such bursts.
+struct Burst {
+    uint32_t at_ms = 0;
+    uint16_t requests = 0;
+    uint16_t succeeded = 0;
+    int status = 0;
+    bool faulted = false;
+};
+
+// route limits the bursts to requests for that route.
+std::vector<Burst> bursts(std::vector<PortalRecord> records, const char* route = nullptr) {
+    // A stalled answer is recorded when it finally goes out.
+    std::stable_sort(records.begin(), records.end(), [](const PortalRecord& a, const PortalRecord& b) {
+        return a.at_ms < b.at_ms;
+    });
+    std::vector<Burst> out;
+    for (const PortalRecord& record : records) {
+        if (route && record.route.compare(0, strlen(route), route) != 0) {
+            continue;
+        }
+        if (out.empty() || out.back().at_ms != record.at_ms) {
+            out.push_back(Burst());
+            out.back().at_ms = record.at_ms;
+        }
+        Burst& burst = out.back();
+        burst.requests++;
+        burst.faulted |= record.faulted;
+        if (record.status >= 200 && record.status < 300) {
+            burst.succeeded++;
+        } else {
+            burst.status = record.status;
+        }
+    }
+    return out;
+}
+
+struct EventReport {
+    const char* name = "";
+    uint32_t failed_requests = 0;
+    std::vector<uint32_t> gaps_sec;
+    // From the fault (window end for outages) to the next 2xx.
+    uint32_t recover_sec = 0;
+    bool recovered = false;
+};
+
+// Outages: every burst inside [start, end) fails; gaps between them are the
+// device's backoff.
+EventReport outage_report(const char* name, const std::vector<Burst>& all, uint32_t start_ms, uint32_t end_ms) {
+    EventReport report;
+    report.name = name;
+    const Burst* previous = nullptr;
+    for (const Burst& burst : all) {
+        if (burst.at_ms >= start_ms && burst.at_ms < end_ms) {
+            report.failed_requests += burst.requests;
+            if (previous) {
+                report.gaps_sec.push_back((burst.at_ms - previous->at_ms) / 1000);
+            }
+            previous = &burst;
+        } else if (burst.at_ms >= end_ms && burst.succeeded > 0) {
+            report.recover_sec = (burst.at_ms - end_ms) / 1000;
+            report.recovered = true;
+            break;
+        }
+    }
+    return report;
+}
+
+// One-shot faults: the first faulted burst at or after start_ms; the gap to
+// the next burst is the delay the device honoured.
+EventReport fault_report(const char* name, const std::vector<Burst>& all, uint32_t start_ms) {
+    EventReport report;
+    report.name = name;
+    const Burst* fault = nullptr;
+    for (const Burst& burst : all) {
+        if (!fault) {
+            if (burst.at_ms >= start_ms && burst.faulted) {
+                fault = &burst;
+                report.failed_requests = burst.requests;
+            }
+            continue;
+        }
+        if (report.gaps_sec.empty()) {
+            report.gaps_sec.push_back((burst.at_ms - fault->at_ms) / 1000);
+        }
+        if (burst.succeeded > 0) {
+            report.recover_sec = (burst.at_ms - fault->at_ms) / 1000;
+            report.recovered = true;
+            break;
+        }
+    }
+    return report;
+}
+
+void print_event(const EventReport& report) {
+    std::string gaps;
+    for (size_t i = 0; i < report.gaps_sec.size(); ++i) {
+        gaps += (i ? "," : "") + std::to_string(report.gaps_sec[i]);
+    }
+    printf("%-16s %6u %-44s %10s\n", report.name, static_cast<unsigned>(report.failed_requests),
+        gaps.empty() ? "-" : gaps.c_str(),
+        report.recovered ? std::to_string(report.recover_sec).c_str() : "never");
+}
+
+// Each gap is the wait the previous attempt drew plus the tick that applied
+// it: decorrelated jitter between 5 s and three times the previous wait
+// (15 s at first), capped at 300 s. Over a long outage the waits must grow.
+bool backoff_jittered(const EventReport& report) {
+    uint32_t upper = kBackoffStartSec * 3;
+    uint32_t longest = 0;
+    for (const uint32_t gap : report.gaps_sec) {
+        if (gap < kBackoffStartSec || gap > upper + 2) {
+            return false;
+        }
+        upper = std::min(std::max(gap, kBackoffStartSec) * 3, kBackoffMaxSec);
+        longest = std::max(longest, gap);
+    }
+    return report.gaps_sec.size() > 1 && longest >= kBackoffStartSec * 4;
+}
+
+void serve_forever(uint16_t port) {
+    MockPortal portal;
+    portal.add_device(kDeviceId, kDeviceSecret);
+    if (!portal.start(port)) {
+        printf("[PORTAL] cannot listen on 127.0.0.1:%u\n", static_cast<unsigned>(port));
+        return;
+    }
+    printf("[PORTAL] listening on 127.0.0.1:%u device=%s secret=%s\n",
+        static_cast<unsigned>(portal.port()), kDeviceId, kDeviceSecret);
+    fflush(stdout);
+    size_t printed = 0;
+    while (true) {
+        std::this_thread::sleep_for(std::chrono::milliseconds(200));
+        const std::vector<PortalRecord> records = portal.records();
+        for (; printed < records.size(); ++printed) {
+            printf("[PORTAL] %s %s status=%d auth=%s\n", records[printed].method.c_str(),
+                records[printed].route.c_str(), records[printed].status, portal_auth_name(records[printed].auth));
+        }
+        fflush(stdout);
+    }
+}
+
+} // namespace
+
+int run_portal_sim(int argc, char** argv) {
+    if (argc > 1 && strcmp(argv[1], "serve") == 0) {
+        serve_forever(argc > 2 ? static_cast<uint16_t>(strtoul(argv[2], nullptr, 10)) : 8080);
+        return 0;
+    }
+    bool ok = true;
+    MockPortal portal;
+    portal.add_device(kDeviceId, kDeviceSecret);
+    portal.set_notices("[{\"id\":\"notice-1\",\"title\":\"Rota\",\"body\":\"Please review the rota.\","
+                       "\"display_seconds\":8,\"sort_order\":1}]");
+    if (!check(portal.start(), "mock portal listening")) {
+        return 1;
+    }
+    host::http_use_socket("127.0.0.1", portal.port());
+    ok &= check_contract(portal);
+    portal.clear_records();
+
+    host::clock_use_virtual(true, 1000);
+    host::sd_set_root("/tmp/ptc-host-sd-portal");
+    host::sd_wipe();
+    host::serial_set_enabled(false);
+    ptc::service_storage_init();
+    ptc::service_log_init();
+
+    ptc::DeviceConfig config;
+    config.device_id = kDeviceId;
+    config.device_secret = kDeviceSecret;
+    ptc::AppState state;
+    state.time_sync_ok = true;
+    state.provisioning_complete = true;
+    ptc::service_http_init();
+
+    const uint32_t base_ms = millis();
+    auto at = [base_ms](uint32_t seconds) { return base_ms + seconds * 1000; };
+    std::vector<PortalFault> faults(5);
+    faults[0].start_ms = at(kOutageSec);
+    faults[0].end_ms = at(kOutageEndSec);
+    faults[0].status = 503;
+    faults[1].start_ms = at(kDropSec);
+    faults[1].end_ms = at(kDropEndSec);
+    faults[1].status = 0;
+    faults[2].start_ms = at(kRateLimitSec);
+    faults[2].end_ms = at(kUnauthorizedSec);
+    faults[2].status = 429;
+    faults[2].retry_after_sec = kRetryAfterSec;
+    faults[2].route = "heartbeat";
+    faults[2].max_hits = 1;
+    faults[3].start_ms = at(kUnauthorizedSec);
+    faults[3].end_ms = at(kInactiveSec);
+    faults[3].status = 401;
+    faults[3].max_hits = 1;
+    faults[4].start_ms = at(kInactiveSec);
+    faults[4].end_ms = at(kSkewSec);
+    faults[4].status = 403;
+    faults[4].max_hits = 1;
+    PortalFault stall;
+    stall.start_ms = at(kStallSec);
+    stall.end_ms = at(kRouteOutageSec);
+    stall.status = 200;
+    stall.latency_ms = kStallMs;
+    stall.max_hits = 1;
+    faults.push_back(stall);
+    PortalFault route_outage;
+    route_outage.start_ms = at(kRouteOutageSec);
+    route_outage.end_ms = at(kRouteOutageEndSec);
+    route_outage.status = 503;
+    route_outage.retry_after_sec = kRouteRetryAfterSec;
+    route_outage.route = "activity";
+    faults.push_back(route_outage);
+    portal.set_faults(faults);
+    portal.set_latency(2);
+
+    uint32_t activity_id = 0;
+    bool inactive_seen = false;
+    for (uint32_t second = 0; second < kEndSec; ++second) {
+        if (second == kSkewSec || second == kSkewEndSec) {
+            // The portal clock runs ahead: every signature is out of window.
+            portal.set_clock_skew(second == kSkewSec ? kClockSkewSec : 0);
+        }
+        if (second % 300 == 0) {
+            activity_id++;
+            portal.add_activity({"evt-" + std::to_string(activity_id), "Employee " + std::to_string(activity_id),
+                activity_id % 2 ? "clock_in" : "clock_out", static_cast<uint32_t>(time(nullptr))});
+        }
+        ptc::service_time_tick(config, state);
+        ptc::service_http_tick(config, state);
+        inactive_seen |= !state.device_active;
+        host::task_wait_idle("portal_http", kStallMs + 2000);
+        host::clock_advance_ms(kTickMs);
+    }
+    ptc::service_http_tick(config, state);
+    host::serial_set_enabled(true);
+
+    // Stopping first lets a still-stalled answer finish and be recorded.
+    portal.stop();
+    const std::vector<PortalRecord> records = portal.records();
+    const host::HttpSocketStats sockets = host::http_socket_stats();
+    host::http_use_socket("", 0);
+
+    const std::vector<Burst> all = bursts(records);
+    const std::vector<Burst> heartbeats = bursts(records, "heartbeat");
+    const std::vector<Burst> activity = bursts(records, "activity");
+    uint32_t rate_requests = 0;
+    uint32_t per_route[5] = {};
+    const char* routes[5] = {"config", "heartbeat", "activity", "notices", "manual-code"};
+    uint32_t auth_ok = 0;
+    uint32_t auth_expired = 0;
+    uint32_t auth_other = 0;
+    for (const PortalRecord& record : records) {
+        if (record.at_ms >= at(kRateFromSec) && record.at_ms < at(kOutageSec)) {
+            rate_requests++;
+            for (uint8_t i = 0; i < 5; ++i) {
+                per_route[i] += record.route.compare(0, strlen(routes[i]), routes[i]) == 0 ? 1 : 0;
+            }
+        }
+        auth_ok += record.auth == PortalAuth::kOk ? 1 : 0;
+        auth_expired += record.auth == PortalAuth::kExpired ? 1 : 0;
+        auth_other += record.auth != PortalAuth::kOk && record.auth != PortalAuth::kExpired ? 1 : 0;
+    }
+    const double healthy_hours = (kOutageSec - kRateFromSec) / 3600.0;
+
+    printf("\n== portal (mock PT Portal over TCP, virtual clock %u s; rate, backoff, recovery) ==\n",
+        static_cast<unsigned>(kEndSec));
+    printf("healthy: %.0f req/h (config %.0f, heartbeat %.0f, activity %.0f, notices %.0f)\n",
+        rate_requests / healthy_hours, per_route[0] / healthy_hours, per_route[1] / healthy_hours,
+        per_route[2] / healthy_hours, per_route[3] / healthy_hours);
+    printf("sockets: %u requests over %u connections, %.1f KB sent, %.1f KB received\n",
+        static_cast<unsigned>(sockets.requests), static_cast<unsigned>(sockets.connects),
+        sockets.bytes_sent / 1024.0, sockets.bytes_received / 1024.0);
+    printf("auth: %u verified, %u outside the window, %u other rejections\n",
+        static_cast<unsigned>(auth_ok), static_cast<unsigned>(auth_expired), static_cast<unsigned>(auth_other));
+    printf("%-16s %6s %-44s %10s\n", "event", "failed", "gaps between attempts (s)", "recover_s");
+
+    // Every endpoint backs off on its own; heartbeat stands for them.
+    const EventReport outage = outage_report("503 x15 min", heartbeats, at(kOutageSec), at(kOutageEndSec));
+    const EventReport drop = outage_report("no answer x5 min", heartbeats, at(kDropSec), at(kDropEndSec));
+    const EventReport limited = fault_report("429 retry 90 s", heartbeats, at(kRateLimitSec));
+    const EventReport unauthorized = fault_report("401", all, at(kUnauthorizedSec));
+    const EventReport inactive = fault_report("403 inactive", all, at(kInactiveSec));
+    const EventReport skew = outage_report("clock +600 s", all, at(kSkewSec), at(kSkewEndSec));
+    const EventReport stalled = fault_report("8.5 s stall", all, at(kStallSec));
+    const EventReport route_down = outage_report("activity 503", activity, at(kRouteOutageSec), at(kRouteOutageEndSec));
+    const EventReport route_peer = outage_report("  heartbeat", heartbeats, at(kRouteOutageSec), at(kRouteOutageEndSec));
+    for (const EventReport* report :
+        {&outage, &drop, &limited, &unauthorized, &inactive, &skew, &stalled, &route_down}) {
+        print_event(*report);
+    }
+    uint16_t peer_bursts = 0;
+    bool peer_ok = true;
+    for (const Burst& burst : heartbeats) {
+        if (burst.at_ms >= at(kRouteOutageSec) && burst.at_ms < at(kRouteOutageEndSec)) {
+            peer_bursts++;
+            peer_ok &= burst.succeeded == burst.requests;
+        }
+    }
+    printf("%-16s %6u %-44s %10s\n", route_peer.name, 0U,
+        (std::to_string(peer_bursts) + " sent, " + (peer_ok ? "all accepted" : "some failed")).c_str(), "-");
+    fflush(stdout);
+
+    ok &= check(auth_other == 0 && auth_ok > 0, "every device request verifies");
+    ok &= check(auth_expired == skew.failed_requests, "only the skewed window fails the timestamp check");
+    ok &= check(backoff_jittered(outage), "5xx backoff is jittered from 5 s, grows and caps at 300 s");
+    ok &= check(backoff_jittered(drop), "unanswered requests back off the same way");
+    ok &= check(outage.recovered && outage.recover_sec <= kBackoffMaxSec + 2 &&
+            drop.recovered && drop.recover_sec <= kBackoffMaxSec + 2,
+        "recovery within one capped backoff of the outage ending");
+    ok &= check(!limited.gaps_sec.empty() && limited.gaps_sec[0] >= kRetryAfterSec &&
+            limited.gaps_sec[0] <= kRetryAfterSec + 2,
+        "429 retry_after honoured");
+    ok &= check(!unauthorized.gaps_sec.empty() && unauthorized.gaps_sec[0] >= kUnauthorizedDelaySec,
+        "401 pauses requests for a time resync");
+    ok &= check(inactive_seen && state.device_active && !inactive.gaps_sec.empty() &&
+            inactive.gaps_sec[0] >= kInactiveDelaySec,
+        "403 marks the device inactive until the next config");
+    ok &= check(!skew.gaps_sec.empty() && skew.gaps_sec[0] >= kUnauthorizedDelaySec && skew.recovered &&
+            skew.recover_sec <= kUnauthorizedDelaySec + 2,
+        "clock skew rejections recover once the clocks agree");
+    ok &= check(stalled.recovered && stalled.recover_sec <= kBackoffMaxSec, "read timeout recovers");
+    bool retry_after_honoured = route_down.gaps_sec.size() > 1;
+    for (const uint32_t gap : route_down.gaps_sec) {
+        retry_after_honoured &= gap >= kRouteRetryAfterSec;
+    }
+    ok &= check(retry_after_honoured && route_down.recovered, "503 Retry-After stretches the endpoint's backoff");
+    ok &= check(peer_bursts >= 4 && peer_ok, "a failing activity route does not hold back heartbeats");
+    ok &= check(ptc::service_http_api_ok(), "portal reachable at the end");
+    return ok ? 0 : 1;
+}
+
+} // namespace bench
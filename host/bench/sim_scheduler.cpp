@@ -0,0 +1,245 @@
+#include <cstdio>
+#include <cstdlib>
+#include <vector>
+
+#include <freertos/FreeRTOS.h>
+#include <freertos/task.h>
+
+#include "bench.h"
+#include "src/services/service_metrics.h"
+#include "src/services/service_scheduler.h"
+
+namespace bench {
+
+namespace {
+
+// Service periods and approximate per-tick CPU cost, mirroring main.cpp.
+struct SimService {
+    const char* name;
+    uint32_t period_ms;
+    uint32_t cost_us;
+    bool gated;
+};
+
+constexpr SimService kServices[] = {
+    {"wifi", 25, 40, true},
+    {"ota", 60, 20, false},
+    {"time", 200, 30, true},
+    {"http", 100, 250, true},
+    {"qr", 80, 60, true},
+    {"log", 120, 5, true},
+};
+constexpr size_t kServiceCount = sizeof(kServices) / sizeof(kServices[0]);
+constexpr uint32_t kLegacyUiSleepMs = 5;
+constexpr uint32_t kLegacyHeadlessSleepMs = 1;
+// An external wake that no scheduled task subscribes to.
+constexpr uint32_t kIrqEventBit = 1UL << 31;
+
+struct ServiceTrace {
+    uint32_t runs = 0;
+    uint64_t last_run_us = 0;
+    bool resync = false;
+    std::vector<uint64_t> jitter_us;
+};
+
+ServiceTrace g_traces[kServiceCount];
+bool g_exclusive = false;
+
+void record_run(size_t index) {
+    ServiceTrace& trace = g_traces[index];
+    const uint64_t now_us = host::clock_now_us();
+    if (trace.runs > 0 && !trace.resync) {
+        const uint64_t interval_us = now_us - trace.last_run_us;
+        const uint64_t period_us = kServices[index].period_ms * 1000ULL;
+        trace.jitter_us.push_back(interval_us > period_us ? interval_us - period_us : period_us - interval_us);
+    }
+    trace.runs++;
+    trace.last_run_us = now_us;
+    trace.resync = false;
+    host::clock_advance_us(kServices[index].cost_us);
+}
+
+template <size_t Index>
+void sim_tick(uint32_t now_ms) {
+    (void)now_ms;
+    record_run(Index);
+}
+
+constexpr ptc::SchedulerTickFn kTicks[kServiceCount] = {
+    sim_tick<0>, sim_tick<1>, sim_tick<2>, sim_tick<3>, sim_tick<4>, sim_tick<5>,
+};
+
+bool exclusive_gate() {
+    return g_exclusive;
+}
+
+void reset_traces() {
+    for (ServiceTrace& trace : g_traces) {
+        trace = ServiceTrace();
+    }
+    g_exclusive = false;
+}
+
+struct SimReport {
+    double wakeups_per_sec = 0.0;
+    Stats jitter;
+    uint32_t runs[kServiceCount] = {};
+};
+
+SimReport collect(uint64_t wakeups, uint32_t seconds) {
+    SimReport report;
+    report.wakeups_per_sec = static_cast<double>(wakeups) / seconds;
+    std::vector<uint64_t> jitter;
+    for (size_t i = 0; i < kServiceCount; ++i) {
+        report.runs[i] = g_traces[i].runs;
+        jitter.insert(jitter.end(), g_traces[i].jitter_us.begin(), g_traces[i].jitter_us.end());
+    }
+    report.jitter = summarize(jitter);
+    return report;
+}
+
+// The loop() from before the scheduler: every service polled on each pass,
+// then a fixed short delay.
+SimReport run_legacy(uint32_t seconds, uint32_t sleep_ms) {
+    reset_traces();
+    host::clock_use_virtual(true, 1000);
+    uint32_t last_tick_ms[kServiceCount] = {};
+    const uint32_t end_ms = millis() + seconds * 1000U;
+    uint64_t wakeups = 0;
+    while (static_cast<int32_t>(millis() - end_ms) < 0) {
+        const uint32_t now_ms = millis();
+        for (size_t i = 0; i < kServiceCount; ++i) {
+            if (now_ms - last_tick_ms[i] >= kServices[i].period_ms) {
+                last_tick_ms[i] = now_ms;
+                record_run(i);
+            }
+        }
+        delay(sleep_ms);
+        wakeups++;
+    }
+    return collect(wakeups, seconds);
+}
+
+struct SchedulerScenario {
+    uint32_t seconds = 60;
+    uint32_t irq_per_sec = 0;
+    uint32_t exclusive_from_ms = 0;
+    uint32_t exclusive_to_ms = 0;
+};
+
+SimReport run_scheduler(const SchedulerScenario& scenario, uint32_t& irq_wakes, uint32_t& skipped) {
+    reset_traces();
+    host::clock_use_virtual(true, 1000);
+    host::task_clear_pending_notifications();
+    ptc::service_scheduler_reset();
+    ptc::service_metrics_reset(ptc::MetricsWindow::kSerial);
+    ptc::service_scheduler_set_gate(exclusive_gate);
+    for (size_t i = 0; i < kServiceCount; ++i) {
+        ptc::service_scheduler_add(kServices[i].name, kServices[i].period_ms, kTicks[i], kServices[i].gated);
+    }
+
+    const uint32_t start_ms = millis();
+    const uint32_t end_ms = start_ms + scenario.seconds * 1000U;
+    HostTask* loop_task = xTaskGetCurrentTaskHandle();
+    srand(7);
+    irq_wakes = 0;
+    if (scenario.irq_per_sec > 0) {
+        const uint32_t count = scenario.irq_per_sec * scenario.seconds;
+        for (uint32_t i = 0; i < count; ++i) {
+            const uint64_t at_ms = start_ms + static_cast<uint64_t>(rand()) % (scenario.seconds * 1000U);
+            host::task_notify_at_us(loop_task, at_ms * 1000ULL + 500ULL, kIrqEventBit);
+        }
+        irq_wakes = count;
+    }
+
+    while (static_cast<int32_t>(millis() - end_ms) < 0) {
+        const uint32_t elapsed_ms = millis() - start_ms;
+        const bool exclusive = elapsed_ms >= scenario.exclusive_from_ms && elapsed_ms < scenario.exclusive_to_ms;
+        if (g_exclusive && !exclusive) {
+            // The pause itself is not jitter; measure from the first run after it.
+            for (ServiceTrace& trace : g_traces) {
+                trace.resync = true;
+            }
+        }
+        g_exclusive = exclusive;
+        const uint32_t sleep_ms = ptc::service_scheduler_run_due();
+        ptc::service_scheduler_sleep(min(sleep_ms, end_ms - millis()));
+    }
+
+    skipped = 0;
+    for (uint8_t i = 0; i < ptc::service_scheduler_task_count(); ++i) {
+        ptc::SchedulerTaskStats stats;
+        ptc::service_scheduler_get_stats(i, stats);
+        skipped += stats.skipped;
+    }
+    host::task_clear_pending_notifications();
+    return collect(ptc::service_scheduler_wakeups(), scenario.seconds);
+}
+
+void print_report(const char* model, const SimReport& report) {
+    printf("%-30s %10.1f %11.3f %11.3f %11.3f\n",
+        model,
+        report.wakeups_per_sec,
+        report.jitter.mean_ns / 1000.0,
+        static_cast<double>(report.jitter.p99_ns) / 1000.0,
+        static_cast<double>(report.jitter.max_ns) / 1000.0);
+}
+
+} // namespace
+
+int run_scheduler_sim(int argc, char** argv) {
+    const uint32_t seconds = argc > 1 ? static_cast<uint32_t>(strtoul(argv[1], nullptr, 10)) : 60;
+    bool ok = true;
+
+    printf("\n== scheduler (virtual clock, %u s) ==\n", static_cast<unsigned>(seconds));
+    printf("%-30s %10s %11s %11s %11s\n", "model", "wakeups/s", "jitter_ms", "p99_ms", "max_ms");
+
+    const SimReport legacy_ui = run_legacy(seconds, kLegacyUiSleepMs);
+    print_report("legacy loop, UI (5 ms)", legacy_ui);
+    const SimReport legacy_headless = run_legacy(seconds, kLegacyHeadlessSleepMs);
+    print_report("legacy loop, headless (1 ms)", legacy_headless);
+
+    uint32_t irq_wakes = 0;
+    uint32_t skipped = 0;
+    SchedulerScenario idle;
+    idle.seconds = seconds;
+    const SimReport scheduled = run_scheduler(idle, irq_wakes, skipped);
+    print_report("deadline scheduler, idle", scheduled);
+    ptc::MetricsSummary http_metrics;
+    ok &= check(ptc::service_metrics_summary(ptc::service_metrics_probe("http"),
+                    ptc::MetricsWindow::kSerial, http_metrics) &&
+            http_metrics.count == scheduled.runs[3],
+        "scheduled ticks are timed into their metrics probe");
+
+    SchedulerScenario touch = idle;
+    touch.irq_per_sec = 5;
+    const SimReport touched = run_scheduler(touch, irq_wakes, skipped);
+    print_report("deadline scheduler, 5 IRQ/s", touched);
+
+    SchedulerScenario ota = idle;
+    ota.exclusive_from_ms = seconds * 250U;
+    ota.exclusive_to_ms = seconds * 750U;
+    const SimReport gated = run_scheduler(ota, irq_wakes, skipped);
+    print_report("deadline scheduler, OTA 50%", gated);
+    const uint32_t gated_skips = skipped;
+
+    for (size_t i = 0; i < kServiceCount; ++i) {
+        const uint32_t expected = seconds * 1000U / kServices[i].period_ms;
+        ok &= check(scheduled.runs[i] + 1 >= expected && scheduled.runs[i] <= expected + 1,
+            "every service runs once per period");
+        if (kServices[i].gated) {
+            ok &= check(gated.runs[i] < expected * 6 / 10, "gated services pause while OTA is exclusive");
+        } else {
+            ok &= check(gated.runs[i] + 1 >= expected, "ungated services keep running during OTA");
+        }
+    }
+    ok &= check(gated_skips > 0, "gate skips are counted");
+    ok &= check(scheduled.wakeups_per_sec * 2 < legacy_ui.wakeups_per_sec,
+        "idle wakeups drop well below the legacy loop");
+    ok &= check(touched.wakeups_per_sec > scheduled.wakeups_per_sec + touch.irq_per_sec / 2,
+        "external wakes end the sleep early");
+    ok &= check(scheduled.jitter.max_ns < 1000000, "scheduled tick jitter stays under 1 ms");
+    return ok ? 0 : 1;
+}
+
+} // namespace bench
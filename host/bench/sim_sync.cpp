@@ -0,0 +1,325 @@
+#include <ArduinoJson.h>
+
+#include <cstdio>
+#include <cstdlib>
+#include <mutex>
+#include <string>
+#include <vector>
+
+#include "bench.h"
+#include "src/services/service_http.h"
+#include "src/services/service_log.h"
+#include "src/services/service_storage.h"
+
+namespace bench {
+
+namespace {
+
+constexpr uint32_t kTickMs = 1000;
+constexpr uint32_t kNoticeRevisionMs = 40 * 60 * 1000;
+constexpr uint32_t kConfigChangeMs = 50 * 60 * 1000;
+constexpr uint32_t kClockEventMs = 150 * 1000;
+// Events stop this long before the end of a phase so every one of them is
+// due to reach the device.
+constexpr uint32_t kQuietTailMs = 5 * 60 * 1000;
+constexpr uint32_t kEpochBase = 1767225600;
+constexpr uint16_t kNoticeCount = 6;
+
+enum class PortalMode : uint8_t {
+    kSeparate,
+    kSync,
+    kSyncRemoved,
+};
+
+struct PhaseTraffic {
+    uint32_t requests = 0;
+    uint32_t syncs = 0;
+    uint32_t signed_requests = 0;
+    uint32_t rejected = 0;
+    uint64_t sent_bytes = 0;
+    uint64_t received_bytes = 0;
+};
+
+struct ClockEvent {
+    uint32_t id;
+    uint32_t timestamp;
+};
+
+// Portal stand-in: per-kind endpoints always, the sync endpoint only while
+// mode is kSync (it answers 404 otherwise, as an older portal would).
+struct Portal {
+    std::mutex mutex;
+    PortalMode mode = PortalMode::kSeparate;
+    uint32_t notice_revision = 0;
+    uint32_t qr_interval_sec = 20;
+    std::vector<ClockEvent> events;
+    PhaseTraffic traffic;
+};
+
+Portal g_portal;
+
+bool sync_offered() {
+    return g_portal.mode == PortalMode::kSync;
+}
+
+std::string config_etag() {
+    return "\"cfg-" + std::to_string(g_portal.qr_interval_sec) + (sync_offered() ? "-s" : "") + "\"";
+}
+
+std::string notices_etag() {
+    return "\"ntc-" + std::to_string(g_portal.notice_revision) + "\"";
+}
+
+std::string config_json() {
+    return std::string("{\"location_id\":\"loc-7\",\"location_name\":\"North depot\",\"qr_interval_sec\":") +
+        std::to_string(g_portal.qr_interval_sec) + ",\"is_active\":true,\"capabilities\":{\"sync\":" +
+        (sync_offered() ? "true" : "false") + "}}";
+}
+
+std::string notice_title(uint32_t revision, uint16_t index) {
+    return "Rota r" + std::to_string(revision) + " #" + std::to_string(index);
+}
+
+std::string notices_json() {
+    std::string json = "[";
+    for (uint16_t i = 0; i < kNoticeCount; ++i) {
+        if (i > 0) {
+            json += ",";
+        }
+        json += "{\"id\":\"notice-" + std::to_string(i) + "\",\"title\":\"" +
+            notice_title(g_portal.notice_revision, i) +
+            "\",\"body\":\"Please review the updated rota before clocking in.\",\"display_seconds\":8,"
+            "\"sort_order\":" + std::to_string(i) + "}";
+    }
+    return json + "]";
+}
+
+std::string event_user(uint32_t id) {
+    return "Employee " + std::to_string(id);
+}
+
+std::string activity_json(uint32_t since) {
+    std::string json = "[";
+    bool first = true;
+    for (const ClockEvent& event : g_portal.events) {
+        if (event.timestamp <= since) {
+            continue;
+        }
+        json += first ? "" : ",";
+        first = false;
+        json += "{\"id\":\"evt-" + std::to_string(event.id) + "\",\"user_name\":\"" + event_user(event.id) +
+            "\",\"action\":\"" + (event.id % 2 ? "clock_out" : "clock_in") + "\",\"timestamp\":" +
+            std::to_string(event.timestamp) + "}";
+    }
+    return json + "]";
+}
+
+uint32_t since_param(const std::string& path) {
+    const size_t at = path.find("since=");
+    return at == std::string::npos ? 0 : static_cast<uint32_t>(strtoul(path.c_str() + at + 6, nullptr, 10));
+}
+
+std::string json_string(const std::string& value) {
+    std::string quoted = "\"";
+    for (char c : value) {
+        if (c == '"' || c == '\\') {
+            quoted += '\\';
+        }
+        quoted += c;
+    }
+    return quoted + "\"";
+}
+
+// The sync response leaves out every section whose revision the device
+// already holds.
+std::string sync_json(const std::string& request_body) {
+    DynamicJsonDocument request(4096);
+    deserializeJson(request, request_body);
+    std::string json = "{";
+    if (std::string(request["config_etag"] | "") != config_etag()) {
+        json += "\"config\":" + config_json() + ",\"config_etag\":" + json_string(config_etag()) + ",";
+    }
+    if (std::string(request["notices_etag"] | "") != notices_etag()) {
+        json += "\"notices_etag\":" + json_string(notices_etag()) + ",\"notices\":" + notices_json() + ",";
+    }
+    json += "\"activity\":" + activity_json(request["activity_since"] | 0) + ",\"server_time\":" +
+        std::to_string(kEpochBase + millis() / 1000) + "}";
+    return json;
+}
+
+host::HttpResponse handle(const host::HttpRequest& request) {
+    std::lock_guard<std::mutex> lock(g_portal.mutex);
+    PhaseTraffic& traffic = g_portal.traffic;
+    traffic.requests++;
+    traffic.sent_bytes += request.body.size();
+    if (request.headers.count("X-PTC-Signature")) {
+        traffic.signed_requests++;
+    }
+    host::HttpResponse response;
+    const std::string& path = request.path_and_query;
+    if (path.find("/devices/sync") != std::string::npos) {
+        traffic.syncs++;
+        if (!sync_offered()) {
+            traffic.rejected++;
+            response.status_code = 404;
+            response.body = "{\"error\":\"not found\"}";
+        } else {
+            response.body = sync_json(request.body);
+            response.headers["Transfer-Encoding"] = "chunked";
+        }
+    } else if (path.find("/devices/config") != std::string::npos) {
+        const auto validator = request.headers.find("If-None-Match");
+        response.headers["ETag"] = config_etag();
+        if (validator != request.headers.end() && validator->second == config_etag()) {
+            response.status_code = 304;
+        } else {
+            response.body = config_json();
+        }
+    } else if (path.find("/notices") != std::string::npos) {
+        const auto validator = request.headers.find("If-None-Match");
+        response.headers["ETag"] = notices_etag();
+        if (validator != request.headers.end() && validator->second == notices_etag()) {
+            response.status_code = 304;
+        } else {
+            response.body = notices_json();
+        }
+    } else if (path.find("/devices/activity") != std::string::npos) {
+        response.body = activity_json(since_param(path));
+    } else {
+        response.body = "{}";
+    }
+    traffic.received_bytes += response.body.size();
+    return response;
+}
+
+struct PhaseReport {
+    PhaseTraffic traffic;
+    uint32_t events = 0;
+    bool config_in_sync = false;
+    bool notices_in_sync = false;
+    bool activity_in_sync = false;
+    bool used_sync = false;
+};
+
+PhaseReport run_phase(PortalMode mode, uint32_t seconds, ptc::DeviceConfig& config, ptc::AppState& state) {
+    {
+        std::lock_guard<std::mutex> lock(g_portal.mutex);
+        g_portal.mode = mode;
+        g_portal.traffic = PhaseTraffic();
+    }
+    PhaseReport report;
+    const uint32_t start_ms = millis();
+    const uint32_t end_ms = start_ms + seconds * 1000U;
+    uint32_t last_revision_ms = start_ms;
+    uint32_t last_event_ms = start_ms;
+    bool config_changed = false;
+
+    while (static_cast<int32_t>(millis() - end_ms) < 0) {
+        const uint32_t now_ms = millis();
+        {
+            std::lock_guard<std::mutex> lock(g_portal.mutex);
+            if (now_ms - last_revision_ms >= kNoticeRevisionMs) {
+                g_portal.notice_revision++;
+                last_revision_ms = now_ms;
+            }
+            if (!config_changed && now_ms - start_ms >= kConfigChangeMs) {
+                g_portal.qr_interval_sec = g_portal.qr_interval_sec == 20 ? 30 : 20;
+                config_changed = true;
+            }
+            if (now_ms - last_event_ms >= kClockEventMs && end_ms - now_ms > kQuietTailMs) {
+                const uint32_t id = static_cast<uint32_t>(g_portal.events.size()) + 1;
+                g_portal.events.push_back({id, kEpochBase + now_ms / 1000});
+                last_event_ms = now_ms;
+                report.events++;
+            }
+        }
+        ptc::service_http_tick(config, state);
+        report.used_sync |= config.portal_sync;
+        host::task_wait_idle("portal_http");
+        host::clock_advance_ms(kTickMs);
+    }
+    ptc::service_http_tick(config, state);
+
+    std::lock_guard<std::mutex> lock(g_portal.mutex);
+    report.traffic = g_portal.traffic;
+    ptc::Notice first;
+    report.config_in_sync = config.qr_interval_sec == g_portal.qr_interval_sec;
+    report.notices_in_sync = ptc::service_http_notice_count() == kNoticeCount &&
+        ptc::service_http_get_notice(0, first) &&
+        first.title == notice_title(g_portal.notice_revision, 0).c_str();
+    uint32_t timestamp = 0;
+    String user;
+    String action;
+    report.activity_in_sync = g_portal.events.empty() ||
+        (ptc::service_log_get_activity(0, timestamp, user, action) &&
+            user == event_user(g_portal.events.back().id).c_str());
+    return report;
+}
+
+void print_report(const char* model, const PhaseReport& report, uint32_t seconds) {
+    const double hours = seconds / 3600.0;
+    printf("%-14s %8u %7.1f %6u %6u %8.1f %8.1f %6u %4s %4s %4s\n",
+        model,
+        static_cast<unsigned>(report.traffic.requests),
+        report.traffic.requests / hours,
+        static_cast<unsigned>(report.traffic.syncs),
+        static_cast<unsigned>(report.traffic.signed_requests),
+        report.traffic.sent_bytes / 1024.0,
+        report.traffic.received_bytes / 1024.0,
+        static_cast<unsigned>(report.events),
+        report.config_in_sync ? "ok" : "OLD",
+        report.notices_in_sync ? "ok" : "OLD",
+        report.activity_in_sync ? "ok" : "OLD");
+    fflush(stdout);
+}
+
+} // namespace
+
+int run_sync_sim(int argc, char** argv) {
+    const uint32_t seconds = argc > 1 ? static_cast<uint32_t>(strtoul(argv[1], nullptr, 10)) : 2 * 3600;
+    bool ok = true;
+
+    host::clock_use_virtual(true, 1000);
+    host::sd_set_root("/tmp/ptc-host-sd-sync");
+    host::sd_wipe();
+    host::http_set_handler(handle);
+    host::serial_set_enabled(false);
+    ptc::service_storage_init();
+    ptc::service_log_init();
+
+    ptc::DeviceConfig config;
+    config.device_id = "ESP32S3-A1B2C3D4E5F6";
+    config.device_secret = "9f3c1a7e5b2d4c6f8a0e1b3d5f7a9c2e4b6d8f0a1c3e5a7b9d2f4a6c8e0b1d3f";
+    ptc::AppState state;
+    state.time_sync_ok = true;
+    state.provisioning_complete = true;
+    ptc::service_http_init();
+
+    const PhaseReport separate = run_phase(PortalMode::kSeparate, seconds, config, state);
+    const PhaseReport sync = run_phase(PortalMode::kSync, seconds, config, state);
+    const PhaseReport removed = run_phase(PortalMode::kSyncRemoved, seconds, config, state);
+    host::serial_set_enabled(true);
+    host::http_set_handler(nullptr);
+
+    printf("\n== batched sync (virtual clock, %u s per phase; requests to the portal and payload bytes) ==\n",
+        static_cast<unsigned>(seconds));
+    printf("%-14s %8s %7s %6s %6s %8s %8s %6s %4s %4s %4s\n",
+        "portal", "requests", "per_h", "syncs", "signed", "up_kb", "down_kb", "events", "cfg", "ntc", "act");
+    print_report("separate", separate, seconds);
+    print_report("sync", sync, seconds);
+    print_report("sync removed", removed, seconds);
+
+    ok &= check(separate.traffic.syncs == 0 && !separate.used_sync, "no sync without the capability");
+    ok &= check(sync.used_sync && sync.traffic.syncs > 0, "sync used once the portal offers it");
+    ok &= check(sync.traffic.requests * 3 < separate.traffic.requests, "sync cuts portal requests by over 3x");
+    ok &= check(removed.traffic.rejected == 1 && !config.portal_sync,
+        "a rejected sync falls back to separate requests");
+    ok &= check(separate.config_in_sync && sync.config_in_sync && removed.config_in_sync, "config follows the portal");
+    ok &= check(separate.notices_in_sync && sync.notices_in_sync && removed.notices_in_sync,
+        "notices follow the portal");
+    ok &= check(separate.activity_in_sync && sync.activity_in_sync && removed.activity_in_sync,
+        "every clock event reaches the device");
+    return ok ? 0 : 1;
+}
+
+} // namespace bench
@@ -0,0 +1,58 @@
+#pragma once
+
+// Minimal Arduino-ESP32 core surface for building src/services on a Linux
+// host (PlatformIO env:native). Only what the firmware actually calls is
+// provided; hardware calls are no-ops and time comes from host_runtime.h.
+
+#include <algorithm>
+#include <cmath>
+#include <cstdarg>
+#include <cstddef>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <ctime>
+
+#include "Esp.h"
+#include "HardwareSerial.h"
+#include "IPAddress.h"
+#include "Print.h"
+#include "Stream.h"
+#include "WString.h"
+
+using std::max;
+using std::min;
+
+#define IRAM_ATTR
+#define LOW 0x0
+#define HIGH 0x1
+#define INPUT 0x01
+#define OUTPUT 0x03
+#define INPUT_PULLUP 0x05
+#define RISING 0x01
+#define FALLING 0x02
+#define CHANGE 0x03
+
+#define digitalPinToInterrupt(pin) (pin)
+
+uint32_t millis();
+uint32_t micros();
+void delay(uint32_t ms);
+void delayMicroseconds(uint32_t us);
+void yield();
+
+void pinMode(uint8_t pin, uint8_t mode);
+void digitalWrite(uint8_t pin, uint8_t value);
+int digitalRead(uint8_t pin);
+void attachInterrupt(uint8_t pin, void (*handler)(), int mode);
+void detachInterrupt(uint8_t pin);
+void noInterrupts();
+void interrupts();
+
+void randomSeed(unsigned long seed);
+long random(long max_value);
+long random(long min_value, long max_value);
+
+void configTzTime(const char* tz, const char* server1, const char* server2 = nullptr,
+    const char* server3 = nullptr);
@@ -0,0 +1,52 @@
+#pragma once
+
+#include <Arduino.h>
+
+#include <functional>
+
+typedef enum {
+    OTA_AUTH_ERROR,
+    OTA_BEGIN_ERROR,
+    OTA_CONNECT_ERROR,
+    OTA_RECEIVE_ERROR,
+    OTA_END_ERROR,
+} ota_error_t;
+
+class ArduinoOTAClass {
+public:
+    typedef std::function<void()> THandlerFunction;
+    typedef std::function<void(ota_error_t)> THandlerFunction_Error;
+    typedef std::function<void(unsigned int, unsigned int)> THandlerFunction_Progress;
+
+    ArduinoOTAClass& setHostname(const char* hostname) {
+        (void)hostname;
+        return *this;
+    }
+    ArduinoOTAClass& onStart(THandlerFunction handler) {
+        start_ = std::move(handler);
+        return *this;
+    }
+    ArduinoOTAClass& onEnd(THandlerFunction handler) {
+        end_ = std::move(handler);
+        return *this;
+    }
+    ArduinoOTAClass& onError(THandlerFunction_Error handler) {
+        error_ = std::move(handler);
+        return *this;
+    }
+    ArduinoOTAClass& onProgress(THandlerFunction_Progress handler) {
+        progress_ = std::move(handler);
+        return *this;
+    }
+    void begin() {}
+    void end() {}
+    void handle() {}
+
+private:
+    THandlerFunction start_;
+    THandlerFunction end_;
+    THandlerFunction_Error error_;
+    THandlerFunction_Progress progress_;
+};
+
+extern ArduinoOTAClass ArduinoOTA;
@@ -0,0 +1,17 @@
+#pragma once
+
+#include <cstdint>
+
+class EspClass {
+public:
+    uint32_t getFreeHeap();
+    uint32_t getHeapSize();
+    uint32_t getMinFreeHeap();
+    uint32_t getMaxAllocHeap();
+    uint32_t getFreePsram();
+    uint32_t getCycleCount();
+    uint32_t getCpuFreqMHz() { return 240; }
+    [[noreturn]] void restart();
+};
+
+extern EspClass ESP;
@@ -0,0 +1,60 @@
+#pragma once
+
+// Arduino fs::File over stdio. SD.h maps card paths into a host directory
+// (see host::sd_set_root).
+
+#include <Arduino.h>
+
+#include <memory>
+#include <string>
+
+#define FILE_READ "r"
+#define FILE_WRITE "w"
+#define FILE_APPEND "a"
+
+namespace fs {
+
+enum SeekMode {
+    SeekSet = 0,
+    SeekCur = 1,
+    SeekEnd = 2,
+};
+
+struct FileHandle;
+
+class File : public Stream {
+public:
+    File() = default;
+    explicit File(std::shared_ptr<FileHandle> handle);
+
+    size_t write(uint8_t value) override;
+    size_t write(const uint8_t* buffer, size_t size) override;
+    using Print::write;
+    int available() override;
+    int read() override;
+    int peek() override;
+    void flush() override;
+    size_t read(uint8_t* buffer, size_t size);
+
+    bool seek(uint32_t position, SeekMode mode = SeekSet);
+    size_t position() const;
+    size_t size() const;
+    void close();
+    bool isDirectory() const;
+    const char* path() const;
+    const char* name() const;
+    explicit operator bool() const;
+
+protected:
+    // Files are finite: end of data is immediate, never a timeout.
+    int timedRead() override { return read(); }
+    int timedPeek() override { return peek(); }
+
+private:
+    std::shared_ptr<FileHandle> handle_;
+};
+
+} // namespace fs
+
+using fs::File;
+using fs::SeekMode;
@@ -0,0 +1,95 @@
+#pragma once
+
+// HTTPClient over the in-process handler installed with host::http_set_handler.
+// The whole exchange happens inside GET()/POST(); the response body is then
+// readable through getString() or getStreamPtr(). A handler that answers with
+// "Transfer-Encoding: chunked" gets its body chunk-framed on the stream, as
+// the Arduino client leaves it. With host::http_use_socket() the exchange
+// goes over a real TCP connection owned by the WiFiClient instead.
+
+#include <Arduino.h>
+#include <WiFiClient.h>
+
+#include <map>
+#include <string>
+#include <vector>
+
+#define HTTPC_ERROR_CONNECTION_REFUSED (-1)
+#define HTTPC_ERROR_SEND_HEADER_FAILED (-2)
+#define HTTPC_ERROR_SEND_PAYLOAD_FAILED (-3)
+#define HTTPC_ERROR_NOT_CONNECTED (-4)
+#define HTTPC_ERROR_CONNECTION_LOST (-5)
+#define HTTPC_ERROR_NO_STREAM (-6)
+#define HTTPC_ERROR_NO_HTTP_SERVER (-7)
+#define HTTPC_ERROR_TOO_LESS_RAM (-8)
+#define HTTPC_ERROR_ENCODING (-9)
+#define HTTPC_ERROR_STREAM_WRITE (-10)
+#define HTTPC_ERROR_READ_TIMEOUT (-11)
+
+typedef enum {
+    HTTP_CODE_OK = 200,
+    HTTP_CODE_NOT_MODIFIED = 304,
+    HTTP_CODE_NOT_FOUND = 404,
+} t_http_codes;
+
+typedef enum {
+    HTTPC_DISABLE_FOLLOW_REDIRECTS,
+    HTTPC_STRICT_FOLLOW_REDIRECTS,
+    HTTPC_FORCE_FOLLOW_REDIRECTS,
+} followRedirects_t;
+
+class HTTPClient {
+public:
+    HTTPClient() = default;
+    // As on the device: a client still held (kept alive by end() with reuse
+    // on) is stopped, so keep-alive needs an HTTPClient that outlives the
+    // requests.
+    ~HTTPClient() {
+        if (client_) {
+            client_->stop();
+        }
+    }
+    HTTPClient(const HTTPClient&) = delete;
+    HTTPClient& operator=(const HTTPClient&) = delete;
+
+    bool begin(WiFiClient& client, const String& url);
+    void end();
+
+    void setConnectTimeout(int32_t timeout_ms) { connect_timeout_ms_ = timeout_ms; }
+    void setTimeout(uint16_t timeout_ms) { timeout_ms_ = timeout_ms; }
+    void setFollowRedirects(followRedirects_t follow) { follow_redirects_ = follow; }
+    void setReuse(bool reuse) { reuse_ = reuse; }
+    void addHeader(const String& name, const String& value);
+    void collectHeaders(const char* header_keys[], const size_t header_keys_count);
+    String header(const char* name);
+
+    int GET();
+    int POST(const String& payload);
+    int POST(const uint8_t* payload, size_t size);
+    int sendRequest(const char* method, const uint8_t* payload, size_t size);
+
+    String getString();
+    int getSize() const { return size_; }
+    WiFiClient* getStreamPtr() { return client_; }
+    WiFiClient& getStream() { return *client_; }
+    bool connected() { return client_ && client_->connected(); }
+
+    static String errorToString(int error);
+
+private:
+    int send_socket(const char* method, const uint8_t* payload, size_t size,
+        const std::string& address, uint16_t port);
+
+    WiFiClient* client_ = nullptr;
+    std::string url_;
+    std::string path_and_query_;
+    std::map<std::string, std::string> request_headers_;
+    std::vector<std::string> collect_keys_;
+    std::map<std::string, std::string> response_headers_;
+    int32_t connect_timeout_ms_ = 5000;
+    uint16_t timeout_ms_ = 5000;
+    followRedirects_t follow_redirects_ = HTTPC_DISABLE_FOLLOW_REDIRECTS;
+    bool reuse_ = true;
+    int size_ = -1;
+    bool chunked_ = false;
+};
@@ -0,0 +1,24 @@
+#pragma once
+
+#include "Stream.h"
+
+class HardwareSerial : public Stream {
+public:
+    void begin(unsigned long baud) { (void)baud; }
+    void end() {}
+
+    size_t write(uint8_t value) override;
+    size_t write(const uint8_t* buffer, size_t size) override;
+    using Print::write;
+    void flush() override;
+
+    int available() override { return 0; }
+    int read() override { return -1; }
+    int peek() override { return -1; }
+
+protected:
+    int timedRead() override { return -1; }
+    int timedPeek() override { return -1; }
+};
+
+extern HardwareSerial Serial;
@@ -0,0 +1,17 @@
+#pragma once
+
+#include <cstdint>
+
+#include "WString.h"
+
+class IPAddress {
+public:
+    IPAddress() = default;
+    IPAddress(uint8_t a, uint8_t b, uint8_t c, uint8_t d) : octets_{a, b, c, d} {}
+
+    uint8_t operator[](int index) const { return octets_[index & 3]; }
+    String toString() const;
+
+private:
+    uint8_t octets_[4] = {0, 0, 0, 0};
+};
@@ -0,0 +1,37 @@
+#pragma once
+
+// In-memory NVS stand-in. Values live for the lifetime of the process and are
+// shared between Preferences instances that open the same namespace.
+
+#include <Arduino.h>
+
+class Preferences {
+public:
+    bool begin(const char* name, bool read_only = false, const char* partition_label = nullptr);
+    void end();
+
+    bool clear();
+    bool remove(const char* key);
+    bool isKey(const char* key);
+
+    size_t putBool(const char* key, bool value);
+    size_t putUShort(const char* key, uint16_t value);
+    size_t putUInt(const char* key, uint32_t value);
+    size_t putFloat(const char* key, float value);
+    size_t putString(const char* key, const char* value);
+    size_t putString(const char* key, const String& value);
+
+    bool getBool(const char* key, bool default_value = false);
+    uint16_t getUShort(const char* key, uint16_t default_value = 0);
+    uint32_t getUInt(const char* key, uint32_t default_value = 0);
+    float getFloat(const char* key, float default_value = NAN);
+    String getString(const char* key, const String& default_value = String());
+
+private:
+    size_t put_bytes(const char* key, const void* value, size_t length);
+    bool get_bytes(const char* key, void* value, size_t length);
+
+    String namespace_;
+    bool started_ = false;
+    bool read_only_ = false;
+};
@@ -0,0 +1,40 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+
+#include "WString.h"
+
+class Print {
+public:
+    virtual ~Print() = default;
+
+    virtual size_t write(uint8_t value) = 0;
+    virtual size_t write(const uint8_t* buffer, size_t size);
+    size_t write(const char* cstr);
+    size_t write(const char* buffer, size_t size) {
+        return write(reinterpret_cast<const uint8_t*>(buffer), size);
+    }
+    virtual void flush() {}
+
+    size_t print(const String& value);
+    size_t print(const char* cstr);
+    size_t print(char c);
+    size_t print(unsigned char value, int base = 10);
+    size_t print(int value, int base = 10);
+    size_t print(unsigned int value, int base = 10);
+    size_t print(long value, int base = 10);
+    size_t print(unsigned long value, int base = 10);
+    size_t print(long long value, int base = 10);
+    size_t print(unsigned long long value, int base = 10);
+    size_t print(double value, int digits = 2);
+
+    size_t println();
+    template <typename T>
+    size_t println(const T& value) {
+        const size_t written = print(value);
+        return written + println();
+    }
+
+    size_t printf(const char* format, ...) __attribute__((format(printf, 2, 3)));
+};
@@ -0,0 +1,49 @@
+#pragma once
+
+#include <Arduino.h>
+#include <FS.h>
+#include <SPI.h>
+
+typedef enum {
+    CARD_NONE,
+    CARD_MMC,
+    CARD_SD,
+    CARD_SDHC,
+    CARD_UNKNOWN,
+} sdcard_type_t;
+
+namespace fs {
+
+class SDFS {
+public:
+    bool begin(uint8_t ss_pin = 10, SPIClass& spi = SPI, uint32_t frequency = 4000000,
+        const char* mountpoint = "/sd", uint8_t max_files = 5, bool format_if_empty = false);
+    void end();
+    sdcard_type_t cardType();
+    uint64_t cardSize();
+    uint64_t totalBytes();
+    uint64_t usedBytes();
+
+    File open(const char* path, const char* mode = FILE_READ, bool create = false);
+    File open(const String& path, const char* mode = FILE_READ, bool create = false) {
+        return open(path.c_str(), mode, create);
+    }
+    bool exists(const char* path);
+    bool exists(const String& path) { return exists(path.c_str()); }
+    bool remove(const char* path);
+    bool remove(const String& path) { return remove(path.c_str()); }
+    bool rename(const char* from, const char* to);
+    bool rename(const String& from, const String& to) { return rename(from.c_str(), to.c_str()); }
+    bool mkdir(const char* path);
+    bool mkdir(const String& path) { return mkdir(path.c_str()); }
+    bool rmdir(const char* path);
+    bool rmdir(const String& path) { return rmdir(path.c_str()); }
+
+private:
+    bool mounted_ = false;
+};
+
+} // namespace fs
+
+extern fs::SDFS SD;
+using fs::SDFS;
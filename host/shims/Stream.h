@@ -0,0 +1,32 @@
+#pragma once
+
+#include "Print.h"
+
+class Stream : public Print {
+public:
+    virtual int available() = 0;
+    virtual int read() = 0;
+    virtual int peek() = 0;
+
+    void setTimeout(unsigned long timeout_ms) { timeout_ms_ = timeout_ms; }
+    unsigned long getTimeout() const { return timeout_ms_; }
+
+    bool find(const char* target);
+    bool findUntil(const char* target, const char* terminator);
+    virtual size_t readBytes(char* buffer, size_t length);
+    size_t readBytes(uint8_t* buffer, size_t length) {
+        return readBytes(reinterpret_cast<char*>(buffer), length);
+    }
+    size_t readBytesUntil(char terminator, char* buffer, size_t length);
+    virtual String readString();
+    virtual String readStringUntil(char terminator);
+
+protected:
+    // Waits for the next byte like the Arduino core, but on the host clock so
+    // a frozen virtual millis() cannot spin forever. Finite sources such as
+    // files and buffered responses override it to return -1 at end of data.
+    virtual int timedRead();
+    virtual int timedPeek();
+
+    unsigned long timeout_ms_ = 1000;
+};
@@ -0,0 +1,28 @@
+#pragma once
+
+// Flash writer stand-in: counts bytes and validates the image header so the
+// OTA install path can run end to end without touching a partition.
+
+#include <Arduino.h>
+
+#define U_FLASH 0
+#define UPDATE_SIZE_UNKNOWN 0xFFFFFFFF
+
+class UpdateClass {
+public:
+    bool begin(size_t size = UPDATE_SIZE_UNKNOWN, int command = U_FLASH);
+    size_t write(uint8_t* data, size_t length);
+    bool end(bool even_if_remaining = false);
+    void abort();
+    bool hasError() const { return error_ != nullptr; }
+    const char* errorString() const { return error_ ? error_ : "No Error"; }
+    size_t progress() const { return written_; }
+
+private:
+    size_t size_ = 0;
+    size_t written_ = 0;
+    bool active_ = false;
+    const char* error_ = nullptr;
+};
+
+extern UpdateClass Update;
@@ -0,0 +1,280 @@
+#include "WString.h"
+
+#include <algorithm>
+#include <cctype>
+#include <cstdio>
+#include <cstdlib>
+
+namespace {
+
+std::string format_integer(unsigned long long value, bool negative, unsigned char base) {
+    if (base < 2 || base > 36) {
+        base = 10;
+    }
+    char buffer[72];
+    size_t index = sizeof(buffer);
+    buffer[--index] = '\0';
+    do {
+        const unsigned digit = static_cast<unsigned>(value % base);
+        buffer[--index] = static_cast<char>(digit < 10 ? '0' + digit : 'a' + digit - 10);
+        value /= base;
+    } while (value > 0);
+    if (negative) {
+        buffer[--index] = '-';
+    }
+    return std::string(buffer + index);
+}
+
+std::string format_signed(long long value, unsigned char base) {
+    if (value < 0 && base == 10) {
+        return format_integer(static_cast<unsigned long long>(-(value + 1)) + 1ULL, true, base);
+    }
+    return format_integer(static_cast<unsigned long long>(value), false, base);
+}
+
+std::string format_float(double value, unsigned int decimal_places) {
+    char buffer[64];
+    snprintf(buffer, sizeof(buffer), "%.*f", static_cast<int>(decimal_places), value);
+    return std::string(buffer);
+}
+
+} // namespace
+
+String::String(const char* cstr) : value_(cstr ? cstr : "") {}
+
+String::String(const char* cstr, unsigned int length) {
+    if (cstr) {
+        value_.assign(cstr, length);
+    }
+}
+
+String::String(char c) : value_(1, c) {}
+String::String(unsigned char value, unsigned char base) : value_(format_integer(value, false, base)) {}
+String::String(int value, unsigned char base) : value_(format_signed(value, base)) {}
+String::String(unsigned int value, unsigned char base) : value_(format_integer(value, false, base)) {}
+String::String(long value, unsigned char base) : value_(format_signed(value, base)) {}
+String::String(unsigned long value, unsigned char base) : value_(format_integer(value, false, base)) {}
+String::String(long long value, unsigned char base) : value_(format_signed(value, base)) {}
+String::String(unsigned long long value, unsigned char base)
+    : value_(format_integer(value, false, base)) {}
+String::String(float value, unsigned int decimal_places) : value_(format_float(value, decimal_places)) {}
+String::String(double value, unsigned int decimal_places) : value_(format_float(value, decimal_places)) {}
+
+String& String::operator=(const char* cstr) {
+    value_ = cstr ? cstr : "";
+    return *this;
+}
+
+bool String::reserve(unsigned int size) {
+    value_.reserve(size);
+    return true;
+}
+
+bool String::concat(const String& value) {
+    value_ += value.value_;
+    return true;
+}
+
+bool String::concat(const char* cstr) {
+    if (!cstr) {
+        return false;
+    }
+    value_ += cstr;
+    return true;
+}
+
+bool String::concat(const char* cstr, unsigned int length) {
+    if (!cstr) {
+        return false;
+    }
+    value_.append(cstr, length);
+    return true;
+}
+
+bool String::concat(char c) {
+    value_ += c;
+    return true;
+}
+
+bool String::concat(unsigned char value) { return concat(String(value)); }
+bool String::concat(int value) { return concat(String(value)); }
+bool String::concat(unsigned int value) { return concat(String(value)); }
+bool String::concat(long value) { return concat(String(value)); }
+bool String::concat(unsigned long value) { return concat(String(value)); }
+bool String::concat(long long value) { return concat(String(value)); }
+bool String::concat(unsigned long long value) { return concat(String(value)); }
+bool String::concat(float value) { return concat(String(value)); }
+bool String::concat(double value) { return concat(String(value)); }
+
+bool String::equalsIgnoreCase(const String& other) const {
+    if (value_.size() != other.value_.size()) {
+        return false;
+    }
+    for (size_t i = 0; i < value_.size(); ++i) {
+        if (std::tolower(static_cast<unsigned char>(value_[i])) !=
+            std::tolower(static_cast<unsigned char>(other.value_[i]))) {
+            return false;
+        }
+    }
+    return true;
+}
+
+bool String::startsWith(const String& prefix) const {
+    return startsWith(prefix, 0);
+}
+
+bool String::startsWith(const String& prefix, unsigned int offset) const {
+    return offset <= value_.size() && value_.compare(offset, prefix.value_.size(), prefix.value_) == 0;
+}
+
+bool String::endsWith(const String& suffix) const {
+    return suffix.value_.size() <= value_.size() &&
+        value_.compare(value_.size() - suffix.value_.size(), suffix.value_.size(), suffix.value_) == 0;
+}
+
+char String::charAt(unsigned int index) const {
+    return index < value_.size() ? value_[index] : '\0';
+}
+
+void String::setCharAt(unsigned int index, char c) {
+    if (index < value_.size()) {
+        value_[index] = c;
+    }
+}
+
+char String::operator[](unsigned int index) const {
+    return charAt(index);
+}
+
+char& String::operator[](unsigned int index) {
+    static char dummy_writable_char;
+    if (index >= value_.size()) {
+        dummy_writable_char = '\0';
+        return dummy_writable_char;
+    }
+    return value_[index];
+}
+
+int String::indexOf(char c, unsigned int from) const {
+    const size_t found = value_.find(c, from);
+    return found == std::string::npos ? -1 : static_cast<int>(found);
+}
+
+int String::indexOf(const String& value, unsigned int from) const {
+    const size_t found = value_.find(value.value_, from);
+    return found == std::string::npos ? -1 : static_cast<int>(found);
+}
+
+int String::lastIndexOf(char c) const {
+    const size_t found = value_.rfind(c);
+    return found == std::string::npos ? -1 : static_cast<int>(found);
+}
+
+int String::lastIndexOf(const String& value) const {
+    const size_t found = value_.rfind(value.value_);
+    return found == std::string::npos ? -1 : static_cast<int>(found);
+}
+
+String String::substring(unsigned int begin_index) const {
+    return substring(begin_index, length());
+}
+
+String String::substring(unsigned int begin_index, unsigned int end_index) const {
+    if (begin_index > end_index) {
+        std::swap(begin_index, end_index);
+    }
+    if (begin_index >= value_.size()) {
+        return String();
+    }
+    end_index = std::min<unsigned int>(end_index, length());
+    return String(value_.data() + begin_index, end_index - begin_index);
+}
+
+void String::replace(char find, char replacement) {
+    std::replace(value_.begin(), value_.end(), find, replacement);
+}
+
+void String::replace(const String& find, const String& replacement) {
+    if (find.value_.empty()) {
+        return;
+    }
+    size_t position = 0;
+    while ((position = value_.find(find.value_, position)) != std::string::npos) {
+        value_.replace(position, find.value_.size(), replacement.value_);
+        position += replacement.value_.size();
+    }
+}
+
+void String::remove(unsigned int index) {
+    if (index < value_.size()) {
+        value_.erase(index);
+    }
+}
+
+void String::remove(unsigned int index, unsigned int count) {
+    if (index < value_.size()) {
+        value_.erase(index, count);
+    }
+}
+
+void String::toLowerCase() {
+    for (char& c : value_) {
+        c = static_cast<char>(std::tolower(static_cast<unsigned char>(c)));
+    }
+}
+
+void String::toUpperCase() {
+    for (char& c : value_) {
+        c = static_cast<char>(std::toupper(static_cast<unsigned char>(c)));
+    }
+}
+
+void String::trim() {
+    const auto is_space = [](char c) { return std::isspace(static_cast<unsigned char>(c)) != 0; };
+    while (!value_.empty() && is_space(value_.back())) {
+        value_.pop_back();
+    }
+    size_t first = 0;
+    while (first < value_.size() && is_space(value_[first])) {
+        ++first;
+    }
+    value_.erase(0, first);
+}
+
+long String::toInt() const {
+    return std::strtol(value_.c_str(), nullptr, 10);
+}
+
+float String::toFloat() const {
+    return std::strtof(value_.c_str(), nullptr);
+}
+
+double String::toDouble() const {
+    return std::strtod(value_.c_str(), nullptr);
+}
+
+namespace {
+
+template <typename T>
+StringSumHelper append(const StringSumHelper& lhs, const T& value) {
+    StringSumHelper result(lhs);
+    result.concat(value);
+    return result;
+}
+
+} // namespace
+
+StringSumHelper operator+(const StringSumHelper& lhs, const String& rhs) { return append(lhs, rhs); }
+StringSumHelper operator+(const StringSumHelper& lhs, const char* cstr) { return append(lhs, cstr); }
+StringSumHelper operator+(const StringSumHelper& lhs, char c) { return append(lhs, c); }
+StringSumHelper operator+(const StringSumHelper& lhs, unsigned char value) { return append(lhs, value); }
+StringSumHelper operator+(const StringSumHelper& lhs, int value) { return append(lhs, value); }
+StringSumHelper operator+(const StringSumHelper& lhs, unsigned int value) { return append(lhs, value); }
+StringSumHelper operator+(const StringSumHelper& lhs, long value) { return append(lhs, value); }
+StringSumHelper operator+(const StringSumHelper& lhs, unsigned long value) { return append(lhs, value); }
+StringSumHelper operator+(const StringSumHelper& lhs, long long value) { return append(lhs, value); }
+StringSumHelper operator+(const StringSumHelper& lhs, unsigned long long value) {
+    return append(lhs, value);
+}
+StringSumHelper operator+(const StringSumHelper& lhs, float value) { return append(lhs, value); }
+StringSumHelper operator+(const StringSumHelper& lhs, double value) { return append(lhs, value); }
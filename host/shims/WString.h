@@ -0,0 +1,144 @@
+#pragma once
+
+// Host replacement for the Arduino String class. Storage is a std::string so
+// that host benchmarks see the same allocate-per-copy behaviour as the device.
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+
+class StringSumHelper;
+
+class String {
+public:
+    String(const char* cstr = "");
+    String(const char* cstr, unsigned int length);
+    String(const String& value) = default;
+    String(String&& value) noexcept = default;
+    explicit String(char c);
+    explicit String(unsigned char value, unsigned char base = 10);
+    explicit String(int value, unsigned char base = 10);
+    explicit String(unsigned int value, unsigned char base = 10);
+    explicit String(long value, unsigned char base = 10);
+    explicit String(unsigned long value, unsigned char base = 10);
+    explicit String(long long value, unsigned char base = 10);
+    explicit String(unsigned long long value, unsigned char base = 10);
+    explicit String(float value, unsigned int decimal_places = 2);
+    explicit String(double value, unsigned int decimal_places = 2);
+    ~String() = default;
+
+    String& operator=(const String& rhs) = default;
+    String& operator=(String&& rhs) noexcept = default;
+    String& operator=(const char* cstr);
+
+    bool reserve(unsigned int size);
+    unsigned int length() const { return static_cast<unsigned int>(value_.size()); }
+    bool isEmpty() const { return value_.empty(); }
+    const char* c_str() const { return value_.c_str(); }
+    char* begin() { return &value_[0]; }
+    char* end() { return begin() + value_.size(); }
+    const char* begin() const { return value_.data(); }
+    const char* end() const { return value_.data() + value_.size(); }
+
+    bool concat(const String& value);
+    bool concat(const char* cstr);
+    bool concat(const char* cstr, unsigned int length);
+    bool concat(char c);
+    bool concat(unsigned char value);
+    bool concat(int value);
+    bool concat(unsigned int value);
+    bool concat(long value);
+    bool concat(unsigned long value);
+    bool concat(long long value);
+    bool concat(unsigned long long value);
+    bool concat(float value);
+    bool concat(double value);
+
+    template <typename T>
+    String& operator+=(const T& value) {
+        concat(value);
+        return *this;
+    }
+
+    int compareTo(const String& other) const { return value_.compare(other.value_); }
+    bool equals(const String& other) const { return value_ == other.value_; }
+    bool equals(const char* cstr) const { return value_ == (cstr ? cstr : ""); }
+    bool equalsIgnoreCase(const String& other) const;
+    bool operator==(const String& rhs) const { return equals(rhs); }
+    bool operator==(const char* rhs) const { return equals(rhs); }
+    bool operator!=(const String& rhs) const { return !equals(rhs); }
+    bool operator!=(const char* rhs) const { return !equals(rhs); }
+    bool operator<(const String& rhs) const { return compareTo(rhs) < 0; }
+    bool operator>(const String& rhs) const { return compareTo(rhs) > 0; }
+    bool startsWith(const String& prefix) const;
+    bool startsWith(const String& prefix, unsigned int offset) const;
+    bool endsWith(const String& suffix) const;
+
+    char charAt(unsigned int index) const;
+    void setCharAt(unsigned int index, char c);
+    char operator[](unsigned int index) const;
+    char& operator[](unsigned int index);
+
+    int indexOf(char c) const { return indexOf(c, 0); }
+    int indexOf(char c, unsigned int from) const;
+    int indexOf(const String& value) const { return indexOf(value, 0); }
+    int indexOf(const String& value, unsigned int from) const;
+    int lastIndexOf(char c) const;
+    int lastIndexOf(const String& value) const;
+    String substring(unsigned int begin_index) const;
+    String substring(unsigned int begin_index, unsigned int end_index) const;
+
+    void replace(char find, char replacement);
+    void replace(const String& find, const String& replacement);
+    void remove(unsigned int index);
+    void remove(unsigned int index, unsigned int count);
+    void toLowerCase();
+    void toUpperCase();
+    void trim();
+
+    long toInt() const;
+    float toFloat() const;
+    double toDouble() const;
+
+    const std::string& host_string() const { return value_; }
+
+private:
+    std::string value_;
+};
+
+class StringSumHelper : public String {
+public:
+    StringSumHelper(const String& value) : String(value) {}
+    StringSumHelper(const char* cstr) : String(cstr) {}
+    StringSumHelper(char c) : String(c) {}
+    StringSumHelper(unsigned char value) : String(value) {}
+    StringSumHelper(int value) : String(value) {}
+    StringSumHelper(unsigned int value) : String(value) {}
+    StringSumHelper(long value) : String(value) {}
+    StringSumHelper(unsigned long value) : String(value) {}
+    StringSumHelper(long long value) : String(value) {}
+    StringSumHelper(unsigned long long value) : String(value) {}
+    StringSumHelper(float value) : String(value) {}
+    StringSumHelper(double value) : String(value) {}
+};
+
+StringSumHelper operator+(const StringSumHelper& lhs, const String& rhs);
+StringSumHelper operator+(const StringSumHelper& lhs, const char* cstr);
+StringSumHelper operator+(const StringSumHelper& lhs, char c);
+StringSumHelper operator+(const StringSumHelper& lhs, unsigned char value);
+StringSumHelper operator+(const StringSumHelper& lhs, int value);
+StringSumHelper operator+(const StringSumHelper& lhs, unsigned int value);
+StringSumHelper operator+(const StringSumHelper& lhs, long value);
+StringSumHelper operator+(const StringSumHelper& lhs, unsigned long value);
+StringSumHelper operator+(const StringSumHelper& lhs, long long value);
+StringSumHelper operator+(const StringSumHelper& lhs, unsigned long long value);
+StringSumHelper operator+(const StringSumHelper& lhs, float value);
+StringSumHelper operator+(const StringSumHelper& lhs, double value);
+
+inline bool operator==(const char* lhs, const String& rhs) {
+    return rhs.equals(lhs);
+}
+
+inline bool operator!=(const char* lhs, const String& rhs) {
+    return !rhs.equals(lhs);
+}
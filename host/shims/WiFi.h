@@ -0,0 +1,89 @@
+#pragma once
+
+#include <Arduino.h>
+#include <WiFiClient.h>
+#include <esp_wifi.h>
+
+typedef enum {
+    WL_IDLE_STATUS = 0,
+    WL_NO_SSID_AVAIL = 1,
+    WL_SCAN_COMPLETED = 2,
+    WL_CONNECTED = 3,
+    WL_CONNECT_FAILED = 4,
+    WL_CONNECTION_LOST = 5,
+    WL_DISCONNECTED = 6,
+} wl_status_t;
+
+typedef enum {
+    WIFI_OFF = 0,
+    WIFI_STA = 1,
+    WIFI_AP = 2,
+    WIFI_AP_STA = 3,
+} wifi_mode_t;
+
+typedef enum {
+    WIFI_POWER_19_5dBm = 78,
+    WIFI_POWER_17dBm = 68,
+    WIFI_POWER_15dBm = 60,
+    WIFI_POWER_11dBm = 44,
+} wifi_power_t;
+
+#define WIFI_SCAN_RUNNING (-1)
+#define WIFI_SCAN_FAILED (-2)
+
+typedef enum {
+    ARDUINO_EVENT_WIFI_STA_CONNECTED = 4,
+    ARDUINO_EVENT_WIFI_STA_DISCONNECTED = 5,
+    ARDUINO_EVENT_WIFI_STA_GOT_IP = 7,
+    ARDUINO_EVENT_MAX = 64,
+} arduino_event_id_t;
+
+typedef struct {
+    uint8_t ssid[33];
+    uint8_t ssid_len;
+    uint8_t bssid[6];
+    uint8_t reason;
+} wifi_event_sta_disconnected_t;
+
+typedef union {
+    wifi_event_sta_disconnected_t wifi_sta_disconnected;
+} arduino_event_info_t;
+
+typedef arduino_event_id_t WiFiEvent_t;
+typedef arduino_event_info_t WiFiEventInfo_t;
+typedef void (*WiFiEventFuncCb)(arduino_event_id_t event, arduino_event_info_t info);
+typedef size_t wifi_event_id_t;
+
+class WiFiClass {
+public:
+    wl_status_t status();
+    wl_status_t begin(const char* ssid, const char* passphrase = nullptr);
+    bool disconnect(bool wifi_off = false, bool erase_ap = false);
+    bool mode(wifi_mode_t mode);
+    bool setSleep(bool enabled);
+    bool setTxPower(wifi_power_t power);
+    wifi_power_t getTxPower();
+    bool setAutoReconnect(bool auto_reconnect);
+    wifi_event_id_t onEvent(WiFiEventFuncCb callback, arduino_event_id_t event = ARDUINO_EVENT_MAX);
+
+    // No networks are ever found on the host.
+    int16_t scanNetworks(bool async = false, bool show_hidden = false);
+    int16_t scanComplete();
+    void scanDelete();
+    String SSID(uint8_t index);
+    int32_t RSSI(uint8_t index);
+    int32_t channel(uint8_t index);
+
+    // Any name resolves to 127.0.0.1 (see host::net_set_latency()).
+    int hostByName(const char* host, IPAddress& result);
+
+    IPAddress localIP();
+    int8_t RSSI();
+    int32_t channel();
+    String SSID();
+    uint8_t* macAddress(uint8_t* mac);
+    String macAddress();
+    const char* disconnectReasonName(wifi_err_reason_t reason);
+};
+
+extern WiFiClass WiFi;
@@ -0,0 +1,89 @@
+#pragma once
+
+// Client side of the host HTTP stand-in. HTTPClient fills the receive buffer
+// with the whole response body, so reads never block. With
+// host::http_use_socket() the client also owns a real TCP connection that
+// HTTPClient writes the request to and reads the response from.
+
+#include <Arduino.h>
+
+#include <string>
+
+class WiFiClient : public Stream {
+public:
+    WiFiClient() = default;
+    WiFiClient(const WiFiClient&) = delete;
+    WiFiClient& operator=(const WiFiClient&) = delete;
+    virtual ~WiFiClient() { host_close(); }
+
+    size_t write(uint8_t value) override { return write(&value, 1); }
+    size_t write(const uint8_t* buffer, size_t size) override {
+        (void)buffer;
+        return connected_ ? size : 0;
+    }
+    using Print::write;
+
+    int available() override {
+        return static_cast<int>(rx_.size() - rx_offset_);
+    }
+    int read() override {
+        return rx_offset_ < rx_.size() ? static_cast<uint8_t>(rx_[rx_offset_++]) : -1;
+    }
+    int peek() override {
+        return rx_offset_ < rx_.size() ? static_cast<uint8_t>(rx_[rx_offset_]) : -1;
+    }
+    int read(uint8_t* buffer, size_t size) {
+        const size_t count = std::min(size, rx_.size() - rx_offset_);
+        memcpy(buffer, rx_.data() + rx_offset_, count);
+        rx_offset_ += count;
+        return static_cast<int>(count);
+    }
+
+    // Connects to the host::http_use_socket() target whatever the name; with
+    // the in-process handler there is nothing to connect to and it succeeds
+    // while Wi-Fi is up.
+    virtual int connect(const char* host, uint16_t port);
+    // A connect latency set with host::net_set_latency() longer than
+    // timeout_ms fails after timeout_ms, as a dead host would.
+    int connect(const char* host, uint16_t port, int32_t timeout_ms);
+
+    uint8_t connected() {
+        if (connected_ && fd_ >= 0 && !host_socket_alive()) {
+            connected_ = false;
+        }
+        return connected_ || available() > 0 ? 1 : 0;
+    }
+    void stop() {
+        host_close();
+        connected_ = false;
+        rx_.clear();
+        rx_offset_ = 0;
+    }
+    explicit operator bool() { return connected() != 0; }
+
+    // Host-only: loads a response body for the caller to read.
+    void host_receive(const std::string& data, bool keep_open) {
+        rx_ = data;
+        rx_offset_ = 0;
+        connected_ = keep_open;
+    }
+
+    // Host-only socket transport (network_host.cpp). host_open() connects to
+    // address:port unless already connected there.
+    bool host_open(const std::string& address, uint16_t port, int32_t timeout_ms);
+    void host_close();
+    int host_fd() const { return fd_; }
+
+protected:
+    int timedRead() override { return read(); }
+    int timedPeek() override { return peek(); }
+
+private:
+    std::string rx_;
+    size_t rx_offset_ = 0;
+    bool connected_ = false;
+    int fd_ = -1;
+    std::string peer_;
+
+    bool host_socket_alive();
+};
@@ -0,0 +1,20 @@
+#pragma once
+
+// The captive portal never starts on the host; provisioning is driven by
+// stored credentials only.
+
+#include <Arduino.h>
+
+class WiFiManager {
+public:
+    void setConfigPortalBlocking(bool blocking) { (void)blocking; }
+    void setConfigPortalTimeout(unsigned long seconds) { (void)seconds; }
+    bool startConfigPortal(const char* ap_name = nullptr, const char* ap_password = nullptr) {
+        (void)ap_name;
+        (void)ap_password;
+        return false;
+    }
+    bool process() { return false; }
+    void stopConfigPortal() {}
+    void resetSettings() {}
+};
@@ -0,0 +1,387 @@
+#include "Arduino.h"
+
+#include <atomic>
+#include <chrono>
+#include <random>
+#include <thread>
+
+#include "host_runtime.h"
+#include "host_tick.h"
+
+namespace {
+
+using SteadyClock = std::chrono::steady_clock;
+
+const SteadyClock::time_point g_epoch = SteadyClock::now();
+std::atomic<bool> g_virtual_clock{false};
+std::atomic<uint64_t> g_virtual_us{0};
+std::atomic<bool> g_serial_enabled{true};
+std::mt19937 g_random;
+
+} // namespace
+
+namespace host {
+
+void clock_use_virtual(bool enabled, uint32_t start_ms) {
+    g_virtual_us = static_cast<uint64_t>(start_ms) * 1000ULL;
+    g_virtual_clock = enabled;
+}
+
+bool clock_is_virtual() {
+    return g_virtual_clock;
+}
+
+void clock_advance_ms(uint32_t ms) {
+    clock_advance_us(static_cast<uint64_t>(ms) * 1000ULL);
+}
+
+void clock_advance_us(uint64_t us) {
+    g_virtual_us += us;
+}
+
+uint64_t clock_now_us() {
+    if (g_virtual_clock) {
+        return g_virtual_us;
+    }
+    return static_cast<uint64_t>(
+        std::chrono::duration_cast<std::chrono::microseconds>(SteadyClock::now() - g_epoch).count());
+}
+
+uint64_t real_now_ns() {
+    return static_cast<uint64_t>(
+        std::chrono::duration_cast<std::chrono::nanoseconds>(SteadyClock::now() - g_epoch).count());
+}
+
+void serial_set_enabled(bool enabled) {
+    g_serial_enabled = enabled;
+}
+
+} // namespace host
+
+uint32_t millis() {
+    return static_cast<uint32_t>(host::clock_now_us() / 1000ULL);
+}
+
+uint32_t host_tick_ms(void) {
+    return millis();
+}
+
+uint32_t micros() {
+    return static_cast<uint32_t>(host::clock_now_us());
+}
+
+void delay(uint32_t ms) {
+    if (g_virtual_clock) {
+        host::clock_advance_ms(ms);
+        return;
+    }
+    std::this_thread::sleep_for(std::chrono::milliseconds(ms));
+}
+
+void delayMicroseconds(uint32_t us) {
+    if (g_virtual_clock) {
+        host::clock_advance_us(us);
+        return;
+    }
+    std::this_thread::sleep_for(std::chrono::microseconds(us));
+}
+
+void yield() {
+    std::this_thread::yield();
+}
+
+void pinMode(uint8_t pin, uint8_t mode) {
+    (void)pin;
+    (void)mode;
+}
+
+void digitalWrite(uint8_t pin, uint8_t value) {
+    (void)pin;
+    (void)value;
+}
+
+int digitalRead(uint8_t pin) {
+    (void)pin;
+    return HIGH;
+}
+
+void attachInterrupt(uint8_t pin, void (*handler)(), int mode) {
+    (void)pin;
+    (void)handler;
+    (void)mode;
+}
+
+void detachInterrupt(uint8_t pin) {
+    (void)pin;
+}
+
+void noInterrupts() {}
+void interrupts() {}
+
+void randomSeed(unsigned long seed) {
+    g_random.seed(static_cast<std::mt19937::result_type>(seed));
+}
+
+long random(long max_value) {
+    return max_value <= 0 ? 0 : static_cast<long>(g_random() % static_cast<unsigned long>(max_value));
+}
+
+long random(long min_value, long max_value) {
+    return max_value <= min_value ? min_value : min_value + random(max_value - min_value);
+}
+
+void configTzTime(const char* tz, const char* server1, const char* server2, const char* server3) {
+    (void)server1;
+    (void)server2;
+    (void)server3;
+    setenv("TZ", tz, 1);
+    tzset();
+}
+
+// Print -----------------------------------------------------------------------
+
+size_t Print::write(const uint8_t* buffer, size_t size) {
+    size_t written = 0;
+    while (size--) {
+        if (write(*buffer++) == 0) {
+            break;
+        }
+        ++written;
+    }
+    return written;
+}
+
+size_t Print::write(const char* cstr) {
+    return cstr ? write(reinterpret_cast<const uint8_t*>(cstr), strlen(cstr)) : 0;
+}
+
+size_t Print::print(const String& value) {
+    return write(reinterpret_cast<const uint8_t*>(value.c_str()), value.length());
+}
+
+size_t Print::print(const char* cstr) {
+    return write(cstr);
+}
+
+size_t Print::print(char c) {
+    return write(static_cast<uint8_t>(c));
+}
+
+size_t Print::print(unsigned char value, int base) {
+    return print(String(value, static_cast<unsigned char>(base)));
+}
+
+size_t Print::print(int value, int base) {
+    return print(String(value, static_cast<unsigned char>(base)));
+}
+
+size_t Print::print(unsigned int value, int base) {
+    return print(String(value, static_cast<unsigned char>(base)));
+}
+
+size_t Print::print(long value, int base) {
+    return print(String(value, static_cast<unsigned char>(base)));
+}
+
+size_t Print::print(unsigned long value, int base) {
+    return print(String(value, static_cast<unsigned char>(base)));
+}
+
+size_t Print::print(long long value, int base) {
+    return print(String(value, static_cast<unsigned char>(base)));
+}
+
+size_t Print::print(unsigned long long value, int base) {
+    return print(String(value, static_cast<unsigned char>(base)));
+}
+
+size_t Print::print(double value, int digits) {
+    return print(String(value, static_cast<unsigned int>(digits)));
+}
+
+size_t Print::println() {
+    return write("\r\n");
+}
+
+size_t Print::printf(const char* format, ...) {
+    char stack_buffer[256];
+    va_list args;
+    va_start(args, format);
+    va_list copy;
+    va_copy(copy, args);
+    const int length = vsnprintf(stack_buffer, sizeof(stack_buffer), format, copy);
+    va_end(copy);
+    if (length < 0) {
+        va_end(args);
+        return 0;
+    }
+    if (static_cast<size_t>(length) < sizeof(stack_buffer)) {
+        va_end(args);
+        return write(reinterpret_cast<const uint8_t*>(stack_buffer), static_cast<size_t>(length));
+    }
+    std::string heap_buffer(static_cast<size_t>(length) + 1, '\0');
+    vsnprintf(&heap_buffer[0], heap_buffer.size(), format, args);
+    va_end(args);
+    return write(reinterpret_cast<const uint8_t*>(heap_buffer.data()), static_cast<size_t>(length));
+}
+
+// Stream ----------------------------------------------------------------------
+
+int Stream::timedRead() {
+    const uint64_t deadline = host::real_now_ns() + static_cast<uint64_t>(timeout_ms_) * 1000000ULL;
+    do {
+        const int c = read();
+        if (c >= 0) {
+            return c;
+        }
+        std::this_thread::yield();
+    } while (host::real_now_ns() < deadline);
+    return -1;
+}
+
+int Stream::timedPeek() {
+    const uint64_t deadline = host::real_now_ns() + static_cast<uint64_t>(timeout_ms_) * 1000000ULL;
+    do {
+        const int c = peek();
+        if (c >= 0) {
+            return c;
+        }
+        std::this_thread::yield();
+    } while (host::real_now_ns() < deadline);
+    return -1;
+}
+
+bool Stream::find(const char* target) {
+    return findUntil(target, nullptr);
+}
+
+bool Stream::findUntil(const char* target, const char* terminator) {
+    const size_t target_length = target ? strlen(target) : 0;
+    const size_t terminator_length = terminator ? strlen(terminator) : 0;
+    if (target_length == 0) {
+        return true;
+    }
+    size_t target_index = 0;
+    size_t terminator_index = 0;
+    int c;
+    while ((c = timedRead()) >= 0) {
+        if (c != target[target_index]) {
+            target_index = 0;
+        }
+        if (c == target[target_index] && ++target_index >= target_length) {
+            return true;
+        }
+        if (terminator_length > 0) {
+            if (c != terminator[terminator_index]) {
+                terminator_index = 0;
+            }
+            if (c == terminator[terminator_index] && ++terminator_index >= terminator_length) {
+                return false;
+            }
+        }
+    }
+    return false;
+}
+
+size_t Stream::readBytes(char* buffer, size_t length) {
+    size_t count = 0;
+    while (count < length) {
+        const int c = timedRead();
+        if (c < 0) {
+            break;
+        }
+        buffer[count++] = static_cast<char>(c);
+    }
+    return count;
+}
+
+size_t Stream::readBytesUntil(char terminator, char* buffer, size_t length) {
+    size_t count = 0;
+    while (count < length) {
+        const int c = timedRead();
+        if (c < 0 || c == terminator) {
+            break;
+        }
+        buffer[count++] = static_cast<char>(c);
+    }
+    return count;
+}
+
+String Stream::readString() {
+    String result;
+    int c;
+    while ((c = timedRead()) >= 0) {
+        result += static_cast<char>(c);
+    }
+    return result;
+}
+
+String Stream::readStringUntil(char terminator) {
+    String result;
+    int c;
+    while ((c = timedRead()) >= 0 && c != terminator) {
+        result += static_cast<char>(c);
+    }
+    return result;
+}
+
+// Serial, IPAddress, ESP ------------------------------------------------------
+
+HardwareSerial Serial;
+
+size_t HardwareSerial::write(uint8_t value) {
+    if (g_serial_enabled) {
+        fputc(value, stdout);
+    }
+    return 1;
+}
+
+size_t HardwareSerial::write(const uint8_t* buffer, size_t size) {
+    if (g_serial_enabled) {
+        fwrite(buffer, 1, size, stdout);
+    }
+    return size;
+}
+
+void HardwareSerial::flush() {
+    fflush(stdout);
+}
+
+String IPAddress::toString() const {
+    char buffer[16];
+    snprintf(buffer, sizeof(buffer), "%u.%u.%u.%u", octets_[0], octets_[1], octets_[2], octets_[3]);
+    return String(buffer);
+}
+
+EspClass ESP;
+
+uint32_t EspClass::getFreeHeap() {
+    return 256U * 1024U;
+}
+
+uint32_t EspClass::getHeapSize() {
+    return 320U * 1024U;
+}
+
+uint32_t EspClass::getMinFreeHeap() {
+    return 200U * 1024U;
+}
+
+uint32_t EspClass::getMaxAllocHeap() {
+    return 110U * 1024U;
+}
+
+uint32_t EspClass::getFreePsram() {
+    return 7U * 1024U * 1024U;
+}
+
+uint32_t EspClass::getCycleCount() {
+    // The S3 runs at 240 MHz; scale host nanoseconds to comparable cycles.
+    return static_cast<uint32_t>(host::real_now_ns() * 240ULL / 1000ULL);
+}
+
+void EspClass::restart() {
+    Serial.println("[HOST] ESP.restart() requested; exiting");
+    fflush(stdout);
+    std::_Exit(0);
+}
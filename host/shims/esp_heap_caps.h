@@ -0,0 +1,41 @@
+#pragma once
+
+// Capability-tagged allocation collapses to malloc on the host.
+
+#include <cstddef>
+#include <cstdint>
+#include <cstdlib>
+
+#define MALLOC_CAP_EXEC (1 << 0)
+#define MALLOC_CAP_32BIT (1 << 1)
+#define MALLOC_CAP_8BIT (1 << 2)
+#define MALLOC_CAP_DMA (1 << 3)
+#define MALLOC_CAP_SPIRAM (1 << 10)
+#define MALLOC_CAP_INTERNAL (1 << 11)
+#define MALLOC_CAP_DEFAULT (1 << 12)
+
+inline void* heap_caps_malloc(size_t size, uint32_t caps) {
+    (void)caps;
+    return malloc(size);
+}
+
+inline void heap_caps_free(void* ptr) {
+    free(ptr);
+}
+
+// Fixed figures in line with EspClass: 320 KiB internal RAM, 8 MiB PSRAM.
+inline size_t heap_caps_get_total_size(uint32_t caps) {
+    return (caps & MALLOC_CAP_SPIRAM) ? 8U * 1024U * 1024U : 320U * 1024U;
+}
+
+inline size_t heap_caps_get_free_size(uint32_t caps) {
+    return (caps & MALLOC_CAP_SPIRAM) ? 7U * 1024U * 1024U : 256U * 1024U;
+}
+
+inline size_t heap_caps_get_largest_free_block(uint32_t caps) {
+    return (caps & MALLOC_CAP_SPIRAM) ? 7U * 1024U * 1024U - 4096U : 110U * 1024U;
+}
+
+inline size_t heap_caps_get_minimum_free_size(uint32_t caps) {
+    return (caps & MALLOC_CAP_SPIRAM) ? 6U * 1024U * 1024U : 200U * 1024U;
+}
@@ -0,0 +1,20 @@
+#pragma once
+
+#include <cstdint>
+
+typedef int esp_err_t;
+#define ESP_OK 0
+
+typedef enum {
+    WIFI_REASON_UNSPECIFIED = 1,
+    WIFI_REASON_4WAY_HANDSHAKE_TIMEOUT = 15,
+    WIFI_REASON_BEACON_TIMEOUT = 200,
+    WIFI_REASON_NO_AP_FOUND = 201,
+    WIFI_REASON_AUTH_FAIL = 202,
+    WIFI_REASON_ASSOC_FAIL = 203,
+    WIFI_REASON_HANDSHAKE_TIMEOUT = 204,
+    WIFI_REASON_CONNECTION_FAIL = 205,
+    WIFI_REASON_TIMEOUT = 208,
+} wifi_err_reason_t;
+
+esp_err_t esp_wifi_scan_stop();
@@ -0,0 +1,27 @@
+#pragma once
+
+// FreeRTOS API subset backed by std::thread, std::mutex and
+// std::condition_variable. One tick is one millisecond, as on the device.
+
+#include <cstddef>
+#include <cstdint>
+
+typedef int BaseType_t;
+typedef unsigned int UBaseType_t;
+typedef uint32_t TickType_t;
+
+#define pdFALSE 0
+#define pdTRUE 1
+#define pdPASS pdTRUE
+#define pdFAIL pdFALSE
+#define errQUEUE_EMPTY 0
+#define errQUEUE_FULL 0
+#define errCOULD_NOT_ALLOCATE_REQUIRED_MEMORY (-1)
+
+#define portMAX_DELAY static_cast<TickType_t>(0xffffffffUL)
+#define portTICK_PERIOD_MS static_cast<TickType_t>(1)
+#define configTICK_RATE_HZ 1000
+#define pdMS_TO_TICKS(ms) static_cast<TickType_t>(ms)
+#define tskNO_AFFINITY 0x7FFFFFFF
+
+#define portYIELD_FROM_ISR(...) ((void)0)
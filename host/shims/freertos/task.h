@@ -0,0 +1,46 @@
+#pragma once
+
+#include "FreeRTOS.h"
+
+typedef enum {
+    eNoAction = 0,
+    eSetBits,
+    eIncrement,
+    eSetValueWithOverwrite,
+    eSetValueWithoutOverwrite,
+} eNotifyAction;
+
+struct HostTask;
+typedef HostTask* TaskHandle_t;
+typedef void (*TaskFunction_t)(void*);
+
+BaseType_t xTaskCreatePinnedToCore(
+    TaskFunction_t function,
+    const char* name,
+    uint32_t stack_depth,
+    void* parameter,
+    UBaseType_t priority,
+    TaskHandle_t* created_task,
+    BaseType_t core_id);
+BaseType_t xTaskCreate(
+    TaskFunction_t function,
+    const char* name,
+    uint32_t stack_depth,
+    void* parameter,
+    UBaseType_t priority,
+    TaskHandle_t* created_task);
+void vTaskDelete(TaskHandle_t task);
+void vTaskDelay(TickType_t ticks);
+TickType_t xTaskGetTickCount();
+TaskHandle_t xTaskGetCurrentTaskHandle();
+const char* pcTaskGetName(TaskHandle_t task);
+UBaseType_t uxTaskGetStackHighWaterMark(TaskHandle_t task);
+
+uint32_t ulTaskNotifyTake(BaseType_t clear_count_on_exit, TickType_t ticks_to_wait);
+BaseType_t xTaskNotifyGive(TaskHandle_t task);
+void vTaskNotifyGiveFromISR(TaskHandle_t task, BaseType_t* higher_priority_woken);
+BaseType_t xTaskNotify(TaskHandle_t task, uint32_t value, eNotifyAction action);
+BaseType_t xTaskNotifyFromISR(
+    TaskHandle_t task, uint32_t value, eNotifyAction action, BaseType_t* higher_priority_woken);
+BaseType_t xTaskNotifyWait(
+    uint32_t bits_to_clear_on_entry, uint32_t bits_to_clear_on_exit, uint32_t* notification_value, TickType_t ticks_to_wait);
@@ -0,0 +1,487 @@
+#include "freertos/FreeRTOS.h"
+#include "freertos/queue.h"
+#include "freertos/semphr.h"
+#include "freertos/task.h"
+
+#include <chrono>
+#include <condition_variable>
+#include <cstring>
+#include <deque>
+#include <map>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "Arduino.h"
+#include "host_runtime.h"
+
+struct HostQueue {
+    std::mutex mutex;
+    std::condition_variable readable;
+    std::condition_variable writable;
+    std::deque<std::vector<uint8_t>> items;
+    size_t length = 0;
+    size_t item_size = 0;
+};
+
+struct HostSemaphore {
+    std::timed_mutex mutex;
+};
+
+struct HostTask {
+    std::string name;
+    TaskFunction_t function = nullptr;
+    void* parameter = nullptr;
+    uint32_t stack_depth = 0;
+    std::mutex notify_mutex;
+    std::condition_variable notified;
+    uint32_t notify_value = 0;
+    bool notify_pending = false;
+    // Set while the task is blocked indefinitely in ulTaskNotifyTake(), for
+    // host::task_wait_idle().
+    bool idle = false;
+    std::condition_variable idle_changed;
+};
+
+namespace {
+
+thread_local HostTask* t_current_task = nullptr;
+std::mutex g_timed_notify_mutex;
+struct TimedNotification {
+    HostTask* task = nullptr;
+    uint32_t bits = 0;
+};
+
+std::multimap<uint64_t, TimedNotification> g_timed_notifications;
+std::mutex g_tasks_mutex;
+std::vector<HostTask*> g_tasks;
+
+// Handles are intentionally leaked: detached worker threads may still be
+// blocked on them while static destructors run at process exit.
+template <typename Predicate>
+bool wait_for(std::unique_lock<std::mutex>& lock,
+    std::condition_variable& condition,
+    TickType_t ticks,
+    Predicate ready) {
+    if (ticks == portMAX_DELAY) {
+        condition.wait(lock, ready);
+        return true;
+    }
+    return condition.wait_for(lock, std::chrono::milliseconds(ticks), ready);
+}
+
+BaseType_t queue_send(QueueHandle_t queue, const void* item, TickType_t ticks, bool front) {
+    if (!queue) {
+        return pdFAIL;
+    }
+    std::unique_lock<std::mutex> lock(queue->mutex);
+    if (!wait_for(lock, queue->writable, ticks, [queue] { return queue->items.size() < queue->length; })) {
+        return errQUEUE_FULL;
+    }
+    const auto* bytes = static_cast<const uint8_t*>(item);
+    std::vector<uint8_t> copy(bytes, bytes + queue->item_size);
+    if (front) {
+        queue->items.push_front(std::move(copy));
+    } else {
+        queue->items.push_back(std::move(copy));
+    }
+    lock.unlock();
+    queue->readable.notify_one();
+    return pdPASS;
+}
+
+BaseType_t notify_task(HostTask* task, uint32_t value, eNotifyAction action) {
+    if (!task) {
+        return pdFAIL;
+    }
+    {
+        std::lock_guard<std::mutex> lock(task->notify_mutex);
+        switch (action) {
+            case eSetBits:
+                task->notify_value |= value;
+                break;
+            case eIncrement:
+                task->notify_value++;
+                break;
+            case eSetValueWithOverwrite:
+                task->notify_value = value;
+                break;
+            case eSetValueWithoutOverwrite:
+                if (task->notify_pending) {
+                    return pdFAIL;
+                }
+                task->notify_value = value;
+                break;
+            case eNoAction:
+                break;
+        }
+        task->notify_pending = true;
+    }
+    task->notified.notify_one();
+    return pdPASS;
+}
+
+// A timed notification with no bits behaves like xTaskNotifyGive().
+void deliver_timed_notifications(uint64_t until_us) {
+    std::lock_guard<std::mutex> lock(g_timed_notify_mutex);
+    while (!g_timed_notifications.empty() && g_timed_notifications.begin()->first <= until_us) {
+        const TimedNotification notification = g_timed_notifications.begin()->second;
+        g_timed_notifications.erase(g_timed_notifications.begin());
+        notify_task(notification.task, notification.bits, notification.bits ? eSetBits : eIncrement);
+    }
+}
+
+uint64_t next_timed_notification(HostTask* task, uint64_t limit_us) {
+    std::lock_guard<std::mutex> lock(g_timed_notify_mutex);
+    for (const auto& entry : g_timed_notifications) {
+        if (entry.first > limit_us) {
+            break;
+        }
+        if (entry.second.task == task) {
+            return entry.first;
+        }
+    }
+    return limit_us;
+}
+
+// With the virtual clock a blocking wait never sleeps: time jumps to the
+// task's next timed notification or to the timeout, whichever comes first.
+// An indefinite wait with nothing scheduled cannot jump anywhere; it returns
+// true and the caller blocks until another task notifies it.
+bool advance_virtual_wait(HostTask* task, TickType_t ticks_to_wait, bool (*ready)(const HostTask*)) {
+    const uint64_t now_us = host::clock_now_us();
+    deliver_timed_notifications(now_us);
+    {
+        std::lock_guard<std::mutex> lock(task->notify_mutex);
+        if (ready(task) || ticks_to_wait == 0) {
+            return false;
+        }
+    }
+    const uint64_t timeout_us = ticks_to_wait == portMAX_DELAY
+        ? UINT64_MAX
+        : now_us + static_cast<uint64_t>(ticks_to_wait) * 1000ULL;
+    const uint64_t wake_us = next_timed_notification(task, timeout_us);
+    if (wake_us == UINT64_MAX) {
+        return true;
+    }
+    host::clock_advance_us(wake_us - now_us);
+    deliver_timed_notifications(wake_us);
+    return false;
+}
+
+bool has_notify_count(const HostTask* task) {
+    return task->notify_value > 0;
+}
+
+bool has_notify_pending(const HostTask* task) {
+    return task->notify_pending;
+}
+
+void task_entry(HostTask* task) {
+    t_current_task = task;
+    task->function(task->parameter);
+}
+
+} // namespace
+
+QueueHandle_t xQueueCreate(UBaseType_t length, UBaseType_t item_size) {
+    if (length == 0 || item_size == 0) {
+        return nullptr;
+    }
+    auto* queue = new HostQueue();
+    queue->length = length;
+    queue->item_size = item_size;
+    return queue;
+}
+
+void vQueueDelete(QueueHandle_t queue) {
+    delete queue;
+}
+
+BaseType_t xQueueSend(QueueHandle_t queue, const void* item, TickType_t ticks_to_wait) {
+    return queue_send(queue, item, ticks_to_wait, false);
+}
+
+BaseType_t xQueueSendToBack(QueueHandle_t queue, const void* item, TickType_t ticks_to_wait) {
+    return queue_send(queue, item, ticks_to_wait, false);
+}
+
+BaseType_t xQueueSendToFront(QueueHandle_t queue, const void* item, TickType_t ticks_to_wait) {
+    return queue_send(queue, item, ticks_to_wait, true);
+}
+
+BaseType_t xQueueSendFromISR(QueueHandle_t queue, const void* item, BaseType_t* higher_priority_woken) {
+    if (higher_priority_woken) {
+        *higher_priority_woken = pdFALSE;
+    }
+    return queue_send(queue, item, 0, false);
+}
+
+BaseType_t xQueueReceive(QueueHandle_t queue, void* item, TickType_t ticks_to_wait) {
+    if (!queue) {
+        return pdFAIL;
+    }
+    std::unique_lock<std::mutex> lock(queue->mutex);
+    if (!wait_for(lock, queue->readable, ticks_to_wait, [queue] { return !queue->items.empty(); })) {
+        return errQUEUE_EMPTY;
+    }
+    memcpy(item, queue->items.front().data(), queue->item_size);
+    queue->items.pop_front();
+    lock.unlock();
+    queue->writable.notify_one();
+    return pdPASS;
+}
+
+BaseType_t xQueuePeek(QueueHandle_t queue, void* item, TickType_t ticks_to_wait) {
+    if (!queue) {
+        return pdFAIL;
+    }
+    std::unique_lock<std::mutex> lock(queue->mutex);
+    if (!wait_for(lock, queue->readable, ticks_to_wait, [queue] { return !queue->items.empty(); })) {
+        return errQUEUE_EMPTY;
+    }
+    memcpy(item, queue->items.front().data(), queue->item_size);
+    return pdPASS;
+}
+
+UBaseType_t uxQueueMessagesWaiting(QueueHandle_t queue) {
+    if (!queue) {
+        return 0;
+    }
+    std::lock_guard<std::mutex> lock(queue->mutex);
+    return static_cast<UBaseType_t>(queue->items.size());
+}
+
+UBaseType_t uxQueueSpacesAvailable(QueueHandle_t queue) {
+    if (!queue) {
+        return 0;
+    }
+    std::lock_guard<std::mutex> lock(queue->mutex);
+    return static_cast<UBaseType_t>(queue->length - queue->items.size());
+}
+
+BaseType_t xQueueReset(QueueHandle_t queue) {
+    if (!queue) {
+        return pdFAIL;
+    }
+    {
+        std::lock_guard<std::mutex> lock(queue->mutex);
+        queue->items.clear();
+    }
+    queue->writable.notify_all();
+    return pdPASS;
+}
+
+SemaphoreHandle_t xSemaphoreCreateMutex() {
+    return new HostSemaphore();
+}
+
+void vSemaphoreDelete(SemaphoreHandle_t semaphore) {
+    delete semaphore;
+}
+
+BaseType_t xSemaphoreTake(SemaphoreHandle_t semaphore, TickType_t ticks_to_wait) {
+    if (!semaphore) {
+        return pdFAIL;
+    }
+    if (ticks_to_wait == portMAX_DELAY) {
+        semaphore->mutex.lock();
+        return pdPASS;
+    }
+    return semaphore->mutex.try_lock_for(std::chrono::milliseconds(ticks_to_wait)) ? pdPASS : pdFAIL;
+}
+
+BaseType_t xSemaphoreGive(SemaphoreHandle_t semaphore) {
+    if (!semaphore) {
+        return pdFAIL;
+    }
+    semaphore->mutex.unlock();
+    return pdPASS;
+}
+
+BaseType_t xTaskCreatePinnedToCore(
+    TaskFunction_t function,
+    const char* name,
+    uint32_t stack_depth,
+    void* parameter,
+    UBaseType_t priority,
+    TaskHandle_t* created_task,
+    BaseType_t core_id) {
+    (void)priority;
+    (void)core_id;
+    if (!function) {
+        return errCOULD_NOT_ALLOCATE_REQUIRED_MEMORY;
+    }
+    auto* task = new HostTask();
+    task->name = name ? name : "";
+    task->function = function;
+    task->parameter = parameter;
+    task->stack_depth = stack_depth;
+    if (created_task) {
+        *created_task = task;
+    }
+    {
+        std::lock_guard<std::mutex> lock(g_tasks_mutex);
+        g_tasks.push_back(task);
+    }
+    std::thread(task_entry, task).detach();
+    return pdPASS;
+}
+
+BaseType_t xTaskCreate(
+    TaskFunction_t function,
+    const char* name,
+    uint32_t stack_depth,
+    void* parameter,
+    UBaseType_t priority,
+    TaskHandle_t* created_task) {
+    return xTaskCreatePinnedToCore(
+        function, name, stack_depth, parameter, priority, created_task, tskNO_AFFINITY);
+}
+
+void vTaskDelete(TaskHandle_t task) {
+    (void)task;
+}
+
+void vTaskDelay(TickType_t ticks) {
+    delay(ticks);
+}
+
+TickType_t xTaskGetTickCount() {
+    return millis();
+}
+
+TaskHandle_t xTaskGetCurrentTaskHandle() {
+    if (!t_current_task) {
+        t_current_task = new HostTask();
+        t_current_task->name = "loopTask";
+    }
+    return t_current_task;
+}
+
+const char* pcTaskGetName(TaskHandle_t task) {
+    if (!task) {
+        task = xTaskGetCurrentTaskHandle();
+    }
+    return task->name.c_str();
+}
+
+UBaseType_t uxTaskGetStackHighWaterMark(TaskHandle_t task) {
+    if (!task) {
+        task = xTaskGetCurrentTaskHandle();
+    }
+    return task->stack_depth / 2;
+}
+
+uint32_t ulTaskNotifyTake(BaseType_t clear_count_on_exit, TickType_t ticks_to_wait) {
+    HostTask* task = xTaskGetCurrentTaskHandle();
+    const bool virtual_clock = host::clock_is_virtual();
+    const bool block = !virtual_clock || advance_virtual_wait(task, ticks_to_wait, has_notify_count);
+
+    std::unique_lock<std::mutex> lock(task->notify_mutex);
+    if (block) {
+        const bool indefinite = ticks_to_wait == portMAX_DELAY && !has_notify_count(task);
+        if (indefinite) {
+            task->idle = true;
+            task->idle_changed.notify_all();
+        }
+        wait_for(lock, task->notified, ticks_to_wait, [task] { return has_notify_count(task); });
+        task->idle = false;
+    }
+    const uint32_t count = task->notify_value;
+    if (count > 0) {
+        task->notify_value = clear_count_on_exit ? 0 : count - 1;
+    }
+    task->notify_pending = false;
+    return count;
+}
+
+BaseType_t xTaskNotifyWait(
+    uint32_t bits_to_clear_on_entry, uint32_t bits_to_clear_on_exit, uint32_t* notification_value, TickType_t ticks_to_wait) {
+    HostTask* task = xTaskGetCurrentTaskHandle();
+    {
+        std::lock_guard<std::mutex> lock(task->notify_mutex);
+        if (!task->notify_pending) {
+            task->notify_value &= ~bits_to_clear_on_entry;
+        }
+    }
+    const bool virtual_clock = host::clock_is_virtual();
+    const bool block = !virtual_clock || advance_virtual_wait(task, ticks_to_wait, has_notify_pending);
+
+    std::unique_lock<std::mutex> lock(task->notify_mutex);
+    if (block) {
+        wait_for(lock, task->notified, ticks_to_wait, [task] { return has_notify_pending(task); });
+    }
+    if (notification_value) {
+        *notification_value = task->notify_value;
+    }
+    if (!task->notify_pending) {
+        return pdFALSE;
+    }
+    task->notify_value &= ~bits_to_clear_on_exit;
+    task->notify_pending = false;
+    return pdTRUE;
+}
+
+BaseType_t xTaskNotify(TaskHandle_t task, uint32_t value, eNotifyAction action) {
+    return notify_task(task, value, action);
+}
+
+BaseType_t xTaskNotifyFromISR(
+    TaskHandle_t task, uint32_t value, eNotifyAction action, BaseType_t* higher_priority_woken) {
+    if (higher_priority_woken) {
+        *higher_priority_woken = pdFALSE;
+    }
+    return notify_task(task, value, action);
+}
+
+BaseType_t xTaskNotifyGive(TaskHandle_t task) {
+    return notify_task(task, 0, eIncrement);
+}
+
+void vTaskNotifyGiveFromISR(TaskHandle_t task, BaseType_t* higher_priority_woken) {
+    if (higher_priority_woken) {
+        *higher_priority_woken = pdFALSE;
+    }
+    notify_task(task, 0, eIncrement);
+}
+
+namespace host {
+
+void task_notify_at_us(HostTask* task, uint64_t at_us, uint32_t bits) {
+    if (!task) {
+        return;
+    }
+    std::lock_guard<std::mutex> lock(g_timed_notify_mutex);
+    TimedNotification notification;
+    notification.task = task;
+    notification.bits = bits;
+    g_timed_notifications.emplace(at_us, notification);
+}
+
+void task_clear_pending_notifications() {
+    std::lock_guard<std::mutex> lock(g_timed_notify_mutex);
+    g_timed_notifications.clear();
+}
+
+bool task_wait_idle(const char* name, uint32_t timeout_ms) {
+    HostTask* task = nullptr;
+    {
+        std::lock_guard<std::mutex> lock(g_tasks_mutex);
+        for (HostTask* candidate : g_tasks) {
+            if (candidate->name == name) {
+                task = candidate;
+            }
+        }
+    }
+    if (!task) {
+        return false;
+    }
+    std::unique_lock<std::mutex> lock(task->notify_mutex);
+    return task->idle_changed.wait_for(lock, std::chrono::milliseconds(timeout_ms), [task] {
+        return task->idle && !has_notify_count(task);
+    });
+}
+
+} // namespace host
@@ -0,0 +1,98 @@
+#pragma once
+
+// Controls for the host shims. Benchmarks and simulations use these to drive
+// the Arduino/FreeRTOS surface that the firmware code sees.
+
+#include <cstdint>
+#include <functional>
+#include <map>
+#include <string>
+
+struct HostTask;
+
+namespace host {
+
+// millis()/micros() follow a monotonic host clock by default. In virtual mode
+// they only move when advanced explicitly or when delay() is called.
+void clock_use_virtual(bool enabled, uint32_t start_ms = 0);
+bool clock_is_virtual();
+void clock_advance_ms(uint32_t ms);
+void clock_advance_us(uint64_t us);
+uint64_t clock_now_us();
+uint64_t real_now_ns();
+
+// With the virtual clock a blocked ulTaskNotifyTake()/xTaskNotifyWait()
+// advances time to its timeout instead of waiting. Notifications queued here
+// are delivered when virtual time reaches at_us, ending such a wait early
+// (e.g. a simulated IRQ). Non-zero bits are OR-ed into the notification value;
+// zero bits act like xTaskNotifyGive().
+void task_notify_at_us(HostTask* task, uint64_t at_us, uint32_t bits = 0);
+void task_clear_pending_notifications();
+
+// Waits (in real time) until the named task is blocked indefinitely in
+// ulTaskNotifyTake() with no notification pending, i.e. it has run out of
+// work. Simulations call it to let a worker finish before moving the clock.
+bool task_wait_idle(const char* name, uint32_t timeout_ms = 5000);
+
+// Serial output is written to stdout unless muted (e.g. inside timed loops).
+void serial_set_enabled(bool enabled);
+
+void wifi_set_connected(bool connected);
+bool wifi_connected();
+
+// SD card paths such as /ptc/config.json are mapped below this directory.
+void sd_set_root(const std::string& path);
+const std::string& sd_root();
+void sd_wipe();
+
+// SD files opened for rewriting (FILE_WRITE, as the atomic text writes do)
+// or appending, bytes written, and NVS entries changed or removed, since
+// start-up.
+struct StorageWriteStats {
+    uint32_t sd_rewrites = 0;
+    uint32_t sd_appends = 0;
+    uint64_t sd_bytes_written = 0;
+    uint32_t nvs_writes = 0;
+};
+StorageWriteStats storage_write_stats();
+
+struct HttpRequest {
+    std::string method;
+    std::string url;
+    std::string path_and_query;
+    std::map<std::string, std::string> headers;
+    std::string body;
+};
+
+struct HttpResponse {
+    int status_code = 200;
+    std::map<std::string, std::string> headers;
+    std::string body;
+};
+
+// In-process stand-in for the remote end of HTTPClient. Requests issued while
+// no handler is installed fail with HTTPC_ERROR_CONNECTION_REFUSED.
+using HttpHandler = std::function<HttpResponse(const HttpRequest&)>;
+void http_set_handler(HttpHandler handler);
+
+// Sends HTTPClient requests as plain HTTP/1.1 over a real TCP connection to
+// address:port instead of the handler; the URL only supplies the Host header
+// and path (TLS is not emulated). Port 0 switches back to the handler.
+// Connections stay open across requests unless either side closes them.
+void http_use_socket(const std::string& address, uint16_t port);
+
+// Time WiFi.hostByName() and WiFiClient::connect() take before they answer,
+// standing in for a slow resolver and a slow TLS handshake (delay(), so
+// virtual time under the virtual clock). A failing lookup answers 0.
+void net_set_latency(uint32_t dns_ms, uint32_t connect_ms);
+void net_set_dns_failing(bool failing);
+
+struct HttpSocketStats {
+    uint32_t connects = 0;
+    uint32_t requests = 0;
+    uint64_t bytes_sent = 0;
+    uint64_t bytes_received = 0;
+};
+HttpSocketStats http_socket_stats();
+
+} // namespace host
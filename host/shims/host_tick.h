@@ -0,0 +1,15 @@
+#pragma once
+
+// C-callable millis() for LVGL's custom tick on the host (see lv_conf.h).
+
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+uint32_t host_tick_ms(void);
+
+#ifdef __cplusplus
+}
+#endif
@@ -0,0 +1,37 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+
+#include "sha256.h"
+
+#define MBEDTLS_ERR_MD_BAD_INPUT_DATA -0x5100
+
+typedef enum {
+    MBEDTLS_MD_NONE = 0,
+    MBEDTLS_MD_SHA256 = 6,
+} mbedtls_md_type_t;
+
+typedef struct mbedtls_md_info_t {
+    mbedtls_md_type_t type;
+    unsigned char size;
+    unsigned char block_size;
+} mbedtls_md_info_t;
+
+// Only HMAC-SHA256 is needed by the firmware; the context is a concrete
+// SHA-256 state plus the precomputed outer pad.
+typedef struct mbedtls_md_context_t {
+    const mbedtls_md_info_t* md_info;
+    mbedtls_sha256_context inner;
+    unsigned char opad[64];
+    int hmac;
+} mbedtls_md_context_t;
+
+const mbedtls_md_info_t* mbedtls_md_info_from_type(mbedtls_md_type_t md_type);
+void mbedtls_md_init(mbedtls_md_context_t* ctx);
+void mbedtls_md_free(mbedtls_md_context_t* ctx);
+int mbedtls_md_setup(mbedtls_md_context_t* ctx, const mbedtls_md_info_t* md_info, int hmac);
+int mbedtls_md_hmac_starts(mbedtls_md_context_t* ctx, const unsigned char* key, size_t keylen);
+int mbedtls_md_hmac_update(mbedtls_md_context_t* ctx, const unsigned char* input, size_t ilen);
+int mbedtls_md_hmac_finish(mbedtls_md_context_t* ctx, unsigned char* output);
+int mbedtls_md_hmac_reset(mbedtls_md_context_t* ctx);
@@ -0,0 +1,335 @@
+#include "mbedtls/base64.h"
+#include "mbedtls/md.h"
+#include "mbedtls/sha256.h"
+
+#include <cstring>
+
+// Portable SHA-256, HMAC and base64 with the mbedtls 2.x signatures used by
+// ESP-IDF 4.4. The device build links the real (hardware-assisted) library.
+
+namespace {
+
+constexpr uint32_t kRoundConstants[64] = {
+    0x428a2f98, 0x71374491, 0xb5c0fbcf, 0xe9b5dba5, 0x3956c25b, 0x59f111f1, 0x923f82a4, 0xab1c5ed5,
+    0xd807aa98, 0x12835b01, 0x243185be, 0x550c7dc3, 0x72be5d74, 0x80deb1fe, 0x9bdc06a7, 0xc19bf174,
+    0xe49b69c1, 0xefbe4786, 0x0fc19dc6, 0x240ca1cc, 0x2de92c6f, 0x4a7484aa, 0x5cb0a9dc, 0x76f988da,
+    0x983e5152, 0xa831c66d, 0xb00327c8, 0xbf597fc7, 0xc6e00bf3, 0xd5a79147, 0x06ca6351, 0x14292967,
+    0x27b70a85, 0x2e1b2138, 0x4d2c6dfc, 0x53380d13, 0x650a7354, 0x766a0abb, 0x81c2c92e, 0x92722c85,
+    0xa2bfe8a1, 0xa81a664b, 0xc24b8b70, 0xc76c51a3, 0xd192e819, 0xd6990624, 0xf40e3585, 0x106aa070,
+    0x19a4c116, 0x1e376c08, 0x2748774c, 0x34b0bcb5, 0x391c0cb3, 0x4ed8aa4a, 0x5b9cca4f, 0x682e6ff3,
+    0x748f82ee, 0x78a5636f, 0x84c87814, 0x8cc70208, 0x90befffa, 0xa4506ceb, 0xbef9a3f7, 0xc67178f2,
+};
+
+constexpr mbedtls_md_info_t kSha256Info = {MBEDTLS_MD_SHA256, 32, 64};
+
+constexpr char kBase64Alphabet[] =
+    "ABCDEFGHIJKLMNOPQRSTUVWXYZabcdefghijklmnopqrstuvwxyz0123456789+/";
+
+inline uint32_t rotr(uint32_t value, unsigned bits) {
+    return (value >> bits) | (value << (32 - bits));
+}
+
+void sha256_process(mbedtls_sha256_context* ctx, const unsigned char block[64]) {
+    uint32_t w[64];
+    for (int i = 0; i < 16; ++i) {
+        w[i] = (static_cast<uint32_t>(block[i * 4]) << 24) |
+            (static_cast<uint32_t>(block[i * 4 + 1]) << 16) |
+            (static_cast<uint32_t>(block[i * 4 + 2]) << 8) |
+            static_cast<uint32_t>(block[i * 4 + 3]);
+    }
+    for (int i = 16; i < 64; ++i) {
+        const uint32_t s0 = rotr(w[i - 15], 7) ^ rotr(w[i - 15], 18) ^ (w[i - 15] >> 3);
+        const uint32_t s1 = rotr(w[i - 2], 17) ^ rotr(w[i - 2], 19) ^ (w[i - 2] >> 10);
+        w[i] = w[i - 16] + s0 + w[i - 7] + s1;
+    }
+
+    uint32_t a = ctx->state[0];
+    uint32_t b = ctx->state[1];
+    uint32_t c = ctx->state[2];
+    uint32_t d = ctx->state[3];
+    uint32_t e = ctx->state[4];
+    uint32_t f = ctx->state[5];
+    uint32_t g = ctx->state[6];
+    uint32_t h = ctx->state[7];
+    for (int i = 0; i < 64; ++i) {
+        const uint32_t s1 = rotr(e, 6) ^ rotr(e, 11) ^ rotr(e, 25);
+        const uint32_t choose = (e & f) ^ (~e & g);
+        const uint32_t temp1 = h + s1 + choose + kRoundConstants[i] + w[i];
+        const uint32_t s0 = rotr(a, 2) ^ rotr(a, 13) ^ rotr(a, 22);
+        const uint32_t majority = (a & b) ^ (a & c) ^ (b & c);
+        const uint32_t temp2 = s0 + majority;
+        h = g;
+        g = f;
+        f = e;
+        e = d + temp1;
+        d = c;
+        c = b;
+        b = a;
+        a = temp1 + temp2;
+    }
+    ctx->state[0] += a;
+    ctx->state[1] += b;
+    ctx->state[2] += c;
+    ctx->state[3] += d;
+    ctx->state[4] += e;
+    ctx->state[5] += f;
+    ctx->state[6] += g;
+    ctx->state[7] += h;
+}
+
+int base64_value(unsigned char c) {
+    if (c >= 'A' && c <= 'Z') return c - 'A';
+    if (c >= 'a' && c <= 'z') return c - 'a' + 26;
+    if (c >= '0' && c <= '9') return c - '0' + 52;
+    if (c == '+') return 62;
+    if (c == '/') return 63;
+    return -1;
+}
+
+} // namespace
+
+void mbedtls_sha256_init(mbedtls_sha256_context* ctx) {
+    memset(ctx, 0, sizeof(*ctx));
+}
+
+void mbedtls_sha256_free(mbedtls_sha256_context* ctx) {
+    if (ctx) {
+        memset(ctx, 0, sizeof(*ctx));
+    }
+}
+
+void mbedtls_sha256_clone(mbedtls_sha256_context* dst, const mbedtls_sha256_context* src) {
+    *dst = *src;
+}
+
+int mbedtls_sha256_starts_ret(mbedtls_sha256_context* ctx, int is224) {
+    static constexpr uint32_t kInitialState[8] = {
+        0x6a09e667, 0xbb67ae85, 0x3c6ef372, 0xa54ff53a,
+        0x510e527f, 0x9b05688c, 0x1f83d9ab, 0x5be0cd19,
+    };
+    if (is224) {
+        return MBEDTLS_ERR_MD_BAD_INPUT_DATA;
+    }
+    ctx->total[0] = 0;
+    ctx->total[1] = 0;
+    memcpy(ctx->state, kInitialState, sizeof(kInitialState));
+    ctx->is224 = 0;
+    return 0;
+}
+
+int mbedtls_sha256_update_ret(mbedtls_sha256_context* ctx, const unsigned char* input, size_t ilen) {
+    if (ilen == 0) {
+        return 0;
+    }
+    size_t left = ctx->total[0] & 0x3F;
+    const size_t fill = 64 - left;
+    ctx->total[0] += static_cast<uint32_t>(ilen);
+    if (ctx->total[0] < static_cast<uint32_t>(ilen)) {
+        ctx->total[1]++;
+    }
+    if (left && ilen >= fill) {
+        memcpy(ctx->buffer + left, input, fill);
+        sha256_process(ctx, ctx->buffer);
+        input += fill;
+        ilen -= fill;
+        left = 0;
+    }
+    while (ilen >= 64) {
+        sha256_process(ctx, input);
+        input += 64;
+        ilen -= 64;
+    }
+    if (ilen > 0) {
+        memcpy(ctx->buffer + left, input, ilen);
+    }
+    return 0;
+}
+
+int mbedtls_sha256_finish_ret(mbedtls_sha256_context* ctx, unsigned char output[32]) {
+    const uint32_t high = (ctx->total[0] >> 29) | (ctx->total[1] << 3);
+    const uint32_t low = ctx->total[0] << 3;
+    unsigned char length_bytes[8];
+    for (int i = 0; i < 4; ++i) {
+        length_bytes[i] = static_cast<unsigned char>(high >> (24 - i * 8));
+        length_bytes[i + 4] = static_cast<unsigned char>(low >> (24 - i * 8));
+    }
+
+    static constexpr unsigned char kPadding[64] = {0x80};
+    const size_t used = ctx->total[0] & 0x3F;
+    const size_t pad_length = used < 56 ? 56 - used : 120 - used;
+    mbedtls_sha256_update_ret(ctx, kPadding, pad_length);
+    mbedtls_sha256_update_ret(ctx, length_bytes, sizeof(length_bytes));
+
+    for (int i = 0; i < 8; ++i) {
+        output[i * 4] = static_cast<unsigned char>(ctx->state[i] >> 24);
+        output[i * 4 + 1] = static_cast<unsigned char>(ctx->state[i] >> 16);
+        output[i * 4 + 2] = static_cast<unsigned char>(ctx->state[i] >> 8);
+        output[i * 4 + 3] = static_cast<unsigned char>(ctx->state[i]);
+    }
+    return 0;
+}
+
+int mbedtls_sha256_ret(const unsigned char* input, size_t ilen, unsigned char output[32], int is224) {
+    mbedtls_sha256_context ctx;
+    mbedtls_sha256_init(&ctx);
+    int result = mbedtls_sha256_starts_ret(&ctx, is224);
+    if (result == 0) {
+        result = mbedtls_sha256_update_ret(&ctx, input, ilen);
+    }
+    if (result == 0) {
+        result = mbedtls_sha256_finish_ret(&ctx, output);
+    }
+    mbedtls_sha256_free(&ctx);
+    return result;
+}
+
+const mbedtls_md_info_t* mbedtls_md_info_from_type(mbedtls_md_type_t md_type) {
+    return md_type == MBEDTLS_MD_SHA256 ? &kSha256Info : nullptr;
+}
+
+void mbedtls_md_init(mbedtls_md_context_t* ctx) {
+    memset(ctx, 0, sizeof(*ctx));
+}
+
+void mbedtls_md_free(mbedtls_md_context_t* ctx) {
+    if (ctx) {
+        memset(ctx, 0, sizeof(*ctx));
+    }
+}
+
+int mbedtls_md_setup(mbedtls_md_context_t* ctx, const mbedtls_md_info_t* md_info, int hmac) {
+    if (!ctx || !md_info) {
+        return MBEDTLS_ERR_MD_BAD_INPUT_DATA;
+    }
+    ctx->md_info = md_info;
+    ctx->hmac = hmac;
+    return 0;
+}
+
+int mbedtls_md_hmac_starts(mbedtls_md_context_t* ctx, const unsigned char* key, size_t keylen) {
+    if (!ctx || !ctx->md_info || !ctx->hmac) {
+        return MBEDTLS_ERR_MD_BAD_INPUT_DATA;
+    }
+    unsigned char hashed_key[32];
+    if (keylen > 64) {
+        mbedtls_sha256_ret(key, keylen, hashed_key, 0);
+        key = hashed_key;
+        keylen = sizeof(hashed_key);
+    }
+    unsigned char ipad[64];
+    memset(ipad, 0x36, sizeof(ipad));
+    memset(ctx->opad, 0x5C, sizeof(ctx->opad));
+    for (size_t i = 0; i < keylen; ++i) {
+        ipad[i] ^= key[i];
+        ctx->opad[i] ^= key[i];
+    }
+    mbedtls_sha256_starts_ret(&ctx->inner, 0);
+    return mbedtls_sha256_update_ret(&ctx->inner, ipad, sizeof(ipad));
+}
+
+int mbedtls_md_hmac_update(mbedtls_md_context_t* ctx, const unsigned char* input, size_t ilen) {
+    if (!ctx || !ctx->md_info) {
+        return MBEDTLS_ERR_MD_BAD_INPUT_DATA;
+    }
+    return mbedtls_sha256_update_ret(&ctx->inner, input, ilen);
+}
+
+int mbedtls_md_hmac_finish(mbedtls_md_context_t* ctx, unsigned char* output) {
+    if (!ctx || !ctx->md_info) {
+        return MBEDTLS_ERR_MD_BAD_INPUT_DATA;
+    }
+    unsigned char inner_digest[32];
+    mbedtls_sha256_finish_ret(&ctx->inner, inner_digest);
+    mbedtls_sha256_context outer;
+    mbedtls_sha256_init(&outer);
+    mbedtls_sha256_starts_ret(&outer, 0);
+    mbedtls_sha256_update_ret(&outer, ctx->opad, sizeof(ctx->opad));
+    mbedtls_sha256_update_ret(&outer, inner_digest, sizeof(inner_digest));
+    mbedtls_sha256_finish_ret(&outer, output);
+    return 0;
+}
+
+int mbedtls_md_hmac_reset(mbedtls_md_context_t* ctx) {
+    if (!ctx || !ctx->md_info) {
+        return MBEDTLS_ERR_MD_BAD_INPUT_DATA;
+    }
+    unsigned char ipad[64];
+    for (size_t i = 0; i < sizeof(ipad); ++i) {
+        ipad[i] = static_cast<unsigned char>(ctx->opad[i] ^ 0x5C ^ 0x36);
+    }
+    mbedtls_sha256_starts_ret(&ctx->inner, 0);
+    return mbedtls_sha256_update_ret(&ctx->inner, ipad, sizeof(ipad));
+}
+
+int mbedtls_base64_encode(unsigned char* dst, size_t dlen, size_t* olen,
+    const unsigned char* src, size_t slen) {
+    const size_t needed = ((slen + 2) / 3) * 4;
+    if (slen == 0) {
+        *olen = 0;
+        return 0;
+    }
+    if (dlen < needed + 1) {
+        *olen = needed + 1;
+        return MBEDTLS_ERR_BASE64_BUFFER_TOO_SMALL;
+    }
+    size_t out = 0;
+    size_t i = 0;
+    for (; i + 2 < slen; i += 3) {
+        const uint32_t chunk = (static_cast<uint32_t>(src[i]) << 16) |
+            (static_cast<uint32_t>(src[i + 1]) << 8) | src[i + 2];
+        dst[out++] = kBase64Alphabet[(chunk >> 18) & 0x3F];
+        dst[out++] = kBase64Alphabet[(chunk >> 12) & 0x3F];
+        dst[out++] = kBase64Alphabet[(chunk >> 6) & 0x3F];
+        dst[out++] = kBase64Alphabet[chunk & 0x3F];
+    }
+    if (i < slen) {
+        uint32_t chunk = static_cast<uint32_t>(src[i]) << 16;
+        if (i + 1 < slen) {
+            chunk |= static_cast<uint32_t>(src[i + 1]) << 8;
+        }
+        dst[out++] = kBase64Alphabet[(chunk >> 18) & 0x3F];
+        dst[out++] = kBase64Alphabet[(chunk >> 12) & 0x3F];
+        dst[out++] = i + 1 < slen ? kBase64Alphabet[(chunk >> 6) & 0x3F] : '=';
+        dst[out++] = '=';
+    }
+    dst[out] = 0;
+    *olen = out;
+    return 0;
+}
+
+int mbedtls_base64_decode(unsigned char* dst, size_t dlen, size_t* olen,
+    const unsigned char* src, size_t slen) {
+    size_t symbols = 0;
+    size_t padding = 0;
+    for (size_t i = 0; i < slen; ++i) {
+        if (src[i] == '=') {
+            ++padding;
+            continue;
+        }
+        if (padding > 0 || base64_value(src[i]) < 0) {
+            return MBEDTLS_ERR_BASE64_INVALID_CHARACTER;
+        }
+        ++symbols;
+    }
+    if ((symbols + padding) % 4 != 0 || padding > 2) {
+        return MBEDTLS_ERR_BASE64_INVALID_CHARACTER;
+    }
+    const size_t needed = (symbols * 6) / 8;
+    if (!dst || dlen < needed) {
+        *olen = needed;
+        return MBEDTLS_ERR_BASE64_BUFFER_TOO_SMALL;
+    }
+    uint32_t accumulator = 0;
+    int bits = 0;
+    size_t out = 0;
+    for (size_t i = 0; i < symbols; ++i) {
+        accumulator = (accumulator << 6) | static_cast<uint32_t>(base64_value(src[i]));
+        bits += 6;
+        if (bits >= 8) {
+            bits -= 8;
+            dst[out++] = static_cast<unsigned char>(accumulator >> bits);
+        }
+    }
+    *olen = out;
+    return 0;
+}
@@ -0,0 +1,464 @@
+#include <Preferences.h>
+#include <SD.h>
+
+#include <cstdio>
+#include <cstring>
+#include <filesystem>
+#include <map>
+#include <mutex>
+#include <string>
+#include <system_error>
+
+#include "host_runtime.h"
+
+namespace stdfs = std::filesystem;
+
+namespace fs {
+
+struct FileHandle {
+    FILE* stream = nullptr;
+    std::string path;
+    std::string name;
+    bool directory = false;
+
+    ~FileHandle() {
+        if (stream) {
+            fclose(stream);
+        }
+    }
+};
+
+} // namespace fs
+
+namespace {
+
+std::mutex g_sd_mutex;
+std::string g_sd_root = "/tmp/ptc-host-sd";
+
+std::mutex g_prefs_mutex;
+std::map<std::string, std::map<std::string, std::string>> g_prefs_store;
+
+std::mutex g_write_stats_mutex;
+host::StorageWriteStats g_write_stats;
+
+std::string host_path(const char* path) {
+    std::lock_guard<std::mutex> lock(g_sd_mutex);
+    std::string mapped = g_sd_root;
+    if (path && path[0] != '/') {
+        mapped += '/';
+    }
+    mapped += path ? path : "";
+    return mapped;
+}
+
+} // namespace
+
+namespace host {
+
+void sd_set_root(const std::string& path) {
+    std::lock_guard<std::mutex> lock(g_sd_mutex);
+    g_sd_root = path;
+}
+
+const std::string& sd_root() {
+    std::lock_guard<std::mutex> lock(g_sd_mutex);
+    return g_sd_root;
+}
+
+StorageWriteStats storage_write_stats() {
+    std::lock_guard<std::mutex> lock(g_write_stats_mutex);
+    return g_write_stats;
+}
+
+void sd_wipe() {
+    const std::string root = sd_root();
+    std::error_code error;
+    stdfs::remove_all(root, error);
+    stdfs::create_directories(root, error);
+}
+
+} // namespace host
+
+// File ------------------------------------------------------------------------
+
+namespace fs {
+
+File::File(std::shared_ptr<FileHandle> handle) : handle_(std::move(handle)) {}
+
+size_t File::write(uint8_t value) {
+    return write(&value, 1);
+}
+
+size_t File::write(const uint8_t* buffer, size_t size) {
+    if (!handle_ || !handle_->stream) {
+        return 0;
+    }
+    const size_t written = fwrite(buffer, 1, size, handle_->stream);
+    std::lock_guard<std::mutex> lock(g_write_stats_mutex);
+    g_write_stats.sd_bytes_written += written;
+    return written;
+}
+
+int File::available() {
+    if (!handle_ || !handle_->stream) {
+        return 0;
+    }
+    const size_t total = size();
+    const size_t offset = position();
+    return offset < total ? static_cast<int>(total - offset) : 0;
+}
+
+int File::read() {
+    if (!handle_ || !handle_->stream) {
+        return -1;
+    }
+    const int c = fgetc(handle_->stream);
+    return c == EOF ? -1 : c;
+}
+
+int File::peek() {
+    if (!handle_ || !handle_->stream) {
+        return -1;
+    }
+    const int c = fgetc(handle_->stream);
+    if (c == EOF) {
+        return -1;
+    }
+    ungetc(c, handle_->stream);
+    return c;
+}
+
+void File::flush() {
+    if (handle_ && handle_->stream) {
+        fflush(handle_->stream);
+    }
+}
+
+size_t File::read(uint8_t* buffer, size_t size) {
+    if (!handle_ || !handle_->stream) {
+        return 0;
+    }
+    return fread(buffer, 1, size, handle_->stream);
+}
+
+bool File::seek(uint32_t position, SeekMode mode) {
+    if (!handle_ || !handle_->stream) {
+        return false;
+    }
+    const int whence = mode == SeekCur ? SEEK_CUR : (mode == SeekEnd ? SEEK_END : SEEK_SET);
+    return fseek(handle_->stream, static_cast<long>(position), whence) == 0;
+}
+
+size_t File::position() const {
+    if (!handle_ || !handle_->stream) {
+        return 0;
+    }
+    const long offset = ftell(handle_->stream);
+    return offset < 0 ? 0 : static_cast<size_t>(offset);
+}
+
+size_t File::size() const {
+    if (!handle_ || handle_->directory) {
+        return 0;
+    }
+    if (handle_->stream) {
+        fflush(handle_->stream);
+    }
+    std::error_code error;
+    const auto bytes = stdfs::file_size(handle_->path, error);
+    return error ? 0 : static_cast<size_t>(bytes);
+}
+
+void File::close() {
+    handle_.reset();
+}
+
+bool File::isDirectory() const {
+    return handle_ && handle_->directory;
+}
+
+const char* File::path() const {
+    return handle_ ? handle_->name.c_str() : nullptr;
+}
+
+const char* File::name() const {
+    if (!handle_) {
+        return nullptr;
+    }
+    const size_t slash = handle_->name.rfind('/');
+    return handle_->name.c_str() + (slash == std::string::npos ? 0 : slash + 1);
+}
+
+File::operator bool() const {
+    return handle_ != nullptr;
+}
+
+// SD --------------------------------------------------------------------------
+
+bool SDFS::begin(uint8_t ss_pin, SPIClass& spi, uint32_t frequency, const char* mountpoint,
+    uint8_t max_files, bool format_if_empty) {
+    (void)ss_pin;
+    (void)spi;
+    (void)frequency;
+    (void)mountpoint;
+    (void)max_files;
+    (void)format_if_empty;
+    std::error_code error;
+    stdfs::create_directories(host::sd_root(), error);
+    mounted_ = !error;
+    return mounted_;
+}
+
+void SDFS::end() {
+    mounted_ = false;
+}
+
+sdcard_type_t SDFS::cardType() {
+    return mounted_ ? CARD_SDHC : CARD_NONE;
+}
+
+uint64_t SDFS::cardSize() {
+    return mounted_ ? 8ULL * 1024ULL * 1024ULL * 1024ULL : 0;
+}
+
+uint64_t SDFS::totalBytes() {
+    return cardSize();
+}
+
+uint64_t SDFS::usedBytes() {
+    if (!mounted_) {
+        return 0;
+    }
+    uint64_t used = 0;
+    std::error_code error;
+    for (const auto& entry : stdfs::recursive_directory_iterator(host::sd_root(), error)) {
+        if (entry.is_regular_file(error)) {
+            used += entry.file_size(error);
+        }
+    }
+    return used;
+}
+
+File SDFS::open(const char* path, const char* mode, bool create) {
+    (void)create;
+    if (!mounted_ || !path) {
+        return File();
+    }
+    const std::string mapped = host_path(path);
+    auto handle = std::make_shared<FileHandle>();
+    handle->path = mapped;
+    handle->name = path;
+
+    std::error_code error;
+    if (stdfs::is_directory(mapped, error)) {
+        handle->directory = true;
+        return File(handle);
+    }
+    // FILE_WRITE on the device truncates and opens read/write.
+    const char* stdio_mode = "rb";
+    if (strcmp(mode, FILE_WRITE) == 0) {
+        stdio_mode = "w+b";
+    } else if (strcmp(mode, FILE_APPEND) == 0) {
+        stdio_mode = "a+b";
+    }
+    handle->stream = fopen(mapped.c_str(), stdio_mode);
+    if (!handle->stream) {
+        return File();
+    }
+    if (strcmp(stdio_mode, "rb") != 0) {
+        std::lock_guard<std::mutex> lock(g_write_stats_mutex);
+        if (strcmp(mode, FILE_WRITE) == 0) {
+            g_write_stats.sd_rewrites++;
+        } else {
+            g_write_stats.sd_appends++;
+        }
+    }
+    return File(handle);
+}
+
+bool SDFS::exists(const char* path) {
+    std::error_code error;
+    return mounted_ && path && stdfs::exists(host_path(path), error);
+}
+
+bool SDFS::remove(const char* path) {
+    if (!mounted_ || !path) {
+        return false;
+    }
+    const std::string mapped = host_path(path);
+    std::error_code error;
+    if (!stdfs::is_regular_file(mapped, error)) {
+        return false;
+    }
+    return ::remove(mapped.c_str()) == 0;
+}
+
+bool SDFS::rename(const char* from, const char* to) {
+    if (!mounted_ || !from || !to) {
+        return false;
+    }
+    const std::string target = host_path(to);
+    std::error_code error;
+    // FAT refuses to rename over an existing file; keep that behaviour.
+    if (stdfs::exists(target, error)) {
+        return false;
+    }
+    return ::rename(host_path(from).c_str(), target.c_str()) == 0;
+}
+
+bool SDFS::mkdir(const char* path) {
+    if (!mounted_ || !path) {
+        return false;
+    }
+    std::error_code error;
+    stdfs::create_directories(host_path(path), error);
+    return !error;
+}
+
+bool SDFS::rmdir(const char* path) {
+    if (!mounted_ || !path) {
+        return false;
+    }
+    std::error_code error;
+    return stdfs::remove(host_path(path), error) && !error;
+}
+
+} // namespace fs
+
+fs::SDFS SD;
+SPIClass SPI;
+
+// Preferences -----------------------------------------------------------------
+
+bool Preferences::begin(const char* name, bool read_only, const char* partition_label) {
+    (void)partition_label;
+    if (started_ || !name) {
+        return false;
+    }
+    namespace_ = name;
+    read_only_ = read_only;
+    started_ = true;
+    return true;
+}
+
+void Preferences::end() {
+    started_ = false;
+}
+
+bool Preferences::clear() {
+    if (!started_ || read_only_) {
+        return false;
+    }
+    std::lock_guard<std::mutex> lock(g_prefs_mutex);
+    g_prefs_store[namespace_.c_str()].clear();
+    return true;
+}
+
+bool Preferences::remove(const char* key) {
+    if (!started_ || read_only_ || !key) {
+        return false;
+    }
+    std::lock_guard<std::mutex> lock(g_prefs_mutex);
+    const bool erased = g_prefs_store[namespace_.c_str()].erase(key) > 0;
+    if (erased) {
+        std::lock_guard<std::mutex> stats_lock(g_write_stats_mutex);
+        g_write_stats.nvs_writes++;
+    }
+    return erased;
+}
+
+bool Preferences::isKey(const char* key) {
+    if (!started_ || !key) {
+        return false;
+    }
+    std::lock_guard<std::mutex> lock(g_prefs_mutex);
+    const auto& values = g_prefs_store[namespace_.c_str()];
+    return values.find(key) != values.end();
+}
+
+size_t Preferences::put_bytes(const char* key, const void* value, size_t length) {
+    if (!started_ || read_only_ || !key) {
+        return 0;
+    }
+    std::lock_guard<std::mutex> lock(g_prefs_mutex);
+    std::string& stored = g_prefs_store[namespace_.c_str()][key];
+    // NVS skips a write when the entry already holds the same bytes.
+    if (stored.size() != length || memcmp(stored.data(), value, length) != 0) {
+        stored.assign(static_cast<const char*>(value), length);
+        std::lock_guard<std::mutex> stats_lock(g_write_stats_mutex);
+        g_write_stats.nvs_writes++;
+    }
+    return length;
+}
+
+bool Preferences::get_bytes(const char* key, void* value, size_t length) {
+    if (!started_ || !key) {
+        return false;
+    }
+    std::lock_guard<std::mutex> lock(g_prefs_mutex);
+    const auto& values = g_prefs_store[namespace_.c_str()];
+    const auto found = values.find(key);
+    if (found == values.end() || found->second.size() != length) {
+        return false;
+    }
+    memcpy(value, found->second.data(), length);
+    return true;
+}
+
+size_t Preferences::putBool(const char* key, bool value) {
+    const uint8_t stored = value ? 1 : 0;
+    return put_bytes(key, &stored, sizeof(stored));
+}
+
+size_t Preferences::putUShort(const char* key, uint16_t value) {
+    return put_bytes(key, &value, sizeof(value));
+}
+
+size_t Preferences::putUInt(const char* key, uint32_t value) {
+    return put_bytes(key, &value, sizeof(value));
+}
+
+size_t Preferences::putFloat(const char* key, float value) {
+    return put_bytes(key, &value, sizeof(value));
+}
+
+size_t Preferences::putString(const char* key, const char* value) {
+    return value ? put_bytes(key, value, strlen(value)) : 0;
+}
+
+size_t Preferences::putString(const char* key, const String& value) {
+    return put_bytes(key, value.c_str(), value.length());
+}
+
+bool Preferences::getBool(const char* key, bool default_value) {
+    uint8_t stored = 0;
+    return get_bytes(key, &stored, sizeof(stored)) ? stored != 0 : default_value;
+}
+
+uint16_t Preferences::getUShort(const char* key, uint16_t default_value) {
+    uint16_t value = 0;
+    return get_bytes(key, &value, sizeof(value)) ? value : default_value;
+}
+
+uint32_t Preferences::getUInt(const char* key, uint32_t default_value) {
+    uint32_t value = 0;
+    return get_bytes(key, &value, sizeof(value)) ? value : default_value;
+}
+
+float Preferences::getFloat(const char* key, float default_value) {
+    float value = 0.0f;
+    return get_bytes(key, &value, sizeof(value)) ? value : default_value;
+}
+
+String Preferences::getString(const char* key, const String& default_value) {
+    if (!started_ || !key) {
+        return default_value;
+    }
+    std::lock_guard<std::mutex> lock(g_prefs_mutex);
+    const auto& values = g_prefs_store[namespace_.c_str()];
+    const auto found = values.find(key);
+    if (found == values.end()) {
+        return default_value;
+    }
+    return String(found->second.data(), static_cast<unsigned int>(found->second.size()));
+}
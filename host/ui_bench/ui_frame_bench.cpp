@@ -0,0 +1,649 @@
+// Headless frame benchmark: renders the real ui_root screens into a memory
+// framebuffer on a virtual clock and reports, per scripted scenario, how long
+// each frame takes to render, how much of the screen was invalidated and how
+// many flushes it took, plus which LVGL timers caused the invalidation.
+//
+//   pio run -e native_ui && .pio/build/native_ui/program [scenario]
+
+#include <cxxabi.h>
+#include <dlfcn.h>
+#include <lvgl.h>
+
+#include <algorithm>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <functional>
+#include <map>
+#include <string>
+#include <vector>
+
+#include "host_runtime.h"
+#include "ui_stubs.h"
+#include "src/drivers/display_rotation.h"
+#include "src/services/service_qr.h"
+#include "src/ui/ui_qr_raster.h"
+#include "src/ui/ui_root.h"
+#include "src/ui/ui_theme.h"
+
+ptc::DeviceConfig g_config;
+ptc::AppState g_state;
+
+extern "C" lv_timer_t* __real_lv_timer_create(lv_timer_cb_t timer_xcb, uint32_t period, void* user_data);
+extern "C" lv_timer_t* __wrap_lv_timer_create(lv_timer_cb_t timer_xcb, uint32_t period, void* user_data);
+
+namespace {
+
+// Same panel, rotation and draw buffers as display_driver_init/main.cpp.
+constexpr int kHorRes = 800;
+constexpr int kVerRes = 480;
+constexpr int kDrawBufferLines = 24;
+constexpr uint32_t kScreenPixels = kHorRes * kVerRes;
+constexpr uint32_t kDisplayRefreshIntervalMs = 30;
+constexpr uint32_t kSettleMs = 4000;
+
+enum Tab : uint16_t {
+    kTabQr = 0,
+    kTabNotices = 1,
+    kTabLog = 2,
+    kTabSettings = 3,
+};
+
+uint16_t g_framebuffer[kHorRes * kVerRes];
+lv_disp_t* g_display = nullptr;
+lv_obj_t* g_tabview = nullptr;
+uint32_t g_frame_flushes = 0;
+uint32_t g_frame_flushed_px = 0;
+uint32_t g_last_refresh_ms = 0;
+uint32_t g_run_start_ms = 0;
+
+struct TimerRecord {
+    std::string label;
+    lv_timer_cb_t callback = nullptr;
+};
+
+struct TimerStats {
+    uint32_t period_ms = 0;
+    uint32_t runs = 0;
+    uint32_t invalidating_runs = 0;
+    uint32_t full_screen_runs = 0;
+    uint64_t invalidated_px = 0;
+    uint64_t callback_ns = 0;
+};
+
+struct FrameStats {
+    // Since the start of the scenario.
+    uint32_t at_ms = 0;
+    uint64_t render_ns = 0;
+    uint32_t invalidated_px = 0;
+    uint32_t flushes = 0;
+    uint32_t flushed_px = 0;
+};
+
+std::map<lv_timer_t*, TimerRecord> g_timers;
+std::map<std::string, uint32_t> g_label_uses;
+std::map<std::string, TimerStats> g_timer_stats;
+std::vector<FrameStats> g_frames;
+bool g_recording = false;
+
+// Turns each area into the framebuffer as the device's flush task does.
+void bench_flush_cb(lv_disp_drv_t* disp, const lv_area_t* area, lv_color_t* color_p) {
+    const ptc::RotatedCopy copy =
+        ptc::display_rotated_copy(static_cast<lv_disp_rot_t>(disp->rotated), *area, kHorRes, kVerRes);
+    const int32_t w = copy.target.x2 - copy.target.x1 + 1;
+    const int32_t h = copy.target.y2 - copy.target.y1 + 1;
+    const uint16_t* source = reinterpret_cast<const uint16_t*>(&color_p->full) + copy.first;
+    if (copy.target.x1 >= 0 && copy.target.y1 >= 0 && copy.target.x2 < kHorRes && copy.target.y2 < kVerRes) {
+        for (int32_t row = 0; row < h; ++row) {
+            uint16_t* out = &g_framebuffer[(copy.target.y1 + row) * kHorRes + copy.target.x1];
+            const uint16_t* in = source + row * copy.row_step;
+            for (int32_t col = 0; col < w; ++col) {
+                out[col] = in[col * copy.step];
+            }
+        }
+    }
+    g_frame_flushes++;
+    g_frame_flushed_px += static_cast<uint32_t>(w * h);
+    lv_disp_flush_ready(disp);
+}
+
+// Area still waiting to be redrawn; overlapping areas are counted twice, so
+// the sum is clamped to the screen.
+uint32_t pending_invalid_px() {
+    if (!g_display) {
+        return 0;
+    }
+    uint64_t total = 0;
+    for (uint16_t i = 0; i < g_display->inv_p; ++i) {
+        if (!g_display->inv_area_joined[i]) {
+            total += lv_area_get_size(&g_display->inv_areas[i]);
+        }
+    }
+    return static_cast<uint32_t>(std::min<uint64_t>(total, kScreenPixels));
+}
+
+bool full_screen_pending() {
+    return g_display && g_display->inv_p == 1 && lv_area_get_size(&g_display->inv_areas[0]) >= kScreenPixels;
+}
+
+std::string creator_name(void* address) {
+    Dl_info info;
+    if (dladdr(address, &info) && info.dli_sname) {
+        int status = 0;
+        char* demangled = abi::__cxa_demangle(info.dli_sname, nullptr, nullptr, &status);
+        std::string name = status == 0 && demangled ? demangled : info.dli_sname;
+        free(demangled);
+        name = name.substr(0, name.find('('));
+        if (name.rfind("ptc::", 0) == 0) {
+            name = name.substr(5);
+        }
+        return name;
+    }
+    char buf[32];
+    snprintf(buf, sizeof(buf), "%p", address);
+    return buf;
+}
+
+// Every LVGL timer runs through this trampoline so the invalidation it causes
+// is charged to the function that created it.
+void attributed_timer_cb(lv_timer_t* timer) {
+    const auto it = g_timers.find(timer);
+    if (it == g_timers.end() || !it->second.callback) {
+        return;
+    }
+    const lv_timer_cb_t callback = it->second.callback;
+    const std::string label = it->second.label;
+    const uint32_t period_ms = timer->period;
+    const uint32_t before_px = pending_invalid_px();
+    const bool full_before = full_screen_pending();
+    const uint64_t start = host::real_now_ns();
+    callback(timer);
+    const uint64_t elapsed = host::real_now_ns() - start;
+    if (!g_recording) {
+        return;
+    }
+    const uint32_t after_px = pending_invalid_px();
+    TimerStats& stats = g_timer_stats[label];
+    stats.period_ms = period_ms;
+    stats.runs++;
+    stats.callback_ns += elapsed;
+    if (after_px > before_px) {
+        stats.invalidating_runs++;
+        stats.invalidated_px += after_px - before_px;
+    }
+    if (!full_before && full_screen_pending()) {
+        stats.full_screen_runs++;
+    }
+}
+
+void record_frame() {
+    FrameStats frame;
+    frame.at_ms = millis() - g_run_start_ms;
+    frame.invalidated_px = pending_invalid_px();
+    g_frame_flushes = 0;
+    g_frame_flushed_px = 0;
+    g_last_refresh_ms = millis();
+    const uint64_t start = host::real_now_ns();
+    lv_refr_now(g_display);
+    frame.render_ns = host::real_now_ns() - start;
+    frame.flushes = g_frame_flushes;
+    frame.flushed_px = g_frame_flushed_px;
+    if (g_recording) {
+        g_frames.push_back(frame);
+    }
+}
+
+lv_obj_t* find_tabview(lv_obj_t* parent) {
+    if (lv_obj_check_type(parent, &lv_tabview_class)) {
+        return parent;
+    }
+    for (uint32_t i = 0; i < lv_obj_get_child_cnt(parent); ++i) {
+        lv_obj_t* found = find_tabview(lv_obj_get_child(parent, static_cast<int32_t>(i)));
+        if (found) {
+            return found;
+        }
+    }
+    return nullptr;
+}
+
+struct ScriptedEvent {
+    uint32_t at_ms;
+    std::function<void()> apply;
+};
+
+struct Scenario {
+    const char* name;
+    const char* description;
+    uint16_t tab;
+    uint32_t duration_ms;
+    std::vector<ScriptedEvent> events;
+    // Scenario times at which a new QR frame is due.
+    std::vector<uint32_t> rotations_ms = {};
+};
+
+// Mirrors the render task: run LVGL timers, flush dirty areas at most every
+// kDisplayRefreshIntervalMs, then sleep until the next deadline.
+void run_frames(uint32_t duration_ms, const std::vector<ScriptedEvent>& events) {
+    const uint32_t start_ms = millis();
+    g_run_start_ms = start_ms;
+    size_t next_event = 0;
+    while (true) {
+        const uint32_t elapsed_ms = millis() - start_ms;
+        if (elapsed_ms >= duration_ms) {
+            break;
+        }
+        while (next_event < events.size() && events[next_event].at_ms <= elapsed_ms) {
+            events[next_event].apply();
+            next_event++;
+        }
+
+        uint32_t wait_ms = lv_timer_handler();
+        if (g_display->inv_p > 0) {
+            const uint32_t since_ms = millis() - g_last_refresh_ms;
+            if (since_ms >= kDisplayRefreshIntervalMs) {
+                record_frame();
+            } else {
+                wait_ms = std::min(wait_ms, kDisplayRefreshIntervalMs - since_ms);
+            }
+        }
+        if (next_event < events.size()) {
+            wait_ms = std::min(wait_ms, events[next_event].at_ms - elapsed_ms);
+        }
+        wait_ms = std::min(wait_ms, duration_ms - elapsed_ms);
+        host::clock_advance_ms(std::max<uint32_t>(wait_ms, 1));
+    }
+}
+
+void setup_ui() {
+    host::clock_use_virtual(true, 1000);
+    host::serial_set_enabled(false);
+    host_ui::stub_services_reset(8, 40);
+    g_state.wifi_connected = true;
+    g_state.time_sync_ok = true;
+    g_state.provisioning_complete = true;
+    g_config.display_rotation = 270;
+
+    lv_init();
+
+    static lv_disp_draw_buf_t draw_buf;
+    static lv_disp_drv_t disp_drv;
+    static lv_color_t buf_1[kHorRes * kDrawBufferLines];
+    static lv_color_t buf_2[kHorRes * kDrawBufferLines];
+    lv_disp_draw_buf_init(&draw_buf, buf_1, buf_2, kHorRes * kDrawBufferLines);
+    lv_disp_drv_init(&disp_drv);
+    disp_drv.hor_res = kHorRes;
+    disp_drv.ver_res = kVerRes;
+    disp_drv.flush_cb = bench_flush_cb;
+    disp_drv.draw_buf = &draw_buf;
+    disp_drv.sw_rotate = 0;
+    disp_drv.full_refresh = 0;
+    g_display = lv_disp_drv_register(&disp_drv);
+    lv_disp_set_rotation(g_display, LV_DISP_ROT_270);
+
+    ptc::ui_root_init(g_config, g_state);
+    if (g_display->refr_timer) {
+        lv_timer_pause(g_display->refr_timer);
+    }
+    g_tabview = find_tabview(lv_scr_act());
+    host::serial_set_enabled(true);
+}
+
+std::vector<Scenario> build_scenarios() {
+    using host_ui::stub_services;
+    std::vector<Scenario> scenarios;
+
+    scenarios.push_back({"qr_idle", "QR tab, nothing changes", kTabQr, 10000, {}});
+
+    // Each next payload is handed over ahead of its rotation, as service_qr
+    // does, and swapped in when it is due.
+    Scenario qr_rotation = {"qr_rotation", "QR tab, payload rotates twice", kTabQr, 10000, {}};
+    for (uint32_t at_ms : {4000U, 8000U}) {
+        qr_rotation.events.push_back({at_ms - ptc::kQrPrepareAheadMs, [at_ms] {
+            stub_services().qr_next_payload = String("ptc1|A1B2C3D4E5F6|") + String(1700000000UL + at_ms) + "|1";
+            stub_services().qr_next_at_ms = millis() + ptc::kQrPrepareAheadMs;
+        }});
+        qr_rotation.rotations_ms.push_back(at_ms);
+    }
+    scenarios.push_back(qr_rotation);
+
+    scenarios.push_back({"notices_refresh", "Notices tab, a sync replaces all 8 notices", kTabNotices, 10000,
+        {{1000, [] {
+            auto& stubs = stub_services();
+            for (ptc::Notice& notice : stubs.notices) {
+                notice.updated_at = "2024-01-15T09:00:00Z";
+            }
+            stubs.notices[0].title = "Updated notice";
+            stubs.last_notice_ts += 600;
+        }}}});
+
+    scenarios.push_back({"log_revision", "Log tab, one clock-in bumps the revision", kTabLog, 10000,
+        {{1000, [] {
+            auto& stubs = stub_services();
+            host_ui::StubActivity entry;
+            entry.timestamp = 1700009999;
+            entry.user = "User 3";
+            entry.action = "Clock in";
+            stubs.activity.insert(stubs.activity.begin(), entry);
+            stubs.log_revision++;
+        }}}});
+
+    Scenario swipe = {"tab_swipe", "animated switch through all four tabs", kTabQr, 8000, {}};
+    for (uint16_t step = 1; step <= 8; ++step) {
+        const uint16_t tab = step % 4;
+        swipe.events.push_back({step * 900U, [tab] {
+            lv_tabview_set_act(g_tabview, tab, LV_ANIM_ON);
+        }});
+    }
+    scenarios.push_back(swipe);
+
+    scenarios.push_back({"settings_idle", "Settings tab, nothing changes", kTabSettings, 10000, {}});
+    return scenarios;
+}
+
+template <typename T, typename Fn>
+T percentile(std::vector<FrameStats>& frames, Fn value, uint32_t pct) {
+    std::vector<T> values;
+    for (const FrameStats& frame : frames) {
+        values.push_back(value(frame));
+    }
+    std::sort(values.begin(), values.end());
+    return values[std::min(values.size() - 1, values.size() * pct / 100)];
+}
+
+void print_scenario(const Scenario& scenario) {
+    const double seconds = scenario.duration_ms / 1000.0;
+    if (g_frames.empty()) {
+        printf("%-16s %7u frames\n", scenario.name, 0U);
+        return;
+    }
+    double render_total = 0.0;
+    double invalid_total = 0.0;
+    double flushes_total = 0.0;
+    double flushed_total = 0.0;
+    uint32_t full_frames = 0;
+    for (const FrameStats& frame : g_frames) {
+        render_total += frame.render_ns;
+        invalid_total += frame.invalidated_px;
+        flushes_total += frame.flushes;
+        flushed_total += frame.flushed_px;
+        full_frames += frame.invalidated_px >= kScreenPixels * 95 / 100 ? 1 : 0;
+    }
+    const double count = static_cast<double>(g_frames.size());
+    printf("%-16s %7.1f %10.1f %10.1f %10.1f %8.1f %6u %9.1f %10.1f\n",
+        scenario.name,
+        count / seconds,
+        render_total / count / 1000.0,
+        percentile<uint64_t>(g_frames, [](const FrameStats& f) { return f.render_ns; }, 99) / 1000.0,
+        invalid_total / count / 1000.0,
+        100.0 * invalid_total / count / kScreenPixels,
+        static_cast<unsigned>(full_frames),
+        flushes_total / count,
+        flushed_total / count / 1000.0);
+}
+
+// What reached the panel in the frames drawn as each QR frame came due.
+void print_rotations(const Scenario& scenario) {
+    for (uint32_t at_ms : scenario.rotations_ms) {
+        uint32_t frames = 0;
+        uint64_t flushed_px = 0;
+        for (const FrameStats& frame : g_frames) {
+            if (frame.at_ms >= at_ms && frame.at_ms < at_ms + kDisplayRefreshIntervalMs) {
+                frames++;
+                flushed_px += frame.flushed_px;
+            }
+        }
+        printf("    rotation at %5u ms: %u frames, %.1f kpx flushed (QR canvas %.1f kpx)\n",
+            static_cast<unsigned>(at_ms), static_cast<unsigned>(frames), flushed_px / 1000.0,
+            ptc::kQrCanvasSize * ptc::kQrCanvasSize / 1000.0);
+    }
+}
+
+// ui_qr_raster_draw() on its own over a run of payloads the size service_qr
+// signs: clearing and redrawing the canvas every rotation, as before, against
+// redrawing only the module rows with a flipped module, with the area each
+// swap invalidates.
+bool run_qr_raster() {
+    constexpr uint32_t kRotations = 200;
+    constexpr size_t kPayloadChars = 180;
+    static const char kAlphabet[] = "ABCDEFGHIJKLMNOPQRSTUVWXYZabcdefghijklmnopqrstuvwxyz0123456789-_";
+    std::vector<uint8_t> full_buffer(ptc::kQrCanvasBytes);
+    std::vector<uint8_t> changed_buffer(ptc::kQrCanvasBytes);
+    ptc::QrRaster full;
+    ptc::QrRaster changed;
+    ptc::ui_qr_raster_init(changed, changed_buffer.data());
+    uint64_t full_ns = 0;
+    uint64_t changed_ns = 0;
+    uint64_t modules_flipped = 0;
+    uint64_t rows_written = 0;
+    uint64_t band_px = 0;
+    uint8_t version = 0;
+    srand(20);
+    for (uint32_t rotation = 0; rotation <= kRotations; ++rotation) {
+        String payload = "ptc1:";
+        for (size_t i = 0; i < kPayloadChars; ++i) {
+            payload += kAlphabet[rand() % 64];
+        }
+        ptc::QrFrame frame;
+        if (!ptc::service_qr_encode(payload, frame)) {
+            printf("CHECK FAILED: QR payload did not encode\n");
+            return false;
+        }
+        frame.sequence = rotation + 1;
+        version = frame.version;
+        ptc::ui_qr_raster_init(full, full_buffer.data());
+        const ptc::QrRaster shown = changed;
+        ptc::QrDrawStats stats;
+
+        uint64_t start = host::real_now_ns();
+        ptc::ui_qr_raster_draw(full, frame);
+        const uint64_t full_elapsed = host::real_now_ns() - start;
+        start = host::real_now_ns();
+        ptc::ui_qr_raster_draw(changed, frame, &stats);
+        const uint64_t changed_elapsed = host::real_now_ns() - start;
+        // The first draw has nothing to start from.
+        if (rotation == 0) {
+            continue;
+        }
+        full_ns += full_elapsed;
+        changed_ns += changed_elapsed;
+        modules_flipped += stats.modules_written;
+        rows_written += stats.rows_written;
+        lv_area_t bands[ptc::kQrMaxBands];
+        const size_t band_count = ptc::ui_qr_raster_diff(shown, changed, bands, ptc::kQrMaxBands);
+        for (size_t i = 0; i < band_count; ++i) {
+            band_px += lv_area_get_size(&bands[i]);
+        }
+    }
+    const uint32_t canvas_px = ptc::kQrCanvasSize * ptc::kQrCanvasSize;
+    printf("\n== qr raster (%u rotations, %u-char payloads, version %u, %dx%d 1-bit canvas, %.1f KB) ==\n",
+        static_cast<unsigned>(kRotations), static_cast<unsigned>(kPayloadChars + 5), static_cast<unsigned>(version),
+        ptc::kQrCanvasSize, ptc::kQrCanvasSize, ptc::kQrCanvasBytes / 1024.0);
+    printf("%-24s %10.1f us/rotation, %6.1f kpx invalidated\n", "clear and redraw",
+        full_ns / 1000.0 / kRotations, canvas_px / 1000.0);
+    printf("%-24s %10.1f us/rotation, %6.1f kpx invalidated, %.0f modules flipped in %.1f rows\n",
+        "rows with flips only", changed_ns / 1000.0 / kRotations, band_px / 1000.0 / kRotations,
+        static_cast<double>(modules_flipped) / kRotations, static_cast<double>(rows_written) / kRotations);
+    fflush(stdout);
+
+    bool ok = true;
+    if (full_buffer != changed_buffer) {
+        printf("CHECK FAILED: incremental canvas differs from a full redraw\n");
+        ok = false;
+    }
+    if (band_px >= static_cast<uint64_t>(canvas_px) * kRotations) {
+        printf("CHECK FAILED: a rotation invalidated the whole canvas\n");
+        ok = false;
+    }
+    return ok;
+}
+
+// The RGB565 pixel the QR canvas held before it went to one bit per pixel:
+// white, with each dark module a scale x scale black square, centred inside
+// a kQrQuietZone-module border.
+uint16_t golden_pixel(const ptc::QrFrame& frame, int x, int y) {
+    const int total_modules = frame.size + ptc::kQrQuietZone * 2;
+    const int scale = ptc::kQrCanvasSize / total_modules;
+    const int origin = (ptc::kQrCanvasSize - total_modules * scale) / 2 + ptc::kQrQuietZone * scale;
+    const int module_x = x - origin;
+    const int module_y = y - origin;
+    const bool dark = module_x >= 0 && module_y >= 0 && module_x < frame.size * scale &&
+        module_y < frame.size * scale && frame.module(module_x / scale, module_y / scale);
+    return dark ? ptc::theme::black().full : ptc::theme::white().full;
+}
+
+// Decodes the 1-bit canvas through LVGL's own image decoder, line by line
+// as lv_img draws it, and compares every pixel with golden_pixel(): one
+// payload per version in kQrCapacities, each drawn in full and then over a
+// second payload of the same version, which redraws only the rows that changed.
+bool run_qr_golden() {
+    std::vector<uint8_t> buffer(ptc::kQrCanvasBytes);
+    ptc::QrRaster raster;
+    ptc::ui_qr_raster_init(raster, buffer.data());
+    lv_img_dsc_t image = {};
+    image.header.cf = LV_IMG_CF_INDEXED_1BIT;
+    image.header.w = ptc::kQrCanvasSize;
+    image.header.h = ptc::kQrCanvasSize;
+    image.data_size = ptc::kQrCanvasBytes;
+    image.data = buffer.data();
+    std::vector<uint8_t> line(ptc::kQrCanvasSize * LV_IMG_PX_SIZE_ALPHA_BYTE);
+
+    uint32_t images = 0;
+    uint64_t mismatches = 0;
+    for (const ptc::QrCapacity& capacity : ptc::kQrCapacities) {
+        for (uint8_t pass = 0; pass < 2; ++pass) {
+            String payload = "ptc1:";
+            while (payload.length() < capacity.byte_capacity) {
+                payload += static_cast<char>('A' + (payload.length() * 7 + pass * 11) % 26);
+            }
+            ptc::QrFrame frame;
+            ptc::QrDrawStats stats;
+            if (!ptc::service_qr_encode(payload, frame) || frame.version != capacity.version ||
+                !ptc::ui_qr_raster_draw(raster, frame, &stats) || stats.full != (pass == 0)) {
+                printf("CHECK FAILED: version %u payload did not draw as expected\n",
+                    static_cast<unsigned>(capacity.version));
+                return false;
+            }
+            lv_img_decoder_dsc_t decoder;
+            if (lv_img_decoder_open(&decoder, &image, lv_color_white(), 0) != LV_RES_OK) {
+                printf("CHECK FAILED: LVGL could not open the 1-bit canvas\n");
+                return false;
+            }
+            for (int y = 0; y < ptc::kQrCanvasSize; ++y) {
+                lv_img_decoder_read_line(&decoder, 0, y, ptc::kQrCanvasSize, line.data());
+                for (int x = 0; x < ptc::kQrCanvasSize; ++x) {
+                    const uint8_t* px = &line[x * LV_IMG_PX_SIZE_ALPHA_BYTE];
+                    const uint16_t color = static_cast<uint16_t>(px[0] | px[1] << 8);
+                    if (color != golden_pixel(frame, x, y) || px[2] != LV_OPA_COVER) {
+                        mismatches++;
+                    }
+                }
+            }
+            lv_img_decoder_close(&decoder);
+            images++;
+        }
+    }
+    printf("\n== qr golden (%u canvases, versions %u-%u, %dx%d) ==\n", static_cast<unsigned>(images),
+        static_cast<unsigned>(ptc::kQrCapacities[0].version),
+        static_cast<unsigned>(raster.version), ptc::kQrCanvasSize, ptc::kQrCanvasSize);
+    printf("%llu of %llu pixels differ from the RGB565 rendering\n", static_cast<unsigned long long>(mismatches),
+        static_cast<unsigned long long>(images) * ptc::kQrCanvasSize * ptc::kQrCanvasSize);
+    fflush(stdout);
+    if (mismatches != 0) {
+        printf("CHECK FAILED: 1-bit QR canvas is not pixel-exact\n");
+        return false;
+    }
+    return true;
+}
+
+void print_timers() {
+    std::vector<std::pair<std::string, TimerStats>> rows(g_timer_stats.begin(), g_timer_stats.end());
+    std::sort(rows.begin(), rows.end(), [](const auto& a, const auto& b) {
+        return a.second.invalidated_px > b.second.invalidated_px;
+    });
+    for (const auto& row : rows) {
+        if (row.second.invalidated_px == 0) {
+            continue;
+        }
+        printf("    %-34s %6ums %6u runs %6u inval %4u full %10.1f kpx %8.1f us/run\n",
+            row.first.c_str(),
+            static_cast<unsigned>(row.second.period_ms),
+            static_cast<unsigned>(row.second.runs),
+            static_cast<unsigned>(row.second.invalidating_runs),
+            static_cast<unsigned>(row.second.full_screen_runs),
+            row.second.invalidated_px / 1000.0,
+            row.second.callback_ns / 1000.0 / std::max<uint32_t>(row.second.runs, 1));
+    }
+}
+
+} // namespace
+
+extern "C" lv_timer_t* __wrap_lv_timer_create(lv_timer_cb_t timer_xcb, uint32_t period, void* user_data) {
+    lv_timer_t* timer = __real_lv_timer_create(attributed_timer_cb, period, user_data);
+    if (timer) {
+        std::string label = creator_name(__builtin_return_address(0));
+        const uint32_t use = ++g_label_uses[label];
+        if (use > 1) {
+            label += "#" + std::to_string(use);
+        }
+        g_timers[timer] = {label, timer_xcb};
+    }
+    return timer;
+}
+
+int main(int argc, char** argv) {
+    const char* only = argc > 1 ? argv[1] : nullptr;
+    setup_ui();
+    if (!g_tabview) {
+        printf("ui_root_init did not create a tabview\n");
+        return 1;
+    }
+
+    printf("\n== ui frames (800x480, sw_rotate 270, %d-line double buffer, virtual clock) ==\n", kDrawBufferLines);
+    printf("%-16s %7s %10s %10s %10s %8s %6s %9s %10s\n",
+        "scenario", "fps", "render_us", "p99_us", "inval_kpx", "inval%", "full", "flushes", "flush_kpx");
+
+    int failures = 0;
+    bool matched = false;
+    for (const Scenario& scenario : build_scenarios()) {
+        if (only && strcmp(only, scenario.name) != 0) {
+            continue;
+        }
+        matched = true;
+        lv_tabview_set_act(g_tabview, scenario.tab, LV_ANIM_OFF);
+        g_recording = false;
+        run_frames(kSettleMs, {});
+
+        g_frames.clear();
+        g_timer_stats.clear();
+        g_recording = true;
+        run_frames(scenario.duration_ms, scenario.events);
+        g_recording = false;
+
+        print_scenario(scenario);
+        print_rotations(scenario);
+        print_timers();
+        if (!scenario.events.empty() && g_frames.empty()) {
+            printf("CHECK FAILED: %s rendered no frames\n", scenario.name);
+            failures++;
+        }
+        fflush(stdout);
+    }
+    if (!only || strcmp(only, "qr_raster") == 0) {
+        matched = true;
+        failures += run_qr_raster() ? 0 : 1;
+    }
+    if (!only || strcmp(only, "qr_golden") == 0) {
+        matched = true;
+        failures += run_qr_golden() ? 0 : 1;
+    }
+    if (!matched) {
+        printf("usage: %s [scenario]\n\nscenarios:\n", argv[0]);
+        for (const Scenario& scenario : build_scenarios()) {
+            printf("  %-16s %s\n", scenario.name, scenario.description);
+        }
+        printf("  %-16s %s\n", "qr_raster", "QR canvas redraw vs changed rows only, per rotation");
+        printf("  %-16s %s\n", "qr_golden", "1-bit QR canvas as LVGL decodes it vs the RGB565 rendering");
+        return 2;
+    }
+    return failures == 0 ? 0 : 1;
+}
@@ -0,0 +1,360 @@
+#include "ui_stubs.h"
+
+#include <qrcode.h>
+
+#include "src/drivers/display_driver.h"
+#include "src/drivers/touch_driver.h"
+#include "src/services/service_http.h"
+#include "src/services/service_log.h"
+#include "src/services/service_ota.h"
+#include "src/services/service_outbox.h"
+#include "src/services/service_qr.h"
+#include "src/services/service_storage.h"
+#include "src/services/service_telemetry.h"
+#include "src/services/service_time.h"
+#include "src/services/service_wifi.h"
+
+namespace host_ui {
+
+namespace {
+
+StubServices g_stubs;
+ptc::QrFrame g_qr_frame;
+ptc::QrFrame g_qr_next;
+uint32_t g_qr_sequence = 0;
+
+void refresh_frame(ptc::QrFrame& frame, const String& payload, uint32_t shown_at_ms) {
+    if (frame.payload == payload) {
+        return;
+    }
+    frame = ptc::QrFrame();
+    if (!payload.isEmpty()) {
+        ptc::service_qr_encode(payload, frame);
+        frame.payload = payload;
+        frame.sequence = ++g_qr_sequence;
+        frame.shown_at_ms = shown_at_ms;
+    }
+}
+
+// Encodes the scripted payloads once each, and promotes the next one when
+// it is due, keeping its sequence as service_qr does.
+void sync_qr_frames() {
+    if (!g_stubs.qr_next_payload.isEmpty() && static_cast<int32_t>(millis() - g_stubs.qr_next_at_ms) >= 0) {
+        refresh_frame(g_qr_next, g_stubs.qr_next_payload, g_stubs.qr_next_at_ms);
+        g_stubs.qr_payload = g_stubs.qr_next_payload;
+        g_stubs.qr_rotated_ms = g_stubs.qr_next_at_ms;
+        g_stubs.qr_next_payload = "";
+        g_qr_frame = g_qr_next;
+        g_qr_next = ptc::QrFrame();
+    }
+    refresh_frame(g_qr_frame, g_stubs.qr_payload, g_stubs.qr_rotated_ms);
+    refresh_frame(g_qr_next, g_stubs.qr_next_payload, g_stubs.qr_next_at_ms);
+}
+
+} // namespace
+
+StubServices& stub_services() {
+    return g_stubs;
+}
+
+void stub_services_reset(uint16_t notice_count, uint16_t activity_count) {
+    g_stubs = StubServices();
+    g_stubs.qr_payload = "ptc1|A1B2C3D4E5F6|1700000000|0";
+    g_stubs.qr_rotated_ms = millis();
+    g_stubs.manual_code = "482 913";
+    g_stubs.last_notice_ts = 1700000000;
+    for (uint16_t i = 0; i < notice_count; ++i) {
+        ptc::Notice notice;
+        notice.id = String(i);
+        notice.title = String("Notice ") + String(i + 1);
+        notice.body = "Shift handover moved to the east entrance while the lobby is being repainted.";
+        notice.created_at = "2024-01-15T08:00:00Z";
+        g_stubs.notices.push_back(notice);
+    }
+    for (uint16_t i = 0; i < activity_count; ++i) {
+        StubActivity entry;
+        entry.timestamp = 1700000000 + i * 60;
+        entry.user = String("User ") + String(i % 12);
+        entry.action = (i % 2) == 0 ? "Clock in" : "Clock out";
+        g_stubs.activity.push_back(entry);
+    }
+    g_stubs.log_revision = 1;
+}
+
+} // namespace host_ui
+
+namespace ptc {
+
+bool service_http_registration_in_progress() {
+    return false;
+}
+
+void service_http_retry_registration() {}
+
+void service_http_force_notices_fetch() {}
+
+bool service_http_has_notices() {
+    return !host_ui::stub_services().notices.empty();
+}
+
+uint16_t service_http_notice_count() {
+    return static_cast<uint16_t>(host_ui::stub_services().notices.size());
+}
+
+bool service_http_get_notice(uint16_t index, Notice& out_notice) {
+    const auto& notices = host_ui::stub_services().notices;
+    if (index >= notices.size()) {
+        return false;
+    }
+    out_notice = notices[index];
+    return true;
+}
+
+uint32_t service_http_last_notice_ts() {
+    return host_ui::stub_services().last_notice_ts;
+}
+
+String service_http_manual_code_display() {
+    return host_ui::stub_services().manual_code;
+}
+
+bool service_http_manual_code_pending() {
+    return false;
+}
+
+bool service_http_api_ok() {
+    return true;
+}
+
+String service_http_last_error() {
+    return String();
+}
+
+uint8_t service_http_endpoint_count() {
+    return 0;
+}
+
+bool service_http_endpoint_status(uint8_t index, HttpEndpointStatus& out_status) {
+    (void)index;
+    (void)out_status;
+    return false;
+}
+
+void service_log_add(const String& message) {
+    (void)message;
+}
+
+uint16_t service_log_count() {
+    return static_cast<uint16_t>(host_ui::stub_services().activity.size());
+}
+
+uint32_t service_log_revision() {
+    return host_ui::stub_services().log_revision;
+}
+
+bool service_log_get_activity(uint16_t index, uint32_t& timestamp_out, String& user_out, String& action_out) {
+    const auto& activity = host_ui::stub_services().activity;
+    if (index >= activity.size()) {
+        return false;
+    }
+    timestamp_out = activity[index].timestamp;
+    user_out = activity[index].user;
+    action_out = activity[index].action;
+    return true;
+}
+
+void service_outbox_stats(OutboxStats& out_stats) {
+    out_stats = OutboxStats();
+}
+
+void service_ota_check_github() {}
+
+void service_ota_download_github() {}
+
+void service_ota_apply_update() {}
+
+bool service_ota_update_available() {
+    return false;
+}
+
+bool service_ota_update_ready() {
+    return false;
+}
+
+String service_ota_github_status() {
+    return "Up to date";
+}
+
+String service_ota_latest_version() {
+    return String();
+}
+
+uint8_t service_ota_progress() {
+    return 0;
+}
+
+OtaState service_ota_state() {
+    return OtaState::kUpToDate;
+}
+
+bool service_ota_exclusive() {
+    return false;
+}
+
+bool service_ota_enabled() {
+    return true;
+}
+
+bool service_ota_ready() {
+    return true;
+}
+
+bool service_ota_updating() {
+    return false;
+}
+
+String service_qr_payload() {
+    host_ui::sync_qr_frames();
+    return host_ui::stub_services().qr_payload;
+}
+
+uint32_t service_qr_seconds_remaining() {
+    host_ui::sync_qr_frames();
+    const auto& stubs = host_ui::stub_services();
+    const uint32_t elapsed_sec = (millis() - stubs.qr_rotated_ms) / 1000;
+    return elapsed_sec >= stubs.qr_interval_sec ? 0 : stubs.qr_interval_sec - elapsed_sec;
+}
+
+uint32_t service_qr_interval_sec() {
+    return host_ui::stub_services().qr_interval_sec;
+}
+
+uint8_t service_qr_select_version(size_t payload_length) {
+    for (const auto& capacity : kQrCapacities) {
+        if (payload_length <= capacity.byte_capacity) {
+            return capacity.version;
+        }
+    }
+    return 0;
+}
+
+bool service_qr_encode(const String& payload, QrFrame& out_frame) {
+    const uint8_t version = service_qr_select_version(payload.length());
+    QRCode qrcode;
+    out_frame.modules.assign(version ? qrcode_getBufferSize(version) : 0, 0);
+    if (version == 0 || qrcode_initText(&qrcode, out_frame.modules.data(), version, ECC_LOW, payload.c_str()) != 0) {
+        return false;
+    }
+    out_frame.version = version;
+    out_frame.size = qrcode.size;
+    return true;
+}
+
+uint32_t service_qr_frame_sequence() {
+    host_ui::sync_qr_frames();
+    return host_ui::g_qr_frame.sequence;
+}
+
+uint32_t service_qr_next_sequence() {
+    host_ui::sync_qr_frames();
+    return host_ui::g_qr_next.sequence;
+}
+
+bool service_qr_frame(QrFrame& out_frame) {
+    host_ui::sync_qr_frames();
+    out_frame = host_ui::g_qr_frame;
+    return !out_frame.payload.isEmpty();
+}
+
+bool service_qr_next_frame(QrFrame& out_frame) {
+    host_ui::sync_qr_frames();
+    out_frame = host_ui::g_qr_next;
+    return !out_frame.payload.isEmpty();
+}
+
+bool service_storage_get_status(StorageStatus& status) {
+    status.mounted = true;
+    status.card_type = "SDHC";
+    status.capacity_bytes = 8ULL * 1024 * 1024 * 1024;
+    status.used_bytes = 64ULL * 1024 * 1024;
+    status.free_bytes = status.capacity_bytes - status.used_bytes;
+    return true;
+}
+
+void service_storage_save_config(const DeviceConfig& config) {
+    (void)config;
+}
+
+bool service_storage_load_wifi(String& ssid, String& password) {
+    ssid = "host";
+    password = String();
+    return true;
+}
+
+void service_storage_save_touch_calibration(const TouchCalibration& calibration) {
+    (void)calibration;
+}
+
+void service_telemetry_sample(TelemetrySnapshot& out_snapshot) {
+    out_snapshot = TelemetrySnapshot();
+    out_snapshot.internal = {320U * 1024U, 182U * 1024U, 110U * 1024U, 150U * 1024U};
+    out_snapshot.psram = {8U * 1024U * 1024U, 7U * 1024U * 1024U, 7U * 1024U * 1024U - 4096U, 6U * 1024U * 1024U};
+    const char* names[] = {"loopTask", "portal_http", "ptc_ota", "ui", "lv_flush"};
+    for (const char* name : names) {
+        out_snapshot.tasks[out_snapshot.task_count].name = name;
+        out_snapshot.tasks[out_snapshot.task_count].free_bytes = 2048;
+        out_snapshot.task_count++;
+    }
+}
+
+uint8_t service_telemetry_fragmentation(const HeapRegionStats& region) {
+    return region.free_bytes ? static_cast<uint8_t>(100 - region.largest_block * 100ULL / region.free_bytes) : 0;
+}
+
+void service_time_force_sync() {}
+
+bool service_wifi_is_connected() {
+    return host_ui::stub_services().wifi_connected;
+}
+
+bool service_wifi_portal_active() {
+    return false;
+}
+
+void service_wifi_connect(const String& ssid, const String& password) {
+    (void)ssid;
+    (void)password;
+}
+
+bool service_wifi_is_connecting() {
+    return false;
+}
+
+String service_wifi_connection_message() {
+    return String();
+}
+
+bool display_driver_is_backlight_on() {
+    return host_ui::stub_services().backlight_on;
+}
+
+void display_driver_set_backlight(bool on) {
+    host_ui::stub_services().backlight_on = on;
+}
+
+void display_driver_set_render_enabled(bool enabled) {
+    (void)enabled;
+}
+
+bool touch_driver_poll_raw(uint16_t& x, uint16_t& y, bool& pressed) {
+    x = 0;
+    y = 0;
+    pressed = false;
+    return false;
+}
+
+void touch_driver_set_calibration(const TouchCalibration& calibration) {
+    (void)calibration;
+}
+
+} // namespace ptc
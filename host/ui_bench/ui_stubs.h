@@ -0,0 +1,43 @@
+#pragma once
+
+// Scriptable stand-ins for the services and drivers that src/ui calls. The
+// frame bench links src/ui against these instead of src/services so each
+// scenario controls exactly what the UI timers observe.
+
+#include <Arduino.h>
+
+#include <vector>
+
+#include "config.h"
+
+namespace host_ui {
+
+struct StubActivity {
+    uint32_t timestamp = 0;
+    String user;
+    String action;
+};
+
+struct StubServices {
+    bool wifi_connected = true;
+    String qr_payload;
+    uint32_t qr_interval_sec = 30;
+    uint32_t qr_rotated_ms = 0;
+    // Takes over from qr_payload at qr_next_at_ms.
+    String qr_next_payload;
+    uint32_t qr_next_at_ms = 0;
+    std::vector<ptc::Notice> notices;
+    uint32_t last_notice_ts = 0;
+    std::vector<StubActivity> activity;
+    uint32_t log_revision = 0;
+    String manual_code;
+    bool backlight_on = true;
+};
+
+StubServices& stub_services();
+
+// Fills the stubs with a registered, online device: a QR payload, cached
+// notices and an activity log of the given sizes.
+void stub_services_reset(uint16_t notice_count, uint16_t activity_count);
+
+} // namespace host_ui
@@ -15,6 +15,11 @@ struct DeviceConfig {
     String location_name;
     uint32_t qr_interval_sec = kDefaultQrIntervalSec;
     uint16_t display_rotation = kDefaultDisplayRotation;
+    // ETag of the portal config these values came from; empty once a field
+    // the portal owns is changed locally, so the next poll fetches it again.
+    String config_etag;
+    // The portal advertised the combined sync endpoint in its config.
+    bool portal_sync = false;
 };
 
 struct AppState {
@@ -7,8 +7,13 @@
 #define LV_COLOR_DEPTH 16
 #define LV_USE_LOG 0
 #define LV_TICK_CUSTOM 1
+#ifdef PTC_HOST
+#define LV_TICK_CUSTOM_INCLUDE "host_tick.h"
+#define LV_TICK_CUSTOM_SYS_TIME_EXPR (host_tick_ms())
+#else
 #define LV_TICK_CUSTOM_INCLUDE "Arduino.h"
 #define LV_TICK_CUSTOM_SYS_TIME_EXPR (millis())
+#endif
 #define LV_INDEV_DEF_READ_PERIOD 10
 
 #define LV_FONT_MONTSERRAT_12 1
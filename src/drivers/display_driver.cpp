@@ -4,9 +4,14 @@
 #include <esp_heap_caps.h>
 #include <esp32s3/rom/cache.h>
 #include <Arduino_GFX_Library.h>
+#include <freertos/FreeRTOS.h>
+#include <freertos/queue.h>
+#include <freertos/semphr.h>
+#include <freertos/task.h>
 
 #include <cstring>
 
+#include "display_rotation.h"
 #include "pins.h"
 
 namespace ptc {
@@ -26,7 +31,12 @@ constexpr int kVsyncFrontPorch = 8;
 constexpr int kVsyncPulseWidth = 4;
 constexpr int kPclkActiveNeg = 1;
 constexpr bool kAutoFlush = true;
-constexpr int kNoPsramBufferLines = 30;
+constexpr int kDrawBufferLines = 24;
+constexpr uint32_t kFlushTaskStackSize = 4096;
+constexpr UBaseType_t kFlushTaskPriority = 3;
+constexpr BaseType_t kFlushTaskCore = 0;
+// Upper bound on one wait for a draw buffer; LVGL checks again after it.
+constexpr uint32_t kFlushWaitMs = 50;
 constexpr uint8_t kBacklightDutyOn = 255;
 constexpr uint8_t kBacklightDutyDim = 48;
 
@@ -36,42 +46,105 @@ bool g_has_framebuffer = false;
 bool g_backlight_on = false;
 bool g_backlight_dimmed = false;
 bool g_render_enabled = true;
+QueueHandle_t g_flush_queue = nullptr;
+SemaphoreHandle_t g_flush_done = nullptr;
+TaskHandle_t g_flush_task = nullptr;
+
+struct FlushJob {
+    lv_disp_drv_t* disp;
+    lv_area_t area;
+    lv_color_t* color_p;
+};
 
 void apply_backlight_duty(uint8_t duty) {
     pinMode(pins::kLcdBl, OUTPUT);
     digitalWrite(pins::kLcdBl, duty > 0 ? HIGH : LOW);
 }
 
-void display_flush_cb(lv_disp_drv_t* disp, const lv_area_t* area, lv_color_t* color_p) {
-    if (!g_gfx || !g_render_enabled) {
-        lv_disp_flush_ready(disp);
-        return;
-    }
-
-    const uint32_t w = area->x2 - area->x1 + 1;
-    const uint32_t h = area->y2 - area->y1 + 1;
-
+uint16_t panel_pixel(uint16_t value) {
 #if (LV_COLOR_16_SWAP != 0)
-    g_gfx->draw16bitBeRGBBitmap(area->x1, area->y1, reinterpret_cast<uint16_t*>(&color_p->full), w, h);
+    return static_cast<uint16_t>(value << 8 | value >> 8);
 #else
+    return value;
+#endif
+}
+
+// LVGL renders in rotated coordinates (sw_rotate off); the area is turned
+// while it is copied into the panel framebuffer, on the flush task.
+void copy_area(const lv_disp_drv_t* disp, const lv_area_t* area, lv_color_t* color_p) {
+    const RotatedCopy copy =
+        display_rotated_copy(static_cast<lv_disp_rot_t>(disp->rotated), *area, kHorRes, kVerRes);
+    const uint32_t w = copy.target.x2 - copy.target.x1 + 1;
+    const uint32_t h = copy.target.y2 - copy.target.y1 + 1;
+    const uint16_t* source = reinterpret_cast<const uint16_t*>(&color_p->full) + copy.first;
     uint16_t* framebuffer = g_gfx->getFramebuffer();
-    const uint16_t* source = reinterpret_cast<const uint16_t*>(&color_p->full);
-    if (framebuffer) {
-        uint16_t* destination = framebuffer + (area->y1 * kHorRes) + area->x1;
+    if (!framebuffer) {
         for (uint32_t row = 0; row < h; ++row) {
-            memcpy(destination + (row * kHorRes), source + (row * w), w * sizeof(uint16_t));
+            const uint16_t* in = source + static_cast<int32_t>(row) * copy.row_step;
+            for (uint32_t col = 0; col < w; ++col) {
+                g_gfx->drawPixel(copy.target.x1 + col, copy.target.y1 + row,
+                    panel_pixel(in[static_cast<int32_t>(col) * copy.step]));
+            }
         }
+        return;
+    }
 
-        const uintptr_t dirty_start = reinterpret_cast<uintptr_t>(destination);
-        const uintptr_t dirty_end = dirty_start + (((h - 1) * kHorRes + w) * sizeof(uint16_t));
-        const uintptr_t cache_start = dirty_start & ~static_cast<uintptr_t>(63);
-        const uintptr_t cache_end = (dirty_end + 63) & ~static_cast<uintptr_t>(63);
-        Cache_WriteBack_Addr(static_cast<uint32_t>(cache_start), static_cast<uint32_t>(cache_end - cache_start));
-    } else {
-        g_gfx->draw16bitRGBBitmap(area->x1, area->y1, const_cast<uint16_t*>(source), w, h);
+    uint16_t* destination = framebuffer + (copy.target.y1 * kHorRes) + copy.target.x1;
+    for (uint32_t row = 0; row < h; ++row) {
+        uint16_t* out = destination + row * kHorRes;
+        const uint16_t* in = source + static_cast<int32_t>(row) * copy.row_step;
+        if (copy.step == 1 && LV_COLOR_16_SWAP == 0) {
+            memcpy(out, in, w * sizeof(uint16_t));
+        } else {
+            for (uint32_t col = 0; col < w; ++col) {
+                out[col] = panel_pixel(in[static_cast<int32_t>(col) * copy.step]);
+            }
+        }
+    }
+
+    const uintptr_t dirty_start = reinterpret_cast<uintptr_t>(destination);
+    const uintptr_t dirty_end = dirty_start + (((h - 1) * kHorRes + w) * sizeof(uint16_t));
+    const uintptr_t cache_start = dirty_start & ~static_cast<uintptr_t>(63);
+    const uintptr_t cache_end = (dirty_end + 63) & ~static_cast<uintptr_t>(63);
+    Cache_WriteBack_Addr(static_cast<uint32_t>(cache_start), static_cast<uint32_t>(cache_end - cache_start));
+}
+
+// Turns finished areas into the panel framebuffer on the other core while
+// LVGL renders the next area into the second draw buffer; LVGL only waits
+// (in flush_wait_cb) when it has filled that one too.
+void flush_task(void* param) {
+    LV_UNUSED(param);
+    FlushJob job;
+    for (;;) {
+        if (xQueueReceive(g_flush_queue, &job, portMAX_DELAY) == pdTRUE) {
+            copy_area(job.disp, &job.area, job.color_p);
+            lv_disp_flush_ready(job.disp);
+            xSemaphoreGive(g_flush_done);
+        }
+    }
+}
+
+// Called by LVGL in a loop while both draw buffers are busy. Blocks the UI
+// task until the flush task finishes one instead of spinning on core 1. A
+// semaphore rather than a notification, which would eat the UI task's wakes.
+void flush_wait_cb(lv_disp_drv_t* disp) {
+    LV_UNUSED(disp);
+    xSemaphoreTake(g_flush_done, pdMS_TO_TICKS(kFlushWaitMs));
+}
+
+void display_flush_cb(lv_disp_drv_t* disp, const lv_area_t* area, lv_color_t* color_p) {
+    if (!g_gfx || !g_render_enabled) {
+        lv_disp_flush_ready(disp);
+        return;
     }
-#endif
 
+    if (g_flush_queue) {
+        const FlushJob job = {disp, *area, color_p};
+        if (xQueueSend(g_flush_queue, &job, portMAX_DELAY) == pdTRUE) {
+            return;
+        }
+    }
+    copy_area(disp, area, color_p);
     lv_disp_flush_ready(disp);
 }
 
@@ -81,6 +154,7 @@ bool display_driver_init(lv_disp_t** out_disp) {
     static lv_disp_draw_buf_t draw_buf;
     static lv_disp_drv_t disp_drv;
     static lv_color_t* lv_draw_buf = nullptr;
+    static lv_color_t* lv_draw_buf_2 = nullptr;
 
     Serial.println("display_driver_init: start");
 
@@ -112,24 +186,45 @@ bool display_driver_init(lv_disp_t** out_disp) {
         g_gfx->flush();
     }
 
-    lv_draw_buf = static_cast<lv_color_t*>(heap_caps_malloc(
-        kHorRes * kNoPsramBufferLines * sizeof(lv_color_t), MALLOC_CAP_INTERNAL | MALLOC_CAP_DMA | MALLOC_CAP_8BIT));
-    size_t lv_buf_pixels = kHorRes * kNoPsramBufferLines;
+    const size_t lv_buf_pixels = kHorRes * kDrawBufferLines;
+    const uint32_t buf_caps = MALLOC_CAP_INTERNAL | MALLOC_CAP_DMA | MALLOC_CAP_8BIT;
+    lv_draw_buf = static_cast<lv_color_t*>(heap_caps_malloc(lv_buf_pixels * sizeof(lv_color_t), buf_caps));
     if (!lv_draw_buf) {
         Serial.println("display_driver_init: draw buffer alloc failed");
         return false;
     }
+    lv_draw_buf_2 = static_cast<lv_color_t*>(heap_caps_malloc(lv_buf_pixels * sizeof(lv_color_t), buf_caps));
+    if (lv_draw_buf_2) {
+        g_flush_queue = xQueueCreate(1, sizeof(FlushJob));
+        g_flush_done = xSemaphoreCreateBinary();
+        if (g_flush_queue && (!g_flush_done ||
+                xTaskCreatePinnedToCore(flush_task, "lv_flush", kFlushTaskStackSize, nullptr, kFlushTaskPriority,
+                    &g_flush_task, kFlushTaskCore) != pdPASS)) {
+            vQueueDelete(g_flush_queue);
+            g_flush_queue = nullptr;
+            g_flush_task = nullptr;
+        }
+    }
+    Serial.printf("display_driver_init: draw buffers=%d lines=%d async_flush=%s\n",
+        lv_draw_buf_2 ? 2 : 1,
+        kDrawBufferLines,
+        g_flush_queue ? "yes" : "no");
 
     display_driver_set_backlight(true);
 
-    lv_disp_draw_buf_init(&draw_buf, lv_draw_buf, nullptr, lv_buf_pixels);
+    lv_disp_draw_buf_init(&draw_buf, lv_draw_buf, lv_draw_buf_2, lv_buf_pixels);
     lv_disp_drv_init(&disp_drv);
     disp_drv.hor_res = kHorRes;
     disp_drv.ver_res = kVerRes;
     disp_drv.flush_cb = display_flush_cb;
     disp_drv.draw_buf = &draw_buf;
-    disp_drv.sw_rotate = 1;
+    // copy_area turns each area itself. LVGL's software rotation waits for
+    // every rotated chunk to be flushed, which would undo the second buffer.
+    disp_drv.sw_rotate = 0;
     disp_drv.full_refresh = 0;
+    if (g_flush_queue) {
+        disp_drv.wait_cb = flush_wait_cb;
+    }
 
     lv_disp_t* disp = lv_disp_drv_register(&disp_drv);
     Serial.println("display_driver_init: ready (backend=Arduino_GFX)");
@@ -193,4 +288,8 @@ bool display_driver_is_render_enabled() {
     return g_render_enabled;
 }
 
+TaskHandle_t display_driver_flush_task() {
+    return g_flush_task;
+}
+
 } // namespace ptc
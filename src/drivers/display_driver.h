@@ -1,5 +1,7 @@
 #pragma once
 
+#include <freertos/FreeRTOS.h>
+#include <freertos/task.h>
 #include <lvgl.h>
 
 namespace ptc {
@@ -12,5 +14,7 @@ void display_driver_set_backlight_dimmed(bool dimmed);
 bool display_driver_is_backlight_dimmed();
 void display_driver_set_render_enabled(bool enabled);
 bool display_driver_is_render_enabled();
+// The async flush task, or nullptr when flushing synchronously.
+TaskHandle_t display_driver_flush_task();
 
 } // namespace ptc
@@ -0,0 +1,53 @@
+#pragma once
+
+#include <lvgl.h>
+
+namespace ptc {
+
+// How an area LVGL rendered in rotated coordinates lands on the panel: the
+// panel area it covers, and where each panel pixel is read from in the draw
+// buffer. Turned the way lv_indev turns touches back, so the two agree.
+struct RotatedCopy {
+    lv_area_t target;
+    // Draw buffer index of the target's top-left pixel, and the change in
+    // index per target row and per target column.
+    int32_t first;
+    int32_t row_step;
+    int32_t step;
+};
+
+inline RotatedCopy display_rotated_copy(lv_disp_rot_t rotation, const lv_area_t& area, lv_coord_t hor_res,
+    lv_coord_t ver_res) {
+    const int32_t w = area.x2 - area.x1 + 1;
+    const int32_t h = area.y2 - area.y1 + 1;
+    RotatedCopy copy = {area, 0, w, 1};
+    switch (rotation) {
+        case LV_DISP_ROT_90:
+            copy.target = {area.y1, static_cast<lv_coord_t>(ver_res - 1 - area.x2), area.y2,
+                static_cast<lv_coord_t>(ver_res - 1 - area.x1)};
+            copy.first = w - 1;
+            copy.row_step = -1;
+            copy.step = w;
+            break;
+        case LV_DISP_ROT_180:
+            copy.target = {static_cast<lv_coord_t>(hor_res - 1 - area.x2),
+                static_cast<lv_coord_t>(ver_res - 1 - area.y2), static_cast<lv_coord_t>(hor_res - 1 - area.x1),
+                static_cast<lv_coord_t>(ver_res - 1 - area.y1)};
+            copy.first = (h - 1) * w + w - 1;
+            copy.row_step = -w;
+            copy.step = -1;
+            break;
+        case LV_DISP_ROT_270:
+            copy.target = {static_cast<lv_coord_t>(hor_res - 1 - area.y2), area.x1,
+                static_cast<lv_coord_t>(hor_res - 1 - area.y1), area.x2};
+            copy.first = (h - 1) * w;
+            copy.row_step = 1;
+            copy.step = -w;
+            break;
+        default:
+            break;
+    }
+    return copy;
+}
+
+} // namespace ptc
@@ -2,6 +2,8 @@
 
 #include <Arduino.h>
 #include <Wire.h>
+#include <freertos/FreeRTOS.h>
+#include <freertos/task.h>
 
 #include "pins.h"
 #include "display_driver.h"
@@ -41,13 +43,20 @@ uint16_t g_sample_y = 0;
 bool g_sample_pressed = false;
 bool g_sample_valid = false;
 bool g_suppress_until_release = false;
+bool g_reported_pressed = false;
 uint32_t g_last_sample_ms = 0;
 volatile bool g_irq_pending = true;
 volatile bool g_wake_irq_pending = false;
+TaskHandle_t g_wake_task = nullptr;
 
 void IRAM_ATTR touch_interrupt_handler() {
     g_irq_pending = true;
     g_wake_irq_pending = true;
+    if (g_wake_task) {
+        BaseType_t higher_priority_woken = pdFALSE;
+        vTaskNotifyGiveFromISR(g_wake_task, &higher_priority_woken);
+        portYIELD_FROM_ISR(higher_priority_woken);
+    }
 }
 
 bool i2c_read(uint16_t reg, uint8_t* data, size_t len) {
@@ -246,6 +255,14 @@ uint16_t map_axis(uint16_t raw, uint16_t raw_min, uint16_t raw_max, uint16_t out
     return static_cast<uint16_t>(mapped);
 }
 
+uint32_t fallback_interval_ms() {
+    return !display_driver_is_backlight_on()
+        ? kScreenOffFallbackIntervalMs
+        : g_sample_pressed
+            ? kActiveFallbackIntervalMs
+            : kIdleFallbackIntervalMs;
+}
+
 uint16_t clamp_u16(int32_t value, uint16_t max_value) {
     if (value < 0) {
         return 0;
@@ -299,6 +316,10 @@ bool touch_driver_init() {
     return detected;
 }
 
+void touch_driver_set_wake_task(TaskHandle_t task) {
+    g_wake_task = task;
+}
+
 void touch_driver_tick() {
     const uint32_t now = millis();
     const uint32_t elapsed = now - g_last_sample_ms;
@@ -306,15 +327,8 @@ void touch_driver_tick() {
         return;
     }
 
-    if (pins::kTouchInt >= 0 && !g_irq_pending) {
-        const uint32_t fallback_interval = !display_driver_is_backlight_on()
-            ? kScreenOffFallbackIntervalMs
-            : g_sample_pressed
-                ? kActiveFallbackIntervalMs
-                : kIdleFallbackIntervalMs;
-        if (elapsed < fallback_interval) {
-            return;
-        }
+    if (pins::kTouchInt >= 0 && !g_irq_pending && elapsed < fallback_interval_ms()) {
+        return;
     }
     g_irq_pending = false;
 
@@ -341,6 +355,7 @@ void touch_driver_tick() {
 void touch_driver_read(lv_indev_drv_t* drv, lv_indev_data_t* data) {
     LV_UNUSED(drv);
 
+    g_reported_pressed = false;
     if (!g_sample_valid) {
         data->state = LV_INDEV_STATE_REL;
         return;
@@ -360,7 +375,22 @@ void touch_driver_read(lv_indev_drv_t* drv, lv_indev_data_t* data) {
     data->state = pressed ? LV_INDEV_STATE_PR : LV_INDEV_STATE_REL;
     data->point.x = x;
     data->point.y = y;
+    g_reported_pressed = pressed;
+}
+
+uint32_t touch_driver_next_poll_ms() {
+    if (!g_sample_valid) {
+        return 0;
+    }
+    const uint32_t elapsed = millis() - g_last_sample_ms;
+    const uint32_t interval = pins::kTouchInt >= 0 && !g_irq_pending
+        ? fallback_interval_ms()
+        : kSampleIntervalMs;
+    return elapsed >= interval ? 0 : interval - elapsed;
+}
 
+bool touch_driver_input_active() {
+    return pins::kTouchInt < 0 || g_irq_pending || g_sample_pressed || g_reported_pressed;
 }
 
 bool touch_driver_consume_tap_event() {
@@ -1,5 +1,7 @@
 #pragma once
 
+#include <freertos/FreeRTOS.h>
+#include <freertos/task.h>
 #include <lvgl.h>
 
 #include "config.h"
@@ -7,8 +9,15 @@
 namespace ptc {
 
 bool touch_driver_init();
+// The panel IRQ sends a task notification to this task (the UI task).
+void touch_driver_set_wake_task(TaskHandle_t task);
 void touch_driver_tick();
 void touch_driver_read(lv_indev_drv_t* drv, lv_indev_data_t* data);
+// Milliseconds until touch_driver_tick() would sample the panel again.
+uint32_t touch_driver_next_poll_ms();
+// False once the last touch has been released and reported to LVGL; with an
+// IRQ line the indev read timer can then stay paused until the next IRQ.
+bool touch_driver_input_active();
 bool touch_driver_consume_tap_event();
 bool touch_driver_consume_wake_event();
 void touch_driver_prepare_for_screen_off();
@@ -5,6 +5,7 @@
 #include "pins.h"
 #include "secrets.h"
 
+#include "services/service_auth_entropy.h"
 #include "services/service_storage.h"
 #include "services/service_wifi.h"
 #include "services/service_time.h"
@@ -12,8 +13,12 @@
 #include "services/service_log.h"
 #include "services/service_http.h"
 #include "services/service_ota.h"
+#include "services/service_metrics.h"
+#include "services/service_scheduler.h"
+#include "services/service_telemetry.h"
 
 #include "ui/ui_root.h"
+#include "ui/ui_task.h"
 #include "drivers/display_driver.h"
 #include "drivers/touch_driver.h"
 
@@ -25,24 +30,95 @@ namespace {
 constexpr uint32_t kScreenOffTimeoutMs = 60000;
 constexpr uint32_t kWifiTickIntervalMs = 25;
 constexpr uint32_t kTimeTickIntervalMs = 200;
-constexpr uint32_t kHttpTickIntervalMs = 40;
+constexpr uint32_t kHttpTickIntervalMs = 100;
 constexpr uint32_t kQrTickIntervalMs = 80;
 constexpr uint32_t kLogTickIntervalMs = 120;
 constexpr uint32_t kOtaTickIntervalMs = 60;
-constexpr uint32_t kDisplayRefreshIntervalMs = 30;
-constexpr uint32_t kMaxUiSleepMs = 5;
+constexpr uint32_t kScreenIdleCheckIntervalMs = 1000;
+constexpr uint32_t kHeartbeatIntervalMs = 5000;
+constexpr uint32_t kEntropyTickIntervalMs = 1000;
 
-uint32_t g_last_input_ms = 0;
+uint32_t g_idle_hold_ms = 0;
 bool g_display_ready = false;
-uint32_t g_last_heartbeat_ms = 0;
-uint32_t g_last_wifi_tick_ms = 0;
-uint32_t g_last_time_tick_ms = 0;
-uint32_t g_last_http_tick_ms = 0;
-uint32_t g_last_qr_tick_ms = 0;
-uint32_t g_last_log_tick_ms = 0;
-uint32_t g_last_ota_tick_ms = 0;
-uint32_t g_last_display_refresh_ms = 0;
-lv_disp_t* g_display = nullptr;
+
+void tick_wifi(uint32_t now_ms) {
+    (void)now_ms;
+    ptc::service_wifi_tick(g_config, g_state);
+}
+
+void tick_ota(uint32_t now_ms) {
+    (void)now_ms;
+    ptc::service_ota_tick(g_config, g_state);
+}
+
+void tick_time(uint32_t now_ms) {
+    (void)now_ms;
+    ptc::service_time_tick(g_config, g_state);
+}
+
+void tick_http(uint32_t now_ms) {
+    (void)now_ms;
+    ptc::service_http_tick(g_config, g_state);
+}
+
+void tick_qr(uint32_t now_ms) {
+    (void)now_ms;
+    ptc::service_qr_tick(g_config, g_state);
+}
+
+void tick_log(uint32_t now_ms) {
+    (void)now_ms;
+    ptc::service_log_tick(g_config, g_state);
+}
+
+// The only producer for the nonce entropy ring. It first runs after setup,
+// once Wi-Fi is up and the hardware RNG has its noise source.
+void tick_entropy(uint32_t now_ms) {
+    (void)now_ms;
+    ptc::service_auth_entropy_refill();
+}
+
+void tick_screen_idle(uint32_t now_ms) {
+    if (ptc::service_ota_exclusive()) {
+        g_idle_hold_ms = now_ms;
+        return;
+    }
+    const uint32_t since_input_ms = min(now_ms - ptc::ui_task_last_input_ms(), now_ms - g_idle_hold_ms);
+    if (ptc::display_driver_is_backlight_on() && since_input_ms > kScreenOffTimeoutMs &&
+        ptc::ui_task_post(ptc::UiMessageType::kDisplaySleep)) {
+        g_idle_hold_ms = now_ms;
+        ptc::service_log_add("Display sleep");
+    }
+}
+
+void tick_heartbeat(uint32_t now_ms) {
+    const String tick_summary = ptc::service_metrics_serial_line(ptc::MetricsWindow::kSerial);
+    ptc::service_metrics_reset(ptc::MetricsWindow::kSerial);
+    const String heap_summary = ptc::service_telemetry_serial_line();
+    Serial.printf("[HEARTBEAT] up=%lus display=%d wifi=%d heap %s tick_us %s\n",
+        static_cast<unsigned long>(now_ms / 1000),
+        g_display_ready ? 1 : 0,
+        g_state.wifi_connected ? 1 : 0,
+        heap_summary.c_str(),
+        tick_summary.c_str());
+}
+
+void register_scheduled_tasks() {
+    // Registration order breaks ties: OTA runs before the services it can
+    // lock out, so the exclusive gate is re-evaluated after it ticks.
+    ptc::service_scheduler_set_gate(ptc::service_ota_exclusive);
+    ptc::service_scheduler_add("wifi", kWifiTickIntervalMs, tick_wifi, true);
+    ptc::service_scheduler_add("ota", kOtaTickIntervalMs, tick_ota, false, ptc::kSchedulerEventOtaResult);
+    ptc::service_scheduler_add("time", kTimeTickIntervalMs, tick_time, true);
+    ptc::service_scheduler_add("http", kHttpTickIntervalMs, tick_http, true, ptc::kSchedulerEventHttpResult);
+    ptc::service_scheduler_add("qr", kQrTickIntervalMs, tick_qr, true);
+    ptc::service_scheduler_add("log", kLogTickIntervalMs, tick_log, true);
+    ptc::service_scheduler_add("entropy", kEntropyTickIntervalMs, tick_entropy, true);
+    if (g_display_ready) {
+        ptc::service_scheduler_add("screen_idle", kScreenIdleCheckIntervalMs, tick_screen_idle, false);
+    }
+    ptc::service_scheduler_add("heartbeat", kHeartbeatIntervalMs, tick_heartbeat, false);
+}
 
 }
 
@@ -50,6 +126,7 @@ void setup() {
     Serial.begin(115200);
     delay(200);
     Serial.println("[BOOT] setup start");
+    ptc::service_telemetry_register_task(xTaskGetCurrentTaskHandle());
 
     ptc::service_storage_init();
     ptc::service_storage_load_config(g_config, g_state);
@@ -66,6 +143,7 @@ void setup() {
     Serial.println("[BOOT] LVGL init done");
 
     lv_disp_t* disp = nullptr;
+    lv_indev_t* touch_indev = nullptr;
     if (!ptc::display_driver_init(&disp)) {
         Serial.println("Display init failed");
         g_display_ready = false;
@@ -81,12 +159,11 @@ void setup() {
         lv_indev_drv_init(&indev_drv);
         indev_drv.type = LV_INDEV_TYPE_POINTER;
         indev_drv.read_cb = ptc::touch_driver_read;
-        lv_indev_drv_register(&indev_drv);
+        touch_indev = lv_indev_drv_register(&indev_drv);
         Serial.println("[BOOT] Touch input registered");
     }
 
     if (disp) {
-        g_display = disp;
         lv_disp_set_rotation(disp, g_config.display_rotation == 90
             ? LV_DISP_ROT_90
             : g_config.display_rotation == 180
@@ -98,101 +175,18 @@ void setup() {
 
     if (g_display_ready) {
         ptc::ui_root_init(g_config, g_state);
-        if (g_display && g_display->refr_timer) {
-            lv_timer_pause(g_display->refr_timer);
+        if (disp && disp->refr_timer) {
+            lv_timer_pause(disp->refr_timer);
         }
         Serial.println("[BOOT] UI root initialized");
     }
-    g_last_input_ms = millis();
-    g_last_heartbeat_ms = g_last_input_ms;
+    register_scheduled_tasks();
+    if (g_display_ready && !ptc::ui_task_start(disp, touch_indev)) {
+        g_display_ready = false;
+    }
     Serial.println("[BOOT] setup complete");
 }
 
 void loop() {
-    uint32_t now_ms = millis();
-
-    if (g_display_ready) {
-        ptc::touch_driver_tick();
-
-        const bool wake_event = ptc::touch_driver_consume_wake_event();
-        const bool tap_event = ptc::touch_driver_consume_tap_event();
-        if (!ptc::display_driver_is_backlight_on()) {
-            if (wake_event || tap_event) {
-                ptc::touch_driver_suppress_until_release();
-                ptc::display_driver_set_render_enabled(true);
-                ptc::display_driver_set_backlight(true);
-                g_last_input_ms = now_ms;
-                lv_obj_invalidate(lv_scr_act());
-                lv_refr_now(g_display);
-                ptc::service_log_add("Display wake");
-            }
-        } else if (tap_event) {
-            g_last_input_ms = now_ms;
-        }
-    }
-
-    bool ota_exclusive = ptc::service_ota_exclusive();
-    if (!ota_exclusive && now_ms - g_last_wifi_tick_ms >= kWifiTickIntervalMs) {
-        g_last_wifi_tick_ms = now_ms;
-        ptc::service_wifi_tick(g_config, g_state);
-    }
-    if (now_ms - g_last_ota_tick_ms >= kOtaTickIntervalMs) {
-        g_last_ota_tick_ms = now_ms;
-        ptc::service_ota_tick(g_config, g_state);
-    }
-    ota_exclusive = ptc::service_ota_exclusive();
-    if (!ota_exclusive) {
-        if (now_ms - g_last_time_tick_ms >= kTimeTickIntervalMs) {
-            g_last_time_tick_ms = now_ms;
-            ptc::service_time_tick(g_config, g_state);
-        }
-        if (now_ms - g_last_http_tick_ms >= kHttpTickIntervalMs) {
-            g_last_http_tick_ms = now_ms;
-            ptc::service_http_tick(g_config, g_state);
-        }
-        if (now_ms - g_last_qr_tick_ms >= kQrTickIntervalMs) {
-            g_last_qr_tick_ms = now_ms;
-            ptc::service_qr_tick(g_config, g_state);
-        }
-        if (now_ms - g_last_log_tick_ms >= kLogTickIntervalMs) {
-            g_last_log_tick_ms = now_ms;
-            ptc::service_log_tick(g_config, g_state);
-        }
-    } else {
-        g_last_input_ms = now_ms;
-    }
-
-    uint32_t sleep_ms = 1;
-    if (g_display_ready) {
-        uint32_t next = lv_timer_handler();
-        sleep_ms = next == 0 ? 1 : min(next, kMaxUiSleepMs);
-
-        if (ptc::display_driver_is_backlight_on() &&
-            now_ms - g_last_display_refresh_ms >= kDisplayRefreshIntervalMs) {
-            g_last_display_refresh_ms = now_ms;
-            lv_refr_now(g_display);
-        }
-    }
-
-    uint32_t now = now_ms;
-    if (now - g_last_heartbeat_ms > 5000) {
-        g_last_heartbeat_ms = now;
-        Serial.printf("[HEARTBEAT] up=%lus display=%d wifi=%d heap=%u\n",
-            static_cast<unsigned long>(now / 1000),
-            g_display_ready ? 1 : 0,
-            g_state.wifi_connected ? 1 : 0,
-            static_cast<unsigned int>(ESP.getFreeHeap()));
-    }
-
-    uint32_t idle_ms = millis() - g_last_input_ms;
-    if (g_display_ready && ptc::display_driver_is_backlight_on() && !ota_exclusive) {
-        if (idle_ms > kScreenOffTimeoutMs) {
-            ptc::touch_driver_prepare_for_screen_off();
-            ptc::display_driver_set_render_enabled(false);
-            ptc::display_driver_set_backlight(false);
-            ptc::service_log_add("Display sleep");
-        }
-    }
-
-    delay(sleep_ms);
+    ptc::service_scheduler_sleep(ptc::service_scheduler_run_due());
 }
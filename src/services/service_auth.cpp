@@ -1,11 +1,9 @@
 #include "service_auth.h"
 
-#include <esp_system.h>
-#include <mbedtls/base64.h>
 #include <mbedtls/md.h>
 #include <mbedtls/sha256.h>
 
-#include <vector>
+#include "service_auth_entropy.h"
 
 namespace ptc {
 
@@ -45,27 +43,210 @@ emyPxgcYxn/eR44/KJ4EBs+lVDR3veyJm+kXQ99b21/+jh5Xos1AnX5iItreGCc=
 -----END CERTIFICATE-----
 )PEM";
 
+constexpr char kBase64UrlAlphabet[] =
+    "ABCDEFGHIJKLMNOPQRSTUVWXYZabcdefghijklmnopqrstuvwxyz0123456789-_";
+// Character -> 6-bit value; 0xFF for anything outside the alphabet, so one
+// test of the high bit over a group of four rejects it.
+constexpr uint8_t kBase64UrlValues[256] = {
+    0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF,
+    0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF,
+    0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0x3E, 0xFF, 0xFF,
+    0x34, 0x35, 0x36, 0x37, 0x38, 0x39, 0x3A, 0x3B, 0x3C, 0x3D, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF,
+    0xFF, 0x00, 0x01, 0x02, 0x03, 0x04, 0x05, 0x06, 0x07, 0x08, 0x09, 0x0A, 0x0B, 0x0C, 0x0D, 0x0E,
+    0x0F, 0x10, 0x11, 0x12, 0x13, 0x14, 0x15, 0x16, 0x17, 0x18, 0x19, 0xFF, 0xFF, 0xFF, 0xFF, 0x3F,
+    0xFF, 0x1A, 0x1B, 0x1C, 0x1D, 0x1E, 0x1F, 0x20, 0x21, 0x22, 0x23, 0x24, 0x25, 0x26, 0x27, 0x28,
+    0x29, 0x2A, 0x2B, 0x2C, 0x2D, 0x2E, 0x2F, 0x30, 0x31, 0x32, 0x33, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF,
+    0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF,
+    0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF,
+    0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF,
+    0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF,
+    0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF,
+    0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF,
+    0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF,
+    0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF,
+};
+constexpr char kHexDigits[] = "0123456789abcdef";
+
+// Four alphabet characters for the 24 bits in the low bytes of bits, packed
+// for one 32-bit store (little-endian, as on Xtensa and x86).
+static_assert(__BYTE_ORDER__ == __ORDER_LITTLE_ENDIAN__, "base64url_word packs characters for a little-endian store");
+uint32_t base64url_word(uint32_t bits) {
+    return static_cast<uint32_t>(kBase64UrlAlphabet[(bits >> 18) & 0x3F]) |
+        static_cast<uint32_t>(kBase64UrlAlphabet[(bits >> 12) & 0x3F]) << 8 |
+        static_cast<uint32_t>(kBase64UrlAlphabet[(bits >> 6) & 0x3F]) << 16 |
+        static_cast<uint32_t>(kBase64UrlAlphabet[bits & 0x3F]) << 24;
+}
+
 } // namespace
 
-String service_auth_base64url_encode(const uint8_t* data, size_t length) {
-    size_t output_length = 0;
-    std::vector<uint8_t> output(((length + 2) / 3) * 4 + 1);
-    if (mbedtls_base64_encode(
-            output.data(), output.size(), &output_length, data, length) != 0) {
-        return "";
+size_t service_auth_base64url_encode(const uint8_t* data, size_t length, char* out, size_t out_size) {
+    const size_t encoded_length = service_auth_base64url_length(length);
+    if (out_size <= encoded_length) {
+        return 0;
+    }
+    char* cursor = out;
+    size_t i = 0;
+    for (; i + 3 <= length; i += 3) {
+        const uint32_t word = base64url_word(data[i] << 16 | data[i + 1] << 8 | data[i + 2]);
+        memcpy(cursor, &word, sizeof(word));
+        cursor += 4;
+    }
+    if (i < length) {
+        const uint32_t bits = data[i] << 16 | (i + 1 < length ? data[i + 1] << 8 : 0);
+        *cursor++ = kBase64UrlAlphabet[(bits >> 18) & 0x3F];
+        *cursor++ = kBase64UrlAlphabet[(bits >> 12) & 0x3F];
+        if (i + 1 < length) {
+            *cursor++ = kBase64UrlAlphabet[(bits >> 6) & 0x3F];
+        }
+    }
+    *cursor = '\0';
+    return encoded_length;
+}
+
+int service_auth_base64url_decode(const char* text, size_t length, uint8_t* out, size_t out_size) {
+    // Padding carries nothing in base64url but is accepted.
+    if (length > 0 && length % 4 == 0 && text[length - 1] == '=') {
+        length -= text[length - 2] == '=' ? 2 : 1;
+    }
+    if (length % 4 == 1) {
+        return -1;
     }
+    const size_t decoded_length = length / 4 * 3 + (length % 4 ? length % 4 - 1 : 0);
+    if (decoded_length > out_size) {
+        return -1;
+    }
+    const auto* in = reinterpret_cast<const uint8_t*>(text);
+    uint8_t* cursor = out;
+    size_t i = 0;
+    for (; i + 4 <= length; i += 4) {
+        const uint32_t a = kBase64UrlValues[in[i]];
+        const uint32_t b = kBase64UrlValues[in[i + 1]];
+        const uint32_t c = kBase64UrlValues[in[i + 2]];
+        const uint32_t d = kBase64UrlValues[in[i + 3]];
+        if ((a | b | c | d) & 0x80) {
+            return -1;
+        }
+        const uint32_t bits = a << 18 | b << 12 | c << 6 | d;
+        *cursor++ = static_cast<uint8_t>(bits >> 16);
+        *cursor++ = static_cast<uint8_t>(bits >> 8);
+        *cursor++ = static_cast<uint8_t>(bits);
+    }
+    if (i < length) {
+        const uint32_t a = kBase64UrlValues[in[i]];
+        const uint32_t b = kBase64UrlValues[in[i + 1]];
+        const uint32_t c = i + 2 < length ? kBase64UrlValues[in[i + 2]] : 0;
+        // The bits past the last whole byte must be zero, or the text is not
+        // what encoding any input would give.
+        const uint32_t spare = i + 2 < length ? c & 0x03 : b & 0x0F;
+        if ((a | b | c) & 0x80 || spare != 0) {
+            return -1;
+        }
+        const uint32_t bits = a << 18 | b << 12 | c << 6;
+        *cursor++ = static_cast<uint8_t>(bits >> 16);
+        if (i + 2 < length) {
+            *cursor++ = static_cast<uint8_t>(bits >> 8);
+        }
+    }
+    return static_cast<int>(decoded_length);
+}
+
+HmacSigner::HmacSigner() {
+    mbedtls_sha256_init(&inner_);
+    mbedtls_sha256_init(&outer_);
+    mbedtls_sha256_init(&message_);
+}
 
-    String encoded(reinterpret_cast<char*>(output.data()), output_length);
-    encoded.replace("+", "-");
-    encoded.replace("/", "_");
-    encoded.replace("=", "");
-    return encoded;
+HmacSigner::~HmacSigner() {
+    // The pad states are as good as the key; do not leave them in RAM.
+    mbedtls_sha256_free(&inner_);
+    mbedtls_sha256_free(&outer_);
+    mbedtls_sha256_free(&message_);
 }
 
-String service_auth_random_nonce(size_t byte_count) {
-    std::vector<uint8_t> bytes(byte_count);
-    esp_fill_random(bytes.data(), bytes.size());
-    return service_auth_base64url_encode(bytes.data(), bytes.size());
+void HmacSigner::set_key(const String& secret) {
+    if (keyed_ && key_ == secret) {
+        return;
+    }
+    uint8_t block[64] = {0};
+    if (secret.length() > sizeof(block)) {
+        mbedtls_sha256_ret(reinterpret_cast<const uint8_t*>(secret.c_str()), secret.length(), block, 0);
+    } else {
+        memcpy(block, secret.c_str(), secret.length());
+    }
+    uint8_t pad[64];
+    for (size_t i = 0; i < sizeof(pad); ++i) {
+        pad[i] = block[i] ^ 0x36;
+    }
+    mbedtls_sha256_starts_ret(&inner_, 0);
+    mbedtls_sha256_update_ret(&inner_, pad, sizeof(pad));
+    for (size_t i = 0; i < sizeof(pad); ++i) {
+        pad[i] = block[i] ^ 0x5C;
+    }
+    mbedtls_sha256_starts_ret(&outer_, 0);
+    mbedtls_sha256_update_ret(&outer_, pad, sizeof(pad));
+    memset(block, 0, sizeof(block));
+    memset(pad, 0, sizeof(pad));
+    key_ = secret;
+    keyed_ = true;
+}
+
+void HmacSigner::begin() {
+    mbedtls_sha256_clone(&message_, &inner_);
+}
+
+void HmacSigner::update(const uint8_t* data, size_t length) {
+    mbedtls_sha256_update_ret(&message_, data, length);
+}
+
+void HmacSigner::update(const char* text) {
+    update(reinterpret_cast<const uint8_t*>(text), strlen(text));
+}
+
+bool HmacSigner::finish(char* out, size_t out_size) {
+    uint8_t digest[32];
+    mbedtls_sha256_finish_ret(&message_, digest);
+    mbedtls_sha256_clone(&message_, &outer_);
+    mbedtls_sha256_update_ret(&message_, digest, sizeof(digest));
+    mbedtls_sha256_finish_ret(&message_, digest);
+    return keyed_ && service_auth_base64url_encode(digest, sizeof(digest), out, out_size) == kSignatureLength;
+}
+
+bool HmacSigner::sign_request(
+    const char* method,
+    const String& path_and_query,
+    const char* timestamp,
+    const char* nonce,
+    const String& body,
+    char* out,
+    size_t out_size) {
+    uint8_t digest[32];
+    mbedtls_sha256_ret(reinterpret_cast<const uint8_t*>(body.c_str()), body.length(), digest, 0);
+    char body_hash[64];
+    for (size_t i = 0; i < sizeof(digest); ++i) {
+        body_hash[i * 2] = kHexDigits[digest[i] >> 4];
+        body_hash[i * 2 + 1] = kHexDigits[digest[i] & 0x0F];
+    }
+
+    begin();
+    update(method);
+    update("\n");
+    update(path_and_query);
+    update("\n");
+    update(timestamp);
+    update("\n");
+    update(nonce);
+    update("\n");
+    update(reinterpret_cast<const uint8_t*>(body_hash), sizeof(body_hash));
+    return finish(out, out_size);
+}
+
+size_t service_auth_format_nonce(char* out, size_t out_size, size_t byte_count) {
+    if (byte_count > kEntropySlotBytes || out_size <= service_auth_base64url_length(byte_count)) {
+        return 0;
+    }
+    uint8_t bytes[kEntropySlotBytes];
+    service_auth_entropy_take(bytes, byte_count);
+    return service_auth_base64url_encode(bytes, byte_count, out, out_size);
 }
 
 String service_auth_sha256_hex(const String& value) {
@@ -73,11 +254,10 @@ String service_auth_sha256_hex(const String& value) {
     mbedtls_sha256_ret(
         reinterpret_cast<const uint8_t*>(value.c_str()), value.length(), digest, 0);
 
-    static constexpr char kHex[] = "0123456789abcdef";
     char encoded[65] = {0};
     for (size_t i = 0; i < sizeof(digest); ++i) {
-        encoded[i * 2] = kHex[digest[i] >> 4];
-        encoded[i * 2 + 1] = kHex[digest[i] & 0x0F];
+        encoded[i * 2] = kHexDigits[digest[i] >> 4];
+        encoded[i * 2 + 1] = kHexDigits[digest[i] & 0x0F];
     }
     return String(encoded);
 }
@@ -101,7 +281,9 @@ String service_auth_hmac_sha256_base64url(const String& secret, const String& ma
         material.length());
     mbedtls_md_hmac_finish(&context, digest);
     mbedtls_md_free(&context);
-    return service_auth_base64url_encode(digest, sizeof(digest));
+    char encoded[kSignatureLength + 1];
+    service_auth_base64url_encode(digest, sizeof(digest), encoded, sizeof(encoded));
+    return String(encoded);
 }
 
 String service_auth_request_signature(
@@ -1,11 +1,75 @@
 #pragma once
 
 #include <Arduino.h>
+#include <mbedtls/sha256.h>
 
 namespace ptc {
 
-String service_auth_base64url_encode(const uint8_t* data, size_t length);
-String service_auth_random_nonce(size_t byte_count = 16);
+// base64url of an HMAC-SHA256 digest, unpadded.
+constexpr size_t kSignatureLength = 43;
+// base64url of a 16-byte request nonce, unpadded.
+constexpr size_t kNonceLength = 22;
+
+// HMAC-SHA256 with the key schedule kept between calls: the SHA-256 states
+// after the inner and outer key pads are computed once per secret and copied
+// for each message, which is streamed in without building a String. Signing
+// takes no heap. Not shared between tasks; each caller keeps its own.
+class HmacSigner {
+public:
+    HmacSigner();
+    ~HmacSigner();
+    HmacSigner(const HmacSigner&) = delete;
+    HmacSigner& operator=(const HmacSigner&) = delete;
+
+    // Re-keys only when secret differs from the current key.
+    void set_key(const String& secret);
+    bool has_key() const {
+        return keyed_;
+    }
+
+    void begin();
+    void update(const uint8_t* data, size_t length);
+    void update(const char* text);
+    void update(const String& text) {
+        update(reinterpret_cast<const uint8_t*>(text.c_str()), text.length());
+    }
+    // Writes the signature and a terminating NUL; out_size must be at least
+    // kSignatureLength + 1.
+    bool finish(char* out, size_t out_size);
+
+    // <METHOD>\n<path and query>\n<timestamp>\n<nonce>\n<sha256 hex of body>
+    bool sign_request(
+        const char* method,
+        const String& path_and_query,
+        const char* timestamp,
+        const char* nonce,
+        const String& body,
+        char* out,
+        size_t out_size);
+
+private:
+    mbedtls_sha256_context inner_;
+    mbedtls_sha256_context outer_;
+    mbedtls_sha256_context message_;
+    String key_;
+    bool keyed_ = false;
+};
+
+// Unpadded base64url straight into caller buffers, without the heap.
+constexpr size_t service_auth_base64url_length(size_t byte_count) {
+    return (byte_count * 4 + 2) / 3;
+}
+// Writes the text and a terminating NUL. Returns its length, or 0 (leaving
+// out untouched) when out_size is not above service_auth_base64url_length().
+size_t service_auth_base64url_encode(const uint8_t* data, size_t length, char* out, size_t out_size);
+// Trailing '=' padding is accepted. Returns the bytes written, or -1 for a
+// character outside the alphabet, an impossible length, non-zero bits after
+// the last byte, or an out too small for the result.
+int service_auth_base64url_decode(const char* text, size_t length, uint8_t* out, size_t out_size);
+// byte_count random bytes from the entropy ring as unpadded base64url in
+// out, NUL-terminated. Returns the length, or 0 when out is too small or
+// byte_count exceeds kEntropySlotBytes. Takes no heap.
+size_t service_auth_format_nonce(char* out, size_t out_size, size_t byte_count = 16);
 String service_auth_sha256_hex(const String& value);
 String service_auth_hmac_sha256_base64url(const String& secret, const String& material);
 String service_auth_request_signature(
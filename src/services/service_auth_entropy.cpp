@@ -0,0 +1,69 @@
+#include "service_auth_entropy.h"
+
+#include <esp_system.h>
+
+#include <atomic>
+
+namespace ptc {
+
+namespace {
+
+constexpr uint32_t kSlotMask = kEntropySlots - 1;
+static_assert((kEntropySlots & kSlotMask) == 0, "kEntropySlots must be a power of two");
+
+uint8_t g_slots[kEntropySlots][kEntropySlotBytes];
+// Free-running; head - tail is the number of filled slots.
+std::atomic<uint32_t> g_head{0};
+std::atomic<uint32_t> g_tail{0};
+std::atomic<uint32_t> g_taken{0};
+std::atomic<uint32_t> g_fallbacks{0};
+std::atomic<uint32_t> g_refilled{0};
+
+} // namespace
+
+uint8_t service_auth_entropy_refill(uint8_t max_slots) {
+    uint8_t written = 0;
+    uint32_t head = g_head.load(std::memory_order_relaxed);
+    while (written < max_slots && head - g_tail.load(std::memory_order_acquire) < kEntropySlots) {
+        esp_fill_random(g_slots[head & kSlotMask], kEntropySlotBytes);
+        g_head.store(++head, std::memory_order_release);
+        written++;
+    }
+    g_refilled.fetch_add(written, std::memory_order_relaxed);
+    return written;
+}
+
+void service_auth_entropy_take(uint8_t* out, size_t length) {
+    length = min(length, kEntropySlotBytes);
+    uint32_t tail = g_tail.load(std::memory_order_acquire);
+    for (;;) {
+        if (tail == g_head.load(std::memory_order_acquire)) {
+            esp_fill_random(out, length);
+            g_fallbacks.fetch_add(1, std::memory_order_relaxed);
+            return;
+        }
+        // Copy first, then claim: the producer cannot reuse the slot until
+        // the tail has passed it, and a copy raced by another taker fails
+        // the exchange and is thrown away.
+        memcpy(out, g_slots[tail & kSlotMask], length);
+        if (g_tail.compare_exchange_weak(tail, tail + 1, std::memory_order_acq_rel, std::memory_order_acquire)) {
+            g_taken.fetch_add(1, std::memory_order_relaxed);
+            return;
+        }
+    }
+}
+
+uint8_t service_auth_entropy_level() {
+    // Tail first: it never passes a head read after it.
+    const uint32_t tail = g_tail.load(std::memory_order_acquire);
+    return static_cast<uint8_t>(g_head.load(std::memory_order_acquire) - tail);
+}
+
+void service_auth_entropy_stats(EntropyStats& out_stats) {
+    out_stats.taken = g_taken.load(std::memory_order_relaxed);
+    out_stats.fallbacks = g_fallbacks.load(std::memory_order_relaxed);
+    out_stats.refilled = g_refilled.load(std::memory_order_relaxed);
+    out_stats.level = service_auth_entropy_level();
+}
+
+} // namespace ptc
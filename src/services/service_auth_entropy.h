@@ -0,0 +1,31 @@
+#pragma once
+
+#include <Arduino.h>
+
+namespace ptc {
+
+// Random bytes drawn ahead of time, so a nonce costs a copy rather than an
+// RNG read and an allocation. One producer, the loop task's "entropy" tick,
+// tops up fixed slots between other work. Any task takes a whole slot by
+// moving the read index with a compare-and-swap, so the ring has no lock.
+// An empty ring falls back to esp_fill_random().
+static constexpr size_t kEntropySlotBytes = 16;
+// A power of two, so indices wrap with a mask.
+static constexpr uint8_t kEntropySlots = 32;
+
+struct EntropyStats {
+    uint32_t taken = 0;
+    uint32_t fallbacks = 0;
+    uint32_t refilled = 0;
+    uint8_t level = 0;
+};
+
+// Producer side; call from one task only. Fills up to max_slots free slots
+// and returns how many it wrote.
+uint8_t service_auth_entropy_refill(uint8_t max_slots = kEntropySlots);
+// Copies length random bytes (at most kEntropySlotBytes) out of one slot.
+void service_auth_entropy_take(uint8_t* out, size_t length);
+uint8_t service_auth_entropy_level();
+void service_auth_entropy_stats(EntropyStats& out_stats);
+
+} // namespace ptc
@@ -12,9 +12,18 @@
 
 #include "secrets.h"
 #include "service_auth.h"
+#include "service_http_breaker.h"
+#include "service_http_inflate.h"
+#include "service_http_queue.h"
+#include "service_http_stream.h"
+#include "service_http_timing.h"
 #include "service_log.h"
+#include "service_metrics.h"
+#include "service_outbox.h"
 #include "service_qr.h"
+#include "service_scheduler.h"
 #include "service_storage.h"
+#include "service_telemetry.h"
 #include "service_time.h"
 #include "service_wifi.h"
 
@@ -22,14 +31,41 @@ namespace ptc {
 
 namespace {
 
+// Declared in priority order: the worker serves lower values first.
 enum class RequestKind : uint8_t {
     kNone,
     kRegister,
+    kManualCode,
     kConfig,
+    kSync,
     kHeartbeat,
-    kNotices,
     kActivity,
-    kManualCode,
+    kNotices,
+    kOutbox,
+};
+constexpr uint8_t kRequestKindCount = 9;
+static_assert(kRequestKindCount - 1 <= kHttpQueueSlots, "every request kind but kNone needs its own queue slot");
+
+// Sections present in a sync response; the portal leaves out the ones that
+// did not change since the revisions the device sent.
+constexpr uint8_t kSyncConfig = 1 << 0;
+constexpr uint8_t kSyncNotices = 1 << 1;
+constexpr uint8_t kSyncActivity = 1 << 2;
+
+// One activity response. The paged form is an object with "events",
+// "next_cursor" and "has_more"; a bare array is the older since= form. A
+// cursor always names the same leading events, so a page cut short is
+// resumed by skipping the elements already applied rather than by looking
+// every event up in the log.
+struct ActivityPage {
+    uint16_t skip = 0;
+    bool check_ids = true;
+    // Elements read, including the skipped ones.
+    uint16_t seen = 0;
+    uint16_t accepted = 0;
+    bool paged = false;
+    bool more = false;
+    String next_cursor;
 };
 
 struct ServiceRequest {
@@ -41,7 +77,12 @@ struct ServiceRequest {
     String device_id;
     String device_secret;
     String correlation;
+    // Sent as If-None-Match; the portal answers 304 when it still matches.
+    String if_none_match;
     bool signed_request = true;
+    // Activity and sync: where to resume the page at the request's cursor.
+    uint16_t activity_skip = 0;
+    bool activity_check_ids = true;
 };
 
 struct ServiceResult {
@@ -50,13 +91,48 @@ struct ServiceResult {
     String body;
     String error;
     String correlation;
+    String etag;
+    // Notices and activity are parsed off the connection by the worker, so
+    // they leave body empty: notices arrive here, activity is applied as it
+    // streams in and only counted.
+    std::vector<Notice> notices;
+    ActivityPage activity;
+    bool body_valid = true;
+    // Streamed bodies: bytes on the wire and after inflating.
+    uint32_t wire_bytes = 0;
+    uint32_t decoded_bytes = 0;
+    // Sync only: body holds the config section and etag its validator.
+    uint8_t sync_sections = 0;
+    String notices_etag;
+    bool reused_connection = false;
+    bool superseded = false;
+    // Retry-After in seconds, 0 when the portal did not send one.
+    uint32_t retry_after_sec = 0;
+    uint32_t started_ms = 0;
+    uint32_t elapsed_ms = 0;
+    uint32_t queued_ms = 0;
+    HttpPhases phases;
+};
+
+enum class BodyRead : uint8_t {
+    kOk,
+    kInvalid,
+    kPreempted,
 };
 
 std::vector<Notice> g_notices;
-QueueHandle_t g_request_queue = nullptr;
+HttpQueue g_work_queue;
 QueueHandle_t g_result_queue = nullptr;
-bool g_request_in_progress = false;
-RequestKind g_active_request = RequestKind::kNone;
+TaskHandle_t g_worker_task = nullptr;
+HttpConnectionStats g_connection_stats;
+// Requests accepted per kind whose result the loop has not applied yet; the
+// worker answers every request it dequeues exactly once.
+uint8_t g_outstanding[kRequestKindCount] = {};
+HttpBreaker g_breakers[kRequestKindCount];
+// The outbox batch in flight; acknowledged by the offsets it was read from.
+OutboxBatch g_outbox_batch;
+String g_manual_queued_payload;
+String g_notices_etag;
 
 uint32_t g_last_config_ms = 0;
 uint32_t g_last_notice_ms = 0;
@@ -65,6 +141,14 @@ uint32_t g_last_activity_ms = 0;
 uint32_t g_activity_interval_ms = 30000;
 uint32_t g_last_notice_ts = 0;
 uint32_t g_last_activity_ts = 0;
+// Paged activity: the cursor after the last complete page, elements of the
+// next page already applied, and whether the portal has more waiting.
+String g_activity_cursor;
+uint16_t g_activity_skip = 0;
+bool g_activity_more = false;
+// A cursor restored from the card may point at a page that was partly
+// applied before a reset, so that page is checked against the log by id.
+bool g_activity_check_ids = true;
 bool g_initial_config_complete = false;
 bool g_force_notice = false;
 
@@ -78,19 +162,26 @@ String g_last_error;
 bool g_scheduler_diagnostic_printed = false;
 uint32_t g_retry_started_ms = 0;
 uint32_t g_retry_delay_ms = 0;
-uint32_t g_failure_backoff_ms = 5000;
 
 uint32_t g_last_registration_attempt_ms = 0;
 uint32_t g_registration_retry_ms = 5000;
 
 constexpr uint32_t kConfigIntervalMs = 300000;
+constexpr uint32_t kConnectTimeoutMs = 5000;
 constexpr uint32_t kNoticeIntervalMs = 180000;
 constexpr size_t kMaxCachedNotices = 16;
+// Per array element, after the filters below drop unknown fields.
+constexpr size_t kNoticeDocumentBytes = 4096;
+constexpr size_t kActivityDocumentBytes = 512;
+constexpr size_t kActivityCursorMaxLength = 256;
 constexpr uint32_t kHeartbeatIntervalMs = 60000;
 constexpr uint32_t kActivityIntervalMs = 30000;
 constexpr uint32_t kActivityUnavailableIntervalMs = 300000;
 constexpr uint32_t kRegistrationRetryMaxMs = 60000;
-constexpr uint32_t kFailureBackoffMaxMs = 300000;
+// A portal without the events route is asked again this much later.
+constexpr uint32_t kOutboxUnavailableMs = 1800000;
+// Endpoints with a breaker, in RequestKind order after registration.
+constexpr RequestKind kFirstBreakerKind = RequestKind::kManualCode;
 
 const char* request_name(RequestKind kind) {
     switch (kind) {
@@ -98,6 +189,8 @@ const char* request_name(RequestKind kind) {
             return "register";
         case RequestKind::kConfig:
             return "config";
+        case RequestKind::kSync:
+            return "sync";
         case RequestKind::kHeartbeat:
             return "heartbeat";
         case RequestKind::kNotices:
@@ -106,6 +199,8 @@ const char* request_name(RequestKind kind) {
             return "activity";
         case RequestKind::kManualCode:
             return "manual-code";
+        case RequestKind::kOutbox:
+            return "outbox";
         default:
             return "request";
     }
@@ -171,10 +266,395 @@ void clear_manual_code() {
     g_manual_code_expires_at = 0;
 }
 
+uint8_t queue_slot(RequestKind kind) {
+    return static_cast<uint8_t>(kind) - 1;
+}
+
+// Bulk downloads that are safe to repeat give way to requests a person is
+// waiting on (the manual code, or registration during setup).
+bool preemptible(RequestKind kind) {
+    return kind == RequestKind::kNotices || kind == RequestKind::kActivity || kind == RequestKind::kSync;
+}
+
+bool urgent_request_waiting() {
+    return service_http_queue_urgent(g_work_queue, queue_slot(RequestKind::kManualCode));
+}
+
+String normalize_activity_action(const String& raw_action) {
+    String action = raw_action;
+    action.toLowerCase();
+    action.replace("_", " ");
+    action.trim();
+    if (action == "in" || action == "clock in" || action == "check in") {
+        return "clocked in";
+    }
+    if (action == "out" || action == "clock out" || action == "check out") {
+        return "clocked out";
+    }
+    return action;
+}
+
+// Reads the notices array one element at a time and keeps the first
+// kMaxCachedNotices; later elements are parsed past without being stored.
+BodyRead read_notices(Stream& body, std::vector<Notice>& out_notices, bool may_preempt) {
+    StaticJsonDocument<JSON_OBJECT_SIZE(9)> filter;
+    for (const char* key : {"id", "title", "body", "image_url", "hyperlink_url", "display_seconds",
+             "sort_order", "created_at", "updated_at"}) {
+        filter[key] = true;
+    }
+    StaticJsonDocument<16> skip;
+    DynamicJsonDocument item(kNoticeDocumentBytes);
+    JsonArrayReader reader(body);
+    out_notices.clear();
+    while (true) {
+        if (may_preempt && urgent_request_waiting()) {
+            return BodyRead::kPreempted;
+        }
+        const bool keep = out_notices.size() < kMaxCachedNotices;
+        const JsonArrayStep step = keep ? reader.next(item, filter) : reader.next(item, skip);
+        if (step == JsonArrayStep::kEnd) {
+            return BodyRead::kOk;
+        }
+        if (step == JsonArrayStep::kError) {
+            return BodyRead::kInvalid;
+        }
+        if (!keep) {
+            continue;
+        }
+        Notice notice;
+        notice.id = String(item["id"] | "");
+        notice.title = String(item["title"] | "");
+        notice.body = String(item["body"] | "");
+        notice.image_url = String(item["image_url"] | "");
+        notice.hyperlink_url = String(item["hyperlink_url"] | "");
+        notice.display_seconds = item["display_seconds"] | 6;
+        notice.sort_order = item["sort_order"] | 0;
+        notice.created_at = String(item["created_at"] | "");
+        notice.updated_at = String(item["updated_at"] | "");
+        out_notices.push_back(notice);
+    }
+}
+
+bool apply_activity_item(JsonObject item, bool check_ids) {
+    const String event_id = String(item["id"] | "");
+    String user = String(item["user_name"] | "");
+    if (user.isEmpty()) {
+        user = String(item["employee_name"] | "");
+    }
+    if (user.isEmpty()) {
+        user = String(item["user"] | "");
+    }
+
+    String action = String(item["action"] | "");
+    if (action.isEmpty()) {
+        action = String(item["punch_type"] | "");
+    }
+    if (action.isEmpty()) {
+        action = String(item["event_type"] | "");
+    }
+    action = normalize_activity_action(action);
+
+    uint32_t timestamp = item["timestamp"] | 0;
+    if (timestamp == 0) {
+        const char* occurred_at = item["occurred_at"] | "";
+        if (!occurred_at[0]) {
+            occurred_at = item["created_at"] | "";
+        }
+        timestamp = parse_iso_timestamp(occurred_at);
+    }
+    if (user.isEmpty() || timestamp == 0 ||
+        (action != "clocked in" && action != "clocked out")) {
+        return false;
+    }
+
+    if (check_ids) {
+        service_log_add_activity(user, action, timestamp, event_id);
+    } else {
+        service_log_append_activity(user, action, timestamp, event_id);
+    }
+    g_last_activity_ts = max(g_last_activity_ts, timestamp);
+    return true;
+}
+
+// Applies each activity event as soon as its array element is parsed, so any
+// number of events fits in one small document. The worker passes locked to
+// take the scheduler lock around each event, since the log belongs to the
+// loop; events applied before a preemption or a parse error stay applied,
+// and page.seen tells the next request for the page how many to skip.
+BodyRead read_activity_events(Stream& body, ActivityPage& page, bool may_preempt, bool locked) {
+    StaticJsonDocument<JSON_OBJECT_SIZE(10)> filter;
+    for (const char* key : {"id", "user_name", "employee_name", "user", "action", "punch_type",
+             "event_type", "timestamp", "occurred_at", "created_at"}) {
+        filter[key] = true;
+    }
+    StaticJsonDocument<kActivityDocumentBytes> item;
+    JsonArrayReader reader(body);
+    while (true) {
+        if (may_preempt && urgent_request_waiting()) {
+            return BodyRead::kPreempted;
+        }
+        const JsonArrayStep step = reader.next(item, filter);
+        if (step == JsonArrayStep::kEnd) {
+            return BodyRead::kOk;
+        }
+        if (step == JsonArrayStep::kError) {
+            return BodyRead::kInvalid;
+        }
+        if (++page.seen <= page.skip) {
+            continue;
+        }
+        if (locked && !service_scheduler_lock(kSchedulerNoDeadline)) {
+            page.seen--;
+            return BodyRead::kInvalid;
+        }
+        if (apply_activity_item(item.as<JsonObject>(), page.check_ids)) {
+            page.accepted++;
+        }
+        if (locked) {
+            service_scheduler_unlock();
+        }
+    }
+}
+
+BodyRead read_activity(Stream& body, ActivityPage& page, bool may_preempt, bool locked) {
+    if (json_peek(body) == '[') {
+        // Positions mean nothing in a since= answer: the log drops repeats.
+        page.skip = 0;
+        page.check_ids = true;
+        return read_activity_events(body, page, may_preempt, locked);
+    }
+    page.paged = true;
+    JsonObjectReader reader(body);
+    String key;
+    while (true) {
+        const JsonArrayStep step = reader.next_key(key);
+        if (step == JsonArrayStep::kEnd) {
+            return BodyRead::kOk;
+        }
+        if (step == JsonArrayStep::kError) {
+            return BodyRead::kInvalid;
+        }
+        BodyRead outcome = BodyRead::kOk;
+        if (key == "events") {
+            outcome = read_activity_events(body, page, may_preempt, locked);
+        } else if (key == "next_cursor" && json_peek(body) == 'n') {
+            // null on the last page, read the same as no cursor.
+            String value;
+            outcome = reader.read_scalar(value) && value == "null" ? BodyRead::kOk : BodyRead::kInvalid;
+        } else if (key == "next_cursor") {
+            outcome = reader.read_string(page.next_cursor, kActivityCursorMaxLength)
+                ? BodyRead::kOk
+                : BodyRead::kInvalid;
+        } else if (key == "has_more") {
+            String value;
+            outcome = reader.read_scalar(value) ? BodyRead::kOk : BodyRead::kInvalid;
+            page.more = value == "true";
+        } else if (!reader.skip_value()) {
+            outcome = BodyRead::kInvalid;
+        }
+        if (outcome != BodyRead::kOk) {
+            return outcome;
+        }
+    }
+}
+
+// Reads a sync response member by member. Notices and activity stream in
+// exactly as from their own endpoints; the config section is kept as JSON in
+// result.body for apply_config_result().
+BodyRead read_sync(Stream& body, ServiceResult& result) {
+    JsonObjectReader reader(body);
+    String key;
+    while (true) {
+        const JsonArrayStep step = reader.next_key(key);
+        if (step == JsonArrayStep::kEnd) {
+            return BodyRead::kOk;
+        }
+        if (step == JsonArrayStep::kError) {
+            return BodyRead::kInvalid;
+        }
+        BodyRead outcome = BodyRead::kOk;
+        if (key == "config") {
+            StaticJsonDocument<768> section;
+            if (deserializeJson(section, body) != DeserializationError::Ok || !section.is<JsonObject>()) {
+                return BodyRead::kInvalid;
+            }
+            result.body = "";
+            serializeJson(section, result.body);
+            result.sync_sections |= kSyncConfig;
+        } else if (key == "config_etag") {
+            outcome = reader.read_string(result.etag) ? BodyRead::kOk : BodyRead::kInvalid;
+        } else if (key == "notices_etag") {
+            outcome = reader.read_string(result.notices_etag) ? BodyRead::kOk : BodyRead::kInvalid;
+        } else if (key == "notices") {
+            outcome = read_notices(body, result.notices, true);
+            if (outcome == BodyRead::kOk) {
+                result.sync_sections |= kSyncNotices;
+            }
+        } else if (key == "activity") {
+            outcome = read_activity(body, result.activity, true, true);
+            if (outcome == BodyRead::kOk) {
+                result.sync_sections |= kSyncActivity;
+            }
+        } else if (!reader.skip_value()) {
+            outcome = BodyRead::kInvalid;
+        }
+        if (outcome != BodyRead::kOk) {
+            return outcome;
+        }
+    }
+}
+
+BodyRead read_streamed_body(Stream& body, RequestKind kind, ServiceResult& result) {
+    if (kind == RequestKind::kNotices) {
+        return read_notices(body, result.notices, true);
+    }
+    if (kind == RequestKind::kActivity) {
+        return read_activity(body, result.activity, true, true);
+    }
+    return read_sync(body, result);
+}
+
+// A kept-alive socket the portal has since closed fails on send or before
+// any response byte, so the request never reached the server.
+bool stale_connection_error(int status_code) {
+    return status_code == HTTPC_ERROR_SEND_HEADER_FAILED ||
+        status_code == HTTPC_ERROR_SEND_PAYLOAD_FAILED ||
+        status_code == HTTPC_ERROR_NOT_CONNECTED ||
+        status_code == HTTPC_ERROR_CONNECTION_LOST;
+}
+
+// Returns false when the body download was preempted.
+bool send_request(WiFiClientSecure& client, HTTPClient& http, HmacSigner& signer, const ServiceRequest& request,
+    ServiceResult& result) {
+    const String url = request.base_url + request.path_and_query;
+    result.phases = HttpPhases();
+    if (!client.connected() && !service_http_timing_connect(client, url, kConnectTimeoutMs, result.phases)) {
+        client.stop();
+        result.status_code = HTTPC_ERROR_CONNECTION_REFUSED;
+        result.error = result.phases.dns_failed ? "DNS lookup failed" : "Connection failed";
+        return true;
+    }
+    if (!http.begin(client, url)) {
+        result.status_code = 0;
+        result.error = "HTTP begin failed";
+        return true;
+    }
+    if (request.signed_request) {
+        char timestamp[12];
+        snprintf(timestamp, sizeof(timestamp), "%lu", static_cast<unsigned long>(time(nullptr)));
+        char nonce[kNonceLength + 1];
+        service_auth_format_nonce(nonce, sizeof(nonce));
+        char signature[kSignatureLength + 1];
+        signer.set_key(request.device_secret);
+        if (!signer.sign_request(request.method.c_str(), request.path_and_query, timestamp, nonce,
+                request.body, signature, sizeof(signature))) {
+            result.status_code = 0;
+            result.error = "Request signing failed";
+            http.end();
+            return true;
+        }
+        http.addHeader("X-PTC-Device-Id", request.device_id);
+        http.addHeader("X-PTC-Timestamp", timestamp);
+        http.addHeader("X-PTC-Nonce", nonce);
+        http.addHeader("X-PTC-Signature", signature);
+    }
+    if (!request.if_none_match.isEmpty()) {
+        http.addHeader("If-None-Match", request.if_none_match);
+    }
+    if (preemptible(request.kind)) {
+        http.addHeader("Accept-Encoding", kAcceptCompressed);
+    }
+    const char* response_headers[] = {"Transfer-Encoding", "Content-Encoding", "ETag", "Retry-After"};
+    http.collectHeaders(response_headers, 4);
+    const uint32_t sent_ms = millis();
+    if (request.method == "POST") {
+        http.addHeader("Content-Type", "application/json");
+        result.status_code = http.POST(request.body);
+    } else {
+        result.status_code = http.GET();
+    }
+    const uint32_t headers_ms = millis();
+    result.phases.ttfb_ms = headers_ms - sent_ms;
+    result.phases.answered = result.status_code > 0;
+    result.etag = http.header("ETag");
+    // Only the delta-seconds form; an HTTP-date falls back to the backoff.
+    const long retry_after = http.header("Retry-After").toInt();
+    result.retry_after_sec = retry_after > 0 ? static_cast<uint32_t>(min<long>(retry_after, 86400)) : 0;
+    bool completed = true;
+    if (request.kind == RequestKind::kSync) {
+        // Validators travel in the body; a header ETag would not match either.
+        result.etag = "";
+    }
+    if (preemptible(request.kind) && result.status_code >= 200 && result.status_code < 300) {
+        // Parsed element by element straight off the socket; peak memory is
+        // one array element, whatever the length of the array.
+        HttpBodyStream body(*http.getStreamPtr(),
+            http.getSize(),
+            http.header("Transfer-Encoding").equalsIgnoreCase("chunked"),
+            8000);
+        const ContentEncoding encoding = content_encoding_from_header(http.header("Content-Encoding"));
+        BodyRead outcome = BodyRead::kInvalid;
+        if (encoding == ContentEncoding::kIdentity) {
+            outcome = read_streamed_body(body, request.kind, result);
+            result.decoded_bytes = body.consumed();
+        } else if (encoding != ContentEncoding::kUnsupported) {
+            // Inflated a byte at a time between the socket and the parser.
+            InflateStream inflated(body, encoding);
+            outcome = read_streamed_body(inflated, request.kind, result);
+            // The parser stops at the closing bracket; the checksum comes after.
+            if (outcome == BodyRead::kOk && !inflated.read_to_end()) {
+                Serial.printf("[HTTP] %s body failed its trailer check\n", request_name(request.kind));
+                outcome = BodyRead::kInvalid;
+            }
+            result.decoded_bytes = inflated.produced();
+        }
+        completed = outcome != BodyRead::kPreempted;
+        result.body_valid = outcome == BodyRead::kOk;
+        result.error = "";
+        // Whatever is left (the rest of a bad or preempted body) is read off
+        // so the connection can carry the next request.
+        if (!completed || !body.drain()) {
+            client.stop();
+        }
+        result.wire_bytes = body.consumed();
+        result.phases.bytes = result.wire_bytes;
+    } else if (result.status_code > 0) {
+        // Reading the whole body leaves the connection ready for the next request.
+        result.body = http.getString();
+        result.error = "";
+        result.phases.bytes = result.body.length();
+    } else {
+        result.error = HTTPClient::errorToString(result.status_code);
+    }
+    result.phases.body_ms = millis() - headers_ms;
+    http.end();
+    return completed;
+}
+
+void send_result(ServiceResult* result) {
+    xQueueSend(g_result_queue, &result, portMAX_DELAY);
+    service_scheduler_signal(kSchedulerEventHttpResult);
+}
+
 void service_worker(void*) {
+    // One connection to the portal lives across requests; HTTPClient keeps it
+    // open when the server allows keep-alive, so only the first request after
+    // a close pays for the TLS handshake. The HTTPClient lives as long: its
+    // destructor stops the client it was given, so one per request would
+    // close the socket after every response.
+    WiFiClientSecure client;
+    HTTPClient http;
+    http.setConnectTimeout(kConnectTimeoutMs);
+    http.setTimeout(8000);
+    http.setReuse(true);
+    HmacSigner signer;
+    bool client_verifies = false;
     while (true) {
-        ServiceRequest* request = nullptr;
-        if (xQueueReceive(g_request_queue, &request, portMAX_DELAY) != pdTRUE || !request) {
+        uint8_t slot = 0;
+        uint32_t waited_ms = 0;
+        auto* request = static_cast<ServiceRequest*>(service_http_queue_pop(g_work_queue, slot, waited_ms));
+        if (!request) {
+            ulTaskNotifyTake(pdTRUE, portMAX_DELAY);
             continue;
         }
 
@@ -185,57 +665,76 @@ void service_worker(void*) {
         }
         result->kind = request->kind;
         result->correlation = request->correlation;
+        result->activity.skip = request->activity_skip;
+        result->activity.check_ids = request->activity_check_ids;
+        result->queued_ms = waited_ms;
+        result->started_ms = millis();
 
+        bool preempted = false;
         if (WiFi.status() != WL_CONNECTED) {
+            client.stop();
             result->error = "Wi-Fi disconnected";
         } else {
-            WiFiClientSecure client;
-            if (request->signed_request) {
-                client.setCACert(service_auth_portal_root_ca());
-            } else {
-                client.setInsecure();
+            const uint32_t started_ms = result->started_ms;
+            if (client_verifies != request->signed_request) {
+                client.stop();
             }
-            client.setTimeout(8000);
-
-            HTTPClient http;
-            http.setConnectTimeout(5000);
-            http.setTimeout(8000);
-            const String url = request->base_url + request->path_and_query;
-            if (!http.begin(client, url)) {
-                result->error = "HTTP begin failed";
-            } else {
-                if (request->signed_request) {
-                    const String timestamp = String(static_cast<uint32_t>(time(nullptr)));
-                    const String nonce = service_auth_random_nonce();
-                    const String signature = service_auth_request_signature(
-                        request->method,
-                        request->path_and_query,
-                        timestamp,
-                        nonce,
-                        request->body,
-                        request->device_secret);
-                    http.addHeader("X-PTC-Device-Id", request->device_id);
-                    http.addHeader("X-PTC-Timestamp", timestamp);
-                    http.addHeader("X-PTC-Nonce", nonce);
-                    http.addHeader("X-PTC-Signature", signature);
+            for (uint8_t attempt = 0; attempt < 2; ++attempt) {
+                const bool reused = client.connected();
+                if (!reused) {
+                    client.stop();
+                    if (request->signed_request) {
+                        client.setCACert(service_auth_portal_root_ca());
+                    } else {
+                        client.setInsecure();
+                    }
+                    client.setTimeout(8000);
+                    client_verifies = request->signed_request;
                 }
-                if (request->method == "POST") {
-                    http.addHeader("Content-Type", "application/json");
-                    result->status_code = http.POST(request->body);
-                } else {
-                    result->status_code = http.GET();
+                preempted = !send_request(client, http, signer, *request, *result);
+                if (!preempted && reused && attempt == 0 && stale_connection_error(result->status_code)) {
+                    client.stop();
+                    g_connection_stats.stale_retries++;
+                    continue;
                 }
-                if (result->status_code > 0) {
-                    result->body = http.getString();
+                if (reused) {
+                    g_connection_stats.reused++;
                 } else {
-                    result->error = HTTPClient::errorToString(result->status_code);
+                    g_connection_stats.handshakes++;
+                }
+                if (!preempted && result->status_code <= 0) {
+                    client.stop();
+                    g_connection_stats.failures++;
                 }
-                http.end();
+                result->reused_connection = reused;
+                break;
+            }
+            result->elapsed_ms = millis() - started_ms;
+            if (!preempted) {
+                service_http_timing_record(request_name(request->kind),
+                    result->phases,
+                    result->status_code <= 0 || result->status_code >= 500);
             }
         }
 
+        if (preempted) {
+            g_connection_stats.preempted++;
+            Serial.printf("[HTTP] %s preempted after %lums\n",
+                request_name(request->kind),
+                static_cast<unsigned long>(result->elapsed_ms));
+            if (result->activity.paged) {
+                request->activity_skip = max(request->activity_skip, result->activity.seen);
+            }
+            if (service_http_queue_requeue(g_work_queue, slot, request)) {
+                delete result;
+                continue;
+            }
+            // A newer request of the same kind is already waiting; report
+            // this one so the loop stops counting it.
+            result->superseded = true;
+        }
         delete request;
-        xQueueSend(g_result_queue, &result, portMAX_DELAY);
+        send_result(result);
     }
 }
 
@@ -246,8 +745,9 @@ bool enqueue_request(
     const String& body,
     const DeviceConfig& config,
     const String& correlation = "",
-    bool signed_request = true) {
-    if (g_request_in_progress || !g_request_queue) {
+    bool signed_request = true,
+    const String& if_none_match = "") {
+    if (!g_work_queue.lock || !g_worker_task) {
         return false;
     }
 
@@ -265,110 +765,145 @@ bool enqueue_request(
     request->device_secret = config.device_secret;
     request->correlation = correlation;
     request->signed_request = signed_request;
+    request->if_none_match = if_none_match;
+    request->activity_skip = g_activity_skip;
+    request->activity_check_ids = g_activity_check_ids;
 
-    if (xQueueSend(g_request_queue, &request, 0) != pdTRUE) {
+    void* waiting = nullptr;
+    if (!service_http_queue_push(g_work_queue, queue_slot(kind), request, waiting)) {
         delete request;
+        g_last_error = String(request_name(kind)) + " has no queue slot";
+        Serial.printf("[HTTP] %s refused slot=%u\n", request_name(kind), static_cast<unsigned>(queue_slot(kind)));
         return false;
     }
-    g_request_in_progress = true;
-    g_active_request = kind;
-    Serial.printf("[HTTP] %s queued\n", request_name(kind));
+    auto* replaced = static_cast<ServiceRequest*>(waiting);
+    if (replaced) {
+        delete replaced;
+    } else {
+        g_outstanding[static_cast<uint8_t>(kind)]++;
+    }
+    xTaskNotifyGive(g_worker_task);
+    Serial.printf("[HTTP] %s %s depth=%u\n",
+        request_name(kind),
+        replaced ? "coalesced" : "queued",
+        static_cast<unsigned>(g_work_queue.depth));
     return true;
 }
 
-void load_notices_from_json(const String& json, bool persist) {
-    DynamicJsonDocument document(8192);
-    if (deserializeJson(document, json) != DeserializationError::Ok || !document.is<JsonArray>()) {
-        g_last_error = "Notices response invalid";
-        service_log_add("Notices parse error");
-        return;
+bool outstanding(RequestKind kind) {
+    return g_outstanding[static_cast<uint8_t>(kind)] > 0;
+}
+
+// Called last in a due check: an open breaker whose wait is over turns
+// half-open here and the request about to be queued is its probe.
+bool ready(RequestKind kind) {
+    return !outstanding(kind) && service_http_breaker_allow(g_breakers[static_cast<uint8_t>(kind)]);
+}
+
+void report_invalid_body(const char* what) {
+    g_last_error = String(what) + " response invalid";
+    service_log_add_error(String(what) + " parse error");
+}
+
+// The cache holds the parsed notices rather than the portal's response, so
+// it stays within kMaxCachedNotices however long the response was.
+String serialize_notices() {
+    // const char* values are stored by reference, so the document only needs
+    // room for the nodes.
+    DynamicJsonDocument document(JSON_ARRAY_SIZE(g_notices.size()) + g_notices.size() * JSON_OBJECT_SIZE(9));
+    JsonArray items = document.to<JsonArray>();
+    for (const Notice& notice : g_notices) {
+        JsonObject item = items.createNestedObject();
+        item["id"] = notice.id.c_str();
+        item["title"] = notice.title.c_str();
+        item["body"] = notice.body.c_str();
+        item["image_url"] = notice.image_url.c_str();
+        item["hyperlink_url"] = notice.hyperlink_url.c_str();
+        item["display_seconds"] = notice.display_seconds;
+        item["sort_order"] = notice.sort_order;
+        item["created_at"] = notice.created_at.c_str();
+        item["updated_at"] = notice.updated_at.c_str();
     }
+    String json;
+    serializeJson(document, json);
+    return json;
+}
 
-    g_notices.clear();
-    for (JsonObject item : document.as<JsonArray>()) {
-        if (g_notices.size() >= kMaxCachedNotices) {
-            break;
+bool same_notices(const std::vector<Notice>& a, const std::vector<Notice>& b) {
+    if (a.size() != b.size()) {
+        return false;
+    }
+    for (size_t i = 0; i < a.size(); ++i) {
+        if (a[i].id != b[i].id || a[i].title != b[i].title || a[i].body != b[i].body ||
+            a[i].image_url != b[i].image_url || a[i].hyperlink_url != b[i].hyperlink_url ||
+            a[i].display_seconds != b[i].display_seconds || a[i].sort_order != b[i].sort_order ||
+            a[i].created_at != b[i].created_at || a[i].updated_at != b[i].updated_at) {
+            return false;
         }
-        Notice notice;
-        notice.id = String(item["id"] | "");
-        notice.title = String(item["title"] | "");
-        notice.body = String(item["body"] | "");
-        notice.image_url = String(item["image_url"] | "");
-        notice.hyperlink_url = String(item["hyperlink_url"] | "");
-        notice.display_seconds = item["display_seconds"] | 6;
-        notice.sort_order = item["sort_order"] | 0;
-        notice.created_at = String(item["created_at"] | "");
-        notice.updated_at = String(item["updated_at"] | "");
-        g_notices.push_back(notice);
     }
+    return true;
+}
 
+// Rewrites the SD cache only when the notices or their validator changed,
+// which also covers a portal that sends no ETag.
+void install_notices(std::vector<Notice>& notices, bool persist, const String& etag = "") {
+    const bool changed = !same_notices(g_notices, notices) || etag != g_notices_etag;
+    g_notices.swap(notices);
+    g_notices_etag = etag;
     g_last_notice_ts = static_cast<uint32_t>(time(nullptr));
-    if (persist) {
-        service_storage_save_notices(json, g_last_notice_ts);
+    if (persist && changed) {
+        service_storage_save_notices(serialize_notices(), g_last_notice_ts, g_notices_etag);
     }
 }
 
-String normalize_activity_action(const String& raw_action) {
-    String action = raw_action;
-    action.toLowerCase();
-    action.replace("_", " ");
-    action.trim();
-    if (action == "in" || action == "clock in" || action == "check in") {
-        return "clocked in";
+bool load_notices_from_json(const String& json, bool persist) {
+    MemoryStream body(json.c_str(), json.length());
+    std::vector<Notice> notices;
+    if (read_notices(body, notices, false) != BodyRead::kOk) {
+        report_invalid_body("Notices");
+        return false;
     }
-    if (action == "out" || action == "clock out" || action == "check out") {
-        return "clocked out";
+    install_notices(notices, persist);
+    return true;
+}
+
+uint16_t load_activity_from_json(const String& json) {
+    MemoryStream body(json.c_str(), json.length());
+    ActivityPage page;
+    if (read_activity(body, page, false, false) != BodyRead::kOk) {
+        report_invalid_body("Activity");
     }
-    return action;
+    Serial.printf("[HTTP] activity applied count=%u\n", page.accepted);
+    return page.accepted;
 }
 
-void load_activity_from_json(const String& json) {
-    DynamicJsonDocument document(8192);
-    if (deserializeJson(document, json) != DeserializationError::Ok ||
-        !document.is<JsonArray>()) {
-        g_last_error = "Activity response invalid";
-        service_log_add("Activity parse error");
+// A complete page moves the cursor on; one cut short keeps it, and the
+// elements already applied are skipped when the page is asked for again. A
+// complete page without a new cursor (the last one, or null) is asked for
+// again under the same cursor, so it is skipped the same way, and ids stay
+// checked until the cursor moves.
+void apply_activity_page(const ActivityPage& page, bool complete) {
+    if (!page.paged) {
+        g_activity_more = false;
         return;
     }
-
-    uint16_t accepted = 0;
-    for (JsonObject item : document.as<JsonArray>()) {
-        const String event_id = String(item["id"] | "");
-        String user = String(item["user_name"] | "");
-        if (user.isEmpty()) {
-            user = String(item["employee_name"] | "");
-        }
-        if (user.isEmpty()) {
-            user = String(item["user"] | "");
-        }
-
-        String action = String(item["action"] | "");
-        if (action.isEmpty()) {
-            action = String(item["punch_type"] | "");
-        }
-        if (action.isEmpty()) {
-            action = String(item["event_type"] | "");
-        }
-        action = normalize_activity_action(action);
-
-        uint32_t timestamp = item["timestamp"] | 0;
-        if (timestamp == 0) {
-            const char* occurred_at = item["occurred_at"] | "";
-            if (!occurred_at[0]) {
-                occurred_at = item["created_at"] | "";
-            }
-            timestamp = parse_iso_timestamp(occurred_at);
-        }
-        if (user.isEmpty() || timestamp == 0 ||
-            (action != "clocked in" && action != "clocked out")) {
-            continue;
-        }
-
-        service_log_add_activity(user, action, timestamp, event_id);
-        g_last_activity_ts = max(g_last_activity_ts, timestamp);
-        accepted++;
+    if (!complete) {
+        // Asked for again straight away while each attempt gets further; a
+        // page that keeps breaking at the same element waits for the poll.
+        g_activity_more = page.seen > g_activity_skip;
+        g_activity_skip = max(g_activity_skip, page.seen);
+        return;
+    }
+    g_activity_skip = 0;
+    const bool advanced = !page.next_cursor.isEmpty() && page.next_cursor != g_activity_cursor;
+    g_activity_check_ids = !advanced;
+    g_activity_more = page.more && advanced;
+    if (advanced) {
+        g_activity_cursor = page.next_cursor;
+        service_storage_save_activity_cursor(g_activity_cursor);
+    } else if (!g_activity_cursor.isEmpty()) {
+        g_activity_skip = page.seen;
     }
-    Serial.printf("[HTTP] activity applied count=%u\n", accepted);
 }
 
 void apply_config_result(DeviceConfig& config, AppState& state, const ServiceResult& result) {
@@ -380,18 +915,35 @@ void apply_config_result(DeviceConfig& config, AppState& state, const ServiceRes
         return;
     }
 
+    const DeviceConfig previous = config;
+    const bool was_active = state.device_active;
     config.location_id = String(response["location_id"] | config.location_id.c_str());
     config.location_name = String(response["location_name"] | config.location_name.c_str());
     config.qr_interval_sec = response["qr_interval_sec"] | config.qr_interval_sec;
+    config.config_etag = result.etag;
+    config.portal_sync = response["capabilities"]["sync"] | false;
     state.device_active = response["is_active"] | state.device_active;
-    service_storage_save_device_active(state.device_active);
-    service_storage_save_config(config);
     g_last_config_ms = millis();
     g_initial_config_complete = true;
-    service_log_add("Config updated");
-    Serial.printf("[HTTP] config applied interval=%lus active=%d\n",
+
+    // Storage is only touched when something changed.
+    if (state.device_active != was_active) {
+        service_storage_save_device_active(state.device_active);
+    }
+    const bool changed = config.location_id != previous.location_id ||
+        config.location_name != previous.location_name ||
+        config.qr_interval_sec != previous.qr_interval_sec;
+    if (changed || config.config_etag != previous.config_etag || config.portal_sync != previous.portal_sync) {
+        service_storage_save_config(config);
+    }
+    if (changed || state.device_active != was_active) {
+        service_log_add("Config updated");
+    }
+    Serial.printf("[HTTP] config applied interval=%lus active=%d changed=%d sync=%d\n",
         static_cast<unsigned long>(config.qr_interval_sec),
-        state.device_active ? 1 : 0);
+        state.device_active ? 1 : 0,
+        changed ? 1 : 0,
+        config.portal_sync ? 1 : 0);
 }
 
 void apply_registration_result(DeviceConfig& config, AppState& state, const ServiceResult& result) {
@@ -414,6 +966,8 @@ void apply_registration_result(DeviceConfig& config, AppState& state, const Serv
     config.location_id = String(response["location_id"] | "");
     config.location_name = String(response["location_name"] | "");
     config.qr_interval_sec = response["qr_interval_sec"] | kDefaultQrIntervalSec;
+    config.config_etag = "";
+    config.portal_sync = false;
     state.device_active = response["is_active"] | true;
     state.provisioning_complete = true;
     service_storage_save_device_active(state.device_active);
@@ -424,21 +978,54 @@ void apply_registration_result(DeviceConfig& config, AppState& state, const Serv
 }
 
 void mark_request_failure(DeviceConfig& config, AppState& state, const ServiceResult& result) {
+    HttpBreaker& endpoint = g_breakers[static_cast<uint8_t>(result.kind)];
+    if (result.status_code > 0 && result.status_code < 500 && result.status_code != 429) {
+        // The route answered; what it objected to is not its health.
+        service_http_breaker_success(endpoint);
+    }
     if (result.kind == RequestKind::kActivity && result.status_code == 404) {
         g_last_activity_ms = millis();
         g_activity_interval_ms = kActivityUnavailableIntervalMs;
         Serial.println("[HTTP] activity route unavailable");
         return;
     }
+    if (result.kind == RequestKind::kOutbox &&
+        (result.status_code == 404 || result.status_code == 405 || result.status_code == 501)) {
+        // Older portals have no events route; the records keep on the card.
+        service_http_breaker_hold(endpoint, result.status_code, kOutboxUnavailableMs);
+        Serial.println("[HTTP] outbox route unavailable");
+        return;
+    }
+    if (result.kind == RequestKind::kOutbox &&
+        (result.status_code == 400 || result.status_code == 413 || result.status_code == 422)) {
+        // Retrying a batch the portal refuses would block the outbox for good.
+        service_outbox_ack(g_outbox_batch, 0, true);
+        Serial.printf("[HTTP] outbox batch rejected status=%d records=%u\n",
+            result.status_code,
+            static_cast<unsigned>(g_outbox_batch.count));
+        return;
+    }
+    if (result.kind == RequestKind::kSync &&
+        (result.status_code == 404 || result.status_code == 405 || result.status_code == 501)) {
+        // Everything the sync would have carried is due again, so the
+        // separate requests go out on the next tick.
+        config.portal_sync = false;
+        service_storage_save_config(config);
+        Serial.println("[HTTP] sync route unavailable");
+        return;
+    }
     if (result.status_code == 429) {
-        StaticJsonDocument<256> response;
-        uint32_t retry_seconds = config.qr_interval_sec;
-        if (deserializeJson(response, result.body) == DeserializationError::Ok) {
-            retry_seconds = response["retry_after"] | retry_seconds;
+        uint32_t retry_seconds = result.retry_after_sec;
+        if (retry_seconds == 0) {
+            StaticJsonDocument<256> response;
+            retry_seconds = config.qr_interval_sec;
+            if (deserializeJson(response, result.body) == DeserializationError::Ok) {
+                retry_seconds = response["retry_after"] | retry_seconds;
+            }
         }
         g_api_ok = true;
         g_last_error = "";
-        delay_requests(max<uint32_t>(retry_seconds, 1) * 1000);
+        service_http_breaker_hold(endpoint, result.status_code, max<uint32_t>(retry_seconds, 1) * 1000);
         Serial.printf("[HTTP] %s rate limited retry=%lus\n",
             request_name(result.kind),
             static_cast<unsigned long>(retry_seconds));
@@ -446,11 +1033,20 @@ void mark_request_failure(DeviceConfig& config, AppState& state, const ServiceRe
     }
 
     g_api_ok = false;
-    g_last_error = result.status_code > 0
-        ? String(request_name(result.kind)) + " HTTP " + result.status_code
-        : String(request_name(result.kind)) + " connection failed";
-    Serial.printf("[HTTP] %s status=%d\n", request_name(result.kind), result.status_code);
-    service_log_add(String(request_name(result.kind)) + " failed");
+    if (result.status_code > 0) {
+        g_last_error = String(request_name(result.kind)) + " HTTP " + result.status_code;
+    } else {
+        // "DNS lookup failed", "Connection failed", "read Timeout", ...
+        g_last_error = String(request_name(result.kind)) + " " +
+            (result.error.isEmpty() ? String("connection failed") : result.error);
+    }
+    Serial.printf("[HTTP] %s status=%d %s\n", request_name(result.kind), result.status_code, result.error.c_str());
+    if (result.kind == RequestKind::kOutbox) {
+        // Queuing this one would grow the outbox with every failed drain.
+        service_log_add("outbox failed");
+    } else {
+        service_log_add_error(String(request_name(result.kind)) + " failed");
+    }
 
     if (result.status_code == 401) {
         state.time_sync_ok = false;
@@ -466,26 +1062,99 @@ void mark_request_failure(DeviceConfig& config, AppState& state, const ServiceRe
         g_last_config_ms = millis();
         delay_requests(kConfigIntervalMs);
     } else if (result.status_code <= 0 || result.status_code >= 500) {
-        delay_requests(g_failure_backoff_ms);
-        g_failure_backoff_ms = min(g_failure_backoff_ms * 2, kFailureBackoffMaxMs);
+        // Only this endpoint waits; the others keep their own schedule.
+        service_http_breaker_failure(endpoint, result.status_code, result.retry_after_sec * 1000);
+        Serial.printf("[HTTP] %s breaker open %lums\n",
+            request_name(result.kind),
+            static_cast<unsigned long>(endpoint.wait_ms));
     }
 
     if (result.status_code == 400) {
         const uint32_t now = millis();
         if (result.kind == RequestKind::kConfig) g_last_config_ms = now;
-        if (result.kind == RequestKind::kHeartbeat) g_last_heartbeat_ms = now;
+        if (result.kind == RequestKind::kSync) g_last_config_ms = g_last_notice_ms = g_last_activity_ms = now;
+        if (result.kind == RequestKind::kSync || result.kind == RequestKind::kHeartbeat) g_last_heartbeat_ms = now;
         if (result.kind == RequestKind::kNotices) g_last_notice_ms = now;
         if (result.kind == RequestKind::kActivity) g_last_activity_ms = now;
         if (result.kind == RequestKind::kManualCode) g_manual_done_for_payload = true;
     }
 }
 
+// The cached copy is still current: only the poll timestamps move, nothing
+// is parsed or written.
+void apply_not_modified(const ServiceResult& result) {
+    g_api_ok = true;
+    g_last_error = "";
+    service_http_breaker_success(g_breakers[static_cast<uint8_t>(result.kind)]);
+    const uint32_t now = millis();
+    if (result.kind == RequestKind::kConfig) {
+        g_last_config_ms = now;
+        g_initial_config_complete = true;
+    } else {
+        g_last_notice_ms = now;
+        g_last_notice_ts = static_cast<uint32_t>(time(nullptr));
+        g_force_notice = false;
+    }
+    Serial.printf("[HTTP] %s not modified\n", request_name(result.kind));
+}
+
+// A sync stands in for a heartbeat, config, notices and activity request at
+// once; a section the portal left out is as good as a 304.
+void apply_sync_result(DeviceConfig& config, AppState& state, ServiceResult& result) {
+    const uint32_t now = millis();
+    g_last_heartbeat_ms = now;
+    g_last_notice_ms = now;
+    g_last_activity_ms = now;
+    g_activity_interval_ms = kActivityIntervalMs;
+    g_force_notice = false;
+    if (!result.body_valid) {
+        report_invalid_body("Sync");
+    }
+    if (result.sync_sections & kSyncConfig) {
+        apply_config_result(config, state, result);
+    } else {
+        g_last_config_ms = now;
+    }
+    if (result.sync_sections & kSyncNotices) {
+        install_notices(result.notices, true, result.notices_etag);
+    } else {
+        g_last_notice_ts = static_cast<uint32_t>(time(nullptr));
+    }
+    apply_activity_page(result.activity, (result.sync_sections & kSyncActivity) != 0);
+    service_log_add("Heartbeat sent");
+    Serial.printf("[HTTP] sync applied config=%d notices=%d activity=%u\n",
+        (result.sync_sections & kSyncConfig) ? 1 : 0,
+        (result.sync_sections & kSyncNotices) ? static_cast<int>(g_notices.size()) : -1,
+        result.activity.accepted);
+}
+
 void apply_service_result(DeviceConfig& config, AppState& state, ServiceResult* result) {
     if (!result) {
         return;
     }
-    g_request_in_progress = false;
-    g_active_request = RequestKind::kNone;
+    uint8_t& count = g_outstanding[static_cast<uint8_t>(result->kind)];
+    if (count > 0) {
+        count--;
+    }
+    if (result->superseded) {
+        delete result;
+        return;
+    }
+    Serial.printf("[HTTP] %s status=%d queued=%lums %lums (dns %lu connect %lu ttfb %lu body %lu) "
+                  "body=%lu/%luB tls=%s (handshakes=%lu reused=%lu)\n",
+        request_name(result->kind),
+        result->status_code,
+        static_cast<unsigned long>(result->queued_ms),
+        static_cast<unsigned long>(result->elapsed_ms),
+        static_cast<unsigned long>(result->phases.dns_ms),
+        static_cast<unsigned long>(result->phases.connect_ms),
+        static_cast<unsigned long>(result->phases.ttfb_ms),
+        static_cast<unsigned long>(result->phases.body_ms),
+        static_cast<unsigned long>(result->wire_bytes),
+        static_cast<unsigned long>(result->decoded_bytes),
+        result->reused_connection ? "reused" : "handshake",
+        static_cast<unsigned long>(g_connection_stats.handshakes),
+        static_cast<unsigned long>(g_connection_stats.reused));
 
     if (result->kind == RequestKind::kRegister) {
         apply_registration_result(config, state, *result);
@@ -493,6 +1162,13 @@ void apply_service_result(DeviceConfig& config, AppState& state, ServiceResult*
         return;
     }
 
+    if (result->status_code == HTTP_CODE_NOT_MODIFIED &&
+        (result->kind == RequestKind::kConfig || result->kind == RequestKind::kNotices)) {
+        apply_not_modified(*result);
+        delete result;
+        return;
+    }
+
     if (result->status_code < 200 || result->status_code >= 300) {
         mark_request_failure(config, state, *result);
         delete result;
@@ -501,26 +1177,39 @@ void apply_service_result(DeviceConfig& config, AppState& state, ServiceResult*
 
     g_api_ok = true;
     g_last_error = "";
-    g_failure_backoff_ms = 5000;
+    service_http_breaker_success(g_breakers[static_cast<uint8_t>(result->kind)]);
     const uint32_t now = millis();
     switch (result->kind) {
         case RequestKind::kConfig:
             apply_config_result(config, state, *result);
             break;
+        case RequestKind::kSync:
+            apply_sync_result(config, state, *result);
+            break;
         case RequestKind::kHeartbeat:
             g_last_heartbeat_ms = now;
             service_log_add("Heartbeat sent");
             Serial.println("[HTTP] heartbeat accepted");
             break;
         case RequestKind::kNotices:
-            load_notices_from_json(result->body, true);
+            if (result->body_valid) {
+                install_notices(result->notices, true, result->etag);
+            } else {
+                report_invalid_body("Notices");
+            }
             g_last_notice_ms = now;
             g_force_notice = false;
             Serial.printf("[HTTP] notices applied count=%u\n",
                 static_cast<unsigned>(g_notices.size()));
             break;
         case RequestKind::kActivity:
-            load_activity_from_json(result->body);
+            if (!result->body_valid) {
+                report_invalid_body("Activity");
+            }
+            apply_activity_page(result->activity, result->body_valid);
+            Serial.printf("[HTTP] activity applied count=%u more=%d\n",
+                result->activity.accepted,
+                g_activity_more ? 1 : 0);
             g_last_activity_ms = now;
             g_activity_interval_ms = kActivityIntervalMs;
             break;
@@ -544,6 +1233,18 @@ void apply_service_result(DeviceConfig& config, AppState& state, ServiceResult*
             Serial.println("[HTTP] manual-code accepted");
             break;
         }
+        case RequestKind::kOutbox: {
+            StaticJsonDocument<128> response;
+            uint16_t duplicates = 0;
+            if (deserializeJson(response, result->body) == DeserializationError::Ok) {
+                duplicates = response["duplicates"] | 0;
+            }
+            service_outbox_ack(g_outbox_batch, duplicates);
+            Serial.printf("[HTTP] outbox batch accepted records=%u duplicates=%u\n",
+                static_cast<unsigned>(g_outbox_batch.count),
+                static_cast<unsigned>(duplicates));
+            break;
+        }
         default:
             break;
     }
@@ -572,25 +1273,108 @@ bool enqueue_config(const DeviceConfig& config) {
         "GET",
         String("/api/timeclock/devices/config?device_id=") + config.device_id,
         "",
-        config);
+        config,
+        "",
+        true,
+        config.config_etag);
 }
 
-bool enqueue_heartbeat(const DeviceConfig& config) {
-    StaticJsonDocument<384> document;
+// Capacity write_heartbeat_json needs: the copied strings plus each nested
+// section at its current count.
+size_t heartbeat_json_size(const DeviceConfig& config) {
+    uint8_t tripped = 0;
+    for (uint8_t kind = static_cast<uint8_t>(kFirstBreakerKind); kind < kRequestKindCount; ++kind) {
+        tripped += g_breakers[kind].trips > 0 ? 1 : 0;
+    }
+    return JSON_OBJECT_SIZE(13) + config.device_id.length() + 1 + sizeof("255.255.255.255") +
+        service_metrics_json_size() + service_telemetry_json_size() + 2 * JSON_OBJECT_SIZE(3) +
+        JSON_OBJECT_SIZE(tripped) + tripped * JSON_OBJECT_SIZE(5) + service_outbox_json_size() +
+        service_http_timing_json_size();
+}
+
+void write_heartbeat_json(JsonObject document, const DeviceConfig& config) {
     document["device_id"] = config.device_id;
     document["firmware_version"] = kFirmwareVersion;
     document["ip"] = WiFi.localIP().toString();
     document["wifi_rssi"] = WiFi.RSSI();
     document["free_heap"] = ESP.getFreeHeap();
     document["uptime_sec"] = millis() / 1000;
+    service_metrics_write_json(document.createNestedObject("tick_us"), MetricsWindow::kReport);
+    service_telemetry_write_json(document.createNestedObject("heap"));
+    JsonObject tls = document.createNestedObject("tls");
+    tls["handshakes"] = g_connection_stats.handshakes;
+    tls["reused"] = g_connection_stats.reused;
+    tls["stale_retries"] = g_connection_stats.stale_retries;
+    JsonObject queue = document.createNestedObject("queue");
+    queue["pushed"] = g_work_queue.pushed;
+    queue["coalesced"] = g_work_queue.coalesced;
+    queue["preempted"] = g_connection_stats.preempted;
+    // Only endpoints that have tripped since boot, to keep the body small.
+    JsonObject breakers = document.createNestedObject("breakers");
+    for (uint8_t kind = static_cast<uint8_t>(kFirstBreakerKind); kind < kRequestKindCount; ++kind) {
+        const HttpBreaker& breaker = g_breakers[kind];
+        if (breaker.trips == 0) {
+            continue;
+        }
+        JsonObject item = breakers.createNestedObject(request_name(static_cast<RequestKind>(kind)));
+        item["state"] = service_http_breaker_state_name(breaker.state);
+        item["trips"] = breaker.trips;
+        item["failures"] = breaker.failures;
+        item["last_status"] = breaker.last_status;
+        item["retry_in_ms"] = service_http_breaker_remaining_ms(breaker);
+    }
+    service_outbox_write_json(document.createNestedObject("outbox"));
+    service_http_timing_write_json(document.createNestedObject("net_ms"));
+}
+
+bool enqueue_heartbeat(const DeviceConfig& config) {
+    DynamicJsonDocument document(heartbeat_json_size(config));
+    write_heartbeat_json(document.to<JsonObject>(), config);
+    if (document.overflowed()) {
+        Serial.printf("[HTTP] Heartbeat JSON overflowed %u bytes\n", static_cast<unsigned>(document.capacity()));
+    }
     String body;
     serializeJson(document, body);
-    return enqueue_request(
-        RequestKind::kHeartbeat,
-        "POST",
-        "/api/timeclock/devices/heartbeat",
-        body,
-        config);
+    if (!enqueue_request(
+            RequestKind::kHeartbeat,
+            "POST",
+            "/api/timeclock/devices/heartbeat",
+            body,
+            config)) {
+        return false;
+    }
+    service_metrics_reset(MetricsWindow::kReport);
+    service_http_timing_reset_window();
+    return true;
+}
+
+// One signed POST with the heartbeat and the revisions the device holds;
+// the portal answers with only the sections that changed.
+bool enqueue_sync(const DeviceConfig& config) {
+    DynamicJsonDocument document(JSON_OBJECT_SIZE(6) + heartbeat_json_size(config) + config.device_id.length() + 1 +
+        config.config_etag.length() + 1 + g_notices_etag.length() + 1 + g_activity_cursor.length() + 1);
+    write_heartbeat_json(document.createNestedObject("heartbeat"), config);
+    document["device_id"] = config.device_id;
+    document["config_etag"] = config.config_etag;
+    document["notices_etag"] = g_notices_etag;
+    document["activity_since"] = g_last_activity_ts;
+    document["activity_cursor"] = g_activity_cursor;
+    if (document.overflowed()) {
+        Serial.printf("[HTTP] Sync JSON overflowed %u bytes\n", static_cast<unsigned>(document.capacity()));
+    }
+    String body;
+    serializeJson(document, body);
+    if (!enqueue_request(
+            RequestKind::kSync,
+            "POST",
+            "/api/timeclock/devices/sync",
+            body,
+            config)) {
+        return false;
+    }
+    service_metrics_reset(MetricsWindow::kReport);
+    service_http_timing_reset_window();
+    return true;
 }
 
 bool enqueue_notices(const DeviceConfig& config) {
@@ -599,12 +1383,35 @@ bool enqueue_notices(const DeviceConfig& config) {
         "GET",
         String("/api/timeclock/notices?device_id=") + config.device_id,
         "",
-        config);
+        config,
+        "",
+        true,
+        g_notices_etag);
 }
 
+String url_encode(const String& value) {
+    static const char kHex[] = "0123456789ABCDEF";
+    String encoded;
+    encoded.reserve(value.length() + 8);
+    for (size_t i = 0; i < value.length(); ++i) {
+        const char c = value[i];
+        if (isalnum(static_cast<unsigned char>(c)) || c == '-' || c == '_' || c == '.' || c == '~') {
+            encoded += c;
+        } else {
+            encoded += '%';
+            encoded += kHex[static_cast<uint8_t>(c) >> 4];
+            encoded += kHex[static_cast<uint8_t>(c) & 0x0F];
+        }
+    }
+    return encoded;
+}
+
+// cursor= tells the portal the device reads pages; an empty one starts from
+// since=. A portal without pages ignores it and answers the bare array.
 bool enqueue_activity(const DeviceConfig& config) {
     String path = String("/api/timeclock/devices/activity?device_id=") + config.device_id;
-    if (g_last_activity_ts > 0) {
+    path += "&cursor=" + url_encode(g_activity_cursor);
+    if (g_activity_cursor.isEmpty() && g_last_activity_ts > 0) {
         path += "&since=" + String(g_last_activity_ts);
     }
     return enqueue_request(
@@ -621,13 +1428,39 @@ bool enqueue_manual_code(const DeviceConfig& config) {
     document["qr_payload"] = g_manual_target_payload;
     String body;
     serializeJson(document, body);
+    if (!enqueue_request(
+            RequestKind::kManualCode,
+            "POST",
+            "/api/timeclock/devices/manual-code",
+            body,
+            config,
+            g_manual_target_payload)) {
+        return false;
+    }
+    g_manual_queued_payload = g_manual_target_payload;
+    return true;
+}
+
+// The batch's records are spliced into the body as they were stored, so
+// the portal sees the timestamps and keys they were written with.
+bool enqueue_outbox(const DeviceConfig& config) {
+    if (!service_outbox_next_batch(g_outbox_batch)) {
+        return false;
+    }
+    String body;
+    body.reserve(g_outbox_batch.events.length() + config.device_id.length() + 32);
+    body = "{\"device_id\":\"";
+    body += config.device_id;
+    body += "\",\"events\":";
+    body += g_outbox_batch.events;
+    body += '}';
+    g_outbox_batch.events = "";
     return enqueue_request(
-        RequestKind::kManualCode,
+        RequestKind::kOutbox,
         "POST",
-        "/api/timeclock/devices/manual-code",
+        "/api/timeclock/devices/events",
         body,
-        config,
-        g_manual_target_payload);
+        config);
 }
 
 bool enqueue_registration(DeviceConfig& config) {
@@ -662,32 +1495,41 @@ void service_http_init() {
     g_api_ok = false;
     g_last_error = "";
     g_notices.reserve(8);
-    g_request_queue = xQueueCreate(1, sizeof(ServiceRequest*));
-    g_result_queue = xQueueCreate(1, sizeof(ServiceResult*));
-    const BaseType_t worker_result = g_request_queue && g_result_queue
-        ? xTaskCreatePinnedToCore(service_worker, "portal_http", 12288, nullptr, 1, nullptr, 0)
+    service_http_timing_init();
+    g_last_activity_ts = 0;
+    service_storage_load_activity_cursor(g_activity_cursor);
+    g_activity_skip = 0;
+    g_activity_more = false;
+    g_activity_check_ids = true;
+    const bool work_queue = service_http_queue_init(g_work_queue);
+    g_result_queue = xQueueCreate(kRequestKindCount, sizeof(ServiceResult*));
+    const BaseType_t worker_result = work_queue && g_result_queue
+        ? xTaskCreatePinnedToCore(service_worker, "portal_http", 12288, nullptr, 1, &g_worker_task, 0)
         : errCOULD_NOT_ALLOCATE_REQUIRED_MEMORY;
-    Serial.printf("[HTTP] init request_queue=%d result_queue=%d worker=%d endpoint=%d\n",
-        g_request_queue ? 1 : 0,
+    Serial.printf("[HTTP] init work_queue=%d result_queue=%d worker=%d endpoint=%d\n",
+        work_queue ? 1 : 0,
         g_result_queue ? 1 : 0,
         worker_result == pdPASS ? 1 : 0,
         api_endpoint_configured() ? 1 : 0);
-    if (!g_request_queue || !g_result_queue || worker_result != pdPASS) {
+    if (!work_queue || !g_result_queue || worker_result != pdPASS) {
+        g_worker_task = nullptr;
         g_last_error = "HTTP worker unavailable";
         return;
     }
+    service_telemetry_register_task(g_worker_task);
 
     String cached;
     uint32_t timestamp = 0;
-    if (service_storage_load_notices(cached, timestamp)) {
-        load_notices_from_json(cached, false);
+    String etag;
+    if (service_storage_load_notices(cached, timestamp, etag) && load_notices_from_json(cached, false)) {
+        g_notices_etag = etag;
         g_last_notice_ts = timestamp;
     }
 }
 
 void service_http_tick(DeviceConfig& config, AppState& state) {
     ServiceResult* result = nullptr;
-    if (g_result_queue && xQueueReceive(g_result_queue, &result, 0) == pdTRUE) {
+    while (g_result_queue && xQueueReceive(g_result_queue, &result, 0) == pdTRUE) {
         apply_service_result(config, state, result);
     }
 
@@ -696,7 +1538,7 @@ void service_http_tick(DeviceConfig& config, AppState& state) {
         clear_manual_code();
         return;
     }
-    if (g_request_in_progress || !retry_ready()) {
+    if (!retry_ready()) {
         return;
     }
     if (!api_endpoint_configured()) {
@@ -722,40 +1564,61 @@ void service_http_tick(DeviceConfig& config, AppState& state) {
             g_last_error = "Device enrollment is required in PT Portal";
             return;
         }
-        if (g_last_registration_attempt_ms == 0 ||
-            millis() - g_last_registration_attempt_ms >= g_registration_retry_ms) {
+        if (!outstanding(RequestKind::kRegister) &&
+            (g_last_registration_attempt_ms == 0 ||
+                millis() - g_last_registration_attempt_ms >= g_registration_retry_ms)) {
             enqueue_registration(config);
         }
         return;
     }
 
     if (!g_initial_config_complete) {
-        enqueue_config(config);
+        if (ready(RequestKind::kConfig)) {
+            enqueue_config(config);
+        }
         return;
     }
-    if (!g_manual_done_for_payload && !g_manual_target_payload.isEmpty()) {
+
+    // Everything due goes into the work queue at once; the worker orders it.
+    // A manual code for a newer QR payload replaces one still waiting.
+    if (!g_manual_done_for_payload && !g_manual_target_payload.isEmpty() &&
+        (!outstanding(RequestKind::kManualCode) || g_manual_queued_payload != g_manual_target_payload) &&
+        service_http_breaker_allow(g_breakers[static_cast<uint8_t>(RequestKind::kManualCode)])) {
         enqueue_manual_code(config);
+    }
+    if (service_outbox_pending() && ready(RequestKind::kOutbox)) {
+        enqueue_outbox(config);
+    }
+    // Only one request carrying activity is out at a time, so each starts
+    // from the cursor the previous page left.
+    if (config.portal_sync) {
+        if ((g_force_notice || interval_due(g_last_heartbeat_ms, kHeartbeatIntervalMs)) &&
+            !outstanding(RequestKind::kActivity) && ready(RequestKind::kSync)) {
+            enqueue_sync(config);
+        }
+        if (g_activity_more && !outstanding(RequestKind::kSync) && ready(RequestKind::kActivity)) {
+            enqueue_activity(config);
+        }
         return;
     }
-    if (interval_due(g_last_config_ms, kConfigIntervalMs)) {
+    if (interval_due(g_last_config_ms, kConfigIntervalMs) && ready(RequestKind::kConfig)) {
         enqueue_config(config);
-        return;
     }
-    if (interval_due(g_last_heartbeat_ms, kHeartbeatIntervalMs)) {
+    if (interval_due(g_last_heartbeat_ms, kHeartbeatIntervalMs) && ready(RequestKind::kHeartbeat)) {
         enqueue_heartbeat(config);
-        return;
     }
-    if (interval_due(g_last_activity_ms, g_activity_interval_ms)) {
+    // The next page of a backlog follows as soon as the last one is applied.
+    if ((g_activity_more || interval_due(g_last_activity_ms, g_activity_interval_ms)) &&
+        ready(RequestKind::kActivity)) {
         enqueue_activity(config);
-        return;
     }
-    if (g_force_notice || interval_due(g_last_notice_ms, kNoticeIntervalMs)) {
+    if ((g_force_notice || interval_due(g_last_notice_ms, kNoticeIntervalMs)) && ready(RequestKind::kNotices)) {
         enqueue_notices(config);
     }
 }
 
 bool service_http_registration_in_progress() {
-    return g_request_in_progress && g_active_request == RequestKind::kRegister;
+    return outstanding(RequestKind::kRegister);
 }
 
 void service_http_retry_registration() {
@@ -803,7 +1666,31 @@ uint32_t service_http_manual_code_expires_at() {
 }
 
 bool service_http_manual_code_pending() {
-    return g_request_in_progress && g_active_request == RequestKind::kManualCode;
+    return outstanding(RequestKind::kManualCode);
+}
+
+void service_http_connection_stats(HttpConnectionStats& out_stats) {
+    out_stats = g_connection_stats;
+}
+
+uint8_t service_http_endpoint_count() {
+    return kRequestKindCount - static_cast<uint8_t>(kFirstBreakerKind);
+}
+
+bool service_http_endpoint_status(uint8_t index, HttpEndpointStatus& out_status) {
+    if (index >= service_http_endpoint_count()) {
+        return false;
+    }
+    const RequestKind kind = static_cast<RequestKind>(static_cast<uint8_t>(kFirstBreakerKind) + index);
+    const HttpBreaker& breaker = g_breakers[static_cast<uint8_t>(kind)];
+    out_status.name = request_name(kind);
+    out_status.state = service_http_breaker_state_name(breaker.state);
+    out_status.retry_in_ms = service_http_breaker_remaining_ms(breaker);
+    out_status.failures = breaker.failures;
+    out_status.last_status = breaker.last_status;
+    out_status.trips = breaker.trips;
+    out_status.probes = breaker.probes;
+    return true;
 }
 
 bool service_http_api_ok() {
@@ -814,4 +1701,12 @@ String service_http_last_error() {
     return g_last_error;
 }
 
+bool service_http_load_notices_json(const String& json, bool persist) {
+    return load_notices_from_json(json, persist);
+}
+
+uint16_t service_http_load_activity_json(const String& json) {
+    return load_activity_from_json(json);
+}
+
 } // namespace ptc
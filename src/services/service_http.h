@@ -4,6 +4,26 @@
 
 namespace ptc {
 
+// Portal connection reuse and preemption, counted by the HTTP worker since boot.
+struct HttpConnectionStats {
+    uint32_t handshakes = 0;
+    uint32_t reused = 0;
+    uint32_t stale_retries = 0;
+    uint32_t failures = 0;
+    uint32_t preempted = 0;
+};
+
+// Circuit breaker of one portal endpoint, as the diagnostics page shows it.
+struct HttpEndpointStatus {
+    const char* name = "";
+    const char* state = "";
+    uint32_t retry_in_ms = 0;
+    uint16_t failures = 0;
+    int last_status = 0;
+    uint32_t trips = 0;
+    uint32_t probes = 0;
+};
+
 void service_http_init();
 void service_http_tick(DeviceConfig& config, AppState& state);
 bool service_http_registration_in_progress();
@@ -18,5 +38,10 @@ uint32_t service_http_manual_code_expires_at();
 bool service_http_manual_code_pending();
 bool service_http_api_ok();
 String service_http_last_error();
+void service_http_connection_stats(HttpConnectionStats& out_stats);
+uint8_t service_http_endpoint_count();
+bool service_http_endpoint_status(uint8_t index, HttpEndpointStatus& out_status);
+bool service_http_load_notices_json(const String& json, bool persist);
+uint16_t service_http_load_activity_json(const String& json);
 
 } // namespace ptc
@@ -0,0 +1,83 @@
+#include "service_http_breaker.h"
+
+#include <esp_system.h>
+
+namespace ptc {
+
+namespace {
+
+// Uniform in [base, 3 x previous], capped; the first wait already spans
+// [base, 3 x base] so devices that failed together do not retry together.
+uint32_t jittered_backoff(uint32_t previous_ms) {
+    const uint32_t previous = max(previous_ms, kHttpBreakerBaseMs);
+    const uint32_t upper = previous > kHttpBreakerMaxMs / 3 ? kHttpBreakerMaxMs : previous * 3;
+    return kHttpBreakerBaseMs + esp_random() % (upper - kHttpBreakerBaseMs + 1);
+}
+
+void open_breaker(HttpBreaker& breaker, int status, uint32_t wait_ms) {
+    if (breaker.state == HttpBreakerState::kClosed) {
+        breaker.trips++;
+    }
+    breaker.state = HttpBreakerState::kOpen;
+    breaker.opened_ms = millis();
+    breaker.wait_ms = wait_ms;
+    breaker.last_status = status;
+    breaker.failures++;
+}
+
+} // namespace
+
+bool service_http_breaker_allow(HttpBreaker& breaker) {
+    switch (breaker.state) {
+        case HttpBreakerState::kClosed:
+            return true;
+        case HttpBreakerState::kOpen:
+            if (millis() - breaker.opened_ms < breaker.wait_ms) {
+                return false;
+            }
+            breaker.state = HttpBreakerState::kHalfOpen;
+            breaker.probes++;
+            return true;
+        case HttpBreakerState::kHalfOpen:
+        default:
+            return true;
+    }
+}
+
+void service_http_breaker_success(HttpBreaker& breaker) {
+    breaker.state = HttpBreakerState::kClosed;
+    breaker.wait_ms = 0;
+    breaker.backoff_ms = 0;
+    breaker.failures = 0;
+}
+
+void service_http_breaker_failure(HttpBreaker& breaker, int status, uint32_t retry_after_ms) {
+    breaker.backoff_ms = jittered_backoff(breaker.backoff_ms);
+    open_breaker(breaker, status, max(breaker.backoff_ms, min(retry_after_ms, kHttpBreakerMaxMs)));
+}
+
+void service_http_breaker_hold(HttpBreaker& breaker, int status, uint32_t wait_ms) {
+    open_breaker(breaker, status, wait_ms);
+}
+
+uint32_t service_http_breaker_remaining_ms(const HttpBreaker& breaker) {
+    if (breaker.state != HttpBreakerState::kOpen) {
+        return 0;
+    }
+    const uint32_t elapsed = millis() - breaker.opened_ms;
+    return elapsed < breaker.wait_ms ? breaker.wait_ms - elapsed : 0;
+}
+
+const char* service_http_breaker_state_name(HttpBreakerState state) {
+    switch (state) {
+        case HttpBreakerState::kOpen:
+            return "open";
+        case HttpBreakerState::kHalfOpen:
+            return "half-open";
+        case HttpBreakerState::kClosed:
+        default:
+            return "closed";
+    }
+}
+
+} // namespace ptc
@@ -0,0 +1,48 @@
+#pragma once
+
+#include "config.h"
+
+namespace ptc {
+
+// Per-endpoint circuit breaker for the portal HTTP worker. A failed request
+// opens the breaker for a decorrelated-jitter delay (a random wait between
+// the base and three times the previous one, capped), so a fleet that lost
+// the portal at the same moment does not come back in lockstep. Once the
+// wait is over the breaker is half-open: the caller keeps one request per
+// endpoint in flight, so that probe's answer closes the breaker or opens it
+// again for a longer wait.
+static constexpr uint32_t kHttpBreakerBaseMs = 5000;
+static constexpr uint32_t kHttpBreakerMaxMs = 300000;
+
+enum class HttpBreakerState : uint8_t {
+    kClosed,
+    kOpen,
+    kHalfOpen,
+};
+
+struct HttpBreaker {
+    HttpBreakerState state = HttpBreakerState::kClosed;
+    uint32_t opened_ms = 0;
+    uint32_t wait_ms = 0;
+    // Last jittered wait; the next one is drawn from [base, 3 x this].
+    uint32_t backoff_ms = 0;
+    uint16_t failures = 0;
+    int last_status = 0;
+    uint32_t trips = 0;
+    uint32_t probes = 0;
+};
+
+// True when a request may go out now. An open breaker whose wait is over
+// turns half-open here.
+bool service_http_breaker_allow(HttpBreaker& breaker);
+void service_http_breaker_success(HttpBreaker& breaker);
+// Opens for the next jittered wait, or for retry_after_ms when the portal
+// asked for longer (Retry-After).
+void service_http_breaker_failure(HttpBreaker& breaker, int status, uint32_t retry_after_ms = 0);
+// Opens for exactly wait_ms without growing the backoff: a rate limit or a
+// policy delay rather than an unhealthy endpoint.
+void service_http_breaker_hold(HttpBreaker& breaker, int status, uint32_t wait_ms);
+uint32_t service_http_breaker_remaining_ms(const HttpBreaker& breaker);
+const char* service_http_breaker_state_name(HttpBreakerState state);
+
+} // namespace ptc
@@ -0,0 +1,493 @@
+#include "service_http_inflate.h"
+
+#include <esp_heap_caps.h>
+
+#include <cstring>
+#include <new>
+
+namespace ptc {
+
+namespace {
+
+constexpr uint16_t kLengthBase[29] = {3, 4, 5, 6, 7, 8, 9, 10, 11, 13, 15, 17, 19, 23, 27, 31, 35, 43, 51, 59,
+    67, 83, 99, 115, 131, 163, 195, 227, 258};
+constexpr uint8_t kLengthExtra[29] = {0, 0, 0, 0, 0, 0, 0, 0, 1, 1, 1, 1, 2, 2, 2, 2, 3, 3, 3, 3, 4, 4, 4, 4, 5,
+    5, 5, 5, 0};
+constexpr uint16_t kDistanceBase[30] = {1, 2, 3, 4, 5, 7, 9, 13, 17, 25, 33, 49, 65, 97, 129, 193, 257, 385,
+    513, 769, 1025, 1537, 2049, 3073, 4097, 6145, 8193, 12289, 16385, 24577};
+constexpr uint8_t kDistanceExtra[30] = {0, 0, 0, 0, 1, 1, 2, 2, 3, 3, 4, 4, 5, 5, 6, 6, 7, 7, 8, 8, 9, 9, 10,
+    10, 11, 11, 12, 12, 13, 13};
+constexpr uint8_t kCodeLengthOrder[19] = {16, 17, 18, 0, 8, 7, 9, 6, 10, 5, 11, 4, 12, 3, 13, 2, 14, 1, 15};
+// CRC-32 (reflected 0xEDB88320) four bits at a time: 64 bytes of table
+// instead of 1 KB, fast enough next to the Huffman decoding.
+constexpr uint32_t kCrcNibbles[16] = {0x00000000, 0x1db71064, 0x3b6e20c8, 0x26d930ac, 0x76dc4190, 0x6b6b51f4,
+    0x4db26158, 0x5005713c, 0xedb88320, 0xf00f9344, 0xd6d6a3e8, 0xcb61b38c, 0x9b64c2b0, 0x86d3d2d4, 0xa00ae278,
+    0xbdbdf21c};
+constexpr uint32_t kAdlerModulus = 65521;
+constexpr uint16_t kMaxLiteralCodes = 288;
+constexpr uint16_t kMaxDistanceCodes = 32;
+
+// Canonical Huffman code as counts per bit length and symbols in code order;
+// decoding walks the lengths one bit at a time.
+bool build_code(uint16_t* counts, uint16_t* symbols, const uint8_t* lengths, uint16_t count) {
+    memset(counts, 0, 16 * sizeof(uint16_t));
+    for (uint16_t i = 0; i < count; ++i) {
+        counts[lengths[i]]++;
+    }
+    counts[0] = 0;
+    int32_t left = 1;
+    for (uint8_t length = 1; length < 16; ++length) {
+        left = (left << 1) - counts[length];
+        if (left < 0) {
+            return false;
+        }
+    }
+    uint16_t offsets[16] = {};
+    for (uint8_t length = 1; length < 15; ++length) {
+        offsets[length + 1] = offsets[length] + counts[length];
+    }
+    for (uint16_t i = 0; i < count; ++i) {
+        if (lengths[i] != 0) {
+            symbols[offsets[lengths[i]]++] = i;
+        }
+    }
+    return true;
+}
+
+} // namespace
+
+struct InflateStream::Tables {
+    uint16_t literal_counts[16];
+    uint16_t literal_symbols[kMaxLiteralCodes];
+    uint16_t distance_counts[16];
+    uint16_t distance_symbols[kMaxDistanceCodes];
+    uint8_t lengths[kMaxLiteralCodes + kMaxDistanceCodes];
+};
+
+ContentEncoding content_encoding_from_header(const String& value) {
+    String encoding = value;
+    encoding.trim();
+    encoding.toLowerCase();
+    if (encoding.isEmpty() || encoding == "identity") {
+        return ContentEncoding::kIdentity;
+    }
+    if (encoding == "gzip" || encoding == "x-gzip") {
+        return ContentEncoding::kGzip;
+    }
+    if (encoding == "deflate") {
+        return ContentEncoding::kDeflate;
+    }
+    return ContentEncoding::kUnsupported;
+}
+
+InflateStream::InflateStream(Stream& source, ContentEncoding encoding, size_t window_bytes)
+    : source_(source), encoding_(encoding) {
+    // read() never waits; a Stream timeout on top would stall readBytes()
+    // at the end of the output.
+    setTimeout(0);
+    const bool power_of_two = window_bytes >= 256 && window_bytes <= kInflateMaxWindowBytes &&
+        (window_bytes & (window_bytes - 1)) == 0;
+    if (!power_of_two || (encoding != ContentEncoding::kGzip && encoding != ContentEncoding::kDeflate)) {
+        state_ = State::kFailed;
+        return;
+    }
+    window_ = static_cast<uint8_t*>(heap_caps_malloc(window_bytes, MALLOC_CAP_SPIRAM | MALLOC_CAP_8BIT));
+    if (!window_) {
+        window_ = static_cast<uint8_t*>(malloc(window_bytes));
+    }
+    tables_ = new (std::nothrow) Tables();
+    if (!window_ || !tables_) {
+        state_ = State::kFailed;
+        return;
+    }
+    window_mask_ = static_cast<uint32_t>(window_bytes - 1);
+}
+
+InflateStream::~InflateStream() {
+    free(window_);
+    delete tables_;
+}
+
+int InflateStream::available() {
+    if (peeked_ >= 0) {
+        return 1;
+    }
+    return state_ == State::kDone || state_ == State::kFailed ? 0 : 1;
+}
+
+int InflateStream::read() {
+    if (peeked_ >= 0) {
+        const int value = peeked_;
+        peeked_ = -1;
+        return value;
+    }
+    return next_byte();
+}
+
+int InflateStream::peek() {
+    if (peeked_ < 0) {
+        peeked_ = next_byte();
+    }
+    return peeked_;
+}
+
+size_t InflateStream::write(uint8_t) {
+    return 0;
+}
+
+bool InflateStream::read_to_end() {
+    while (read() >= 0) {
+    }
+    return finished();
+}
+
+int InflateStream::fail() {
+    state_ = State::kFailed;
+    return -1;
+}
+
+int InflateStream::source_byte() {
+    // The source (an HttpBodyStream) does its own waiting.
+    return source_.read();
+}
+
+bool InflateStream::bits(uint8_t count, uint32_t& out_value) {
+    while (bit_count_ < count) {
+        const int c = source_byte();
+        if (c < 0) {
+            return false;
+        }
+        bit_buffer_ |= static_cast<uint32_t>(c) << bit_count_;
+        bit_count_ += 8;
+    }
+    out_value = bit_buffer_ & ((1UL << count) - 1);
+    bit_buffer_ >>= count;
+    bit_count_ -= count;
+    return true;
+}
+
+int InflateStream::emit(uint8_t value) {
+    window_[position_ & window_mask_] = value;
+    position_++;
+    produced_++;
+    if (encoding_ == ContentEncoding::kGzip) {
+        uint32_t crc = checksum_ ^ value;
+        crc = (crc >> 4) ^ kCrcNibbles[crc & 0x0F];
+        checksum_ = (crc >> 4) ^ kCrcNibbles[crc & 0x0F];
+    } else if (zlib_) {
+        checksum_ += value;
+        if (checksum_ >= kAdlerModulus) {
+            checksum_ -= kAdlerModulus;
+        }
+        adler_b_ += checksum_;
+        if (adler_b_ >= kAdlerModulus) {
+            adler_b_ -= kAdlerModulus;
+        }
+    }
+    return value;
+}
+
+bool InflateStream::read_header() {
+    uint32_t b0 = 0;
+    uint32_t b1 = 0;
+    if (!bits(8, b0) || !bits(8, b1)) {
+        return false;
+    }
+    if (encoding_ == ContentEncoding::kDeflate) {
+        // "deflate" is meant to be zlib-wrapped, but some servers send raw
+        // DEFLATE; the two header bytes tell them apart.
+        zlib_ = (b0 & 0x0F) == 8 && ((b0 << 8) | b1) % 31 == 0;
+        if (!zlib_) {
+            bit_buffer_ = b0 | (b1 << 8);
+            bit_count_ = 16;
+            return true;
+        }
+        if ((b1 & 0x20) != 0 || (1UL << ((b0 >> 4) + 8)) > window_mask_ + 1) {
+            return false;
+        }
+        checksum_ = 1;
+        return true;
+    }
+
+    uint32_t method = 0;
+    uint32_t flags = 0;
+    uint32_t ignored = 0;
+    if (b0 != 0x1F || b1 != 0x8B || !bits(8, method) || method != 8 || !bits(8, flags) || (flags & 0xE0) != 0) {
+        return false;
+    }
+    // MTIME, XFL, OS.
+    for (uint8_t i = 0; i < 6; ++i) {
+        if (!bits(8, ignored)) {
+            return false;
+        }
+    }
+    if (flags & 0x04) {
+        uint32_t extra = 0;
+        if (!bits(16, extra)) {
+            return false;
+        }
+        while (extra-- > 0) {
+            if (!bits(8, ignored)) {
+                return false;
+            }
+        }
+    }
+    // File name and comment, both zero-terminated.
+    for (const uint32_t flag : {0x08U, 0x10U}) {
+        if ((flags & flag) == 0) {
+            continue;
+        }
+        do {
+            if (!bits(8, ignored)) {
+                return false;
+            }
+        } while (ignored != 0);
+    }
+    if ((flags & 0x02) && !bits(16, ignored)) {
+        return false;
+    }
+    checksum_ = 0xFFFFFFFF;
+    return true;
+}
+
+bool InflateStream::read_dynamic_tables() {
+    uint32_t literal_count = 0;
+    uint32_t distance_count = 0;
+    uint32_t code_length_count = 0;
+    if (!bits(5, literal_count) || !bits(5, distance_count) || !bits(4, code_length_count)) {
+        return false;
+    }
+    literal_count += 257;
+    distance_count += 1;
+    code_length_count += 4;
+    if (literal_count > 286 || distance_count > 30) {
+        return false;
+    }
+
+    uint8_t* lengths = tables_->lengths;
+    memset(lengths, 0, 19);
+    for (uint8_t i = 0; i < code_length_count; ++i) {
+        uint32_t length = 0;
+        if (!bits(3, length)) {
+            return false;
+        }
+        lengths[kCodeLengthOrder[i]] = static_cast<uint8_t>(length);
+    }
+    // The code-length code borrows the literal table until the real one is
+    // built from the lengths it decodes.
+    if (!build_code(tables_->literal_counts, tables_->literal_symbols, lengths, 19)) {
+        return false;
+    }
+
+    const uint16_t total = static_cast<uint16_t>(literal_count + distance_count);
+    uint16_t filled = 0;
+    while (filled < total) {
+        const int symbol = decode_symbol(false);
+        if (symbol < 0) {
+            return false;
+        }
+        if (symbol < 16) {
+            lengths[filled++] = static_cast<uint8_t>(symbol);
+            continue;
+        }
+        uint8_t value = 0;
+        uint32_t repeat = 0;
+        if (symbol == 16) {
+            if (filled == 0 || !bits(2, repeat)) {
+                return false;
+            }
+            value = lengths[filled - 1];
+            repeat += 3;
+        } else if (symbol == 17) {
+            if (!bits(3, repeat)) {
+                return false;
+            }
+            repeat += 3;
+        } else {
+            if (!bits(7, repeat)) {
+                return false;
+            }
+            repeat += 11;
+        }
+        if (filled + repeat > total) {
+            return false;
+        }
+        memset(lengths + filled, value, repeat);
+        filled += static_cast<uint16_t>(repeat);
+    }
+    return lengths[256] != 0 &&
+        build_code(tables_->literal_counts, tables_->literal_symbols, lengths, static_cast<uint16_t>(literal_count)) &&
+        build_code(tables_->distance_counts,
+            tables_->distance_symbols,
+            lengths + literal_count,
+            static_cast<uint16_t>(distance_count));
+}
+
+bool InflateStream::read_block_header() {
+    uint32_t final_block = 0;
+    uint32_t type = 0;
+    if (!bits(1, final_block) || !bits(2, type)) {
+        return false;
+    }
+    final_block_ = final_block != 0;
+    if (type == 0) {
+        bit_buffer_ >>= bit_count_ % 8;
+        bit_count_ -= bit_count_ % 8;
+        uint32_t length = 0;
+        uint32_t complement = 0;
+        if (!bits(16, length) || !bits(16, complement) || (length ^ complement) != 0xFFFF) {
+            return false;
+        }
+        stored_left_ = static_cast<uint16_t>(length);
+        state_ = State::kStored;
+        return true;
+    }
+    if (type == 1) {
+        uint8_t* lengths = tables_->lengths;
+        memset(lengths, 8, 144);
+        memset(lengths + 144, 9, 112);
+        memset(lengths + 256, 7, 24);
+        memset(lengths + 280, 8, 8);
+        build_code(tables_->literal_counts, tables_->literal_symbols, lengths, kMaxLiteralCodes);
+        memset(lengths, 5, 30);
+        build_code(tables_->distance_counts, tables_->distance_symbols, lengths, 30);
+        state_ = State::kCodes;
+        return true;
+    }
+    if (type == 2 && read_dynamic_tables()) {
+        state_ = State::kCodes;
+        return true;
+    }
+    return false;
+}
+
+bool InflateStream::read_trailer() {
+    bit_buffer_ >>= bit_count_ % 8;
+    bit_count_ -= bit_count_ % 8;
+    if (encoding_ == ContentEncoding::kGzip) {
+        uint32_t crc_low = 0;
+        uint32_t crc_high = 0;
+        uint32_t size_low = 0;
+        uint32_t size_high = 0;
+        return bits(16, crc_low) && bits(16, crc_high) && bits(16, size_low) && bits(16, size_high) &&
+            ((crc_high << 16) | crc_low) == ~checksum_ && ((size_high << 16) | size_low) == produced_;
+    }
+    if (!zlib_) {
+        return true;
+    }
+    uint32_t adler = 0;
+    for (uint8_t i = 0; i < 4; ++i) {
+        uint32_t byte = 0;
+        if (!bits(8, byte)) {
+            return false;
+        }
+        adler = (adler << 8) | byte;
+    }
+    return adler == ((adler_b_ << 16) | checksum_);
+}
+
+int InflateStream::decode_symbol(bool distance) {
+    const uint16_t* counts = distance ? tables_->distance_counts : tables_->literal_counts;
+    const uint16_t* symbols = distance ? tables_->distance_symbols : tables_->literal_symbols;
+    int32_t code = 0;
+    int32_t first = 0;
+    int32_t index = 0;
+    for (uint8_t length = 1; length < 16; ++length) {
+        uint32_t bit = 0;
+        if (!bits(1, bit)) {
+            return -1;
+        }
+        code |= static_cast<int32_t>(bit);
+        const int32_t count = counts[length];
+        if (code - first < count) {
+            return symbols[index + code - first];
+        }
+        index += count;
+        first = (first + count) << 1;
+        code <<= 1;
+    }
+    return -1;
+}
+
+int InflateStream::next_byte() {
+    while (true) {
+        switch (state_) {
+            case State::kHeader:
+                if (!read_header()) {
+                    return fail();
+                }
+                state_ = State::kBlock;
+                break;
+            case State::kBlock:
+                if (final_block_) {
+                    if (!read_trailer()) {
+                        return fail();
+                    }
+                    state_ = State::kDone;
+                    return -1;
+                }
+                if (!read_block_header()) {
+                    return fail();
+                }
+                break;
+            case State::kStored: {
+                if (stored_left_ == 0) {
+                    state_ = State::kBlock;
+                    break;
+                }
+                uint32_t value = 0;
+                if (!bits(8, value)) {
+                    return fail();
+                }
+                stored_left_--;
+                return emit(static_cast<uint8_t>(value));
+            }
+            case State::kCodes: {
+                const int symbol = decode_symbol(false);
+                if (symbol < 0) {
+                    return fail();
+                }
+                if (symbol < 256) {
+                    return emit(static_cast<uint8_t>(symbol));
+                }
+                if (symbol == 256) {
+                    state_ = State::kBlock;
+                    break;
+                }
+                const int length_code = symbol - 257;
+                uint32_t length_extra = 0;
+                uint32_t distance_extra = 0;
+                if (length_code >= 29 || !bits(kLengthExtra[length_code], length_extra)) {
+                    return fail();
+                }
+                const int distance_code = decode_symbol(true);
+                if (distance_code < 0 || distance_code >= 30 ||
+                    !bits(kDistanceExtra[distance_code], distance_extra)) {
+                    return fail();
+                }
+                const uint32_t distance = kDistanceBase[distance_code] + distance_extra;
+                // Reaching back past the output or past the window this
+                // stream was given is corrupt input or too large a window.
+                if (distance > produced_ || distance > window_mask_ + 1) {
+                    return fail();
+                }
+                copy_left_ = static_cast<uint16_t>(kLengthBase[length_code] + length_extra);
+                copy_distance_ = static_cast<uint16_t>(distance);
+                state_ = State::kCopy;
+                break;
+            }
+            case State::kCopy: {
+                const uint8_t value = window_[(position_ - copy_distance_) & window_mask_];
+                if (--copy_left_ == 0) {
+                    state_ = State::kCodes;
+                }
+                return emit(value);
+            }
+            case State::kDone:
+            case State::kFailed:
+                return -1;
+        }
+    }
+}
+
+} // namespace ptc
@@ -0,0 +1,100 @@
+#pragma once
+
+#include "config.h"
+
+namespace ptc {
+
+enum class ContentEncoding : uint8_t {
+    kIdentity,
+    kGzip,
+    kDeflate,
+    kUnsupported,
+};
+
+// Value sent as Accept-Encoding on requests whose body is read through
+// InflateStream.
+constexpr const char* kAcceptCompressed = "gzip, deflate";
+// Largest window DEFLATE allows; gzip does not declare a smaller one.
+constexpr size_t kInflateMaxWindowBytes = 32768;
+
+ContentEncoding content_encoding_from_header(const String& value);
+
+// Inflates a gzip (RFC 1952), zlib (RFC 1950) or raw DEFLATE body as it is
+// read, one byte at a time, so a JSON parser can consume the decoded bytes
+// in place. Memory is the history window plus ~1.3 KB of code tables; the
+// window is taken from PSRAM when there is some. The trailer checksum and
+// length are verified once the final block has been read.
+class InflateStream : public Stream {
+public:
+    // window_bytes (a power of two up to kInflateMaxWindowBytes) bounds the
+    // history kept; a zlib stream declaring a larger window, or any back
+    // reference further than that, fails the stream.
+    InflateStream(Stream& source, ContentEncoding encoding, size_t window_bytes = kInflateMaxWindowBytes);
+    ~InflateStream();
+    InflateStream(const InflateStream&) = delete;
+    InflateStream& operator=(const InflateStream&) = delete;
+
+    int available() override;
+    int read() override;
+    int peek() override;
+    size_t write(uint8_t value) override;
+
+    // Reads whatever a parser left after its closing bracket through the
+    // trailer. True when the stream ended on a trailer that matched.
+    bool read_to_end();
+
+    bool failed() const {
+        return state_ == State::kFailed;
+    }
+    // True once the trailer has been read and matched the output.
+    bool finished() const {
+        return state_ == State::kDone;
+    }
+    uint32_t produced() const {
+        return produced_;
+    }
+
+private:
+    enum class State : uint8_t {
+        kHeader,
+        kBlock,
+        kStored,
+        kCodes,
+        kCopy,
+        kDone,
+        kFailed,
+    };
+    struct Tables;
+
+    int next_byte();
+    int emit(uint8_t value);
+    int fail();
+    int source_byte();
+    bool bits(uint8_t count, uint32_t& out_value);
+    bool read_header();
+    bool read_block_header();
+    bool read_dynamic_tables();
+    bool read_trailer();
+    int decode_symbol(bool distance);
+
+    Stream& source_;
+    ContentEncoding encoding_;
+    State state_ = State::kHeader;
+    Tables* tables_ = nullptr;
+    uint8_t* window_ = nullptr;
+    uint32_t window_mask_ = 0;
+    uint32_t position_ = 0;
+    uint32_t produced_ = 0;
+    uint32_t checksum_ = 0;
+    uint32_t adler_b_ = 0;
+    uint32_t bit_buffer_ = 0;
+    uint8_t bit_count_ = 0;
+    bool final_block_ = false;
+    bool zlib_ = false;
+    uint16_t stored_left_ = 0;
+    uint16_t copy_left_ = 0;
+    uint16_t copy_distance_ = 0;
+    int peeked_ = -1;
+};
+
+} // namespace ptc
@@ -0,0 +1,82 @@
+#include "service_http_queue.h"
+
+namespace ptc {
+
+bool service_http_queue_init(HttpQueue& queue) {
+    if (!queue.lock) {
+        queue.lock = xSemaphoreCreateMutex();
+    }
+    return queue.lock != nullptr;
+}
+
+bool service_http_queue_push(HttpQueue& queue, uint8_t slot, void* item, void*& out_replaced) {
+    out_replaced = nullptr;
+    if (slot >= kHttpQueueSlots || !item) {
+        return false;
+    }
+    xSemaphoreTake(queue.lock, portMAX_DELAY);
+    void* replaced = queue.items[slot];
+    if (replaced) {
+        queue.coalesced++;
+    } else {
+        queue.depth++;
+        queue.enqueued_ms[slot] = millis();
+    }
+    __atomic_store_n(&queue.items[slot], item, __ATOMIC_RELEASE);
+    queue.pushed++;
+    xSemaphoreGive(queue.lock);
+    out_replaced = replaced;
+    return true;
+}
+
+bool service_http_queue_requeue(HttpQueue& queue, uint8_t slot, void* item) {
+    if (slot >= kHttpQueueSlots || !item) {
+        return false;
+    }
+    xSemaphoreTake(queue.lock, portMAX_DELAY);
+    const bool free_slot = queue.items[slot] == nullptr;
+    if (free_slot) {
+        queue.depth++;
+        queue.enqueued_ms[slot] = millis();
+        __atomic_store_n(&queue.items[slot], item, __ATOMIC_RELEASE);
+    }
+    xSemaphoreGive(queue.lock);
+    return free_slot;
+}
+
+void* service_http_queue_pop(HttpQueue& queue, uint8_t& out_slot, uint32_t& out_waited_ms) {
+    void* item = nullptr;
+    xSemaphoreTake(queue.lock, portMAX_DELAY);
+    for (uint8_t slot = 0; slot < kHttpQueueSlots; ++slot) {
+        if (queue.items[slot]) {
+            item = queue.items[slot];
+            __atomic_store_n(&queue.items[slot], static_cast<void*>(nullptr), __ATOMIC_RELEASE);
+            queue.depth--;
+            out_slot = slot;
+            out_waited_ms = millis() - queue.enqueued_ms[slot];
+            break;
+        }
+    }
+    xSemaphoreGive(queue.lock);
+    return item;
+}
+
+uint8_t service_http_queue_head(const HttpQueue& queue) {
+    for (uint8_t slot = 0; slot < kHttpQueueSlots; ++slot) {
+        if (__atomic_load_n(&queue.items[slot], __ATOMIC_ACQUIRE)) {
+            return slot;
+        }
+    }
+    return kHttpQueueEmpty;
+}
+
+bool service_http_queue_pending(const HttpQueue& queue, uint8_t slot) {
+    return slot < kHttpQueueSlots && __atomic_load_n(&queue.items[slot], __ATOMIC_ACQUIRE) != nullptr;
+}
+
+bool service_http_queue_urgent(const HttpQueue& queue, uint8_t max_slot) {
+    const uint8_t head = service_http_queue_head(queue);
+    return head != kHttpQueueEmpty && head <= max_slot;
+}
+
+} // namespace ptc
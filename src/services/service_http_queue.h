@@ -0,0 +1,42 @@
+#pragma once
+
+#include <freertos/FreeRTOS.h>
+#include <freertos/semphr.h>
+
+#include "config.h"
+
+namespace ptc {
+
+// Pending work for the portal HTTP worker. Every request kind owns one slot
+// and lower slots are served first. Pushing into a slot that still holds a
+// queued item replaces it (the newer request wins), so the depth is bounded
+// by the number of slots. Items are opaque; the caller owns them.
+static constexpr uint8_t kHttpQueueSlots = 8;
+static constexpr uint8_t kHttpQueueEmpty = 0xFF;
+
+struct HttpQueue {
+    void* items[kHttpQueueSlots] = {};
+    uint32_t enqueued_ms[kHttpQueueSlots] = {};
+    uint8_t depth = 0;
+    uint32_t pushed = 0;
+    uint32_t coalesced = 0;
+    SemaphoreHandle_t lock = nullptr;
+};
+
+bool service_http_queue_init(HttpQueue& queue);
+// out_replaced is the item that was waiting in the slot, or nullptr. False,
+// with item still the caller's, when slot is out of range or item is null.
+bool service_http_queue_push(HttpQueue& queue, uint8_t slot, void* item, void*& out_replaced);
+// Puts a preempted item back unless a newer one has taken its slot.
+bool service_http_queue_requeue(HttpQueue& queue, uint8_t slot, void* item);
+// Removes the highest-priority item; nullptr when the queue is empty.
+void* service_http_queue_pop(HttpQueue& queue, uint8_t& out_slot, uint32_t& out_waited_ms);
+// Slot of the highest-priority waiting item, or kHttpQueueEmpty. Lock-free,
+// cheap enough to poll while a response body streams in.
+uint8_t service_http_queue_head(const HttpQueue& queue);
+bool service_http_queue_pending(const HttpQueue& queue, uint8_t slot);
+// True when an item in slot max_slot or higher priority is waiting; a worker
+// streaming a preemptible response checks this between chunks.
+bool service_http_queue_urgent(const HttpQueue& queue, uint8_t max_slot);
+
+} // namespace ptc
@@ -0,0 +1,338 @@
+#include "service_http_stream.h"
+
+namespace ptc {
+
+namespace {
+
+int hex_value(int c) {
+    if (c >= '0' && c <= '9') {
+        return c - '0';
+    }
+    if (c >= 'a' && c <= 'f') {
+        return c - 'a' + 10;
+    }
+    if (c >= 'A' && c <= 'F') {
+        return c - 'A' + 10;
+    }
+    return -1;
+}
+
+bool json_whitespace(int c) {
+    return c == ' ' || c == '\t' || c == '\r' || c == '\n';
+}
+
+} // namespace
+
+HttpBodyStream::HttpBodyStream(WiFiClient& source, int content_length, bool chunked, uint32_t timeout_ms)
+    : source_(source),
+      remaining_(chunked ? 0 : content_length),
+      chunked_(chunked),
+      timeout_ms_(timeout_ms) {
+    finished_ = !chunked && content_length == 0;
+    // read() does its own waiting; a Stream timeout on top would stall
+    // readBytes() at the end of the body.
+    setTimeout(0);
+}
+
+int HttpBodyStream::available() {
+    if (finished_ || failed_) {
+        return 0;
+    }
+    const int pending = static_cast<int>(buffered_ - offset_);
+    if (pending > 0) {
+        return pending;
+    }
+    const int source = source_.available();
+    return remaining_ > 0 ? min(source, static_cast<int>(remaining_)) : (remaining_ < 0 ? source : 0);
+}
+
+int HttpBodyStream::read() {
+    return body_byte(true);
+}
+
+int HttpBodyStream::peek() {
+    return body_byte(false);
+}
+
+size_t HttpBodyStream::write(uint8_t) {
+    return 0;
+}
+
+bool HttpBodyStream::drain() {
+    while (body_byte(true) >= 0) {
+    }
+    return finished_;
+}
+
+bool HttpBodyStream::fail() {
+    failed_ = true;
+    return false;
+}
+
+int HttpBodyStream::source_byte(bool consume) {
+    if (offset_ >= buffered_) {
+        const uint32_t started_ms = millis();
+        while (source_.available() <= 0) {
+            if (!source_.connected()) {
+                if (remaining_ < 0) {
+                    finished_ = true;
+                } else {
+                    failed_ = true;
+                }
+                return -1;
+            }
+            if (millis() - started_ms >= timeout_ms_) {
+                failed_ = true;
+                return -1;
+            }
+            delay(1);
+        }
+        // Chunk headers are read a byte at a time so the buffer never runs
+        // ahead of the body.
+        size_t want = remaining_ < 0 ? sizeof(buffer_) : min(sizeof(buffer_), static_cast<size_t>(remaining_));
+        want = min(want, static_cast<size_t>(source_.available()));
+        const int count = source_.read(buffer_, max(want, static_cast<size_t>(1)));
+        if (count <= 0) {
+            failed_ = true;
+            return -1;
+        }
+        buffered_ = static_cast<uint8_t>(count);
+        offset_ = 0;
+    }
+    return consume ? buffer_[offset_++] : buffer_[offset_];
+}
+
+bool HttpBodyStream::next_chunk() {
+    if (chunk_crlf_ && (source_byte(true) != '\r' || source_byte(true) != '\n')) {
+        return fail();
+    }
+    uint32_t size = 0;
+    uint8_t digits = 0;
+    bool extension = false;
+    while (true) {
+        const int c = source_byte(true);
+        if (c < 0) {
+            return fail();
+        }
+        if (c == '\n') {
+            break;
+        }
+        if (c == '\r' || extension) {
+            continue;
+        }
+        if (c == ';' || c == ' ' || c == '\t') {
+            extension = true;
+            continue;
+        }
+        const int value = hex_value(c);
+        if (value < 0 || ++digits > 7) {
+            return fail();
+        }
+        size = (size << 4) | static_cast<uint32_t>(value);
+    }
+    if (digits == 0) {
+        return fail();
+    }
+    if (size > 0) {
+        remaining_ = static_cast<int32_t>(size);
+        chunk_crlf_ = true;
+        return true;
+    }
+
+    // Last chunk: skip any trailer fields up to the empty line.
+    uint16_t line_length = 0;
+    while (true) {
+        const int c = source_byte(true);
+        if (c < 0) {
+            return fail();
+        }
+        if (c == '\n') {
+            if (line_length == 0) {
+                break;
+            }
+            line_length = 0;
+        } else if (c != '\r') {
+            line_length++;
+        }
+    }
+    finished_ = true;
+    return false;
+}
+
+int HttpBodyStream::body_byte(bool consume) {
+    if (finished_ || failed_) {
+        return -1;
+    }
+    if (remaining_ == 0 && !next_chunk()) {
+        return -1;
+    }
+    const int c = source_byte(consume);
+    if (c < 0 || !consume) {
+        return c;
+    }
+    consumed_++;
+    if (remaining_ > 0 && --remaining_ == 0 && !chunked_) {
+        finished_ = true;
+    }
+    return c;
+}
+
+int json_peek(Stream& stream) {
+    int c = stream.peek();
+    while (json_whitespace(c)) {
+        stream.read();
+        c = stream.peek();
+    }
+    return c;
+}
+
+int JsonArrayReader::skip_whitespace(bool consume) {
+    int c = stream_.peek();
+    while (json_whitespace(c)) {
+        stream_.read();
+        c = stream_.peek();
+    }
+    if (consume && c >= 0) {
+        stream_.read();
+    }
+    return c;
+}
+
+JsonArrayStep JsonArrayReader::next(JsonDocument& element, JsonDocument& filter) {
+    if (done_) {
+        return JsonArrayStep::kEnd;
+    }
+    if (!started_) {
+        if (skip_whitespace(true) != '[') {
+            done_ = true;
+            return JsonArrayStep::kError;
+        }
+        started_ = true;
+        if (skip_whitespace(false) == ']') {
+            stream_.read();
+            done_ = true;
+            return JsonArrayStep::kEnd;
+        }
+    }
+
+    // deserializeJson() stops at the end of the element, leaving the
+    // separator in the stream.
+    const DeserializationError error =
+        deserializeJson(element, stream_, DeserializationOption::Filter(filter));
+    const int separator = skip_whitespace(true);
+    if (error != DeserializationError::Ok || (separator != ',' && separator != ']')) {
+        done_ = true;
+        return JsonArrayStep::kError;
+    }
+    done_ = separator == ']';
+    return JsonArrayStep::kElement;
+}
+
+int JsonObjectReader::skip_whitespace(bool consume) {
+    int c = stream_.peek();
+    while (json_whitespace(c)) {
+        stream_.read();
+        c = stream_.peek();
+    }
+    if (consume && c >= 0) {
+        stream_.read();
+    }
+    return c;
+}
+
+JsonArrayStep JsonObjectReader::next_key(String& key) {
+    if (done_) {
+        return JsonArrayStep::kEnd;
+    }
+    const int c = skip_whitespace(true);
+    if (!started_) {
+        started_ = true;
+        if (c != '{') {
+            done_ = true;
+            return JsonArrayStep::kError;
+        }
+        if (skip_whitespace(false) == '}') {
+            stream_.read();
+            done_ = true;
+            return JsonArrayStep::kEnd;
+        }
+    } else if (c == '}') {
+        done_ = true;
+        return JsonArrayStep::kEnd;
+    } else if (c != ',') {
+        done_ = true;
+        return JsonArrayStep::kError;
+    }
+    if (!read_string(key, 32) || skip_whitespace(true) != ':') {
+        done_ = true;
+        return JsonArrayStep::kError;
+    }
+    skip_whitespace(false);
+    return JsonArrayStep::kElement;
+}
+
+bool JsonObjectReader::read_string(String& value, size_t max_length) {
+    value = "";
+    if (skip_whitespace(true) != '"') {
+        return false;
+    }
+    while (true) {
+        int c = stream_.read();
+        if (c < 0) {
+            return false;
+        }
+        if (c == '"') {
+            return true;
+        }
+        // Keys and validators only ever escape quotes and backslashes, so
+        // an escape keeps the character after the backslash.
+        if (c == '\\' && (c = stream_.read()) < 0) {
+            return false;
+        }
+        if (value.length() >= max_length) {
+            return false;
+        }
+        value += static_cast<char>(c);
+    }
+}
+
+bool JsonObjectReader::skip_value() {
+    const int c = skip_whitespace(false);
+    if (c == '"') {
+        stream_.read();
+        for (int next = stream_.read(); next != '"'; next = stream_.read()) {
+            if (next < 0 || (next == '\\' && stream_.read() < 0)) {
+                return false;
+            }
+        }
+        return true;
+    }
+    if (c == '{' || c == '[') {
+        // An empty filter parses the value without storing any of it.
+        StaticJsonDocument<16> filter;
+        StaticJsonDocument<16> ignored;
+        return deserializeJson(ignored, stream_, DeserializationOption::Filter(filter)) ==
+            DeserializationError::Ok;
+    }
+    String ignored;
+    return read_scalar(ignored, 0);
+}
+
+bool JsonObjectReader::read_scalar(String& value, size_t max_length) {
+    value = "";
+    // Numbers and literals end at the next separator, which deserializeJson()
+    // would consume along with the value.
+    int length = 0;
+    for (int next = skip_whitespace(false); next >= 0 && next != ',' && next != '}' && next != ']' &&
+         !json_whitespace(next);
+         next = stream_.peek()) {
+        stream_.read();
+        if (value.length() < max_length) {
+            value += static_cast<char>(next);
+        }
+        length++;
+    }
+    return length > 0;
+}
+
+} // namespace ptc
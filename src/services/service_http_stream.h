@@ -0,0 +1,134 @@
+#pragma once
+
+#include <ArduinoJson.h>
+#include <WiFiClient.h>
+
+#include "config.h"
+
+namespace ptc {
+
+// Response body reader over the raw connection. It undoes chunked transfer
+// encoding and stops at the end of the body, so a parser can consume the
+// body in place and a kept-alive connection stays usable afterwards.
+class HttpBodyStream : public Stream {
+public:
+    // content_length < 0 with chunked false reads until the peer closes.
+    HttpBodyStream(WiFiClient& source, int content_length, bool chunked, uint32_t timeout_ms);
+
+    int available() override;
+    int read() override;
+    int peek() override;
+    size_t write(uint8_t value) override;
+
+    // Reads and discards the rest of the body; false if it did not arrive.
+    bool drain();
+    bool finished() const {
+        return finished_;
+    }
+    bool failed() const {
+        return failed_;
+    }
+    uint32_t consumed() const {
+        return consumed_;
+    }
+
+private:
+    bool next_chunk();
+    int body_byte(bool consume);
+    int source_byte(bool consume);
+    bool fail();
+
+    WiFiClient& source_;
+    // Body bytes left in the current chunk (or the whole body); 0 between
+    // chunks, -1 when the body runs until the connection closes.
+    int32_t remaining_;
+    bool chunked_;
+    bool chunk_crlf_ = false;
+    bool finished_ = false;
+    bool failed_ = false;
+    uint32_t timeout_ms_;
+    uint32_t consumed_ = 0;
+    // Never holds bytes past the body, so nothing of a following response is
+    // taken off the socket.
+    uint8_t buffer_[128];
+    uint8_t buffered_ = 0;
+    uint8_t offset_ = 0;
+};
+
+// Stream over a buffer the caller keeps alive, for cached bodies.
+class MemoryStream : public Stream {
+public:
+    MemoryStream(const char* data, size_t length) : data_(data), length_(length) {}
+
+    int available() override {
+        return static_cast<int>(length_ - offset_);
+    }
+    int read() override {
+        return offset_ < length_ ? static_cast<uint8_t>(data_[offset_++]) : -1;
+    }
+    int peek() override {
+        return offset_ < length_ ? static_cast<uint8_t>(data_[offset_]) : -1;
+    }
+    size_t write(uint8_t) override {
+        return 0;
+    }
+
+private:
+    const char* data_;
+    size_t length_;
+    size_t offset_ = 0;
+};
+
+// Skips whitespace and returns the next byte without consuming it, so a
+// caller can tell an array from an object; -1 at the end of the stream.
+int json_peek(Stream& stream);
+
+// Walks a top-level JSON array one element at a time, so memory depends on
+// the largest element rather than on the length of the array.
+enum class JsonArrayStep : uint8_t {
+    kElement,
+    kEnd,
+    kError,
+};
+
+class JsonArrayReader {
+public:
+    explicit JsonArrayReader(Stream& stream) : stream_(stream) {}
+
+    // Deserializes the next element into element, keeping only the fields
+    // set in filter. kError covers malformed input and elements too large
+    // for the document.
+    JsonArrayStep next(JsonDocument& element, JsonDocument& filter);
+
+private:
+    int skip_whitespace(bool consume);
+
+    Stream& stream_;
+    bool started_ = false;
+    bool done_ = false;
+};
+
+// Walks the members of a top-level JSON object. After next_key() returns
+// kElement the member's value is next in the stream, and the caller consumes
+// it with deserializeJson(), a JsonArrayReader, read_string() or
+// skip_value() before asking for the next key.
+class JsonObjectReader {
+public:
+    explicit JsonObjectReader(Stream& stream) : stream_(stream) {}
+
+    JsonArrayStep next_key(String& key);
+    // Reads a string value of at most max_length characters.
+    bool read_string(String& value, size_t max_length = 128);
+    // Reads a number or literal (true, false, null) as its text.
+    bool read_scalar(String& value, size_t max_length = 16);
+    bool skip_value();
+
+private:
+    int skip_whitespace(bool consume);
+
+    Stream& stream_;
+    bool started_ = false;
+    bool done_ = false;
+};
+
+} // namespace ptc
@@ -0,0 +1,191 @@
+#include "service_http_timing.h"
+
+#include <WiFi.h>
+#include <freertos/FreeRTOS.h>
+#include <freertos/semphr.h>
+
+namespace ptc {
+
+namespace {
+
+struct Target {
+    HttpTimingStats stats;
+    // Rolling averages in 1/8 ms, so small phases do not round away.
+    uint32_t dns_x8 = 0;
+    uint32_t connect_x8 = 0;
+    uint32_t ttfb_x8 = 0;
+    uint32_t body_x8 = 0;
+    bool sampled = false;
+    bool opened_sampled = false;
+};
+
+Target g_targets[kHttpTimingMaxTargets];
+uint8_t g_target_count = 0;
+SemaphoreHandle_t g_lock = nullptr;
+
+// Weight 1/8 for the new sample; the first sample seeds the average.
+void roll(uint32_t& average_x8, uint32_t sample_ms, bool seeded) {
+    const uint32_t sample_x8 = sample_ms * 8;
+    average_x8 = seeded ? average_x8 - average_x8 / 8 + sample_x8 / 8 : sample_x8;
+}
+
+Target* find_target(const char* name) {
+    for (uint8_t i = 0; i < g_target_count; ++i) {
+        if (strcmp(g_targets[i].stats.name, name) == 0) {
+            return &g_targets[i];
+        }
+    }
+    if (g_target_count >= kHttpTimingMaxTargets) {
+        return nullptr;
+    }
+    Target& target = g_targets[g_target_count++];
+    target = Target();
+    target.stats.name = name;
+    return &target;
+}
+
+// "https://host[:port]/path" -> host and port.
+bool split_host(const String& url, String& host, uint16_t& port) {
+    const int scheme_end = url.indexOf("://");
+    if (scheme_end < 0) {
+        return false;
+    }
+    const int host_start = scheme_end + 3;
+    int host_end = url.indexOf('/', host_start);
+    if (host_end < 0) {
+        host_end = url.length();
+    }
+    const int colon = url.indexOf(':', host_start);
+    port = url.startsWith("https") ? 443 : 80;
+    if (colon >= 0 && colon < host_end) {
+        port = static_cast<uint16_t>(url.substring(colon + 1, host_end).toInt());
+        host_end = colon;
+    }
+    host = url.substring(host_start, host_end);
+    return !host.isEmpty() && port != 0;
+}
+
+} // namespace
+
+void service_http_timing_init() {
+    if (!g_lock) {
+        g_lock = xSemaphoreCreateMutex();
+    }
+    if (g_lock) {
+        xSemaphoreTake(g_lock, portMAX_DELAY);
+        g_target_count = 0;
+        xSemaphoreGive(g_lock);
+    }
+}
+
+bool service_http_timing_connect(WiFiClientSecure& client, const String& url, uint32_t timeout_ms,
+    HttpPhases& phases) {
+    String host;
+    uint16_t port = 0;
+    if (!split_host(url, host, port)) {
+        return false;
+    }
+    phases.opened = true;
+    uint32_t started_ms = millis();
+    IPAddress address;
+    const bool resolved = WiFi.hostByName(host.c_str(), address) == 1;
+    phases.dns_ms = millis() - started_ms;
+    if (!resolved) {
+        phases.dns_failed = true;
+        return false;
+    }
+    // Connecting by name again keeps SNI and certificate checks on the host
+    // name; the lookup is answered from the resolver's cache.
+    started_ms = millis();
+    const bool connected = client.connect(host.c_str(), port, static_cast<int32_t>(timeout_ms)) == 1;
+    phases.connect_ms = millis() - started_ms;
+    return connected;
+}
+
+void service_http_timing_record(const char* name, const HttpPhases& phases, bool failed) {
+    if (!g_lock) {
+        return;
+    }
+    xSemaphoreTake(g_lock, portMAX_DELAY);
+    Target* target = find_target(name);
+    if (target) {
+        HttpTimingStats& stats = target->stats;
+        stats.count++;
+        stats.failures += failed ? 1 : 0;
+        stats.bytes += phases.bytes;
+        stats.max_total_ms = max(stats.max_total_ms,
+            phases.dns_ms + phases.connect_ms + phases.ttfb_ms + phases.body_ms);
+        if (phases.opened) {
+            stats.opened++;
+            roll(target->dns_x8, phases.dns_ms, target->opened_sampled);
+            roll(target->connect_x8, phases.connect_ms, target->opened_sampled);
+            target->opened_sampled = true;
+        }
+        if (phases.answered) {
+            roll(target->ttfb_x8, phases.ttfb_ms, target->sampled);
+            roll(target->body_x8, phases.body_ms, target->sampled);
+            target->sampled = true;
+        }
+        stats.dns_ms = target->dns_x8 / 8;
+        stats.connect_ms = target->connect_x8 / 8;
+        stats.ttfb_ms = target->ttfb_x8 / 8;
+        stats.body_ms = target->body_x8 / 8;
+    }
+    xSemaphoreGive(g_lock);
+}
+
+uint8_t service_http_timing_count() {
+    return g_target_count;
+}
+
+bool service_http_timing_stats(uint8_t index, HttpTimingStats& out_stats) {
+    if (!g_lock || index >= g_target_count) {
+        return false;
+    }
+    xSemaphoreTake(g_lock, portMAX_DELAY);
+    out_stats = g_targets[index].stats;
+    xSemaphoreGive(g_lock);
+    return true;
+}
+
+void service_http_timing_reset_window() {
+    if (!g_lock) {
+        return;
+    }
+    xSemaphoreTake(g_lock, portMAX_DELAY);
+    for (uint8_t i = 0; i < g_target_count; ++i) {
+        HttpTimingStats& stats = g_targets[i].stats;
+        stats.count = 0;
+        stats.failures = 0;
+        stats.opened = 0;
+        stats.bytes = 0;
+        stats.max_total_ms = 0;
+    }
+    xSemaphoreGive(g_lock);
+}
+
+size_t service_http_timing_json_size() {
+    const uint8_t count = service_http_timing_count();
+    return JSON_OBJECT_SIZE(count) + count * JSON_OBJECT_SIZE(9);
+}
+
+void service_http_timing_write_json(JsonObject target) {
+    for (uint8_t i = 0; i < service_http_timing_count(); ++i) {
+        HttpTimingStats stats;
+        if (!service_http_timing_stats(i, stats) || stats.count == 0) {
+            continue;
+        }
+        JsonObject item = target.createNestedObject(stats.name);
+        item["n"] = stats.count;
+        item["fail"] = stats.failures;
+        item["open"] = stats.opened;
+        item["dns"] = stats.dns_ms;
+        item["connect"] = stats.connect_ms;
+        item["ttfb"] = stats.ttfb_ms;
+        item["body"] = stats.body_ms;
+        item["max"] = stats.max_total_ms;
+        item["bytes"] = stats.bytes;
+    }
+}
+
+} // namespace ptc
@@ -0,0 +1,68 @@
+#pragma once
+
+#include <ArduinoJson.h>
+#include <WiFiClientSecure.h>
+
+#include "config.h"
+
+namespace ptc {
+
+// Where the time of each HTTP exchange goes, per target (a portal request
+// kind, the GitHub release check, the firmware download), so a slow DNS
+// server, a slow portal and a weak link show up as different phases rather
+// than one "status=-1". The worker and the OTA task record; the loop reads.
+static constexpr uint8_t kHttpTimingMaxTargets = 12;
+
+// One exchange, in milliseconds. dns and connect stay 0 when the request
+// went out on a connection that was already open.
+struct HttpPhases {
+    uint32_t dns_ms = 0;
+    // TCP connect and TLS handshake; WiFiClientSecure does both in one call.
+    uint32_t connect_ms = 0;
+    // From sending the request until the status line and headers are in.
+    uint32_t ttfb_ms = 0;
+    uint32_t body_ms = 0;
+    // Response body bytes as they came off the connection.
+    uint32_t bytes = 0;
+    bool opened = false;
+    bool dns_failed = false;
+    // A status line came back, so ttfb and body mean something.
+    bool answered = false;
+};
+
+struct HttpTimingStats {
+    const char* name = "";
+    // Since the last report (heartbeat or sync).
+    uint32_t count = 0;
+    uint32_t failures = 0;
+    uint32_t opened = 0;
+    uint32_t bytes = 0;
+    uint32_t max_total_ms = 0;
+    // Rolling averages over recent requests (1/8 weight for the newest);
+    // dns and connect only over requests that opened a connection.
+    uint32_t dns_ms = 0;
+    uint32_t connect_ms = 0;
+    uint32_t ttfb_ms = 0;
+    uint32_t body_ms = 0;
+};
+
+// Called from service_http_init(), before the OTA task starts recording.
+void service_http_timing_init();
+// Opens client to the host in url ahead of HTTPClient, timing the DNS lookup
+// and the connect apart; HTTPClient then sends on the open connection. The
+// connect (TCP and TLS handshake) gives up after timeout_ms, as HTTPClient's
+// own connect would. False when either step failed.
+bool service_http_timing_connect(WiFiClientSecure& client, const String& url, uint32_t timeout_ms,
+    HttpPhases& phases);
+// name must outlive the target (string literals in practice).
+void service_http_timing_record(const char* name, const HttpPhases& phases, bool failed);
+uint8_t service_http_timing_count();
+bool service_http_timing_stats(uint8_t index, HttpTimingStats& out_stats);
+void service_http_timing_reset_window();
+// {"activity":{"n":..,"fail":..,"open":..,"dns":..,"connect":..,"ttfb":..,
+// "body":..,"max":..,"bytes":..},...} for targets used since the last report.
+void service_http_timing_write_json(JsonObject target);
+// Capacity service_http_timing_write_json needs with every target reporting.
+size_t service_http_timing_json_size();
+
+} // namespace ptc
@@ -3,6 +3,7 @@
 #include <vector>
 #include <time.h>
 
+#include "service_outbox.h"
 #include "service_storage.h"
 
 namespace ptc {
@@ -17,12 +18,12 @@ constexpr uint16_t kActivityCacheEntries = 50;
 
 void service_log_init() {
     service_storage_load_recent_activity(g_activity, kActivityCacheEntries);
+    service_outbox_init();
     g_revision++;
 }
 
 void service_log_tick(DeviceConfig& config, AppState& state) {
-    (void)config;
-    (void)state;
+    service_outbox_tick(config, state);
 }
 
 void service_log_add(const String& message) {
@@ -32,17 +33,18 @@ void service_log_add(const String& message) {
     service_storage_append_system_log(static_cast<uint32_t>(time(nullptr)), message);
 }
 
+void service_log_add_error(const String& message) {
+    service_log_add(message);
+    if (!message.isEmpty()) {
+        service_outbox_add_error(message);
+    }
+}
+
 void service_log_add_activity(
     const String& user,
     const String& action,
     uint32_t timestamp,
     const String& event_id) {
-    if (user.isEmpty() || (action != "clocked in" && action != "clocked out")) {
-        return;
-    }
-    if (timestamp == 0) {
-        timestamp = static_cast<uint32_t>(time(nullptr));
-    }
     if (!event_id.isEmpty()) {
         for (const auto& existing : g_activity) {
             if (existing.event_id == event_id) {
@@ -50,6 +52,20 @@ void service_log_add_activity(
             }
         }
     }
+    service_log_append_activity(user, action, timestamp, event_id);
+}
+
+void service_log_append_activity(
+    const String& user,
+    const String& action,
+    uint32_t timestamp,
+    const String& event_id) {
+    if (user.isEmpty() || (action != "clocked in" && action != "clocked out")) {
+        return;
+    }
+    if (timestamp == 0) {
+        timestamp = static_cast<uint32_t>(time(nullptr));
+    }
 
     StoredActivity entry;
     entry.event_id = event_id;
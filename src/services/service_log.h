@@ -7,11 +7,20 @@ namespace ptc {
 void service_log_init();
 void service_log_tick(DeviceConfig& config, AppState& state);
 void service_log_add(const String& message);
+// Logged like service_log_add and also queued in the outbox for the portal.
+void service_log_add_error(const String& message);
 void service_log_add_activity(
     const String& user,
     const String& action,
     uint32_t timestamp = 0,
     const String& event_id = "");
+// As service_log_add_activity, without looking event_id up in the log: the
+// caller knows the event is new (it came from past the activity cursor).
+void service_log_append_activity(
+    const String& user,
+    const String& action,
+    uint32_t timestamp,
+    const String& event_id);
 uint16_t service_log_count();
 uint32_t service_log_revision();
 bool service_log_get_activity(
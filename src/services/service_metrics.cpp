@@ -0,0 +1,170 @@
+#include "service_metrics.h"
+
+namespace ptc {
+
+namespace {
+
+constexpr uint8_t kMaxProbes = 12;
+constexpr uint8_t kSubBucketBits = 2;
+constexpr uint8_t kSubBuckets = 1 << kSubBucketBits;
+// 4 sub-buckets per power of two, exact below 4 us; the last bucket collects
+// everything above ~230 ms (max_us stays exact).
+constexpr uint8_t kBucketCount = 68;
+constexpr uint8_t kWindowCount = 2;
+
+struct Histogram {
+    uint16_t buckets[kBucketCount];
+    uint32_t count;
+    uint32_t max_us;
+};
+
+struct Probe {
+    const char* name;
+    Histogram windows[kWindowCount];
+};
+
+Probe g_probes[kMaxProbes];
+uint8_t g_probe_count = 0;
+uint32_t g_cycles_per_us = 0;
+
+uint8_t bucket_for(uint32_t us) {
+    if (us < kSubBuckets) {
+        return static_cast<uint8_t>(us);
+    }
+    const uint8_t exponent = static_cast<uint8_t>(31 - __builtin_clz(us));
+    const uint32_t index = static_cast<uint32_t>(exponent - kSubBucketBits + 1) * kSubBuckets +
+        ((us >> (exponent - kSubBucketBits)) & (kSubBuckets - 1));
+    return static_cast<uint8_t>(min<uint32_t>(index, kBucketCount - 1));
+}
+
+// Largest value that maps to the bucket, so percentiles never under-report.
+uint32_t bucket_upper_us(uint8_t bucket) {
+    if (bucket < kSubBuckets) {
+        return bucket;
+    }
+    const uint8_t exponent = bucket / kSubBuckets + kSubBucketBits - 1;
+    const uint32_t sub = bucket % kSubBuckets;
+    const uint32_t step = 1UL << (exponent - kSubBucketBits);
+    return (1UL << exponent) + (sub + 1) * step - 1;
+}
+
+uint32_t percentile_us(const Histogram& histogram, uint8_t percent) {
+    const uint32_t rank = (histogram.count * percent + 99) / 100;
+    uint32_t seen = 0;
+    for (uint8_t bucket = 0; bucket < kBucketCount; ++bucket) {
+        seen += histogram.buckets[bucket];
+        if (seen >= rank && seen > 0) {
+            return min(bucket_upper_us(bucket), histogram.max_us);
+        }
+    }
+    return histogram.max_us;
+}
+
+} // namespace
+
+int8_t service_metrics_probe(const char* name) {
+    for (uint8_t i = 0; i < g_probe_count; ++i) {
+        if (strcmp(g_probes[i].name, name) == 0) {
+            return static_cast<int8_t>(i);
+        }
+    }
+    if (g_probe_count >= kMaxProbes) {
+        return -1;
+    }
+    Probe& probe = g_probes[g_probe_count];
+    memset(&probe, 0, sizeof(probe));
+    probe.name = name;
+    return static_cast<int8_t>(g_probe_count++);
+}
+
+uint32_t service_metrics_start() {
+    return ESP.getCycleCount();
+}
+
+void service_metrics_stop(int8_t probe, uint32_t start_cycles) {
+    if (g_cycles_per_us == 0) {
+        g_cycles_per_us = max<uint32_t>(ESP.getCpuFreqMHz(), 1);
+    }
+    service_metrics_record_us(probe, (ESP.getCycleCount() - start_cycles) / g_cycles_per_us);
+}
+
+void service_metrics_record_us(int8_t probe, uint32_t elapsed_us) {
+    if (probe < 0 || probe >= g_probe_count) {
+        return;
+    }
+    const uint8_t bucket = bucket_for(elapsed_us);
+    for (Histogram& histogram : g_probes[probe].windows) {
+        if (histogram.buckets[bucket] < UINT16_MAX) {
+            histogram.buckets[bucket]++;
+        }
+        histogram.count++;
+        histogram.max_us = max(histogram.max_us, elapsed_us);
+    }
+}
+
+uint8_t service_metrics_probe_count() {
+    return g_probe_count;
+}
+
+bool service_metrics_summary(uint8_t probe, MetricsWindow window, MetricsSummary& out_summary) {
+    if (probe >= g_probe_count) {
+        return false;
+    }
+    const Histogram& histogram = g_probes[probe].windows[static_cast<uint8_t>(window)];
+    out_summary.name = g_probes[probe].name;
+    out_summary.count = histogram.count;
+    out_summary.p50_us = percentile_us(histogram, 50);
+    out_summary.p95_us = percentile_us(histogram, 95);
+    out_summary.p99_us = percentile_us(histogram, 99);
+    out_summary.max_us = histogram.max_us;
+    return true;
+}
+
+size_t service_metrics_json_size() {
+    return JSON_OBJECT_SIZE(g_probe_count) + g_probe_count * JSON_ARRAY_SIZE(5);
+}
+
+void service_metrics_reset(MetricsWindow window) {
+    for (uint8_t i = 0; i < g_probe_count; ++i) {
+        memset(&g_probes[i].windows[static_cast<uint8_t>(window)], 0, sizeof(Histogram));
+    }
+}
+
+String service_metrics_serial_line(MetricsWindow window) {
+    String line;
+    line.reserve(g_probe_count * 28);
+    for (uint8_t i = 0; i < g_probe_count; ++i) {
+        MetricsSummary summary;
+        if (!service_metrics_summary(i, window, summary) || summary.count == 0) {
+            continue;
+        }
+        char entry[72];
+        snprintf(entry, sizeof(entry), "%s%s=%lu:%lu/%lu/%lu/%lu",
+            line.isEmpty() ? "" : " ",
+            summary.name,
+            static_cast<unsigned long>(summary.count),
+            static_cast<unsigned long>(summary.p50_us),
+            static_cast<unsigned long>(summary.p95_us),
+            static_cast<unsigned long>(summary.p99_us),
+            static_cast<unsigned long>(summary.max_us));
+        line += entry;
+    }
+    return line;
+}
+
+void service_metrics_write_json(JsonObject target, MetricsWindow window) {
+    for (uint8_t i = 0; i < g_probe_count; ++i) {
+        MetricsSummary summary;
+        if (!service_metrics_summary(i, window, summary) || summary.count == 0) {
+            continue;
+        }
+        JsonArray values = target.createNestedArray(summary.name);
+        values.add(summary.count);
+        values.add(summary.p50_us);
+        values.add(summary.p95_us);
+        values.add(summary.p99_us);
+        values.add(summary.max_us);
+    }
+}
+
+} // namespace ptc
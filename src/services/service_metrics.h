@@ -0,0 +1,44 @@
+#pragma once
+
+#include <ArduinoJson.h>
+
+#include "config.h"
+
+namespace ptc {
+
+// Latency probes for work done on the loop task. Each probe keeps two
+// independent log-bucketed histograms: one drained by the 5 s serial
+// heartbeat and one drained when a portal heartbeat is queued.
+enum class MetricsWindow : uint8_t {
+    kSerial,
+    kReport,
+};
+
+struct MetricsSummary {
+    const char* name = "";
+    uint32_t count = 0;
+    uint32_t p50_us = 0;
+    uint32_t p95_us = 0;
+    uint32_t p99_us = 0;
+    uint32_t max_us = 0;
+};
+
+// Returns the probe id for name, registering it on first use (-1 if full).
+// name must outlive the probe (string literals in practice).
+int8_t service_metrics_probe(const char* name);
+uint32_t service_metrics_start();
+void service_metrics_stop(int8_t probe, uint32_t start_cycles);
+void service_metrics_record_us(int8_t probe, uint32_t elapsed_us);
+
+uint8_t service_metrics_probe_count();
+bool service_metrics_summary(uint8_t probe, MetricsWindow window, MetricsSummary& out_summary);
+void service_metrics_reset(MetricsWindow window);
+
+// "wifi=count:p50/p95/p99/max ..." in microseconds, for probes that ran.
+String service_metrics_serial_line(MetricsWindow window);
+// {"wifi":[count,p50,p95,p99,max],...} in microseconds.
+void service_metrics_write_json(JsonObject target, MetricsWindow window);
+// Capacity service_metrics_write_json needs with every probe reporting.
+size_t service_metrics_json_size();
+
+} // namespace ptc
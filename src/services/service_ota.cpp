@@ -13,7 +13,13 @@
 
 #include "config.h"
 #include "secrets.h"
+#include "service_http_inflate.h"
+#include "service_http_stream.h"
+#include "service_http_timing.h"
+#include "service_outbox.h"
+#include "service_scheduler.h"
 #include "service_storage.h"
+#include "service_telemetry.h"
 #include "service_wifi.h"
 
 namespace ptc {
@@ -27,6 +33,8 @@ constexpr const char* kPartialFirmwarePath = "/ptc/update/firmware.bin.part";
 constexpr const char* kMetadataPath = "/ptc/update/metadata.json";
 constexpr size_t kMinimumFirmwareBytes = 64U * 1024U;
 constexpr uint32_t kRebootDelayMs = 1500;
+// HTTPClient's default, which the connects made ahead of it used to bypass.
+constexpr uint32_t kConnectTimeoutMs = 5000;
 constexpr uint32_t kInitialAutoCheckDelayMs = 20000;
 constexpr uint32_t kPeriodicAutoCheckMs = 6U * 60U * 60U * 1000U;
 constexpr uint32_t kFailedAutoCheckRetryMs = 15U * 60U * 1000U;
@@ -134,13 +142,21 @@ bool is_version_newer(const String& candidate, const String& current) {
     return false;
 }
 
+// Parses a 2xx release body straight off the connection (inflating it when
+// GitHub compresses it), keeping only the fields fetch_latest_release reads.
 bool request_latest_release(
     bool use_authentication,
     int& code,
-    String& response,
+    JsonDocument& release,
     String& error) {
     WiFiClientSecure client;
     client.setInsecure();
+    HttpPhases phases;
+    if (!service_http_timing_connect(client, github_api_url(), kConnectTimeoutMs, phases)) {
+        service_http_timing_record("github", phases, true);
+        error = phases.dns_failed ? "GitHub DNS lookup failed" : "GitHub connection failed";
+        return false;
+    }
     HTTPClient http;
     if (!http.begin(client, github_api_url())) {
         error = "GitHub HTTP begin failed";
@@ -149,16 +165,58 @@ bool request_latest_release(
     http.setTimeout(15000);
     http.addHeader("User-Agent", "ptc-esp32");
     http.addHeader("Accept", "application/vnd.github+json");
+    http.addHeader("Accept-Encoding", kAcceptCompressed);
     if (use_authentication) {
         http.addHeader("Authorization", String("token ") + secrets::kGithubToken);
     }
+    const char* response_headers[] = {"Transfer-Encoding", "Content-Encoding"};
+    http.collectHeaders(response_headers, 2);
 
+    const uint32_t sent_ms = millis();
     code = http.GET();
-    response = "";
-    if (code > 0) {
-        response = http.getString();
+    const uint32_t headers_ms = millis();
+    phases.ttfb_ms = headers_ms - sent_ms;
+    phases.answered = code > 0;
+    release.clear();
+    if (code < 200 || code >= 300) {
+        http.end();
+        service_http_timing_record("github", phases, code <= 0 || code >= 500);
+        return true;
+    }
+
+    StaticJsonDocument<256> filter;
+    filter["tag_name"] = true;
+    JsonObject asset = filter["assets"].createNestedObject();
+    for (const char* key : {"name", "url", "browser_download_url", "size", "digest"}) {
+        asset[key] = true;
+    }
+    HttpBodyStream body(*http.getStreamPtr(),
+        http.getSize(),
+        http.header("Transfer-Encoding").equalsIgnoreCase("chunked"),
+        15000);
+    const ContentEncoding encoding = content_encoding_from_header(http.header("Content-Encoding"));
+    DeserializationError parsed = DeserializationError::InvalidInput;
+    if (encoding == ContentEncoding::kIdentity) {
+        parsed = deserializeJson(release, body, DeserializationOption::Filter(filter));
+    } else if (encoding != ContentEncoding::kUnsupported) {
+        InflateStream inflated(body, encoding);
+        parsed = deserializeJson(release, inflated, DeserializationOption::Filter(filter));
+        if (parsed == DeserializationError::Ok && !inflated.read_to_end()) {
+            Serial.println("[OTA] release JSON failed its trailer check");
+            parsed = DeserializationError::InvalidInput;
+        }
+        Serial.printf("[OTA] release JSON %u bytes inflated from %u\n",
+            static_cast<unsigned>(inflated.produced()),
+            static_cast<unsigned>(body.consumed()));
     }
+    phases.body_ms = millis() - headers_ms;
+    phases.bytes = body.consumed();
+    service_http_timing_record("github", phases, parsed != DeserializationError::Ok);
     http.end();
+    if (parsed != DeserializationError::Ok) {
+        error = "GitHub JSON parse failed";
+        return false;
+    }
     return true;
 }
 
@@ -297,11 +355,11 @@ bool fetch_latest_release(OtaResult& result) {
 
     bool use_authentication = github_token_valid();
     int code = 0;
-    String response;
+    DynamicJsonDocument doc(6144);
     if (!request_latest_release(
             use_authentication,
             code,
-            response,
+            doc,
             result.error)) {
         return false;
     }
@@ -311,7 +369,7 @@ bool fetch_latest_release(OtaResult& result) {
         if (!request_latest_release(
                 false,
                 code,
-                response,
+                doc,
                 result.error)) {
             return false;
         }
@@ -321,12 +379,6 @@ bool fetch_latest_release(OtaResult& result) {
         return false;
     }
 
-    DynamicJsonDocument doc(6144);
-    if (deserializeJson(doc, response) != DeserializationError::Ok) {
-        result.error = "GitHub JSON parse failed";
-        return false;
-    }
-
     result.version = String(doc["tag_name"] | "");
     for (JsonObject asset : doc["assets"].as<JsonArray>()) {
         if (String(asset["name"] | "") != kFirmwareAssetName) {
@@ -378,6 +430,16 @@ bool download_firmware(const OtaCommand& command, OtaResult& result) {
 
     WiFiClientSecure client;
     client.setInsecure();
+    // A redirect to the asset host is connected inside GET(), so its lookup
+    // and handshake count towards ttfb.
+    HttpPhases phases;
+    if (!service_http_timing_connect(client, command.asset_url, kConnectTimeoutMs, phases)) {
+        service_http_timing_record("firmware", phases, true);
+        target.close();
+        SD.remove(kPartialFirmwarePath);
+        result.error = phases.dns_failed ? "Asset DNS lookup failed" : "Asset connection failed";
+        return false;
+    }
     HTTPClient http;
     if (!http.begin(client, command.asset_url)) {
         target.close();
@@ -393,8 +455,13 @@ bool download_firmware(const OtaCommand& command, OtaResult& result) {
         http.addHeader("Accept", "application/octet-stream");
     }
 
+    const uint32_t sent_ms = millis();
     const int code = http.GET();
+    const uint32_t headers_ms = millis();
+    phases.ttfb_ms = headers_ms - sent_ms;
+    phases.answered = code > 0;
     if (code < 200 || code >= 300) {
+        service_http_timing_record("firmware", phases, code <= 0 || code >= 500);
         http.end();
         target.close();
         SD.remove(kPartialFirmwarePath);
@@ -466,6 +533,9 @@ bool download_firmware(const OtaCommand& command, OtaResult& result) {
     target.flush();
     target.close();
     http.end();
+    phases.body_ms = millis() - headers_ms;
+    phases.bytes = written;
+    service_http_timing_record("firmware", phases, !write_ok || written != command.expected_size);
 
     if (!write_ok || written != command.expected_size) {
         SD.remove(kPartialFirmwarePath);
@@ -593,6 +663,7 @@ void ota_worker(void*) {
         }
         delete command;
         xQueueSend(g_result_queue, &result, portMAX_DELAY);
+        service_scheduler_signal(kSchedulerEventOtaResult);
     }
 }
 
@@ -616,10 +687,27 @@ void set_error(const String& error) {
     Serial.printf("[OTA] %s\n", error.c_str());
 }
 
+// Downloads and installs are reported to the portal; a release check is not.
+void queue_outbox_record(const OtaResult& result) {
+    if (result.type == OtaCommandType::kCheck) {
+        return;
+    }
+    StaticJsonDocument<384> data;
+    data["stage"] = result.type == OtaCommandType::kDownload ? "download" : "install";
+    data["ok"] = result.success;
+    data["version"] = result.version.isEmpty() ? g_latest_version : result.version;
+    data["from"] = kFirmwareVersion;
+    if (!result.success) {
+        data["error"] = result.error;
+    }
+    service_outbox_add(OutboxKind::kOta, data);
+}
+
 void consume_result(OtaResult* result) {
     if (!result) {
         return;
     }
+    queue_outbox_record(*result);
     if (!result->success) {
         set_error(result->error);
         delete result;
@@ -688,6 +776,8 @@ void service_ota_init() {
             &g_worker_task,
             0) != pdPASS) {
         set_error("Cannot start update worker");
+    } else {
+        service_telemetry_register_task(g_worker_task);
     }
 
     String staged_version;
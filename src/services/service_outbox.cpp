@@ -0,0 +1,346 @@
+#include "service_outbox.h"
+
+#include <Esp.h>
+#include <esp_system.h>
+#include <time.h>
+
+#include <vector>
+
+#include "service_http.h"
+#include "service_storage.h"
+#include "service_wifi.h"
+
+namespace ptc {
+
+namespace {
+
+// Once the cursor is this far in, acknowledged records are cut off the file.
+constexpr uint32_t kCompactAfterBytes = 32 * 1024;
+constexpr size_t kRecordDocumentBytes = 768;
+constexpr size_t kReadChunkBytes = 512;
+
+char g_boot_id[17] = {};
+uint32_t g_sequence = 0;
+uint32_t g_cursor = 0;
+uint32_t g_size = 0;
+// Bumped whenever offsets move (trim or compaction); older batches are stale.
+uint32_t g_generation = 0;
+OutboxStats g_stats;
+uint32_t g_drain_started_ms = 0;
+uint32_t g_drain_records = 0;
+uint32_t g_unreachable_since_ms = 0;
+uint32_t g_last_heartbeat_ms = 0;
+// Recent error messages, so a failure that repeats every retry is queued
+// once per kOutboxErrorRepeatMs rather than on every attempt.
+constexpr uint8_t kRecentErrors = 6;
+String g_recent_errors[kRecentErrors];
+uint32_t g_recent_error_ms[kRecentErrors] = {};
+
+const char* kind_name(OutboxKind kind) {
+    switch (kind) {
+        case OutboxKind::kHeartbeat:
+            return "heartbeat";
+        case OutboxKind::kOta:
+            return "ota";
+        case OutboxKind::kError:
+        default:
+            return "error";
+    }
+}
+
+// Calls fn(line_start, line_end_exclusive_of_newline) for every complete
+// line from offset on, until fn returns false or max_bytes have been read.
+// Returns the offset just past the last line handed to fn.
+template <typename Fn>
+uint32_t scan_lines(uint32_t offset, uint32_t max_bytes, Fn&& fn) {
+    char chunk[kReadChunkBytes];
+    uint32_t line_start = offset;
+    uint32_t position = offset;
+    uint32_t consumed = offset;
+    while (position - offset < max_bytes) {
+        const size_t count = service_storage_outbox_read(position, chunk, sizeof(chunk));
+        if (count == 0) {
+            break;
+        }
+        for (size_t i = 0; i < count; ++i) {
+            if (chunk[i] != '\n') {
+                continue;
+            }
+            const uint32_t line_end = position + static_cast<uint32_t>(i);
+            if (!fn(line_start, line_end)) {
+                return line_end + 1;
+            }
+            line_start = line_end + 1;
+            consumed = line_start;
+        }
+        position += static_cast<uint32_t>(count);
+    }
+    return consumed;
+}
+
+bool compact_if_needed(bool force = false) {
+    if (g_cursor == 0 || (!force && g_cursor < g_size && g_cursor < kCompactAfterBytes) ||
+        !service_storage_outbox_compact(g_cursor)) {
+        return false;
+    }
+    g_size -= min(g_cursor, g_size);
+    g_cursor = 0;
+    g_generation++;
+    return true;
+}
+
+// Drops the oldest records until needed_bytes more fit in kOutboxMaxBytes.
+void trim_for(uint32_t needed_bytes) {
+    if (g_size - g_cursor + needed_bytes <= kOutboxMaxBytes) {
+        return;
+    }
+    const uint32_t target = g_size - g_cursor + needed_bytes - kOutboxMaxBytes + kOutboxMaxBytes / 8;
+    uint32_t dropped = 0;
+    const uint32_t end = scan_lines(g_cursor, g_size - g_cursor, [&](uint32_t start, uint32_t line_end) {
+        (void)start;
+        dropped++;
+        return line_end + 1 - g_cursor < target;
+    });
+    g_cursor = end;
+    g_stats.dropped += dropped;
+    g_stats.depth -= min(dropped, g_stats.depth);
+    g_generation++;
+    service_storage_outbox_save_cursor(g_cursor);
+    Serial.printf("[OUTBOX] full; dropped %lu oldest records\n", static_cast<unsigned long>(dropped));
+    // The card holds no more than kOutboxMaxBytes whatever the cursor.
+    compact_if_needed(true);
+}
+
+void finish_drain_if_empty() {
+    if (g_stats.depth != 0 || g_drain_started_ms == 0) {
+        return;
+    }
+    g_stats.last_drain_records = g_drain_records;
+    g_stats.last_drain_ms = millis() - g_drain_started_ms;
+    g_drain_started_ms = 0;
+    g_drain_records = 0;
+    Serial.printf("[OUTBOX] drained %lu records in %lums\n",
+        static_cast<unsigned long>(g_stats.last_drain_records),
+        static_cast<unsigned long>(g_stats.last_drain_ms));
+}
+
+} // namespace
+
+void service_outbox_init() {
+    snprintf(g_boot_id, sizeof(g_boot_id), "%08lx%08lx",
+        static_cast<unsigned long>(esp_random()),
+        static_cast<unsigned long>(esp_random()));
+    g_sequence = 0;
+    g_stats = OutboxStats();
+    g_drain_started_ms = 0;
+    g_drain_records = 0;
+    g_unreachable_since_ms = 0;
+    g_last_heartbeat_ms = 0;
+    for (uint8_t i = 0; i < kRecentErrors; ++i) {
+        g_recent_errors[i] = "";
+        g_recent_error_ms[i] = 0;
+    }
+    g_size = service_storage_outbox_size();
+    g_cursor = min(service_storage_outbox_load_cursor(), g_size);
+    if (g_size > 0) {
+        char last = '\n';
+        service_storage_outbox_read(g_size - 1, &last, 1);
+        if (last != '\n' && service_storage_outbox_append(String())) {
+            // Terminates a record cut short by a reset; the reader skips it.
+            g_size++;
+        }
+    }
+    scan_lines(g_cursor, g_size - g_cursor, [](uint32_t, uint32_t) {
+        g_stats.depth++;
+        return true;
+    });
+    g_stats.pending_bytes = g_size - g_cursor;
+    Serial.printf("[OUTBOX] init depth=%lu bytes=%lu\n",
+        static_cast<unsigned long>(g_stats.depth),
+        static_cast<unsigned long>(g_stats.pending_bytes));
+}
+
+void service_outbox_tick(const DeviceConfig& config, const AppState& state) {
+    (void)config;
+    const bool reachable = service_wifi_is_connected() && service_http_api_ok();
+    if (!state.provisioning_complete || reachable) {
+        g_unreachable_since_ms = 0;
+        return;
+    }
+    const uint32_t now = millis();
+    if (g_unreachable_since_ms == 0) {
+        g_unreachable_since_ms = now;
+        g_last_heartbeat_ms = now;
+        return;
+    }
+    if (now - g_last_heartbeat_ms < kOutboxHeartbeatIntervalMs) {
+        return;
+    }
+    g_last_heartbeat_ms = now;
+    StaticJsonDocument<192> data;
+    data["uptime_sec"] = now / 1000;
+    data["free_heap"] = ESP.getFreeHeap();
+    data["min_free_heap"] = ESP.getMinFreeHeap();
+    data["unreachable_sec"] = (now - g_unreachable_since_ms) / 1000;
+    data["wifi"] = service_wifi_is_connected();
+    service_outbox_add(OutboxKind::kHeartbeat, data);
+}
+
+bool service_outbox_add(OutboxKind kind, const JsonDocument& data) {
+    char key[32];
+    snprintf(key, sizeof(key), "%s-%lu", g_boot_id, static_cast<unsigned long>(g_sequence + 1));
+    StaticJsonDocument<kRecordDocumentBytes> record;
+    record["key"] = key;
+    record["type"] = kind_name(kind);
+    record["ts"] = static_cast<uint32_t>(time(nullptr));
+    record["data"] = data;
+    String line;
+    serializeJson(record, line);
+    trim_for(line.length() + 1);
+    if (!service_storage_outbox_append(line)) {
+        return false;
+    }
+    g_sequence++;
+    g_size += line.length() + 1;
+    g_stats.depth++;
+    g_stats.appended++;
+    g_stats.pending_bytes = g_size - g_cursor;
+    return true;
+}
+
+bool service_outbox_add_error(const String& message) {
+    const uint32_t now = millis();
+    uint8_t slot = 0;
+    for (uint8_t i = 0; i < kRecentErrors; ++i) {
+        if (g_recent_errors[i] == message) {
+            if (now - g_recent_error_ms[i] < kOutboxErrorRepeatMs) {
+                return false;
+            }
+            slot = i;
+            break;
+        }
+        if (now - g_recent_error_ms[i] > now - g_recent_error_ms[slot]) {
+            slot = i;
+        }
+    }
+    g_recent_errors[slot] = message;
+    g_recent_error_ms[slot] = now;
+    StaticJsonDocument<256> data;
+    data["message"] = message;
+    return service_outbox_add(OutboxKind::kError, data);
+}
+
+bool service_outbox_pending() {
+    return g_stats.depth > 0;
+}
+
+bool service_outbox_next_batch(OutboxBatch& out_batch) {
+    out_batch = OutboxBatch();
+    if (g_stats.depth == 0) {
+        return false;
+    }
+    // One read covers the batch: kOutboxBatchBytes plus the record that
+    // crosses that line.
+    std::vector<char> window(min<uint32_t>(g_size - g_cursor, kOutboxBatchBytes + kRecordDocumentBytes));
+    const size_t available = service_storage_outbox_read(g_cursor, window.data(), window.size());
+    String& events = out_batch.events;
+    events.reserve(available + 2);
+    events = "[";
+    size_t line_start = 0;
+    for (size_t i = 0; i < available; ++i) {
+        if (window[i] != '\n') {
+            continue;
+        }
+        const char* line = window.data() + line_start;
+        const size_t length = i - line_start;
+        line_start = i + 1;
+        out_batch.lines++;
+        out_batch.end_offset = g_cursor + static_cast<uint32_t>(line_start);
+        if (length < 2 || line[0] != '{' || line[length - 1] != '}') {
+            // A torn record; it is consumed with the batch but not sent.
+            continue;
+        }
+        if (out_batch.count > 0) {
+            events += ',';
+        }
+        events.concat(line, static_cast<unsigned int>(length));
+        out_batch.count++;
+        if (out_batch.count >= kOutboxBatchRecords || events.length() >= kOutboxBatchBytes) {
+            break;
+        }
+    }
+    events += ']';
+    out_batch.start_offset = g_cursor;
+    out_batch.generation = g_generation;
+    if (out_batch.lines == 0) {
+        out_batch.events = "";
+        if (available == window.size() && available > 0) {
+            // Longer than any record could be: garbage, not a record.
+            g_cursor += static_cast<uint32_t>(available);
+            g_stats.dropped++;
+            g_generation++;
+            service_storage_outbox_save_cursor(g_cursor);
+        }
+        return false;
+    }
+    if (out_batch.count == 0) {
+        // Only torn records: step over them without a request.
+        g_cursor = out_batch.end_offset;
+        g_stats.depth -= min<uint32_t>(out_batch.lines, g_stats.depth);
+        service_storage_outbox_save_cursor(g_cursor);
+        return service_outbox_next_batch(out_batch);
+    }
+    if (g_drain_started_ms == 0) {
+        g_drain_started_ms = millis();
+        g_drain_records = 0;
+    }
+    return true;
+}
+
+void service_outbox_ack(const OutboxBatch& batch, uint16_t duplicates, bool rejected) {
+    if (batch.generation != g_generation || batch.start_offset != g_cursor || batch.end_offset <= g_cursor) {
+        return;
+    }
+    g_cursor = batch.end_offset;
+    g_stats.depth -= min<uint32_t>(batch.lines, g_stats.depth);
+    g_stats.batches++;
+    if (rejected) {
+        g_stats.dropped += batch.count;
+    } else {
+        g_stats.delivered += batch.count;
+        g_stats.duplicates += duplicates;
+        g_drain_records += batch.count;
+    }
+    if (!compact_if_needed()) {
+        service_storage_outbox_save_cursor(g_cursor);
+    }
+    g_stats.pending_bytes = g_size - g_cursor;
+    finish_drain_if_empty();
+}
+
+void service_outbox_stats(OutboxStats& out_stats) {
+    out_stats = g_stats;
+}
+
+uint32_t service_outbox_drain_per_min() {
+    if (g_stats.last_drain_records == 0) {
+        return 0;
+    }
+    return static_cast<uint32_t>(
+        static_cast<uint64_t>(g_stats.last_drain_records) * 60000ULL / max<uint32_t>(g_stats.last_drain_ms, 1));
+}
+
+size_t service_outbox_json_size() {
+    return JSON_OBJECT_SIZE(6);
+}
+
+void service_outbox_write_json(JsonObject target) {
+    target["depth"] = g_stats.depth;
+    target["bytes"] = g_stats.pending_bytes;
+    target["delivered"] = g_stats.delivered;
+    target["dropped"] = g_stats.dropped;
+    target["duplicates"] = g_stats.duplicates;
+    target["drain_per_min"] = service_outbox_drain_per_min();
+}
+
+} // namespace ptc
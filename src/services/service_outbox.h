@@ -0,0 +1,78 @@
+#pragma once
+
+#include <ArduinoJson.h>
+
+#include "config.h"
+
+namespace ptc {
+
+// Device events for the portal that must survive a Wi-Fi drop or a reboot:
+// downsampled heartbeats while the portal is unreachable, errors and OTA
+// results. Records are appended to the SD card and drained in batches by
+// the HTTP worker; a batch is dropped from the outbox only once the portal
+// acknowledges it, so delivery is at least once and every record carries an
+// idempotency key ("<boot id>-<sequence>") the portal deduplicates by.
+static constexpr size_t kOutboxMaxBytes = 128 * 1024;
+static constexpr uint8_t kOutboxBatchRecords = 20;
+static constexpr size_t kOutboxBatchBytes = 4096;
+static constexpr uint32_t kOutboxHeartbeatIntervalMs = 15UL * 60UL * 1000UL;
+static constexpr uint32_t kOutboxErrorRepeatMs = 5UL * 60UL * 1000UL;
+
+enum class OutboxKind : uint8_t {
+    kHeartbeat,
+    kError,
+    kOta,
+};
+
+struct OutboxStats {
+    uint32_t depth = 0;
+    uint32_t pending_bytes = 0;
+    uint32_t appended = 0;
+    uint32_t delivered = 0;
+    // Oldest records discarded to stay within kOutboxMaxBytes.
+    uint32_t dropped = 0;
+    // Records the portal already had: redeliveries after a lost answer.
+    uint32_t duplicates = 0;
+    uint32_t batches = 0;
+    // The last backlog that drained completely: records and milliseconds.
+    uint32_t last_drain_records = 0;
+    uint32_t last_drain_ms = 0;
+};
+
+// One batch read from the cursor, ready to POST.
+struct OutboxBatch {
+    String events;
+    uint16_t count = 0;
+    // count plus torn lines (a write cut short by a reset) skipped over.
+    uint16_t lines = 0;
+    uint32_t start_offset = 0;
+    uint32_t end_offset = 0;
+    uint32_t generation = 0;
+};
+
+void service_outbox_init();
+// Samples a heartbeat every kOutboxHeartbeatIntervalMs while the portal is
+// out of reach; live heartbeats cover the rest.
+void service_outbox_tick(const DeviceConfig& config, const AppState& state);
+// data is the record's payload; it is copied into the outbox line.
+bool service_outbox_add(OutboxKind kind, const JsonDocument& data);
+// A message already queued within kOutboxErrorRepeatMs is not queued again.
+bool service_outbox_add_error(const String& message);
+bool service_outbox_pending();
+// The next batch from the cursor as a JSON array of records; false when
+// the outbox is empty.
+bool service_outbox_next_batch(OutboxBatch& out_batch);
+// The portal stored (or already had) the batch. rejected records were
+// refused as malformed and are dropped instead of retried forever. A batch
+// read before the outbox was trimmed or compacted is ignored; its records
+// go out again and the portal drops them by key.
+void service_outbox_ack(const OutboxBatch& batch, uint16_t duplicates, bool rejected = false);
+void service_outbox_stats(OutboxStats& out_stats);
+// Records per minute of the last completed drain, 0 before the first.
+uint32_t service_outbox_drain_per_min();
+// {"depth":..,"bytes":..,"delivered":..,"dropped":..,"duplicates":..,"drain_per_min":..}
+void service_outbox_write_json(JsonObject target);
+// Capacity service_outbox_write_json needs.
+size_t service_outbox_json_size();
+
+} // namespace ptc
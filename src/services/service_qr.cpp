@@ -4,32 +4,91 @@
 #include <time.h>
 #include <esp_system.h>
 
+#include <qrcode.h>
+
 #include "service_auth.h"
 #include "service_log.h"
+#include "service_qr_encoder.h"
 
 namespace ptc {
 
 namespace {
 
 constexpr uint32_t kMinimumPairingLifetimeSec = 30;
-
-String g_payload;
+constexpr size_t kNonceBytes = 12;
+constexpr char kPayloadPrefix[] = "ptc1:";
+constexpr size_t kPayloadPrefixLength = sizeof(kPayloadPrefix) - 1;
+// Builds with -DPTC_QR_MASK=<0-7> draw every code with that mask instead of
+// scoring all eight.
+#ifdef PTC_QR_MASK
+constexpr int8_t kQrMask = PTC_QR_MASK;
+static_assert(kQrMask >= 0 && kQrMask <= 7, "PTC_QR_MASK is a mask number, 0 to 7");
+#else
+constexpr int8_t kQrMask = kQrMaskAuto;
+#endif
+
+// The frame on screen and the one prepared for the next rotation; a frame
+// with an empty payload is absent.
+QrFrame g_frame;
+QrFrame g_next;
+uint32_t g_sequence = 0;
+// Keyed with the device secret on first use and whenever it changes.
+HmacSigner g_signer;
 uint32_t g_last_gen_ms = 0;
 uint32_t g_interval_sec = kDefaultQrIntervalSec;
 
-String random_nonce() {
-    return service_auth_random_nonce(12);
+bool due(uint32_t at_ms) {
+    return static_cast<int32_t>(millis() - at_ms) >= 0;
 }
 
-void generate_payload(DeviceConfig& config) {
+// Signs a payload stamped with the second it will be shown and encodes it.
+bool prepare_frame(DeviceConfig& config, uint32_t shown_at_ms, QrFrame& frame) {
     if (config.device_secret.length() == 0) {
+        return false;
+    }
+    const uint32_t lead_ms = due(shown_at_ms) ? 0 : shown_at_ms - millis();
+    const uint32_t ts = static_cast<uint32_t>(time(nullptr)) + (lead_ms + 500) / 1000;
+    frame = QrFrame();
+    frame.payload = service_qr_build_payload(config, ts);
+    if (frame.payload.isEmpty()) {
+        return false;
+    }
+    // A payload too large to draw still binds manual codes.
+    service_qr_encode(frame.payload, frame);
+    frame.sequence = ++g_sequence;
+    frame.shown_at_ms = shown_at_ms;
+    return true;
+}
+
+void promote_if_due() {
+    if (g_next.payload.isEmpty() || !due(g_next.shown_at_ms)) {
         return;
     }
+    g_frame = std::move(g_next);
+    g_next = QrFrame();
+    g_last_gen_ms = g_frame.shown_at_ms;
+    service_log_add("QR refreshed");
+}
 
-    uint32_t ts = static_cast<uint32_t>(time(nullptr));
-    String nonce = random_nonce();
-    String message = config.device_id + "." + String(ts) + "." + nonce;
-    String sig = service_auth_hmac_sha256_base64url(config.device_secret, message);
+} // namespace
+
+String service_qr_build_payload(const DeviceConfig& config, uint32_t ts) {
+    char nonce[(kNonceBytes * 4 + 2) / 3 + 1];
+    service_auth_format_nonce(nonce, sizeof(nonce), kNonceBytes);
+    char ts_text[12];
+    snprintf(ts_text, sizeof(ts_text), "%lu", static_cast<unsigned long>(ts));
+    // Signed material: <device_id>.<ts>.<nonce>
+    char sig[kSignatureLength + 1];
+    g_signer.set_key(config.device_secret);
+    g_signer.begin();
+    g_signer.update(config.device_id);
+    g_signer.update(".");
+    g_signer.update(ts_text);
+    g_signer.update(".");
+    g_signer.update(nonce);
+    if (!g_signer.finish(sig, sizeof(sig))) {
+        return "";
+    }
 
     StaticJsonDocument<256> doc;
     doc["v"] = 1;
@@ -38,14 +97,60 @@ void generate_payload(DeviceConfig& config) {
     doc["nonce"] = nonce;
     doc["sig"] = sig;
 
-    String json;
-    serializeJson(doc, json);
-    const String encoded = service_auth_base64url_encode(
-        reinterpret_cast<const uint8_t*>(json.c_str()), json.length());
-    g_payload = encoded.isEmpty() ? "" : String("ptc1:") + encoded;
+    // Well above what the largest QR version carries once encoded; a
+    // document filling it is treated as too large.
+    char json[256];
+    const size_t json_length = serializeJson(doc, json, sizeof(json));
+    if (json_length == 0 || json_length >= sizeof(json) - 1) {
+        return "";
+    }
+    char encoded[kPayloadPrefixLength + service_auth_base64url_length(sizeof(json)) + 1];
+    memcpy(encoded, kPayloadPrefix, kPayloadPrefixLength);
+    if (service_auth_base64url_encode(reinterpret_cast<const uint8_t*>(json), json_length,
+            encoded + kPayloadPrefixLength, sizeof(encoded) - kPayloadPrefixLength) == 0) {
+        return "";
+    }
+    return String(encoded);
 }
 
-} // namespace
+uint8_t service_qr_select_version(size_t payload_length) {
+    for (const auto& capacity : kQrCapacities) {
+        if (payload_length <= capacity.byte_capacity) {
+            return capacity.version;
+        }
+    }
+    return 0;
+}
+
+bool service_qr_encode(const String& payload, QrFrame& out_frame) {
+    out_frame.version = 0;
+    out_frame.size = 0;
+    const uint8_t version = service_qr_select_version(payload.length());
+    if (version == 0) {
+        Serial.printf("[QR] payload too large bytes=%u\n",
+            static_cast<unsigned int>(payload.length()));
+        return false;
+    }
+    out_frame.modules.assign(service_qr_encoder_buffer_size(version), 0);
+    // Lowercase "ptc1:" keeps qrcode_initText in byte mode, which is all the
+    // specialised encoder does; anything else goes to the library.
+    if (payload.startsWith(kPayloadPrefix)) {
+        if (service_qr_encoder_encode(reinterpret_cast<const uint8_t*>(payload.c_str()), payload.length(), version,
+                kQrMask, out_frame.modules.data()) < 0) {
+            Serial.println("[QR] encoder failed");
+            return false;
+        }
+    } else {
+        QRCode qrcode;
+        if (qrcode_initText(&qrcode, out_frame.modules.data(), version, ECC_LOW, payload.c_str()) != 0) {
+            Serial.println("[QR] encoder failed");
+            return false;
+        }
+    }
+    out_frame.version = version;
+    out_frame.size = service_qr_encoder_size(version);
+    return true;
+}
 
 void service_qr_init() {
     randomSeed(esp_random());
@@ -53,7 +158,8 @@ void service_qr_init() {
 
 void service_qr_tick(DeviceConfig& config, AppState& state) {
     if (!state.time_sync_ok || !state.device_active || config.device_secret.length() == 0) {
-        g_payload = "";
+        g_frame = QrFrame();
+        g_next = QrFrame();
         return;
     }
 
@@ -63,21 +169,30 @@ void service_qr_tick(DeviceConfig& config, AppState& state) {
     // Manual codes are bound to this payload and remain valid for 30 seconds.
     g_interval_sec = max(configured_interval, kMinimumPairingLifetimeSec);
     uint32_t interval_ms = g_interval_sec * 1000;
-    if (!g_payload.isEmpty() && millis() - g_last_gen_ms < interval_ms) {
+    promote_if_due();
+    if (g_frame.payload.isEmpty()) {
+        g_last_gen_ms = millis();
+        if (prepare_frame(config, g_last_gen_ms, g_frame)) {
+            service_log_add("QR refreshed");
+        }
         return;
     }
-
-    g_last_gen_ms = millis();
-    generate_payload(config);
-    service_log_add("QR refreshed");
+    // The next payload is ready before the rotation, so the UI can draw it
+    // off screen and only swap buffers when it is due.
+    if (g_next.payload.isEmpty() && millis() - g_last_gen_ms >= interval_ms - kQrPrepareAheadMs) {
+        const uint32_t rotate_ms = g_last_gen_ms + interval_ms;
+        prepare_frame(config, due(rotate_ms) ? millis() : rotate_ms, g_next);
+    }
 }
 
 String service_qr_payload() {
-    return g_payload;
+    promote_if_due();
+    return g_frame.payload;
 }
 
 uint32_t service_qr_seconds_remaining() {
-    if (g_interval_sec == 0 || g_payload.isEmpty()) {
+    promote_if_due();
+    if (g_interval_sec == 0 || g_frame.payload.isEmpty()) {
         return 0;
     }
     const uint32_t elapsed = (millis() - g_last_gen_ms) / 1000;
@@ -92,4 +207,32 @@ uint32_t service_qr_last_refresh_ms() {
     return g_last_gen_ms;
 }
 
+uint32_t service_qr_frame_sequence() {
+    promote_if_due();
+    return g_frame.sequence;
+}
+
+uint32_t service_qr_next_sequence() {
+    promote_if_due();
+    return g_next.sequence;
+}
+
+bool service_qr_frame(QrFrame& out_frame) {
+    promote_if_due();
+    if (g_frame.payload.isEmpty()) {
+        return false;
+    }
+    out_frame = g_frame;
+    return true;
+}
+
+bool service_qr_next_frame(QrFrame& out_frame) {
+    promote_if_due();
+    if (g_next.payload.isEmpty()) {
+        return false;
+    }
+    out_frame = g_next;
+    return true;
+}
+
 } // namespace ptc
@@ -1,14 +1,65 @@
 #pragma once
 
+#include <vector>
+
 #include "config.h"
 
 namespace ptc {
 
+// A payload with its QR modules, encoded on the service side so the UI only
+// rasterizes it. sequence changes with every payload.
+struct QrFrame {
+    String payload;
+    uint32_t sequence = 0;
+    // millis() at which the frame is (or was) first shown.
+    uint32_t shown_at_ms = 0;
+    uint8_t version = 0;
+    uint8_t size = 0;
+    // Row-major, one bit per module, most significant bit first (the
+    // qrcode.h layout).
+    std::vector<uint8_t> modules;
+
+    bool module(uint8_t x, uint8_t y) const {
+        const uint32_t offset = static_cast<uint32_t>(y) * size + x;
+        return (modules[offset >> 3] >> (7 - (offset & 7))) & 1;
+    }
+};
+
+struct QrCapacity {
+    uint8_t version;
+    uint16_t byte_capacity;
+};
+
+// Byte-mode capacity at ECC low for the versions the QR canvas can draw.
+static constexpr QrCapacity kQrCapacities[] = {
+    {5, 106},
+    {6, 134},
+    {7, 154},
+    {8, 192},
+    {9, 230},
+    {10, 271},
+};
+
+// The next payload is signed and encoded this long before it is due.
+static constexpr uint32_t kQrPrepareAheadMs = 3000;
+
 void service_qr_init();
 void service_qr_tick(DeviceConfig& config, AppState& state);
+// The payload shown now; the prepared one takes over the moment it is due,
+// even between ticks, so the screen and manual codes switch together.
 String service_qr_payload();
 uint32_t service_qr_seconds_remaining();
 uint32_t service_qr_interval_sec();
 uint32_t service_qr_last_refresh_ms();
+String service_qr_build_payload(const DeviceConfig& config, uint32_t ts);
+// Smallest version in kQrCapacities that holds the payload, 0 if none does.
+uint8_t service_qr_select_version(size_t payload_length);
+bool service_qr_encode(const String& payload, QrFrame& out_frame);
+// 0 when there is no frame; compare before copying one out.
+uint32_t service_qr_frame_sequence();
+uint32_t service_qr_next_sequence();
+bool service_qr_frame(QrFrame& out_frame);
+// The frame prepared for the next rotation, once it is encoded.
+bool service_qr_next_frame(QrFrame& out_frame);
 
 } // namespace ptc
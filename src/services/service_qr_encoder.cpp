@@ -0,0 +1,522 @@
+#include "service_qr_encoder.h"
+
+#include <string.h>
+
+#include "service_qr.h"
+
+namespace ptc {
+
+namespace {
+
+// ---- Compile time. C++11 constexpr: one return statement per function, so
+// loops are recursion and tables are pack expansions over an index list.
+
+template <size_t... Is>
+struct IndexList {};
+template <size_t N, size_t... Is>
+struct MakeIndexList : MakeIndexList<N - 1, N - 1, Is...> {};
+template <size_t... Is>
+struct MakeIndexList<0, Is...> {
+    typedef IndexList<Is...> type;
+};
+
+// GF(256) over x^8 + x^4 + x^3 + x^2 + 1.
+constexpr uint8_t gf_double(uint8_t a) {
+    return static_cast<uint8_t>((a << 1) ^ (a & 0x80 ? 0x11D : 0));
+}
+constexpr uint8_t gf_multiply(uint8_t a, uint8_t b) {
+    return b == 0 ? 0 : static_cast<uint8_t>((b & 1 ? a : 0) ^ gf_multiply(gf_double(a), b >> 1));
+}
+constexpr uint8_t gf_power(size_t exponent, uint8_t value = 1) {
+    return exponent == 0 ? value : gf_power(exponent - 1, gf_double(value));
+}
+constexpr uint8_t gf_log(uint8_t value, size_t exponent = 0, uint8_t power = 1) {
+    return exponent >= 255 ? 0 : power == value ? static_cast<uint8_t>(exponent) :
+        gf_log(value, exponent + 1, gf_double(power));
+}
+
+// Exponents doubled up, so a sum of two logs needs no % 255.
+template <typename List = MakeIndexList<510>::type>
+struct GfExp;
+template <size_t... Is>
+struct GfExp<IndexList<Is...>> {
+    static constexpr uint8_t kValues[sizeof...(Is)] = {gf_power(Is % 255)...};
+};
+template <size_t... Is>
+constexpr uint8_t GfExp<IndexList<Is...>>::kValues[sizeof...(Is)];
+
+template <typename List = MakeIndexList<256>::type>
+struct GfLog;
+template <size_t... Is>
+struct GfLog<IndexList<Is...>> {
+    static constexpr uint8_t kValues[sizeof...(Is)] = {gf_log(static_cast<uint8_t>(Is))...};
+};
+template <size_t... Is>
+constexpr uint8_t GfLog<IndexList<Is...>>::kValues[sizeof...(Is)];
+
+// Reed-Solomon divisor of the given degree, built a root (2^(Step - 1)) at a
+// time from x^0; the leading 1 is implied.
+template <size_t Degree, size_t Step, typename List = typename MakeIndexList<Degree>::type>
+struct RsDivisor;
+template <size_t Degree, size_t... Is>
+struct RsDivisor<Degree, 0, IndexList<Is...>> {
+    static constexpr uint8_t kCoefficients[Degree] = {static_cast<uint8_t>(Is + 1 == Degree ? 1 : 0)...};
+};
+template <size_t Degree, size_t Step, size_t... Is>
+struct RsDivisor<Degree, Step, IndexList<Is...>> {
+    typedef RsDivisor<Degree, Step - 1> Previous;
+    static constexpr uint8_t kCoefficients[Degree] = {static_cast<uint8_t>(
+        gf_multiply(Previous::kCoefficients[Is], gf_power(Step - 1)) ^
+        (Is + 1 < Degree ? Previous::kCoefficients[(Is + 1) % Degree] : 0))...};
+};
+template <size_t Degree, size_t... Is>
+constexpr uint8_t RsDivisor<Degree, 0, IndexList<Is...>>::kCoefficients[Degree];
+template <size_t Degree, size_t Step, size_t... Is>
+constexpr uint8_t RsDivisor<Degree, Step, IndexList<Is...>>::kCoefficients[Degree];
+
+// The divisor as logs, which is how the remainder loop uses it. No
+// coefficient of a generator is zero.
+template <size_t Degree, typename List = typename MakeIndexList<Degree>::type>
+struct RsGenerator;
+template <size_t Degree, size_t... Is>
+struct RsGenerator<Degree, IndexList<Is...>> {
+    static constexpr uint8_t kLogs[Degree] = {gf_log(RsDivisor<Degree, Degree>::kCoefficients[Is])...};
+};
+template <size_t Degree, size_t... Is>
+constexpr uint8_t RsGenerator<Degree, IndexList<Is...>>::kLogs[Degree];
+
+constexpr int qr_size(int version) {
+    return 17 + 4 * version;
+}
+constexpr int abs_value(int value) {
+    return value < 0 ? -value : value;
+}
+constexpr int ring(int dx, int dy) {
+    return abs_value(dx) > abs_value(dy) ? abs_value(dx) : abs_value(dy);
+}
+// Data and ECC codewords of a version; remainder bits dropped.
+constexpr int raw_codewords(int version) {
+    return ((16 * version + 128) * version + 64 -
+        (version >= 2 ? (25 * (version / 7 + 2) - 10) * (version / 7 + 2) - 55 : 0) - (version >= 7 ? 36 : 0)) / 8;
+}
+
+// Finder patterns with their separators.
+constexpr bool in_finder(int size, int x, int y) {
+    return (x < 8 && y < 8) || (x >= size - 8 && y < 8) || (x < 8 && y >= size - 8);
+}
+constexpr bool finder_dark(int size, int x, int y) {
+    return ring(x - (x < 8 ? 3 : size - 4), y - (y < 8 ? 3 : size - 4)) != 2 &&
+        ring(x - (x < 8 ? 3 : size - 4), y - (y < 8 ? 3 : size - 4)) != 4;
+}
+
+constexpr int align_count(int version) {
+    return version / 7 + 2;
+}
+constexpr int align_step(int version) {
+    return (version * 4 + align_count(version) * 2 + 1) / (align_count(version) * 2 - 2) * 2;
+}
+constexpr int align_center(int version, int i) {
+    return i == 0 ? 6 : qr_size(version) - 7 - (align_count(version) - 1 - i) * align_step(version);
+}
+// Alignment row or column within two modules of c, -1 if none.
+constexpr int align_index(int version, int c, int i = 0) {
+    return i >= align_count(version) ? -1 : abs_value(c - align_center(version, i)) <= 2 ? i :
+        align_index(version, c, i + 1);
+}
+constexpr bool align_corner(int version, int i, int j) {
+    return (i == 0 && j == 0) || (i == 0 && j == align_count(version) - 1) || (i == align_count(version) - 1 && j == 0);
+}
+constexpr bool in_alignment(int version, int x, int y) {
+    return align_index(version, x) >= 0 && align_index(version, y) >= 0 &&
+        !align_corner(version, align_index(version, x), align_index(version, y));
+}
+constexpr bool alignment_dark(int version, int x, int y) {
+    return ring(x - align_center(version, align_index(version, x)),
+        y - align_center(version, align_index(version, y))) != 1;
+}
+
+constexpr bool in_timing(int x, int y) {
+    return x == 6 || y == 6;
+}
+constexpr bool timing_dark(int x, int y) {
+    return (x == 6 ? y : x) % 2 == 0;
+}
+
+// Format bits (written per mask) and the dark module.
+constexpr bool in_format(int size, int x, int y) {
+    return (y == 8 && (x <= 8 || x >= size - 8)) || (x == 8 && (y <= 8 || y >= size - 8));
+}
+
+constexpr uint32_t version_remainder(uint32_t remainder, int steps = 12) {
+    return steps == 0 ? remainder : version_remainder((remainder << 1) ^ ((remainder >> 11) * 0x1F25), steps - 1);
+}
+constexpr uint32_t version_word(int version) {
+    return static_cast<uint32_t>(version) << 12 | version_remainder(static_cast<uint32_t>(version));
+}
+// Version information blocks, from version 7 on.
+constexpr bool in_version(int version, int x, int y) {
+    return version >= 7 && ((x >= qr_size(version) - 11 && x < qr_size(version) - 8 && y < 6) ||
+        (y >= qr_size(version) - 11 && y < qr_size(version) - 8 && x < 6));
+}
+constexpr bool version_dark(int version, int x, int y) {
+    return ((version_word(version) >>
+        (y < 6 ? y * 3 + x - (qr_size(version) - 11) : x * 3 + y - (qr_size(version) - 11))) & 1) != 0;
+}
+
+constexpr bool is_function(int version, int x, int y) {
+    return in_finder(qr_size(version), x, y) || in_alignment(version, x, y) || in_timing(x, y) ||
+        in_format(qr_size(version), x, y) || in_version(version, x, y);
+}
+// Function modules as qrcode.h draws them, format bits left light.
+constexpr bool base_dark(int version, int x, int y) {
+    return in_finder(qr_size(version), x, y) ? finder_dark(qr_size(version), x, y) :
+        in_alignment(version, x, y) ? alignment_dark(version, x, y) :
+        in_timing(x, y) ? timing_dark(x, y) :
+        in_version(version, x, y) ? version_dark(version, x, y) :
+        x == 8 && y == qr_size(version) - 8;
+}
+
+constexpr uint8_t layout_bit(int version, size_t offset, bool base, int shift) {
+    return offset >= static_cast<size_t>(qr_size(version) * qr_size(version)) ? 0 :
+        static_cast<uint8_t>((base ? base_dark(version, static_cast<int>(offset % qr_size(version)),
+                                         static_cast<int>(offset / qr_size(version))) :
+                                     is_function(version, static_cast<int>(offset % qr_size(version)),
+                                         static_cast<int>(offset / qr_size(version))))
+            << shift);
+}
+constexpr uint8_t layout_byte(int version, size_t index, bool base) {
+    return layout_bit(version, index * 8, base, 7) | layout_bit(version, index * 8 + 1, base, 6) |
+        layout_bit(version, index * 8 + 2, base, 5) | layout_bit(version, index * 8 + 3, base, 4) |
+        layout_bit(version, index * 8 + 4, base, 3) | layout_bit(version, index * 8 + 5, base, 2) |
+        layout_bit(version, index * 8 + 6, base, 1) | layout_bit(version, index * 8 + 7, base, 0);
+}
+
+// Which modules of a version are function modules, and their values, in the
+// qrcode.h bit layout.
+template <int Version, typename List = typename MakeIndexList<service_qr_encoder_buffer_size(Version)>::type>
+struct QrLayout;
+template <int Version, size_t... Is>
+struct QrLayout<Version, IndexList<Is...>> {
+    static constexpr uint8_t kFunction[sizeof...(Is)] = {layout_byte(Version, Is, false)...};
+    static constexpr uint8_t kBase[sizeof...(Is)] = {layout_byte(Version, Is, true)...};
+};
+template <int Version, size_t... Is>
+constexpr uint8_t QrLayout<Version, IndexList<Is...>>::kFunction[sizeof...(Is)];
+template <int Version, size_t... Is>
+constexpr uint8_t QrLayout<Version, IndexList<Is...>>::kBase[sizeof...(Is)];
+
+// ECC low format words: level bits 01, the mask, BCH(15,5), XOR 0x5412.
+constexpr uint32_t format_remainder(uint32_t remainder, int steps = 10) {
+    return steps == 0 ? remainder : format_remainder((remainder << 1) ^ ((remainder >> 9) * 0x537), steps - 1);
+}
+constexpr uint16_t format_word(uint32_t mask) {
+    return static_cast<uint16_t>(((1 << 3 | mask) << 10 | format_remainder(1 << 3 | mask)) ^ 0x5412);
+}
+constexpr uint16_t kFormatWords[8] = {
+    format_word(0), format_word(1), format_word(2), format_word(3),
+    format_word(4), format_word(5), format_word(6), format_word(7),
+};
+
+struct VersionSpec {
+    uint8_t version;
+    uint8_t ecc_per_block;
+    uint8_t blocks;
+    const uint8_t* function;
+    const uint8_t* base;
+    const uint8_t* generator_logs;
+};
+
+template <int Version, size_t EccPerBlock, uint8_t Blocks>
+constexpr VersionSpec version_spec() {
+    return {Version, EccPerBlock, Blocks, QrLayout<Version>::kFunction, QrLayout<Version>::kBase,
+        RsGenerator<EccPerBlock>::kLogs};
+}
+
+// ECC low block structure of each version in kQrCapacities.
+constexpr VersionSpec kVersions[] = {
+    version_spec<5, 26, 1>(),
+    version_spec<6, 18, 2>(),
+    version_spec<7, 20, 2>(),
+    version_spec<8, 24, 2>(),
+    version_spec<9, 30, 2>(),
+    version_spec<10, 18, 4>(),
+};
+constexpr size_t kVersionCount = sizeof(kVersions) / sizeof(kVersions[0]);
+
+constexpr int data_codewords(const VersionSpec& spec) {
+    return raw_codewords(spec.version) - spec.ecc_per_block * spec.blocks;
+}
+// Mode and count take 12 bits below version 10, 20 from there.
+constexpr int byte_capacity(const VersionSpec& spec) {
+    return data_codewords(spec) - (spec.version < 10 ? 2 : 3);
+}
+constexpr bool matches_capacities(size_t i = 0) {
+    return i >= kVersionCount ? true :
+        kVersions[i].version == kQrCapacities[i].version &&
+        byte_capacity(kVersions[i]) == kQrCapacities[i].byte_capacity && matches_capacities(i + 1);
+}
+static_assert(kVersionCount == sizeof(kQrCapacities) / sizeof(kQrCapacities[0]) && matches_capacities(),
+    "encoder versions must follow kQrCapacities");
+
+constexpr int kMaxSize = qr_size(kQrCapacities[kVersionCount - 1].version);
+constexpr int kMaxCodewords = raw_codewords(kQrCapacities[kVersionCount - 1].version);
+
+// ---- Run time. One byte per module while encoding; the QR tick is the only
+// caller, so the working grids are static rather than on its stack.
+
+uint8_t g_dark[kMaxSize * kMaxSize];
+uint8_t g_function[kMaxSize * kMaxSize];
+uint8_t g_data[kMaxCodewords];
+uint8_t g_ecc[kMaxCodewords];
+uint8_t g_codewords[kMaxCodewords];
+
+const VersionSpec* find_spec(uint8_t version) {
+    for (const VersionSpec& spec : kVersions) {
+        if (spec.version == version) {
+            return &spec;
+        }
+    }
+    return nullptr;
+}
+
+// Mode 0100, the count, the data, the terminator, then pad codewords. The
+// header is a whole number of bytes and a nibble, so every data byte
+// straddles two codewords.
+void build_data(const uint8_t* data, size_t length, uint8_t version, int capacity) {
+    int n = 0;
+    if (version < 10) {
+        g_data[n++] = static_cast<uint8_t>(0x40 | length >> 4);
+    } else {
+        g_data[n++] = static_cast<uint8_t>(0x40 | length >> 12);
+        g_data[n++] = static_cast<uint8_t>(length >> 4);
+    }
+    uint8_t carry = length & 0x0F;
+    for (size_t i = 0; i < length; ++i) {
+        g_data[n++] = static_cast<uint8_t>(carry << 4 | data[i] >> 4);
+        carry = data[i] & 0x0F;
+    }
+    g_data[n++] = static_cast<uint8_t>(carry << 4);
+    for (uint8_t pad = 0xEC; n < capacity; pad ^= 0xEC ^ 0x11) {
+        g_data[n++] = pad;
+    }
+}
+
+void ecc_block(const uint8_t* data, int length, const uint8_t* generator_logs, int degree, uint8_t* remainder) {
+    memset(remainder, 0, degree);
+    for (int i = 0; i < length; ++i) {
+        const uint8_t factor = data[i] ^ remainder[0];
+        memmove(remainder, remainder + 1, degree - 1);
+        remainder[degree - 1] = 0;
+        if (factor != 0) {
+            const uint8_t* exp = GfExp<>::kValues + GfLog<>::kValues[factor];
+            for (int j = 0; j < degree; ++j) {
+                remainder[j] ^= exp[generator_logs[j]];
+            }
+        }
+    }
+}
+
+// Splits the data into blocks, appends each block's ECC and interleaves.
+int build_codewords(const VersionSpec& spec) {
+    const int total = raw_codewords(spec.version);
+    const int short_blocks = spec.blocks - total % spec.blocks;
+    const int short_data = total / spec.blocks - spec.ecc_per_block;
+    int offsets[4];
+    int n = 0;
+    for (int b = 0, k = 0; b < spec.blocks; ++b) {
+        const int length = short_data + (b < short_blocks ? 0 : 1);
+        offsets[b] = k;
+        ecc_block(g_data + k, length, spec.generator_logs, spec.ecc_per_block, g_ecc + b * spec.ecc_per_block);
+        k += length;
+    }
+    for (int i = 0; i <= short_data; ++i) {
+        for (int b = 0; b < spec.blocks; ++b) {
+            if (i < short_data || b >= short_blocks) {
+                g_codewords[n++] = g_data[offsets[b] + i];
+            }
+        }
+    }
+    for (int i = 0; i < spec.ecc_per_block; ++i) {
+        for (int b = 0; b < spec.blocks; ++b) {
+            g_codewords[n++] = g_ecc[b * spec.ecc_per_block + i];
+        }
+    }
+    return n;
+}
+
+void unpack_layout(const VersionSpec& spec, int size) {
+    for (int offset = 0; offset < size * size; ++offset) {
+        const int shift = 7 - (offset & 7);
+        g_function[offset] = (spec.function[offset >> 3] >> shift) & 1;
+        g_dark[offset] = (spec.base[offset >> 3] >> shift) & 1;
+    }
+}
+
+// Two-column zigzag from the bottom right, around the function modules.
+void place_codewords(int size, int count) {
+    const int bits = count * 8;
+    int i = 0;
+    for (int right = size - 1; right >= 1; right -= 2) {
+        if (right == 6) {
+            right = 5;
+        }
+        const bool upward = ((right + 1) & 2) == 0;
+        for (int vert = 0; vert < size; ++vert) {
+            const int y = upward ? size - 1 - vert : vert;
+            for (int j = 0; j < 2 && i < bits; ++j) {
+                const int offset = y * size + right - j;
+                if (!g_function[offset]) {
+                    g_dark[offset] = (g_codewords[i >> 3] >> (7 - (i & 7))) & 1;
+                    i++;
+                }
+            }
+        }
+    }
+}
+
+bool mask_bit(int mask, int x, int y) {
+    switch (mask) {
+        case 0: return (x + y) % 2 == 0;
+        case 1: return y % 2 == 0;
+        case 2: return x % 3 == 0;
+        case 3: return (x + y) % 3 == 0;
+        case 4: return (x / 3 + y / 2) % 2 == 0;
+        case 5: return x * y % 2 + x * y % 3 == 0;
+        case 6: return (x * y % 2 + x * y % 3) % 2 == 0;
+        default: return ((x + y) % 2 + x * y % 3) % 2 == 0;
+    }
+}
+
+void apply_mask(int size, int mask) {
+    for (int y = 0; y < size; ++y) {
+        uint8_t* dark = g_dark + y * size;
+        const uint8_t* function = g_function + y * size;
+        for (int x = 0; x < size; ++x) {
+            dark[x] ^= !function[x] && mask_bit(mask, x, y);
+        }
+    }
+}
+
+void draw_format(int size, int mask) {
+    const uint16_t word = kFormatWords[mask];
+    auto bit = [word](int i) {
+        return static_cast<uint8_t>((word >> i) & 1);
+    };
+    for (int i = 0; i <= 5; ++i) {
+        g_dark[i * size + 8] = bit(i);
+    }
+    g_dark[7 * size + 8] = bit(6);
+    g_dark[8 * size + 8] = bit(7);
+    g_dark[8 * size + 7] = bit(8);
+    for (int i = 9; i < 15; ++i) {
+        g_dark[8 * size + 14 - i] = bit(i);
+    }
+    for (int i = 0; i < 8; ++i) {
+        g_dark[8 * size + size - 1 - i] = bit(i);
+    }
+    for (int i = 8; i < 15; ++i) {
+        g_dark[(size - 15 + i) * size + 8] = bit(i);
+    }
+}
+
+// The qrcode.h score: runs of five or more, 2x2 blocks, finder-like
+// 1011101 with four light modules on either side, and dark balance.
+long penalty(int size) {
+    long result = 0;
+    for (int pass = 0; pass < 2; ++pass) {
+        const int step = pass == 0 ? 1 : size;
+        const int line_step = pass == 0 ? size : 1;
+        for (int a = 0; a < size; ++a) {
+            const uint8_t* line = g_dark + a * line_step;
+            uint8_t color = line[0];
+            int run = 1;
+            int bits = color;
+            for (int b = 1; b < size; ++b) {
+                const uint8_t c = line[b * step];
+                if (c != color) {
+                    color = c;
+                    run = 1;
+                } else if (++run == 5) {
+                    result += 3;
+                } else if (run > 5) {
+                    result++;
+                }
+                bits = ((bits << 1) & 0x7FF) | c;
+                if (b >= 10 && (bits == 0x05D || bits == 0x5D0)) {
+                    result += 40;
+                }
+            }
+        }
+    }
+    int dark = 0;
+    for (int y = 0; y < size - 1; ++y) {
+        const uint8_t* row = g_dark + y * size;
+        const uint8_t* next = row + size;
+        for (int x = 0; x < size - 1; ++x) {
+            dark += row[x];
+            const uint8_t c = row[x];
+            if (c == row[x + 1] && c == next[x] && c == next[x + 1]) {
+                result += 3;
+            }
+        }
+        dark += row[size - 1];
+    }
+    for (int x = 0; x < size; ++x) {
+        dark += g_dark[(size - 1) * size + x];
+    }
+    const int total = size * size;
+    for (int k = 0; dark * 20 < (9 - k) * total || dark * 20 > (11 + k) * total; ++k) {
+        result += 10;
+    }
+    return result;
+}
+
+int choose_mask(int size) {
+    int best = 0;
+    long best_penalty = -1;
+    for (int mask = 0; mask < 8; ++mask) {
+        draw_format(size, mask);
+        apply_mask(size, mask);
+        const long score = penalty(size);
+        if (best_penalty < 0 || score < best_penalty) {
+            best = mask;
+            best_penalty = score;
+        }
+        apply_mask(size, mask);
+    }
+    return best;
+}
+
+void pack_modules(int size, uint8_t* modules) {
+    const int count = size * size;
+    for (int offset = 0; offset < count; offset += 8) {
+        uint8_t byte = 0;
+        for (int bit = 0; bit < 8; ++bit) {
+            byte = static_cast<uint8_t>(byte << 1 | (offset + bit < count ? g_dark[offset + bit] : 0));
+        }
+        modules[offset >> 3] = byte;
+    }
+}
+
+} // namespace
+
+int8_t service_qr_encoder_encode(const uint8_t* data, size_t length, uint8_t version, int8_t mask, uint8_t* modules) {
+    const VersionSpec* spec = find_spec(version);
+    if (!spec || mask < kQrMaskAuto || mask > 7 || length > static_cast<size_t>(byte_capacity(*spec))) {
+        return -1;
+    }
+    const int size = qr_size(version);
+    build_data(data, length, version, data_codewords(*spec));
+    const int count = build_codewords(*spec);
+    unpack_layout(*spec, size);
+    place_codewords(size, count);
+    if (mask == kQrMaskAuto) {
+        mask = static_cast<int8_t>(choose_mask(size));
+    }
+    draw_format(size, mask);
+    apply_mask(size, mask);
+    pack_modules(size, modules);
+    return mask;
+}
+
+} // namespace ptc
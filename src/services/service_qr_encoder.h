@@ -0,0 +1,30 @@
+#pragma once
+
+#include "config.h"
+
+namespace ptc {
+
+// Passed as mask to have the encoder score all eight and keep the best, as
+// qrcode.h does.
+static constexpr int8_t kQrMaskAuto = -1;
+
+// Modules per side of version.
+constexpr uint8_t service_qr_encoder_size(uint8_t version) {
+    return static_cast<uint8_t>(17 + 4 * version);
+}
+// Bytes of its modules, row-major and one bit each (the qrcode.h layout).
+constexpr uint16_t service_qr_encoder_buffer_size(uint8_t version) {
+    return static_cast<uint16_t>((service_qr_encoder_size(version) * service_qr_encoder_size(version) + 7) / 8);
+}
+
+// Byte-mode, ECC low QR encoder for the versions in kQrCapacities only. The
+// function patterns, format words and Reed-Solomon generator of each version
+// are built at compile time, so an encode is the codewords, their placement
+// and the mask. With kQrMaskAuto the modules match what qrcode_initText
+// writes for the same byte-mode text; mask 0-7 skips the scoring.
+// modules takes service_qr_encoder_buffer_size(version) bytes. Returns the
+// mask used, or -1 when the version is not one of kQrCapacities or the data
+// does not fit.
+int8_t service_qr_encoder_encode(const uint8_t* data, size_t length, uint8_t version, int8_t mask, uint8_t* modules);
+
+} // namespace ptc
@@ -0,0 +1,244 @@
+#include "service_scheduler.h"
+
+#include <freertos/FreeRTOS.h>
+#include <freertos/semphr.h>
+#include <freertos/task.h>
+
+#include "service_metrics.h"
+#include "service_telemetry.h"
+
+namespace ptc {
+
+namespace {
+
+constexpr uint8_t kMaxTasks = 12;
+
+struct ScheduledTask {
+    SchedulerTaskStats stats;
+    SchedulerTickFn tick = nullptr;
+    uint32_t due_ms = 0;
+    uint32_t wake_events = 0;
+    int8_t probe = -1;
+    int8_t alloc_tag = -1;
+    bool gated = false;
+};
+
+ScheduledTask g_tasks[kMaxTasks];
+uint8_t g_heap[kMaxTasks];
+uint8_t g_task_count = 0;
+SchedulerGateFn g_gate = nullptr;
+TaskHandle_t g_loop_task = nullptr;
+SemaphoreHandle_t g_tick_mutex = nullptr;
+uint32_t g_task_events = 0;
+uint32_t g_wakeups = 0;
+uint32_t g_event_wakeups = 0;
+
+// Deadlines are compared as signed distances so millis() wrap is harmless.
+// Equal deadlines run in registration order.
+bool runs_before(uint8_t a, uint8_t b) {
+    const int32_t delta = static_cast<int32_t>(g_tasks[a].due_ms - g_tasks[b].due_ms);
+    return delta < 0 || (delta == 0 && a < b);
+}
+
+void sift_up(uint8_t position) {
+    while (position > 0) {
+        const uint8_t parent = (position - 1) / 2;
+        if (!runs_before(g_heap[position], g_heap[parent])) {
+            break;
+        }
+        const uint8_t swap = g_heap[parent];
+        g_heap[parent] = g_heap[position];
+        g_heap[position] = swap;
+        position = parent;
+    }
+}
+
+void sift_down(uint8_t position) {
+    while (true) {
+        const uint8_t left = position * 2 + 1;
+        const uint8_t right = left + 1;
+        uint8_t first = position;
+        if (left < g_task_count && runs_before(g_heap[left], g_heap[first])) {
+            first = left;
+        }
+        if (right < g_task_count && runs_before(g_heap[right], g_heap[first])) {
+            first = right;
+        }
+        if (first == position) {
+            return;
+        }
+        const uint8_t swap = g_heap[first];
+        g_heap[first] = g_heap[position];
+        g_heap[position] = swap;
+        position = first;
+    }
+}
+
+void make_subscribers_due(uint32_t events) {
+    const uint32_t now_ms = millis();
+    bool changed = false;
+    for (uint8_t i = 0; i < g_task_count; ++i) {
+        ScheduledTask& task = g_tasks[i];
+        if ((task.wake_events & events) && static_cast<int32_t>(task.due_ms - now_ms) > 0) {
+            task.due_ms = now_ms;
+            changed = true;
+        }
+    }
+    if (!changed) {
+        return;
+    }
+    for (uint8_t i = g_task_count / 2; i-- > 0;) {
+        sift_down(i);
+    }
+}
+
+} // namespace
+
+int8_t service_scheduler_add(
+    const char* name, uint32_t period_ms, SchedulerTickFn tick, bool gated, uint32_t wake_events) {
+    if (g_task_count >= kMaxTasks || !tick || period_ms == 0) {
+        return -1;
+    }
+    const uint8_t index = g_task_count;
+    ScheduledTask& task = g_tasks[index];
+    task = ScheduledTask();
+    task.stats.name = name;
+    task.stats.period_ms = period_ms;
+    task.tick = tick;
+    task.gated = gated;
+    task.wake_events = wake_events;
+    task.probe = service_metrics_probe(name);
+    task.alloc_tag = service_telemetry_alloc_tag(name);
+    task.due_ms = millis();
+    g_heap[index] = index;
+    g_task_count++;
+    if (!g_loop_task) {
+        g_loop_task = xTaskGetCurrentTaskHandle();
+    }
+    if (!g_tick_mutex) {
+        g_tick_mutex = xSemaphoreCreateMutex();
+    }
+    sift_up(index);
+    return static_cast<int8_t>(index);
+}
+
+void service_scheduler_set_gate(SchedulerGateFn gate) {
+    g_gate = gate;
+}
+
+void service_scheduler_reset() {
+    g_task_count = 0;
+    g_gate = nullptr;
+    g_loop_task = nullptr;
+    g_task_events = 0;
+    g_wakeups = 0;
+    g_event_wakeups = 0;
+}
+
+uint32_t service_scheduler_run_due() {
+    if (g_task_events) {
+        make_subscribers_due(g_task_events);
+        g_task_events = 0;
+    }
+    for (uint8_t pass = 0; pass < g_task_count; ++pass) {
+        ScheduledTask& task = g_tasks[g_heap[0]];
+        const uint32_t now_ms = millis();
+        if (static_cast<int32_t>(task.due_ms - now_ms) > 0) {
+            break;
+        }
+
+        if (task.gated && g_gate && g_gate()) {
+            task.stats.skipped++;
+        } else {
+            const uint32_t late_ms = now_ms - task.due_ms;
+            task.stats.runs++;
+            task.stats.total_late_ms += late_ms;
+            task.stats.max_late_ms = max(task.stats.max_late_ms, late_ms);
+            xSemaphoreTake(g_tick_mutex, portMAX_DELAY);
+            const int8_t outer_tag = service_telemetry_swap_alloc_tag(task.alloc_tag);
+            const uint32_t start_cycles = service_metrics_start();
+            task.tick(now_ms);
+            service_metrics_stop(task.probe, start_cycles);
+            service_telemetry_swap_alloc_tag(outer_tag);
+            xSemaphoreGive(g_tick_mutex);
+        }
+
+        // Keep the original phase; after a stall skip the missed periods
+        // instead of replaying them back to back.
+        task.due_ms += task.stats.period_ms;
+        const uint32_t finished_ms = millis();
+        if (static_cast<int32_t>(task.due_ms - finished_ms) <= 0) {
+            task.due_ms = finished_ms + task.stats.period_ms;
+        }
+        sift_down(0);
+    }
+
+    if (g_task_count == 0) {
+        return kSchedulerNoDeadline;
+    }
+    const int32_t remaining = static_cast<int32_t>(g_tasks[g_heap[0]].due_ms - millis());
+    return remaining > 0 ? static_cast<uint32_t>(remaining) : 0;
+}
+
+void service_scheduler_sleep(uint32_t max_ms) {
+    g_wakeups++;
+    // A zero wait still collects events that arrived while the loop was busy.
+    uint32_t events = 0;
+    const TickType_t ticks = max_ms == kSchedulerNoDeadline ? portMAX_DELAY : pdMS_TO_TICKS(max_ms);
+    if (xTaskNotifyWait(0, 0xFFFFFFFFUL, &events, ticks) == pdTRUE && events) {
+        g_task_events |= events;
+        if (max_ms != 0) {
+            g_event_wakeups++;
+        }
+    }
+}
+
+void service_scheduler_signal(uint32_t events) {
+    if (g_loop_task) {
+        xTaskNotify(g_loop_task, events, eSetBits);
+    }
+}
+
+void IRAM_ATTR service_scheduler_signal_from_isr(uint32_t events) {
+    if (!g_loop_task) {
+        return;
+    }
+    BaseType_t higher_priority_woken = pdFALSE;
+    xTaskNotifyFromISR(g_loop_task, events, eSetBits, &higher_priority_woken);
+    portYIELD_FROM_ISR(higher_priority_woken);
+}
+
+bool service_scheduler_lock(uint32_t timeout_ms) {
+    if (!g_tick_mutex) {
+        return true;
+    }
+    return xSemaphoreTake(g_tick_mutex, timeout_ms == kSchedulerNoDeadline ? portMAX_DELAY : pdMS_TO_TICKS(timeout_ms)) == pdTRUE;
+}
+
+void service_scheduler_unlock() {
+    if (g_tick_mutex) {
+        xSemaphoreGive(g_tick_mutex);
+    }
+}
+
+uint8_t service_scheduler_task_count() {
+    return g_task_count;
+}
+
+bool service_scheduler_get_stats(uint8_t index, SchedulerTaskStats& out_stats) {
+    if (index >= g_task_count) {
+        return false;
+    }
+    out_stats = g_tasks[index].stats;
+    return true;
+}
+
+uint32_t service_scheduler_wakeups() {
+    return g_wakeups;
+}
+
+uint32_t service_scheduler_event_wakeups() {
+    return g_event_wakeups;
+}
+
+} // namespace ptc
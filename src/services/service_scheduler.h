@@ -0,0 +1,57 @@
+#pragma once
+
+#include "config.h"
+
+namespace ptc {
+
+using SchedulerTickFn = void (*)(uint32_t now_ms);
+using SchedulerGateFn = bool (*)();
+
+static constexpr uint32_t kSchedulerNoDeadline = 0xFFFFFFFFUL;
+
+// Wake sources for the loop task. Signalling an event ends the current sleep
+// and makes every task subscribed to it due immediately.
+static constexpr uint32_t kSchedulerEventHttpResult = 1UL << 0;
+static constexpr uint32_t kSchedulerEventOtaResult = 1UL << 1;
+
+struct SchedulerTaskStats {
+    const char* name = "";
+    uint32_t period_ms = 0;
+    uint32_t runs = 0;
+    uint32_t skipped = 0;
+    uint32_t max_late_ms = 0;
+    uint64_t total_late_ms = 0;
+};
+
+// Registers a periodic task; returns its index or -1 when the table is full.
+// Gated tasks are skipped (and rescheduled) while the gate returns true.
+// Each tick is timed into the service_metrics probe of the same name.
+// wake_events lists the kSchedulerEvent* bits that pull the task forward.
+// The first call binds the scheduler to the calling (loop) task.
+int8_t service_scheduler_add(
+    const char* name, uint32_t period_ms, SchedulerTickFn tick, bool gated, uint32_t wake_events = 0);
+void service_scheduler_set_gate(SchedulerGateFn gate);
+void service_scheduler_reset();
+
+// Runs every task whose deadline has passed, at most once each, and returns
+// the milliseconds until the next deadline (kSchedulerNoDeadline if none).
+uint32_t service_scheduler_run_due();
+
+// Blocks the loop task for up to max_ms, returning early when an event is
+// signalled. Must be called from the loop task, since it waits on that task's
+// notification. Signal from any task, and with the ISR variant from interrupts.
+void service_scheduler_sleep(uint32_t max_ms);
+void service_scheduler_signal(uint32_t events);
+void service_scheduler_signal_from_isr(uint32_t events);
+
+// Ticks run while holding the scheduler lock. Code on other tasks (the UI)
+// takes it before reading or changing service state.
+bool service_scheduler_lock(uint32_t timeout_ms);
+void service_scheduler_unlock();
+
+uint8_t service_scheduler_task_count();
+bool service_scheduler_get_stats(uint8_t index, SchedulerTaskStats& out_stats);
+uint32_t service_scheduler_wakeups();
+uint32_t service_scheduler_event_wakeups();
+
+} // namespace ptc
@@ -28,6 +28,10 @@ constexpr const char* kLegacyLogsPath = "/ptc/logs.json";
 constexpr const char* kSystemLogPath = "/ptc/system.jsonl";
 constexpr const char* kActivityLogPath = "/ptc/activity.jsonl";
 constexpr const char* kCalibrationPath = "/ptc/calibration.json";
+constexpr const char* kActivityCursorPath = "/ptc/activity.cursor";
+constexpr const char* kOutboxPath = "/ptc/outbox.jsonl";
+constexpr const char* kOutboxCursorPath = "/ptc/outbox.cursor";
+constexpr size_t kOutboxCopyChunkBytes = 512;
 constexpr size_t kMaxSystemLogBytes = 512 * 1024;
 constexpr size_t kMaxActivityLogBytes = 1024 * 1024;
 
@@ -372,6 +376,8 @@ void service_storage_load_config(DeviceConfig& config, AppState& state) {
             config.location_name = String(doc["location_name"] | config.location_name.c_str());
             config.qr_interval_sec = doc["qr_interval_sec"] | config.qr_interval_sec;
             config.display_rotation = doc["display_rotation"] | config.display_rotation;
+            config.config_etag = String(doc["etag"] | "");
+            config.portal_sync = doc["portal_sync"] | false;
             loaded_from_sd = true;
         }
     }
@@ -427,6 +433,12 @@ void service_storage_save_config(const DeviceConfig& config) {
     doc["location_name"] = config.location_name;
     doc["qr_interval_sec"] = config.qr_interval_sec;
     doc["display_rotation"] = config.display_rotation;
+    if (!config.config_etag.isEmpty()) {
+        doc["etag"] = config.config_etag;
+    }
+    if (config.portal_sync) {
+        doc["portal_sync"] = true;
+    }
     String json;
     serializeJson(doc, json);
     if (!write_sd_text_atomic(kConfigPath, json)) {
@@ -492,10 +504,13 @@ void service_storage_save_device_active(bool active) {
     }
 }
 
-void service_storage_save_notices(const String& json, uint32_t ts) {
+void service_storage_save_notices(const String& json, uint32_t ts, const String& etag) {
     const bool saved_notices = write_sd_text_atomic(kNoticesPath, json);
-    StaticJsonDocument<96> meta;
+    StaticJsonDocument<192> meta;
     meta["timestamp"] = ts;
+    if (!etag.isEmpty()) {
+        meta["etag"] = etag;
+    }
     String meta_json;
     serializeJson(meta, meta_json);
     const bool saved_meta = write_sd_text_atomic(kNoticesMetaPath, meta_json);
@@ -508,17 +523,20 @@ void service_storage_save_notices(const String& json, uint32_t ts) {
     }
 }
 
-bool service_storage_load_notices(String& json, uint32_t& ts) {
+bool service_storage_load_notices(String& json, uint32_t& ts, String& etag) {
+    etag = "";
     if (read_sd_text(kNoticesPath, json)) {
         ts = 0;
         String meta_json;
-        StaticJsonDocument<96> meta;
+        StaticJsonDocument<192> meta;
         if (read_sd_text(kNoticesMetaPath, meta_json) &&
             deserializeJson(meta, meta_json) == DeserializationError::Ok) {
             ts = meta["timestamp"] | 0;
+            etag = String(meta["etag"] | "");
         }
         return !json.isEmpty();
     }
+    // The NVS fallback keeps no validator, so the next poll fetches in full.
     json = g_prefs.isKey(kKeyNoticesJson) ? g_prefs.getString(kKeyNoticesJson, "") : "";
     ts = g_prefs.getUInt(kKeyNoticesTs, 0);
     return !json.isEmpty();
@@ -555,6 +573,105 @@ bool service_storage_load_recent_activity(
     return !entries.empty();
 }
 
+bool service_storage_load_activity_cursor(String& cursor) {
+    cursor = "";
+    return read_sd_text(kActivityCursorPath, cursor);
+}
+
+bool service_storage_save_activity_cursor(const String& cursor) {
+    return write_sd_text_atomic(kActivityCursorPath, cursor);
+}
+
+bool service_storage_outbox_append(const String& line) {
+    if (!g_sd_ready) {
+        return false;
+    }
+    File file = SD.open(kOutboxPath, FILE_APPEND);
+    if (!file) {
+        return false;
+    }
+    const size_t written = file.print(line);
+    const size_t newline_written = file.print('\n');
+    file.flush();
+    file.close();
+    return written == line.length() && newline_written == 1;
+}
+
+size_t service_storage_outbox_read(uint32_t offset, char* buffer, size_t size) {
+    if (!g_sd_ready || !buffer || size == 0) {
+        return 0;
+    }
+    File file = SD.open(kOutboxPath, FILE_READ);
+    if (!file) {
+        return 0;
+    }
+    size_t count = 0;
+    if (offset < file.size() && file.seek(offset)) {
+        count = file.read(reinterpret_cast<uint8_t*>(buffer), size);
+    }
+    file.close();
+    return count;
+}
+
+uint32_t service_storage_outbox_size() {
+    if (!g_sd_ready || !SD.exists(kOutboxPath)) {
+        return 0;
+    }
+    File file = SD.open(kOutboxPath, FILE_READ);
+    if (!file) {
+        return 0;
+    }
+    const uint32_t size = static_cast<uint32_t>(file.size());
+    file.close();
+    return size;
+}
+
+uint32_t service_storage_outbox_load_cursor() {
+    String text;
+    return read_sd_text(kOutboxCursorPath, text) ? static_cast<uint32_t>(strtoul(text.c_str(), nullptr, 10)) : 0;
+}
+
+bool service_storage_outbox_save_cursor(uint32_t offset) {
+    return write_sd_text_atomic(kOutboxCursorPath, String(static_cast<unsigned long>(offset)));
+}
+
+bool service_storage_outbox_compact(uint32_t offset) {
+    if (!g_sd_ready) {
+        return false;
+    }
+    if (offset >= service_storage_outbox_size()) {
+        service_storage_outbox_save_cursor(0);
+        SD.remove(kOutboxPath);
+        return true;
+    }
+    const String temp_path = String(kOutboxPath) + ".tmp";
+    SD.remove(temp_path.c_str());
+    File source = SD.open(kOutboxPath, FILE_READ);
+    File target = SD.open(temp_path.c_str(), FILE_WRITE);
+    bool copied = source && target && source.seek(offset);
+    char chunk[kOutboxCopyChunkBytes];
+    while (copied) {
+        const size_t count = source.read(reinterpret_cast<uint8_t*>(chunk), sizeof(chunk));
+        if (count == 0) {
+            break;
+        }
+        copied = target.write(reinterpret_cast<const uint8_t*>(chunk), count) == count;
+    }
+    if (source) {
+        source.close();
+    }
+    if (target) {
+        target.flush();
+        target.close();
+    }
+    if (!copied || !service_storage_outbox_save_cursor(0)) {
+        SD.remove(temp_path.c_str());
+        return false;
+    }
+    SD.remove(kOutboxPath);
+    return SD.rename(temp_path.c_str(), kOutboxPath);
+}
+
 void service_storage_save_touch_calibration(const TouchCalibration& calibration) {
     g_prefs.putUShort(kKeyTouchMinX, calibration.raw_min_x);
     g_prefs.putUShort(kKeyTouchMaxX, calibration.raw_max_x);
@@ -668,6 +785,9 @@ void service_storage_clear_all() {
     remove_sd_file(kActivityLogPath);
     remove_sd_file((String(kActivityLogPath) + ".1").c_str());
     remove_sd_file(kCalibrationPath);
+    remove_sd_file(kActivityCursorPath);
+    remove_sd_file(kOutboxPath);
+    remove_sd_file(kOutboxCursorPath);
     remove_sd_file(kMarkerPath);
     g_prefs.remove(kKeyLegacyLogsJson);
 }
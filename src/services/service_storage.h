@@ -31,8 +31,9 @@ bool service_storage_save_wifi(const String& ssid, const String& password);
 void service_storage_clear_wifi();
 void service_storage_save_time_sync(bool ok);
 void service_storage_save_device_active(bool active);
-void service_storage_save_notices(const String& json, uint32_t ts);
-bool service_storage_load_notices(String& json, uint32_t& ts);
+// etag is the portal's validator for the notices; empty if it sent none.
+void service_storage_save_notices(const String& json, uint32_t ts, const String& etag);
+bool service_storage_load_notices(String& json, uint32_t& ts, String& etag);
 bool service_storage_append_system_log(uint32_t timestamp, const String& message);
 bool service_storage_append_activity(
     const String& event_id,
@@ -42,6 +43,20 @@ bool service_storage_append_activity(
 bool service_storage_load_recent_activity(
     std::vector<StoredActivity>& entries,
     uint16_t max_entries);
+// The portal's opaque activity cursor: where the next page starts.
+bool service_storage_load_activity_cursor(String& cursor);
+bool service_storage_save_activity_cursor(const String& cursor);
+// Outbox of device events the portal has not acknowledged: JSON lines
+// appended at the end and consumed from a byte cursor kept beside them.
+bool service_storage_outbox_append(const String& line);
+size_t service_storage_outbox_read(uint32_t offset, char* buffer, size_t size);
+uint32_t service_storage_outbox_size();
+uint32_t service_storage_outbox_load_cursor();
+bool service_storage_outbox_save_cursor(uint32_t offset);
+// Drops everything before offset and resets the cursor to 0. The cursor is
+// saved before the file is replaced, so a reset in between repeats records
+// rather than skipping them.
+bool service_storage_outbox_compact(uint32_t offset);
 void service_storage_save_touch_calibration(const TouchCalibration& calibration);
 bool service_storage_load_touch_calibration(TouchCalibration& calibration);
 void service_storage_clear_all();
@@ -0,0 +1,246 @@
+#include "service_telemetry.h"
+
+#include <esp_heap_caps.h>
+
+namespace ptc {
+
+namespace {
+
+struct TrackedTask {
+    TaskHandle_t handle;
+    int8_t alloc_tag;
+};
+
+TrackedTask g_tasks[kTelemetryMaxTasks];
+uint8_t g_task_count = 0;
+
+#ifdef PTC_ALLOC_TRACE
+constexpr uint8_t kMaxAllocTags = 16;
+
+struct AllocTag {
+    const char* name;
+    uint32_t count;
+    uint32_t bytes;
+};
+
+AllocTag g_alloc_tags[kMaxAllocTags] = {{"other", 0, 0}};
+uint8_t g_alloc_tag_count = 1;
+
+// Runs inside every malloc, so it must not allocate or block.
+void IRAM_ATTR count_alloc(size_t size) {
+    uint8_t tag = 0;
+    if (xTaskGetSchedulerState() != taskSCHEDULER_NOT_STARTED) {
+        const TaskHandle_t current = xTaskGetCurrentTaskHandle();
+        const uint8_t task_count = __atomic_load_n(&g_task_count, __ATOMIC_ACQUIRE);
+        for (uint8_t i = 0; i < task_count; ++i) {
+            if (g_tasks[i].handle == current) {
+                tag = static_cast<uint8_t>(__atomic_load_n(&g_tasks[i].alloc_tag, __ATOMIC_RELAXED));
+                break;
+            }
+        }
+    }
+    __atomic_fetch_add(&g_alloc_tags[tag].count, 1, __ATOMIC_RELAXED);
+    __atomic_fetch_add(&g_alloc_tags[tag].bytes, static_cast<uint32_t>(size), __ATOMIC_RELAXED);
+}
+#endif
+
+HeapRegionStats sample_region(uint32_t caps) {
+    HeapRegionStats region;
+    region.total_bytes = heap_caps_get_total_size(caps);
+    region.free_bytes = heap_caps_get_free_size(caps);
+    region.largest_block = heap_caps_get_largest_free_block(caps);
+    region.min_free_bytes = heap_caps_get_minimum_free_size(caps);
+    return region;
+}
+
+} // namespace
+
+#ifdef PTC_ALLOC_TRACE
+
+int8_t service_telemetry_alloc_tag(const char* name) {
+    for (uint8_t i = 0; i < g_alloc_tag_count; ++i) {
+        if (strcmp(g_alloc_tags[i].name, name) == 0) {
+            return static_cast<int8_t>(i);
+        }
+    }
+    if (g_alloc_tag_count >= kMaxAllocTags) {
+        return 0;
+    }
+    g_alloc_tags[g_alloc_tag_count].name = name;
+    return static_cast<int8_t>(g_alloc_tag_count++);
+}
+
+int8_t service_telemetry_swap_alloc_tag(int8_t tag) {
+    const TaskHandle_t current = xTaskGetCurrentTaskHandle();
+    for (uint8_t i = 0; i < g_task_count; ++i) {
+        if (g_tasks[i].handle == current) {
+            return __atomic_exchange_n(&g_tasks[i].alloc_tag, static_cast<int8_t>(tag < 0 ? 0 : tag), __ATOMIC_RELAXED);
+        }
+    }
+    return 0;
+}
+
+uint8_t service_telemetry_alloc_tag_count() {
+    return g_alloc_tag_count;
+}
+
+bool service_telemetry_alloc_stats(uint8_t tag, AllocTagStats& out_stats) {
+    if (tag >= g_alloc_tag_count) {
+        return false;
+    }
+    out_stats.name = g_alloc_tags[tag].name;
+    out_stats.count = __atomic_load_n(&g_alloc_tags[tag].count, __ATOMIC_RELAXED);
+    out_stats.bytes = __atomic_load_n(&g_alloc_tags[tag].bytes, __ATOMIC_RELAXED);
+    return true;
+}
+
+#endif
+
+void service_telemetry_register_task(TaskHandle_t task) {
+    if (!task || g_task_count >= kTelemetryMaxTasks) {
+        return;
+    }
+    for (uint8_t i = 0; i < g_task_count; ++i) {
+        if (g_tasks[i].handle == task) {
+            return;
+        }
+    }
+    TrackedTask& tracked = g_tasks[g_task_count];
+    tracked.handle = task;
+    tracked.alloc_tag = service_telemetry_alloc_tag(pcTaskGetName(task));
+    // Publish the entry only once it is complete; the malloc hook reads the
+    // table from other tasks without a lock.
+    __atomic_store_n(&g_task_count, static_cast<uint8_t>(g_task_count + 1), __ATOMIC_RELEASE);
+}
+
+void service_telemetry_sample(TelemetrySnapshot& out_snapshot) {
+    out_snapshot.internal = sample_region(MALLOC_CAP_INTERNAL);
+    out_snapshot.psram = sample_region(MALLOC_CAP_SPIRAM);
+    out_snapshot.task_count = g_task_count;
+    for (uint8_t i = 0; i < g_task_count; ++i) {
+        // ESP-IDF reports stack high-water marks in bytes.
+        out_snapshot.tasks[i].name = pcTaskGetName(g_tasks[i].handle);
+        out_snapshot.tasks[i].free_bytes = uxTaskGetStackHighWaterMark(g_tasks[i].handle);
+    }
+}
+
+uint8_t service_telemetry_fragmentation(const HeapRegionStats& region) {
+    if (region.free_bytes == 0 || region.largest_block >= region.free_bytes) {
+        return 0;
+    }
+    return static_cast<uint8_t>(100 - (static_cast<uint64_t>(region.largest_block) * 100) / region.free_bytes);
+}
+
+String service_telemetry_serial_line() {
+    TelemetrySnapshot snapshot;
+    service_telemetry_sample(snapshot);
+
+    char entry[112];
+    snprintf(entry, sizeof(entry), "int=%lu/%lu/%lu psram=%lu/%lu/%lu frag=%u/%u stack",
+        static_cast<unsigned long>(snapshot.internal.free_bytes),
+        static_cast<unsigned long>(snapshot.internal.largest_block),
+        static_cast<unsigned long>(snapshot.internal.min_free_bytes),
+        static_cast<unsigned long>(snapshot.psram.free_bytes),
+        static_cast<unsigned long>(snapshot.psram.largest_block),
+        static_cast<unsigned long>(snapshot.psram.min_free_bytes),
+        static_cast<unsigned int>(service_telemetry_fragmentation(snapshot.internal)),
+        static_cast<unsigned int>(service_telemetry_fragmentation(snapshot.psram)));
+    String line;
+    line.reserve(160 + snapshot.task_count * 20 + service_telemetry_alloc_tag_count() * 24);
+    line += entry;
+    for (uint8_t i = 0; i < snapshot.task_count; ++i) {
+        snprintf(entry, sizeof(entry), " %s=%lu",
+            snapshot.tasks[i].name,
+            static_cast<unsigned long>(snapshot.tasks[i].free_bytes));
+        line += entry;
+    }
+    if (kTelemetryAllocTrace) {
+        line += " alloc";
+        for (uint8_t i = 0; i < service_telemetry_alloc_tag_count(); ++i) {
+            AllocTagStats stats;
+            if (!service_telemetry_alloc_stats(i, stats) || stats.count == 0) {
+                continue;
+            }
+            snprintf(entry, sizeof(entry), " %s=%lu:%lu",
+                stats.name,
+                static_cast<unsigned long>(stats.count),
+                static_cast<unsigned long>(stats.bytes));
+            line += entry;
+        }
+    }
+    return line;
+}
+
+size_t service_telemetry_json_size() {
+    const uint8_t task_count = __atomic_load_n(&g_task_count, __ATOMIC_ACQUIRE);
+    size_t size = JSON_OBJECT_SIZE(kTelemetryAllocTrace ? 4 : 3) + 2 * JSON_ARRAY_SIZE(3) +
+        JSON_OBJECT_SIZE(task_count);
+    if (kTelemetryAllocTrace) {
+        const uint8_t tags = service_telemetry_alloc_tag_count();
+        size += JSON_OBJECT_SIZE(tags) + tags * JSON_ARRAY_SIZE(2);
+    }
+    return size;
+}
+
+void service_telemetry_write_json(JsonObject target) {
+    TelemetrySnapshot snapshot;
+    service_telemetry_sample(snapshot);
+
+    JsonArray internal = target.createNestedArray("internal");
+    internal.add(snapshot.internal.free_bytes);
+    internal.add(snapshot.internal.largest_block);
+    internal.add(snapshot.internal.min_free_bytes);
+    JsonArray psram = target.createNestedArray("psram");
+    psram.add(snapshot.psram.free_bytes);
+    psram.add(snapshot.psram.largest_block);
+    psram.add(snapshot.psram.min_free_bytes);
+
+    JsonObject stacks = target.createNestedObject("stack_free");
+    for (uint8_t i = 0; i < snapshot.task_count; ++i) {
+        stacks[snapshot.tasks[i].name] = snapshot.tasks[i].free_bytes;
+    }
+
+    if (kTelemetryAllocTrace) {
+        JsonObject alloc = target.createNestedObject("alloc");
+        for (uint8_t i = 0; i < service_telemetry_alloc_tag_count(); ++i) {
+            AllocTagStats stats;
+            if (!service_telemetry_alloc_stats(i, stats) || stats.count == 0) {
+                continue;
+            }
+            JsonArray values = alloc.createNestedArray(stats.name);
+            values.add(stats.count);
+            values.add(stats.bytes);
+        }
+    }
+}
+
+} // namespace ptc
+
+#ifdef PTC_ALLOC_TRACE
+// Link with -Wl,--wrap=malloc,--wrap=calloc,--wrap=realloc (see the
+// esp32-s3-alloc-trace environment); operator new goes through malloc.
+extern "C" {
+
+void* __real_malloc(size_t size);
+void* __real_calloc(size_t count, size_t size);
+void* __real_realloc(void* ptr, size_t size);
+
+void* IRAM_ATTR __wrap_malloc(size_t size) {
+    ptc::count_alloc(size);
+    return __real_malloc(size);
+}
+
+void* IRAM_ATTR __wrap_calloc(size_t count, size_t size) {
+    ptc::count_alloc(count * size);
+    return __real_calloc(count, size);
+}
+
+void* IRAM_ATTR __wrap_realloc(void* ptr, size_t size) {
+    if (size > 0) {
+        ptc::count_alloc(size);
+    }
+    return __real_realloc(ptr, size);
+}
+
+} // extern "C"
+#endif
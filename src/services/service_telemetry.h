@@ -0,0 +1,75 @@
+#pragma once
+
+#include <ArduinoJson.h>
+#include <freertos/FreeRTOS.h>
+#include <freertos/task.h>
+
+#include "config.h"
+
+namespace ptc {
+
+static constexpr uint8_t kTelemetryMaxTasks = 6;
+
+struct HeapRegionStats {
+    uint32_t total_bytes = 0;
+    uint32_t free_bytes = 0;
+    uint32_t largest_block = 0;
+    uint32_t min_free_bytes = 0;
+};
+
+struct TaskStackStats {
+    const char* name = "";
+    uint32_t free_bytes = 0;
+};
+
+struct TelemetrySnapshot {
+    HeapRegionStats internal;
+    HeapRegionStats psram;
+    TaskStackStats tasks[kTelemetryMaxTasks];
+    uint8_t task_count = 0;
+};
+
+// Adds a task to the stack high-water report (and, in PTC_ALLOC_TRACE
+// builds, gives its allocations a tag named after the task).
+void service_telemetry_register_task(TaskHandle_t task);
+void service_telemetry_sample(TelemetrySnapshot& out_snapshot);
+// Share of free memory not reachable by the largest block, 0-100.
+uint8_t service_telemetry_fragmentation(const HeapRegionStats& region);
+
+// "int=free/largest/min psram=free/largest/min frag=int/psram stack loopTask=..."
+// in bytes and percent.
+String service_telemetry_serial_line();
+// {"internal":[free,largest,min],"psram":[...],"stack_free":{...}}, plus
+// "alloc":{tag:[count,bytes]} in PTC_ALLOC_TRACE builds.
+void service_telemetry_write_json(JsonObject target);
+// Capacity service_telemetry_write_json needs with every task and tag listed.
+size_t service_telemetry_json_size();
+
+// Allocation-site attribution. PTC_ALLOC_TRACE builds wrap malloc/calloc/
+// realloc at link time and count each call against the current tag of the
+// calling task; allocations from unregistered tasks count as "other".
+// Without the flag these compile away.
+struct AllocTagStats {
+    const char* name = "";
+    uint32_t count = 0;
+    uint32_t bytes = 0;
+};
+
+#ifdef PTC_ALLOC_TRACE
+static constexpr bool kTelemetryAllocTrace = true;
+// Returns the tag id for name, registering it on first use (0 = "other").
+// name must outlive the tag.
+int8_t service_telemetry_alloc_tag(const char* name);
+// Sets the calling task's tag and returns the previous one.
+int8_t service_telemetry_swap_alloc_tag(int8_t tag);
+uint8_t service_telemetry_alloc_tag_count();
+bool service_telemetry_alloc_stats(uint8_t tag, AllocTagStats& out_stats);
+#else
+static constexpr bool kTelemetryAllocTrace = false;
+inline int8_t service_telemetry_alloc_tag(const char*) { return -1; }
+inline int8_t service_telemetry_swap_alloc_tag(int8_t) { return -1; }
+inline uint8_t service_telemetry_alloc_tag_count() { return 0; }
+inline bool service_telemetry_alloc_stats(uint8_t, AllocTagStats&) { return false; }
+#endif
+
+} // namespace ptc
@@ -153,7 +153,7 @@ void service_wifi_tick(DeviceConfig& config, AppState& state) {
     if (g_connected) {
         g_connected = false;
         state.wifi_connected = false;
-        service_log_add("Wi-Fi disconnected");
+        service_log_add_error("Wi-Fi disconnected");
     }
 
     if (g_connecting && millis() - g_connect_start_ms > kConnectTimeoutMs) {
@@ -217,7 +217,7 @@ void service_wifi_start_portal() {
         service_log_add("Wi-Fi portal started");
         Serial.printf("[WIFI] portal started: %s\n", ap_ssid.c_str());
     } else {
-        service_log_add("Wi-Fi portal start failed");
+        service_log_add_error("Wi-Fi portal start failed");
         Serial.println("[WIFI] portal start failed");
     }
 }
@@ -2,121 +2,167 @@
 
 #include <Arduino.h>
 #include <algorithm>
-#include <vector>
 
 #include <esp_heap_caps.h>
 
-#include <qrcode.h>
-
 #include "services/service_http.h"
 #include "services/service_qr.h"
+#include "ui_qr_raster.h"
 #include "ui_theme.h"
 
 namespace ptc {
 
 namespace {
 
-constexpr int kQrCanvasSize = 432;
-constexpr int kQrQuietZone = 4;
-
 struct QrUi {
     lv_obj_t* canvas = nullptr;
-    lv_color_t* canvas_buf = nullptr;
+    // The canvas shows raster `front`; the other one is drawn off screen
+    // with the next frame and swapped in when that frame is due.
+    QrRaster rasters[2];
+    uint8_t front = 0;
+    lv_timer_t* swap_timer = nullptr;
     lv_obj_t* qr_box = nullptr;
     lv_obj_t* code_value = nullptr;
     lv_obj_t* arc = nullptr;
     lv_obj_t* countdown = nullptr;
     lv_obj_t* qr_label = nullptr;
     const DeviceConfig* config = nullptr;
-    String last_payload;
     bool qr_rendered = false;
 };
 
-struct QrCapacity {
-    uint8_t version;
-    uint16_t byte_capacity;
-};
+void animate_pulse(lv_obj_t* target) {
+    LV_UNUSED(target);
+}
 
-constexpr QrCapacity kQrCapacities[] = {
-    {5, 106},
-    {6, 134},
-    {7, 154},
-    {8, 192},
-    {9, 230},
-    {10, 271},
-};
+// The back raster last held the frame before the one on screen, so only the
+// module rows that differ from it are redrawn.
+void draw_back(QrUi& ui, const QrFrame& frame) {
+    QrRaster& back = ui.rasters[ui.front ^ 1];
+    QrDrawStats stats;
+    if (ui_qr_raster_draw(back, frame, &stats)) {
+        Serial.printf("[QR] rendered version=%u modules=%u rows=%u full=%d payload_bytes=%u\n",
+            frame.version,
+            static_cast<unsigned int>(frame.size),
+            static_cast<unsigned int>(stats.rows_written),
+            stats.full ? 1 : 0,
+            static_cast<unsigned int>(frame.payload.length()));
+    }
+    back.sequence = frame.sequence;
+}
+
+// Points the canvas at the other buffer without lv_canvas_set_buffer(),
+// which would invalidate the whole canvas, and invalidates only the bands
+// where the two frames differ.
+void swap_buffers(QrUi& ui) {
+    const QrRaster& shown = ui.rasters[ui.front];
+    ui.front ^= 1;
+    const QrRaster& next = ui.rasters[ui.front];
+    auto* canvas = reinterpret_cast<lv_canvas_t*>(ui.canvas);
+    canvas->dsc.data = next.buffer;
+    lv_img_cache_invalidate_src(&canvas->dsc);
+
+    lv_area_t bands[kQrMaxBands];
+    const size_t band_count = ui_qr_raster_diff(shown, next, bands, kQrMaxBands);
+    lv_area_t coords;
+    lv_obj_get_coords(ui.canvas, &coords);
+    for (size_t i = 0; i < band_count; ++i) {
+        lv_area_move(&bands[i], coords.x1, coords.y1);
+        lv_obj_invalidate_area(ui.canvas, &bands[i]);
+    }
+    ui.qr_rendered = next.version != 0;
+    if (ui.qr_rendered) {
+        animate_pulse(ui.qr_box);
+    }
+}
 
-uint8_t select_qr_version(size_t payload_length) {
-    for (const auto& capacity : kQrCapacities) {
-        if (payload_length <= capacity.byte_capacity) {
-            return capacity.version;
+// Puts the current frame on the canvas, drawing it first only if it was not
+// prepared ahead, then draws the next frame into the back buffer and arms
+// the swap for the moment it is due.
+void sync_canvas(QrUi& ui) {
+    if (!ui.canvas) {
+        return;
+    }
+    const uint32_t sequence = service_qr_frame_sequence();
+    if (sequence == 0) {
+        ui.rasters[ui.front].sequence = 0;
+        ui.qr_rendered = false;
+        return;
+    }
+    if (sequence != ui.rasters[ui.front].sequence) {
+        QrFrame frame;
+        if (ui.rasters[ui.front ^ 1].sequence != sequence && service_qr_frame(frame)) {
+            draw_back(ui, frame);
+        }
+        swap_buffers(ui);
+    }
+    const uint32_t next_sequence = service_qr_next_sequence();
+    if (next_sequence != 0 && next_sequence != ui.rasters[ui.front ^ 1].sequence) {
+        QrFrame next;
+        if (service_qr_next_frame(next)) {
+            draw_back(ui, next);
+            const uint32_t lead_ms = next.shown_at_ms - millis();
+            if (ui.swap_timer && lead_ms < 0x80000000UL) {
+                lv_timer_set_period(ui.swap_timer, max<uint32_t>(lead_ms, 1));
+                lv_timer_reset(ui.swap_timer);
+                lv_timer_resume(ui.swap_timer);
+            }
         }
     }
-    return 0;
 }
 
-bool draw_qr(QrUi& ui, const String& payload) {
-    if (!ui.canvas || !ui.canvas_buf) {
-        return false;
+void update_qr(QrUi& ui) {
+    uint32_t interval = service_qr_interval_sec();
+    if (interval == 0) {
+        interval = 1;
     }
+    uint32_t remain = service_qr_seconds_remaining();
+    uint32_t pct = (interval - remain) * 100 / interval;
 
-    const uint8_t version = select_qr_version(payload.length());
-    if (version == 0) {
-        Serial.printf("[QR] payload too large bytes=%u\n",
-            static_cast<unsigned int>(payload.length()));
-        return false;
+    if (ui.arc) {
+        lv_arc_set_value(ui.arc, pct);
     }
 
-    QRCode qrcode;
-    static std::vector<uint8_t> qrcode_data;
-    const size_t buffer_size = qrcode_getBufferSize(version);
-    if (qrcode_data.size() != buffer_size) {
-        qrcode_data.assign(buffer_size, 0);
+    if (ui.countdown) {
+        char buf[24];
+        snprintf(buf, sizeof(buf), "Refresh %lus", static_cast<unsigned long>(remain));
+        lv_label_set_text(ui.countdown, buf);
     }
 
-    if (qrcode_initText(&qrcode, qrcode_data.data(), version, ECC_LOW, payload.c_str()) != 0) {
-        Serial.println("[QR] encoder failed");
-        return false;
+    sync_canvas(ui);
+    const bool has_payload = service_qr_frame_sequence() != 0;
+    if (ui.qr_label) {
+        lv_label_set_text(
+            ui.qr_label,
+            has_payload
+                ? (ui.qr_rendered ? "" : "QR unavailable")
+                : "Waiting for QR");
     }
 
-    const int size = qrcode.size;
-    const int total_modules = size + kQrQuietZone * 2;
-    const int scale = kQrCanvasSize / total_modules;
-    if (scale < 1) {
-        Serial.println("[QR] canvas too small");
-        return false;
+    if (ui.canvas) {
+        if (has_payload && ui.qr_rendered) {
+            lv_obj_clear_flag(ui.canvas, LV_OBJ_FLAG_HIDDEN);
+        } else {
+            lv_obj_add_flag(ui.canvas, LV_OBJ_FLAG_HIDDEN);
+        }
     }
-    const int drawn_size = total_modules * scale;
-    const int offset = (kQrCanvasSize - drawn_size) / 2;
-
-    const lv_color_t white = theme::white();
-    const lv_color_t black = theme::black();
-    std::fill_n(ui.canvas_buf, kQrCanvasSize * kQrCanvasSize, white);
-
-    for (int y = 0; y < size; ++y) {
-        for (int x = 0; x < size; ++x) {
-            if (qrcode_getModule(&qrcode, x, y)) {
-                const int pixel_x = offset + (x + kQrQuietZone) * scale;
-                const int pixel_y = offset + (y + kQrQuietZone) * scale;
-                for (int row = 0; row < scale; ++row) {
-                    lv_color_t* destination =
-                        ui.canvas_buf + ((pixel_y + row) * kQrCanvasSize) + pixel_x;
-                    std::fill_n(destination, scale, black);
-                }
-            }
+
+    if (ui.code_value) {
+        const String code = service_http_manual_code_display();
+        if (!code.isEmpty()) {
+            lv_label_set_text(ui.code_value, code.c_str());
+            lv_obj_set_style_text_color(ui.code_value, theme::white(), 0);
+        } else if (service_http_manual_code_pending()) {
+            lv_label_set_text(ui.code_value, "Loading...");
+            lv_obj_set_style_text_color(ui.code_value, theme::text_soft(), 0);
+        } else {
+            lv_label_set_text(ui.code_value, "Unavailable");
+            lv_obj_set_style_text_color(ui.code_value, theme::text_soft(), 0);
         }
     }
-    lv_obj_invalidate(ui.canvas);
-    Serial.printf("[QR] rendered version=%u modules=%u scale=%d payload_bytes=%u\n",
-        version,
-        static_cast<unsigned int>(size),
-        scale,
-        static_cast<unsigned int>(payload.length()));
-    return true;
 }
 
-void animate_pulse(lv_obj_t* target) {
-    LV_UNUSED(target);
+bool qr_visible(const QrUi* ui) {
+    return ui && ui->config && ui->qr_box && lv_obj_is_visible(ui->qr_box);
 }
 
 } // namespace
@@ -142,19 +188,20 @@ void ui_qr_build(lv_obj_t* parent, const DeviceConfig& config, AppState& state)
     lv_obj_set_style_pad_all(ui.qr_box, 0, 0);
     lv_obj_clear_flag(ui.qr_box, LV_OBJ_FLAG_SCROLLABLE);
 
-    ui.canvas_buf = static_cast<lv_color_t*>(heap_caps_malloc(
-        kQrCanvasSize * kQrCanvasSize * sizeof(lv_color_t),
-        MALLOC_CAP_SPIRAM | MALLOC_CAP_8BIT));
-    if (ui.canvas_buf) {
+    for (QrRaster& raster : ui.rasters) {
+        ui_qr_raster_init(raster, static_cast<uint8_t*>(heap_caps_malloc(
+            kQrCanvasBytes,
+            MALLOC_CAP_SPIRAM | MALLOC_CAP_8BIT)));
+    }
+    if (ui.rasters[0].buffer && ui.rasters[1].buffer) {
         ui.canvas = lv_canvas_create(ui.qr_box);
         lv_canvas_set_buffer(
             ui.canvas,
-            ui.canvas_buf,
+            ui.rasters[ui.front].buffer,
             kQrCanvasSize,
             kQrCanvasSize,
-            LV_IMG_CF_TRUE_COLOR);
+            LV_IMG_CF_INDEXED_1BIT);
         lv_obj_center(ui.canvas);
-        lv_canvas_fill_bg(ui.canvas, theme::white(), LV_OPA_COVER);
     }
 
     ui.qr_label = lv_label_create(ui.qr_box);
@@ -207,72 +254,22 @@ void ui_qr_build(lv_obj_t* parent, const DeviceConfig& config, AppState& state)
 
     lv_timer_create([](lv_timer_t* timer) {
         auto* ui_ptr = static_cast<QrUi*>(timer->user_data);
-        if (!ui_ptr || !ui_ptr->config || !ui_ptr->qr_box || !lv_obj_is_visible(ui_ptr->qr_box)) {
-            return;
-        }
-
-        uint32_t interval = service_qr_interval_sec();
-        if (interval == 0) {
-            interval = 1;
-        }
-        uint32_t remain = service_qr_seconds_remaining();
-        uint32_t pct = (interval - remain) * 100 / interval;
-
-        if (ui_ptr->arc) {
-            lv_arc_set_value(ui_ptr->arc, pct);
-        }
-
-        if (ui_ptr->countdown) {
-            char buf[24];
-            snprintf(buf, sizeof(buf), "Refresh %lus", static_cast<unsigned long>(remain));
-            lv_label_set_text(ui_ptr->countdown, buf);
-        }
-
-        String payload = service_qr_payload();
-        bool has_payload = payload.length() > 0;
-        if (ui_ptr->qr_label) {
-            lv_label_set_text(
-                ui_ptr->qr_label,
-                has_payload
-                    ? (ui_ptr->qr_rendered ? "" : "QR unavailable")
-                    : "Waiting for QR");
-        }
-
-        if (has_payload && payload != ui_ptr->last_payload) {
-            ui_ptr->last_payload = payload;
-            ui_ptr->qr_rendered = draw_qr(*ui_ptr, payload);
-            if (ui_ptr->qr_rendered) {
-                animate_pulse(ui_ptr->qr_box);
-            }
-            if (ui_ptr->qr_label) {
-                lv_label_set_text(
-                    ui_ptr->qr_label,
-                    ui_ptr->qr_rendered ? "" : "QR unavailable");
-            }
-        }
-
-        if (ui_ptr->canvas) {
-            if (has_payload && ui_ptr->qr_rendered) {
-                lv_obj_clear_flag(ui_ptr->canvas, LV_OBJ_FLAG_HIDDEN);
-            } else {
-                lv_obj_add_flag(ui_ptr->canvas, LV_OBJ_FLAG_HIDDEN);
-            }
+        if (qr_visible(ui_ptr)) {
+            update_qr(*ui_ptr);
         }
+    }, 1000, &ui);
 
-        if (ui_ptr->code_value) {
-            const String code = service_http_manual_code_display();
-            if (!code.isEmpty()) {
-                lv_label_set_text(ui_ptr->code_value, code.c_str());
-                lv_obj_set_style_text_color(ui_ptr->code_value, theme::white(), 0);
-            } else if (service_http_manual_code_pending()) {
-                lv_label_set_text(ui_ptr->code_value, "Loading...");
-                lv_obj_set_style_text_color(ui_ptr->code_value, theme::text_soft(), 0);
-            } else {
-                lv_label_set_text(ui_ptr->code_value, "Unavailable");
-                lv_obj_set_style_text_color(ui_ptr->code_value, theme::text_soft(), 0);
-            }
+    // One-shot, armed by sync_canvas() for the instant the next frame is due.
+    ui.swap_timer = lv_timer_create([](lv_timer_t* timer) {
+        lv_timer_pause(timer);
+        auto* ui_ptr = static_cast<QrUi*>(timer->user_data);
+        if (qr_visible(ui_ptr)) {
+            update_qr(*ui_ptr);
         }
     }, 1000, &ui);
+    if (ui.swap_timer) {
+        lv_timer_pause(ui.swap_timer);
+    }
 }
 
 } // namespace ptc
@@ -0,0 +1,195 @@
+#include "ui_qr_raster.h"
+
+#include <Arduino.h>
+#include <algorithm>
+
+#include "ui_theme.h"
+
+namespace ptc {
+
+namespace {
+
+struct Layout {
+    int scale = 0;
+    int offset = 0;
+};
+
+bool layout_for(uint8_t size, Layout& layout) {
+    const int total_modules = size + kQrQuietZone * 2;
+    layout.scale = kQrCanvasSize / total_modules;
+    layout.offset = (kQrCanvasSize - total_modules * layout.scale) / 2;
+    return layout.scale >= 1;
+}
+
+int module_pixel(const Layout& layout, int module) {
+    return layout.offset + (module + kQrQuietZone) * layout.scale;
+}
+
+uint8_t* pixel_row(const QrRaster& raster, int y) {
+    return raster.buffer + kQrPaletteBytes + y * kQrRowBytes;
+}
+
+// Sets (dark) or clears count pixels of one row from x, a byte at a time.
+void fill_span(uint8_t* row, int x, int count, bool dark) {
+    const int end = x + count;
+    while (x < end) {
+        const int bit = x & 7;
+        const int taken = std::min(8 - bit, end - x);
+        const uint8_t mask = static_cast<uint8_t>((0xFF >> bit) & (0xFF << (8 - bit - taken)));
+        row[x >> 3] = dark ? row[x >> 3] | mask : row[x >> 3] & ~mask;
+        x += taken;
+    }
+}
+
+// Draws module row y into its first pixel row, then copies that down the
+// rest of the module's height. Returns the dark modules drawn.
+uint32_t draw_module_row(const QrRaster& raster, const Layout& layout, const QrFrame& frame, int y) {
+    uint8_t* first_row = pixel_row(raster, module_pixel(layout, y));
+    fill_span(first_row, module_pixel(layout, 0), frame.size * layout.scale, false);
+    uint32_t dark = 0;
+    for (int x = 0; x < frame.size; ++x) {
+        if (frame.module(x, y)) {
+            fill_span(first_row, module_pixel(layout, x), layout.scale, true);
+            dark++;
+        }
+    }
+    for (int row = 1; row < layout.scale; ++row) {
+        memcpy(first_row + row * kQrRowBytes, first_row, kQrRowBytes);
+    }
+    return dark;
+}
+
+// Calls fn(x, y, dark) for every module where the bitmaps (same version)
+// differ, dark being its value in to. Whole bytes that match are skipped.
+template <typename Fn>
+void for_each_flip(const std::vector<uint8_t>& from, const std::vector<uint8_t>& to, uint8_t size, Fn&& fn) {
+    const uint32_t module_count = static_cast<uint32_t>(size) * size;
+    for (size_t i = 0; i < to.size(); ++i) {
+        uint32_t flipped = from[i] ^ to[i];
+        while (flipped != 0) {
+            const int bit = 31 - __builtin_clz(flipped);
+            flipped &= ~(1U << bit);
+            const uint32_t offset = i * 8 + (7 - bit);
+            if (offset >= module_count) {
+                break;
+            }
+            fn(static_cast<int>(offset % size), static_cast<int>(offset / size), ((to[i] >> bit) & 1) != 0);
+        }
+    }
+}
+
+bool same_shape(const QrRaster& raster, const QrFrame& frame) {
+    return raster.version != 0 && raster.version == frame.version && raster.size == frame.size &&
+        raster.modules.size() == frame.modules.size();
+}
+
+} // namespace
+
+void ui_qr_raster_init(QrRaster& raster, uint8_t* buffer) {
+    raster = QrRaster();
+    raster.buffer = buffer;
+    if (!buffer) {
+        return;
+    }
+    lv_img_dsc_t image = {};
+    image.header.cf = LV_IMG_CF_INDEXED_1BIT;
+    image.header.w = kQrCanvasSize;
+    image.header.h = kQrCanvasSize;
+    image.data_size = kQrCanvasBytes;
+    image.data = buffer;
+    lv_img_buf_set_palette(&image, 0, theme::white());
+    lv_img_buf_set_palette(&image, 1, theme::black());
+    memset(buffer + kQrPaletteBytes, 0, kQrCanvasBytes - kQrPaletteBytes);
+}
+
+bool ui_qr_raster_draw(QrRaster& raster, const QrFrame& frame, QrDrawStats* stats) {
+    QrDrawStats local;
+    QrDrawStats& out = stats ? *stats : local;
+    out = QrDrawStats();
+    Layout layout;
+    if (!raster.buffer || frame.version == 0 || frame.size > kQrMaxModules) {
+        raster.version = 0;
+        return false;
+    }
+    if (!layout_for(frame.size, layout)) {
+        Serial.println("[QR] canvas too small");
+        raster.version = 0;
+        return false;
+    }
+
+    if (same_shape(raster, frame)) {
+        // A whole module row is cheaper to redraw than its flipped modules
+        // one by one, so only rows without a flip are left alone.
+        bool row_flipped[kQrMaxModules] = {};
+        for_each_flip(raster.modules, frame.modules, frame.size, [&](int, int y, bool) {
+            row_flipped[y] = true;
+            out.modules_written++;
+        });
+        for (int y = 0; y < frame.size; ++y) {
+            if (row_flipped[y]) {
+                draw_module_row(raster, layout, frame, y);
+                out.rows_written++;
+            }
+        }
+    } else {
+        out.full = true;
+        memset(raster.buffer + kQrPaletteBytes, 0, kQrCanvasBytes - kQrPaletteBytes);
+        for (int y = 0; y < frame.size; ++y) {
+            out.modules_written += draw_module_row(raster, layout, frame, y);
+        }
+        out.rows_written = frame.size;
+    }
+    raster.version = frame.version;
+    raster.size = frame.size;
+    raster.sequence = frame.sequence;
+    raster.modules = frame.modules;
+    return true;
+}
+
+size_t ui_qr_raster_diff(const QrRaster& from, const QrRaster& to, lv_area_t* bands, size_t max_bands) {
+    if (max_bands == 0) {
+        return 0;
+    }
+    Layout layout;
+    if (from.version == 0 || from.version != to.version || from.size != to.size ||
+        from.modules.size() != to.modules.size() || !layout_for(to.size, layout)) {
+        bands[0] = {0, 0, kQrCanvasSize - 1, kQrCanvasSize - 1};
+        return 1;
+    }
+
+    // Flipped column range per module row, then consecutive rows joined.
+    uint8_t row_min[kQrMaxModules];
+    uint8_t row_max[kQrMaxModules];
+    std::fill_n(row_min, to.size, 0xFF);
+    std::fill_n(row_max, to.size, 0);
+    for_each_flip(from.modules, to.modules, to.size, [&](int x, int y, bool) {
+        row_min[y] = std::min<uint8_t>(row_min[y], x);
+        row_max[y] = std::max<uint8_t>(row_max[y], x);
+    });
+    size_t count = 0;
+    int last_row = -2;
+    for (int y = 0; y < to.size; ++y) {
+        if (row_min[y] == 0xFF) {
+            continue;
+        }
+        if (count > 0 && (y == last_row + 1 || count == max_bands)) {
+            lv_area_t& band = bands[count - 1];
+            band.x1 = std::min<lv_coord_t>(band.x1, row_min[y]);
+            band.x2 = std::max<lv_coord_t>(band.x2, row_max[y]);
+            band.y2 = y;
+        } else {
+            bands[count++] = {row_min[y], static_cast<lv_coord_t>(y), row_max[y], static_cast<lv_coord_t>(y)};
+        }
+        last_row = y;
+    }
+    for (size_t i = 0; i < count; ++i) {
+        lv_area_t& band = bands[i];
+        band = {static_cast<lv_coord_t>(module_pixel(layout, band.x1)),
+            static_cast<lv_coord_t>(module_pixel(layout, band.y1)),
+            static_cast<lv_coord_t>(module_pixel(layout, band.x2 + 1) - 1),
+            static_cast<lv_coord_t>(module_pixel(layout, band.y2 + 1) - 1)};
+    }
+    return count;
+}
+
+} // namespace ptc
@@ -0,0 +1,55 @@
+#pragma once
+
+#include <lvgl.h>
+#include <vector>
+
+#include "services/service_qr.h"
+
+namespace ptc {
+
+static constexpr int kQrCanvasSize = 432;
+static constexpr int kQrQuietZone = 4;
+// Modules per side of the largest version in kQrCapacities.
+static constexpr int kQrMaxModules =
+    17 + 4 * kQrCapacities[sizeof(kQrCapacities) / sizeof(kQrCapacities[0]) - 1].version;
+// Areas invalidated per swap; well under LVGL's LV_INV_BUF_SIZE, past which
+// it would redraw the whole screen.
+static constexpr size_t kQrMaxBands = 8;
+// The canvas is LV_IMG_CF_INDEXED_1BIT: a two-colour palette (0 light,
+// 1 dark), then one bit per pixel, most significant bit first, rows of
+// kQrRowBytes. About 23 KB against 373 KB for RGB565.
+static constexpr size_t kQrPaletteBytes = 2 * sizeof(lv_color32_t);
+static constexpr size_t kQrRowBytes = (kQrCanvasSize + 7) / 8;
+static constexpr size_t kQrCanvasBytes = LV_CANVAS_BUF_SIZE_INDEXED_1BIT(kQrCanvasSize, kQrCanvasSize);
+
+// A canvas buffer and the modules last drawn into it, so the next frame only
+// rewrites the modules that flipped.
+struct QrRaster {
+    // kQrCanvasBytes, palette first.
+    uint8_t* buffer = nullptr;
+    // 0 while the pixels match no frame; the next draw then starts over.
+    uint8_t version = 0;
+    uint8_t size = 0;
+    uint32_t sequence = 0;
+    std::vector<uint8_t> modules;
+};
+
+struct QrDrawStats {
+    bool full = false;
+    // Dark modules on a full draw, flipped ones otherwise.
+    uint32_t modules_written = 0;
+    uint32_t rows_written = 0;
+};
+
+// Takes buffer for raster, writes the palette and clears it to light.
+void ui_qr_raster_init(QrRaster& raster, uint8_t* buffer);
+// Draws frame into raster. Same version as the frame it holds: only the
+// module rows with a flipped module are redrawn; otherwise the canvas is
+// cleared and drawn in full.
+bool ui_qr_raster_draw(QrRaster& raster, const QrFrame& frame, QrDrawStats* stats = nullptr);
+// Canvas-relative row bands covering every module that differs between two
+// rasters, each as wide as its flipped modules. Returns the band count: 0
+// when they match, 1 covering the canvas when their versions differ.
+size_t ui_qr_raster_diff(const QrRaster& from, const QrRaster& to, lv_area_t* bands, size_t max_bands);
+
+} // namespace ptc
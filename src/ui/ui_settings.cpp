@@ -3,7 +3,9 @@
 #include "services/service_time.h"
 #include "services/service_wifi.h"
 #include "services/service_http.h"
+#include "services/service_outbox.h"
 #include "services/service_ota.h"
+#include "services/service_telemetry.h"
 #include "drivers/touch_driver.h"
 #include "ui_root.h"
 #include "ui_theme.h"
@@ -38,6 +40,8 @@ struct SettingsUi {
     lv_obj_t* update_percent = nullptr;
     lv_obj_t* update_install_button = nullptr;
     lv_obj_t* update_back_button = nullptr;
+    lv_obj_t* diag_page = nullptr;
+    lv_obj_t* diag_body = nullptr;
     String dismissed_update_version;
     lv_obj_t* toast = nullptr;
     AppState* state = nullptr;
@@ -213,6 +217,67 @@ String format_storage_status() {
         String(static_cast<unsigned long>(total_mib)) + " MB";
 }
 
+String format_kib(uint32_t bytes) {
+    return String(static_cast<unsigned long>((bytes + 512) / 1024)) + " KB";
+}
+
+String format_heap_region(const char* name, const HeapRegionStats& region) {
+    if (region.total_bytes == 0) {
+        return String(name) + ": not present\n";
+    }
+    return String(name) + ": " + format_kib(region.free_bytes) + " free of " +
+        format_kib(region.total_bytes) + "\n  largest block " + format_kib(region.largest_block) +
+        ", lowest " + format_kib(region.min_free_bytes) +
+        ", " + String(service_telemetry_fragmentation(region)) + "% fragmented\n";
+}
+
+String format_diagnostics() {
+    TelemetrySnapshot snapshot;
+    service_telemetry_sample(snapshot);
+
+    String text;
+    text.reserve(768);
+    text += format_heap_region("Internal RAM", snapshot.internal);
+    text += format_heap_region("PSRAM", snapshot.psram);
+    text += "\nStack headroom\n";
+    for (uint8_t i = 0; i < snapshot.task_count; ++i) {
+        text += String("  ") + snapshot.tasks[i].name + ": " +
+            String(static_cast<unsigned long>(snapshot.tasks[i].free_bytes)) + " B\n";
+    }
+    text += "\nPortal endpoints\n";
+    for (uint8_t i = 0; i < service_http_endpoint_count(); ++i) {
+        HttpEndpointStatus endpoint;
+        if (!service_http_endpoint_status(i, endpoint)) {
+            continue;
+        }
+        text += String("  ") + endpoint.name + ": " + endpoint.state;
+        if (endpoint.retry_in_ms > 0) {
+            text += ", retry in " + String(static_cast<unsigned long>((endpoint.retry_in_ms + 999) / 1000)) + " s";
+        }
+        if (endpoint.failures > 0) {
+            text += ", " + String(endpoint.failures) + " failed (" + String(endpoint.last_status) + ")";
+        }
+        text += ", " + String(static_cast<unsigned long>(endpoint.trips)) + " trips\n";
+    }
+    OutboxStats outbox;
+    service_outbox_stats(outbox);
+    text += "  outbox: " + String(static_cast<unsigned long>(outbox.depth)) + " queued, " +
+        format_kib(outbox.pending_bytes) + ", " + String(static_cast<unsigned long>(outbox.delivered)) +
+        " sent, " + String(static_cast<unsigned long>(outbox.dropped)) + " dropped\n";
+    if (kTelemetryAllocTrace) {
+        text += "\nAllocations (count / bytes)\n";
+        for (uint8_t i = 0; i < service_telemetry_alloc_tag_count(); ++i) {
+            AllocTagStats stats;
+            if (!service_telemetry_alloc_stats(i, stats) || stats.count == 0) {
+                continue;
+            }
+            text += String("  ") + stats.name + ": " + String(static_cast<unsigned long>(stats.count)) +
+                " / " + format_kib(stats.bytes) + "\n";
+        }
+    }
+    return text;
+}
+
 lv_obj_t* create_field(lv_obj_t* parent, const char* label, const char* value) {
     lv_obj_t* row = lv_obj_create(parent);
     lv_obj_set_width(row, lv_pct(100));
@@ -448,6 +513,50 @@ void create_install_page(SettingsUi& ui) {
     }, 200, &ui);
 }
 
+void create_diagnostics_page(SettingsUi& ui) {
+    ui.diag_page = lv_obj_create(lv_scr_act());
+    lv_obj_set_size(ui.diag_page, lv_pct(100), lv_pct(100));
+    lv_obj_set_pos(ui.diag_page, 0, 0);
+    lv_obj_set_style_radius(ui.diag_page, 0, 0);
+    lv_obj_set_style_border_width(ui.diag_page, 0, 0);
+    lv_obj_set_style_bg_color(ui.diag_page, theme::black(), 0);
+    lv_obj_set_style_bg_opa(ui.diag_page, LV_OPA_COVER, 0);
+    lv_obj_set_style_pad_all(ui.diag_page, 32, 0);
+    lv_obj_set_style_pad_row(ui.diag_page, 20, 0);
+    lv_obj_set_flex_flow(ui.diag_page, LV_FLEX_FLOW_COLUMN);
+
+    lv_obj_t* title = lv_label_create(ui.diag_page);
+    lv_label_set_text(title, "Diagnostics");
+    lv_obj_set_style_text_color(title, theme::white(), 0);
+
+    ui.diag_body = lv_label_create(ui.diag_page);
+    lv_obj_set_width(ui.diag_body, lv_pct(100));
+    lv_label_set_long_mode(ui.diag_body, LV_LABEL_LONG_WRAP);
+    lv_obj_set_style_text_color(ui.diag_body, theme::white(), 0);
+    lv_label_set_text(ui.diag_body, "");
+
+    lv_obj_t* back_button = create_action(ui.diag_page, LV_SYMBOL_LEFT " Back to settings");
+    lv_obj_set_style_bg_color(back_button, theme::surface(), 0);
+    lv_obj_add_event_cb(back_button, [](lv_event_t* event) {
+        auto* ui_ptr = static_cast<SettingsUi*>(lv_event_get_user_data(event));
+        if (ui_ptr && ui_ptr->diag_page) {
+            lv_obj_add_flag(ui_ptr->diag_page, LV_OBJ_FLAG_HIDDEN);
+        }
+    }, LV_EVENT_CLICKED, &ui);
+
+    lv_obj_add_flag(ui.diag_page, LV_OBJ_FLAG_HIDDEN);
+    lv_timer_create([](lv_timer_t* timer) {
+        auto* ui_ptr = static_cast<SettingsUi*>(timer->user_data);
+        if (!ui_ptr || !ui_ptr->diag_page || lv_obj_has_flag(ui_ptr->diag_page, LV_OBJ_FLAG_HIDDEN)) {
+            return;
+        }
+        const String text = format_diagnostics();
+        if (text != lv_label_get_text(ui_ptr->diag_body)) {
+            lv_label_set_text(ui_ptr->diag_body, text.c_str());
+        }
+    }, 1000, &ui);
+}
+
 } // namespace
 
 void ui_settings_build(lv_obj_t* parent, DeviceConfig& config, AppState& state) {
@@ -568,6 +677,7 @@ void ui_settings_build(lv_obj_t* parent, DeviceConfig& config, AppState& state)
         uint16_t selected = lv_dropdown_get_selected(lv_event_get_target(event));
         uint32_t values[] = {5, 10, 20, 30};
         ctx->config->qr_interval_sec = values[selected];
+        ctx->config->config_etag = "";
         service_storage_save_config(*ctx->config);
         if (ctx->toast) {
             lv_label_set_text(ctx->toast, "QR interval updated");
@@ -613,7 +723,20 @@ void ui_settings_build(lv_obj_t* parent, DeviceConfig& config, AppState& state)
     }, LV_EVENT_CLICKED, &ui);
     lv_obj_add_flag(ui.github_apply_button, LV_OBJ_FLAG_HIDDEN);
 
+    lv_obj_t* diag_btn = create_action(parent, LV_SYMBOL_LIST " Diagnostics");
+    lv_obj_add_event_cb(diag_btn, [](lv_event_t* event) {
+        auto* ui_ptr = static_cast<SettingsUi*>(lv_event_get_user_data(event));
+        if (!ui_ptr || !ui_ptr->diag_page) {
+            return;
+        }
+        const String text = format_diagnostics();
+        lv_label_set_text(ui_ptr->diag_body, text.c_str());
+        lv_obj_clear_flag(ui_ptr->diag_page, LV_OBJ_FLAG_HIDDEN);
+        lv_obj_move_foreground(ui_ptr->diag_page);
+    }, LV_EVENT_CLICKED, &ui);
+
     create_install_page(ui);
+    create_diagnostics_page(ui);
 
     ui.toast = lv_label_create(parent);
     lv_label_set_text(ui.toast, "Saved");
@@ -0,0 +1,184 @@
+#include "ui_task.h"
+
+#include <Arduino.h>
+#include <freertos/FreeRTOS.h>
+#include <freertos/queue.h>
+#include <freertos/task.h>
+
+#include "drivers/display_driver.h"
+#include "drivers/touch_driver.h"
+#include "services/service_log.h"
+#include "services/service_metrics.h"
+#include "services/service_scheduler.h"
+#include "services/service_telemetry.h"
+
+namespace ptc {
+
+namespace {
+
+constexpr uint32_t kTaskStackSize = 12288;
+constexpr UBaseType_t kTaskPriority = 2;
+constexpr BaseType_t kTaskCore = 1;
+constexpr UBaseType_t kQueueLength = 8;
+constexpr uint32_t kDisplayRefreshIntervalMs = 30;
+constexpr uint32_t kServiceLockWaitMs = 2;
+constexpr uint32_t kServiceLockRetryMs = 5;
+
+QueueHandle_t g_queue = nullptr;
+TaskHandle_t g_task = nullptr;
+lv_disp_t* g_display = nullptr;
+lv_indev_t* g_touch_indev = nullptr;
+volatile uint32_t g_last_input_ms = 0;
+uint32_t g_last_refresh_ms = 0;
+bool g_wake_log_pending = false;
+int8_t g_lv_timer_probe = -1;
+int8_t g_lv_refr_probe = -1;
+
+void refresh_now() {
+    g_last_refresh_ms = millis();
+    const uint32_t refr_start = service_metrics_start();
+    lv_refr_now(g_display);
+    service_metrics_stop(g_lv_refr_probe, refr_start);
+}
+
+void wake_display(uint32_t now_ms) {
+    display_driver_set_render_enabled(true);
+    display_driver_set_backlight(true);
+    g_last_input_ms = now_ms;
+    lv_obj_invalidate(lv_scr_act());
+    refresh_now();
+    g_wake_log_pending = true;
+}
+
+void sleep_display() {
+    if (!display_driver_is_backlight_on()) {
+        return;
+    }
+    touch_driver_prepare_for_screen_off();
+    display_driver_set_render_enabled(false);
+    display_driver_set_backlight(false);
+}
+
+void handle_messages() {
+    UiMessageType message;
+    while (xQueueReceive(g_queue, &message, 0) == pdTRUE) {
+        switch (message) {
+            case UiMessageType::kDisplaySleep:
+                sleep_display();
+                break;
+        }
+    }
+}
+
+void handle_touch(uint32_t now_ms) {
+    touch_driver_tick();
+    const bool wake_event = touch_driver_consume_wake_event();
+    const bool tap_event = touch_driver_consume_tap_event();
+    if (!display_driver_is_backlight_on()) {
+        if (wake_event || tap_event) {
+            touch_driver_suppress_until_release();
+            wake_display(now_ms);
+        }
+    } else if (tap_event) {
+        g_last_input_ms = now_ms;
+    }
+}
+
+// The indev read timer only runs while a touch is in progress; with an IRQ
+// line the panel wakes the task itself, so idle reads are pure overhead.
+void update_touch_read_timer() {
+    if (!g_touch_indev) {
+        return;
+    }
+    lv_timer_t* read_timer = g_touch_indev->driver->read_timer;
+    if (touch_driver_input_active()) {
+        if (read_timer->paused) {
+            lv_timer_resume(read_timer);
+            lv_timer_ready(read_timer);
+        }
+    } else if (!read_timer->paused) {
+        lv_timer_pause(read_timer);
+    }
+}
+
+// Flushes invalidated areas at most every kDisplayRefreshIntervalMs and
+// returns how long the task may sleep before the next flush is needed.
+uint32_t refresh_display_if_dirty(uint32_t now_ms) {
+    if (!display_driver_is_backlight_on() || g_display->inv_p == 0) {
+        return kSchedulerNoDeadline;
+    }
+    const uint32_t since_ms = now_ms - g_last_refresh_ms;
+    if (since_ms < kDisplayRefreshIntervalMs) {
+        return kDisplayRefreshIntervalMs - since_ms;
+    }
+    refresh_now();
+    return kSchedulerNoDeadline;
+}
+
+void ui_task(void* param) {
+    LV_UNUSED(param);
+    touch_driver_set_wake_task(xTaskGetCurrentTaskHandle());
+    for (;;) {
+        const uint32_t now_ms = millis();
+        handle_messages();
+        handle_touch(now_ms);
+        update_touch_read_timer();
+
+        // UI timers and event handlers call into services, so they only run
+        // between service ticks. Rendering does not wait for the lock.
+        uint32_t sleep_ms = kServiceLockRetryMs;
+        if (service_scheduler_lock(kServiceLockWaitMs)) {
+            if (g_wake_log_pending) {
+                g_wake_log_pending = false;
+                service_log_add("Display wake");
+            }
+            const uint32_t timer_start = service_metrics_start();
+            sleep_ms = lv_timer_handler();
+            service_metrics_stop(g_lv_timer_probe, timer_start);
+            service_scheduler_unlock();
+        }
+        sleep_ms = min(sleep_ms, refresh_display_if_dirty(millis()));
+        sleep_ms = min(sleep_ms, touch_driver_next_poll_ms());
+        ulTaskNotifyTake(pdTRUE, sleep_ms == kSchedulerNoDeadline ? portMAX_DELAY : pdMS_TO_TICKS(sleep_ms));
+    }
+}
+
+} // namespace
+
+bool ui_task_start(lv_disp_t* display, lv_indev_t* touch_indev) {
+    if (g_task || !display) {
+        return false;
+    }
+    g_display = display;
+    g_touch_indev = touch_indev;
+    g_last_input_ms = millis();
+    g_lv_timer_probe = service_metrics_probe("lv_timer");
+    g_lv_refr_probe = service_metrics_probe("lv_refr");
+    g_queue = xQueueCreate(kQueueLength, sizeof(UiMessageType));
+    if (!g_queue) {
+        Serial.println("[UI] message queue alloc failed");
+        return false;
+    }
+    if (xTaskCreatePinnedToCore(ui_task, "ui", kTaskStackSize, nullptr, kTaskPriority, &g_task, kTaskCore) != pdPASS) {
+        Serial.println("[UI] render task start failed");
+        g_task = nullptr;
+        return false;
+    }
+    service_telemetry_register_task(g_task);
+    service_telemetry_register_task(display_driver_flush_task());
+    return true;
+}
+
+bool ui_task_post(UiMessageType type) {
+    if (!g_queue || xQueueSend(g_queue, &type, 0) != pdTRUE) {
+        return false;
+    }
+    xTaskNotifyGive(g_task);
+    return true;
+}
+
+uint32_t ui_task_last_input_ms() {
+    return g_last_input_ms;
+}
+
+} // namespace ptc
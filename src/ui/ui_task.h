@@ -0,0 +1,22 @@
+#pragma once
+
+#include <lvgl.h>
+#include "config.h"
+
+namespace ptc {
+
+enum class UiMessageType : uint8_t {
+    kDisplaySleep,
+};
+
+// Starts the render task on core 1. From then on it owns LVGL: other tasks
+// must not call lv_* functions and reach the UI only through ui_task_post().
+bool ui_task_start(lv_disp_t* display, lv_indev_t* touch_indev);
+
+// Thread-safe; queues the message and wakes the render task.
+bool ui_task_post(UiMessageType type);
+
+// millis() of the last touch that reached the UI or woke the display.
+uint32_t ui_task_last_input_ms();
+
+} // namespace ptc